@@ -0,0 +1,171 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "concurrent_table.h"
+
+/**
+ * Stress benchmark of the concurrent table. Every workload runs with 1 up to
+ * the given number of threads, which look up random keys and insert the keys
+ * they miss. The values are checked on every hit, so that torn reads are
+ * reported. Run it with "make bench", the maximal number of threads and the
+ * seconds per run can be passed as arguments.
+ */
+
+#define CAPACITY 65536
+#define VALUE_WORDS 4
+
+struct workload {
+  const char *name;
+  // number of distinct keys, relative to the capacity
+  double key_space;
+};
+
+static const struct workload workloads[] = {
+    {"fits into table", 0.5},
+    {"2x capacity", 2.0},
+    {"8x capacity", 8.0},
+};
+
+struct worker {
+  pthread_t thread;
+  struct concurrent_table *table;
+  uint64_t key_space;
+  uint64_t seed;
+  atomic_int *stop;
+  unsigned long long operations;
+  unsigned long long torn_reads;
+};
+
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static void value_of(uint64_t key, uint64_t value[]) {
+  for (int i = 0; i < VALUE_WORDS; i++) {
+    value[i] = key * 0x9e3779b97f4a7c15ULL + (uint64_t)i;
+  }
+}
+
+static void *run_worker(void *data) {
+  struct worker *worker = data;
+  char error_message[256];
+  uint64_t expected[VALUE_WORDS], value[VALUE_WORDS];
+
+  while (!atomic_load_explicit(worker->stop, memory_order_relaxed)) {
+    for (int i = 0; i < 256; i++) {
+      uint64_t key = next_random(&worker->seed) % worker->key_space;
+      value_of(key, expected);
+      if (concurrent_table_get(worker->table, error_message, &key, value,
+                               NULL) == 1) {
+        worker->torn_reads += memcmp(value, expected, sizeof(value)) != 0;
+      } else {
+        concurrent_table_insert(worker->table, error_message, &key, expected,
+                                value, NULL);
+      }
+    }
+    worker->operations += 256;
+  }
+  return NULL;
+}
+
+static int run(const struct workload *workload, int thread_count,
+               double seconds) {
+  char error_message[256] = {0};
+  struct concurrent_table *table =
+      concurrent_table_new(error_message, CAPACITY, sizeof(uint64_t),
+                           VALUE_WORDS * sizeof(uint64_t), NULL);
+  if (table == NULL) {
+    fprintf(stderr, "%s", error_message);
+    return 1;
+  }
+
+  struct worker *workers = calloc(thread_count, sizeof(struct worker));
+  atomic_int stop = 0;
+  for (int i = 0; i < thread_count; i++) {
+    workers[i] = (struct worker){
+        .table = table,
+        .key_space = (uint64_t)(workload->key_space * CAPACITY),
+        .seed = 0x2545f4914f6cdd1dULL * (uint64_t)(i + 1),
+        .stop = &stop};
+    pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]);
+  }
+
+  struct timespec duration = {.tv_sec = (time_t)seconds,
+                              .tv_nsec = (long)((seconds - (time_t)seconds) *
+                                                1e9)};
+  nanosleep(&duration, NULL);
+  atomic_store(&stop, 1);
+
+  unsigned long long operations = 0, torn_reads = 0;
+  for (int i = 0; i < thread_count; i++) {
+    pthread_join(workers[i].thread, NULL);
+    operations += workers[i].operations;
+    torn_reads += workers[i].torn_reads;
+  }
+
+  struct concurrent_table_shard_stats stats, shard_stats;
+  unsigned long long busiest = 0, idlest = ~0ULL;
+  concurrent_table_stats(table, &stats);
+  for (int i = 0; i < CONCURRENT_TABLE_SHARD_COUNT; i++) {
+    concurrent_table_shard_stats(table, i, &shard_stats);
+    unsigned long long lookups = shard_stats.hits + shard_stats.misses;
+    busiest = lookups > busiest ? lookups : busiest;
+    idlest = lookups < idlest ? lookups : idlest;
+  }
+
+  printf("  %-16s %3d threads %12.0f ops/s  hit rate %5.1f%%  "
+         "evictions %10llu  shard lookups %llu..%llu  torn reads %llu\n",
+         workload->name, thread_count, operations / seconds,
+         100.0 * stats.hits / (stats.hits + stats.misses), stats.evictions,
+         idlest, busiest, torn_reads);
+
+  free(workers);
+  concurrent_table_free(table);
+  return torn_reads != 0;
+}
+
+int main(int argc, char **argv) {
+  long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  int max_threads = argc > 1 ? atoi(argv[1]) : (int)processors;
+  double seconds = argc > 2 ? atof(argv[2]) : 1.0;
+  int failed = 0;
+
+  if (max_threads <= 0 || seconds <= 0) {
+    fprintf(stderr, "usage: %s [max threads] [seconds per run]\n", argv[0]);
+    return 1;
+  }
+
+  printf("concurrent table with %d entries\n", CAPACITY);
+  for (size_t i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      failed |= run(&workloads[i], threads, seconds);
+    }
+  }
+  return failed;
+}
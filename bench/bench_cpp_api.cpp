@@ -0,0 +1,147 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <execution>
+#include <vector>
+
+#include "besu_native_ec.hpp"
+
+/**
+ * Compares the C++ front end with the C functions it wraps and the execution
+ * policies of the batch functions. The front end only passes pointers, so that
+ * both should run at the same speed. Run it with "make bench", the number of
+ * signatures can be passed as the first argument.
+ */
+
+namespace ec = besu::native_ec;
+
+using bench_clock = std::chrono::steady_clock;
+
+template <typename Function>
+static void report(const char *name, int operations, Function &&function) {
+  auto start = bench_clock::now();
+  int checked = function();
+  double seconds =
+      std::chrono::duration<double>(bench_clock::now() - start).count();
+  std::printf("  %-32s %10.0f ops/s %s\n", name, operations / seconds,
+              checked == operations ? "" : "(FAILED)");
+}
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 10000;
+  if (count <= 0) {
+    std::fprintf(stderr, "usage: %s [signature count]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<ec::key_pair<ec::P256>> key_pairs(count);
+  std::vector<char> private_keys(count * 32), public_keys(count * 64);
+  char error_message[256] = {0};
+  if (p256_generate_keypairs(private_keys.data(), public_keys.data(),
+                             error_message, count) != 1) {
+    std::fprintf(stderr, "could not generate key pairs: %s", error_message);
+    return 1;
+  }
+
+  std::vector<ec::bytes<32>> hashes(count);
+  std::vector<ec::signature<ec::P256>> signatures;
+  std::vector<ec::verify_request<ec::P256>> verify_requests;
+  std::vector<ec::recover_request<ec::P256>> recover_requests;
+  signatures.reserve(count);
+  for (int i = 0; i < count; i++) {
+    std::memcpy(key_pairs[i].private_key.data(), &private_keys[i * 32], 32);
+    std::memcpy(key_pairs[i].public_key.data(), &public_keys[i * 64], 64);
+    std::memcpy(hashes[i].data(), &i, sizeof(i));
+    signatures.push_back(ec::sign<ec::P256>(
+        hashes[i], key_pairs[i].private_key, key_pairs[i].public_key));
+  }
+  for (int i = 0; i < count; i++) {
+    verify_requests.push_back({hashes[i], signatures[i].r, signatures[i].s,
+                               key_pairs[i].public_key});
+    recover_requests.push_back(
+        {hashes[i], signatures[i].r, signatures[i].s, signatures[i].v});
+  }
+  std::vector<verify_result> verify_results(count);
+  std::vector<key_recovery_result> recover_results(count);
+
+  std::printf("%d signatures\n", count);
+
+  report("verify (C)", count, [&] {
+    int verified = 0;
+    for (int i = 0; i < count; i++) {
+      verified += p256_verify(
+                      reinterpret_cast<const char *>(hashes[i].data()), 32,
+                      reinterpret_cast<const char *>(signatures[i].r.data()),
+                      reinterpret_cast<const char *>(signatures[i].s.data()),
+                      &public_keys[i * 64])
+                      .verified == 1;
+    }
+    return verified;
+  });
+  report("verify<P256>", count, [&] {
+    int verified = 0;
+    for (int i = 0; i < count; i++) {
+      verified += ec::verify<ec::P256>(hashes[i], signatures[i],
+                                       key_pairs[i].public_key);
+    }
+    return verified;
+  });
+  report("verify_batch<P256> (seq)", count, [&] {
+    return static_cast<int>(ec::verify_batch<ec::P256>(
+        std::execution::seq, verify_requests, verify_results));
+  });
+  report("verify_batch<P256> (par)", count, [&] {
+    return static_cast<int>(ec::verify_batch<ec::P256>(
+        std::execution::par, verify_requests, verify_results));
+  });
+
+  report("key recovery (C)", count, [&] {
+    int recovered = 0;
+    for (int i = 0; i < count; i++) {
+      recovered +=
+          p256_key_recovery(
+              reinterpret_cast<const char *>(hashes[i].data()), 32,
+              reinterpret_cast<const char *>(signatures[i].r.data()),
+              reinterpret_cast<const char *>(signatures[i].s.data()),
+              signatures[i].v)
+              .error_message[0] == '\0';
+    }
+    return recovered;
+  });
+  report("recover<P256>", count, [&] {
+    int recovered = 0;
+    for (int i = 0; i < count; i++) {
+      recovered +=
+          ec::recover<ec::P256>(hashes[i], signatures[i]) ==
+          key_pairs[i].public_key;
+    }
+    return recovered;
+  });
+  report("recover_batch<P256> (seq)", count, [&] {
+    return static_cast<int>(ec::recover_batch<ec::P256>(
+        std::execution::seq, recover_requests, recover_results));
+  });
+  report("recover_batch<P256> (par)", count, [&] {
+    return static_cast<int>(ec::recover_batch<ec::P256>(
+        std::execution::par, recover_requests, recover_results));
+  });
+
+  return 0;
+}
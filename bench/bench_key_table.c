@@ -0,0 +1,182 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "besu_native_ec.h"
+
+/**
+ * Compares the memory and the verification speed of full and compact key
+ * tables. Every format verifies signatures of random keys of the table, once
+ * with the key cache and once without it, and reports the memory of the key
+ * tables and the key cache per key. Run it with "make bench", the number of
+ * keys and the seconds per run can be passed as arguments.
+ */
+
+#define DATA_HASH_LEN 32
+#define PRIVATE_KEY_LEN 32
+#define PUBLIC_KEY_LEN 64
+#define SIGNATURE_LEN 64
+
+struct key_set {
+  int key_count;
+  char *public_keys;
+  char *data_hashes;
+  char *signatures;
+};
+
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static double now(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+static unsigned long long key_memory(void) {
+  struct memory_budget_stats stats = besu_native_ec_memory_budget_stats();
+  return stats.subsystems[MEMORY_SUBSYSTEM_KEY_TABLES].used +
+         stats.subsystems[MEMORY_SUBSYSTEM_KEY_CACHE].used;
+}
+
+static int create_key_set(struct key_set *set, int key_count) {
+  char error_message[256] = {0};
+  char *private_keys = malloc((size_t)key_count * PRIVATE_KEY_LEN);
+  uint64_t seed = 0x2545f4914f6cdd1dULL;
+
+  set->key_count = key_count;
+  set->public_keys = malloc((size_t)key_count * PUBLIC_KEY_LEN);
+  set->data_hashes = malloc((size_t)key_count * DATA_HASH_LEN);
+  set->signatures = malloc((size_t)key_count * SIGNATURE_LEN);
+
+  if (p256_generate_keypairs(private_keys, set->public_keys, error_message,
+                             key_count) != 1) {
+    fprintf(stderr, "%s", error_message);
+    free(private_keys);
+    return 1;
+  }
+
+  for (int i = 0; i < key_count; i++) {
+    char *data_hash = set->data_hashes + (size_t)i * DATA_HASH_LEN;
+    for (int j = 0; j < DATA_HASH_LEN; j++) {
+      data_hash[j] = (char)next_random(&seed);
+    }
+
+    struct sign_result result =
+        p256_sign(data_hash, DATA_HASH_LEN,
+                  private_keys + (size_t)i * PRIVATE_KEY_LEN,
+                  set->public_keys + (size_t)i * PUBLIC_KEY_LEN);
+    if (result.error_message[0] != '\0') {
+      fprintf(stderr, "%s", result.error_message);
+      free(private_keys);
+      return 1;
+    }
+    memcpy(set->signatures + (size_t)i * SIGNATURE_LEN, result.signature_r,
+           SIGNATURE_LEN / 2);
+    memcpy(set->signatures + (size_t)i * SIGNATURE_LEN + SIGNATURE_LEN / 2,
+           result.signature_s, SIGNATURE_LEN / 2);
+  }
+
+  free(private_keys);
+  return 0;
+}
+
+static int run(const struct key_set *set, const char *name, int format,
+               int key_cache, double seconds) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+
+  besu_native_ec_key_cache_set_enabled(key_cache);
+  unsigned long long memory_before = key_memory();
+  if (p256_key_table_create_with_format(&table, error_message,
+                                        set->public_keys, set->key_count,
+                                        format) != 1) {
+    fprintf(stderr, "%s", error_message);
+    return 1;
+  }
+
+  // the table is sorted, so the keys are looked up once before the run
+  int *key_indexes = malloc((size_t)set->key_count * sizeof(int));
+  for (int i = 0; i < set->key_count; i++) {
+    key_indexes[i] = p256_key_table_find(
+        table, set->public_keys + (size_t)i * PUBLIC_KEY_LEN);
+  }
+
+  uint64_t seed = 0x9e3779b97f4a7c15ULL;
+  unsigned long long verifications = 0, failures = 0;
+  double start = now(), elapsed;
+  do {
+    for (int i = 0; i < 64; i++) {
+      int key = (int)(next_random(&seed) % (uint64_t)set->key_count);
+      const char *data_hash = set->data_hashes + (size_t)key * DATA_HASH_LEN;
+      const char *signature = set->signatures + (size_t)key * SIGNATURE_LEN;
+      struct verify_result result = p256_key_table_verify(
+          table, key_indexes[key], data_hash, DATA_HASH_LEN, signature,
+          signature + SIGNATURE_LEN / 2);
+      failures += result.verified != 1;
+    }
+    verifications += 64;
+    elapsed = now() - start;
+  } while (elapsed < seconds);
+
+  unsigned long long memory = key_memory() - memory_before;
+  printf("  %-8s key cache %-3s %10.0f verifications/s  %8.1f bytes/key  "
+         "failures %llu\n",
+         name, key_cache ? "on" : "off", verifications / elapsed,
+         (double)memory / set->key_count, failures);
+
+  free(key_indexes);
+  p256_key_table_free(table);
+  return failures != 0;
+}
+
+int main(int argc, char **argv) {
+  int key_count = argc > 1 ? atoi(argv[1]) : 10000;
+  double seconds = argc > 2 ? atof(argv[2]) : 1.0;
+  struct key_set set;
+  int failed = 0;
+
+  if (key_count <= 0 || seconds <= 0) {
+    fprintf(stderr, "usage: %s [key count] [seconds per run]\n", argv[0]);
+    return 1;
+  }
+
+  if (create_key_set(&set, key_count) != 0) {
+    return 1;
+  }
+
+  printf("key table with %d keys\n", key_count);
+  for (int key_cache = 1; key_cache >= 0; key_cache--) {
+    failed |= run(&set, "full", KEY_TABLE_FULL, key_cache, seconds);
+    failed |= run(&set, "compact", KEY_TABLE_COMPACT, key_cache, seconds);
+  }
+  besu_native_ec_key_cache_set_enabled(1);
+
+  free(set.public_keys);
+  free(set.data_hashes);
+  free(set.signatures);
+  return failed;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "besu_native_ec.h"
+#include "worker_pool.h"
+
+/**
+ * Measures the latency of single verifications and key recoveries with the
+ * low latency mode disabled and enabled. The signatures are from a few repeat
+ * signers, whose keys are cached like those of the validators of a network.
+ * Every call is timed on its own, so that the percentiles show the spread. Run
+ * it with "make bench", the number of calls and of worker threads can be
+ * passed as arguments. Without worker threads, the low latency mode has no
+ * effect.
+ */
+
+#define KEY_COUNT 16
+#define INPUT_COUNT 64
+#define WORD_LEN 32
+
+enum operation { VERIFY, KEY_RECOVERY };
+
+struct input {
+  char data_hash[WORD_LEN];
+  char signature_r[WORD_LEN];
+  char signature_s[WORD_LEN];
+  int signature_v;
+  char public_key[2 * WORD_LEN];
+};
+
+static struct input inputs[INPUT_COUNT];
+
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static uint64_t now_nanoseconds(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+static int compare_samples(const void *a, const void *b) {
+  uint64_t left = *(const uint64_t *)a, right = *(const uint64_t *)b;
+  return (left > right) - (left < right);
+}
+
+static uint64_t percentile(const uint64_t sorted[], int count, int percent) {
+  return sorted[(size_t)count * percent / 100 -
+                ((size_t)count * percent % 100 == 0 ? 1 : 0)];
+}
+
+// signs random hashes with KEY_COUNT keys
+static int create_inputs(void) {
+  char error_message[256] = {0};
+  char private_keys[KEY_COUNT * WORD_LEN];
+  char public_keys[KEY_COUNT * 2 * WORD_LEN];
+  uint64_t seed = 0x2545f4914f6cdd1dULL;
+
+  if (p256_generate_keypairs(private_keys, public_keys, error_message,
+                             KEY_COUNT) != 1) {
+    fprintf(stderr, "%s", error_message);
+    return 1;
+  }
+
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    int key = i % KEY_COUNT;
+    struct input *input = &inputs[i];
+
+    for (int j = 0; j < WORD_LEN; j++) {
+      input->data_hash[j] = (char)next_random(&seed);
+    }
+    memcpy(input->public_key, public_keys + (size_t)key * 2 * WORD_LEN,
+           2 * WORD_LEN);
+    struct sign_result result =
+        p256_sign(input->data_hash, WORD_LEN,
+                  private_keys + (size_t)key * WORD_LEN, input->public_key);
+    if (result.error_message[0] != '\0') {
+      fprintf(stderr, "%s", result.error_message);
+      return 1;
+    }
+    memcpy(input->signature_r, result.signature_r, WORD_LEN);
+    memcpy(input->signature_s, result.signature_s, WORD_LEN);
+    input->signature_v = result.signature_v;
+  }
+  return 0;
+}
+
+// returns 1 if the call had the expected result
+static int call(enum operation operation, const struct input *input) {
+  if (operation == VERIFY) {
+    return p256_verify(input->data_hash, WORD_LEN, input->signature_r,
+                       input->signature_s, input->public_key)
+               .verified == 1;
+  }
+
+  struct key_recovery_result result =
+      p256_key_recovery(input->data_hash, WORD_LEN, input->signature_r,
+                        input->signature_s, input->signature_v);
+  return memcmp(result.public_key, input->public_key, 2 * WORD_LEN) == 0;
+}
+
+static int run(const char *name, enum operation operation, int low_latency,
+               uint64_t samples[], int calls) {
+  uint64_t total = 0;
+  int unexpected = 0;
+
+  besu_native_ec_low_latency_set_enabled(low_latency);
+  // imports the keys into the cache and decodes their points before the
+  // measurement
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    call(operation, &inputs[i]);
+  }
+
+  for (int i = 0; i < calls; i++) {
+    uint64_t start = now_nanoseconds();
+    int expected = call(operation, &inputs[i % INPUT_COUNT]);
+    samples[i] = now_nanoseconds() - start;
+
+    total += samples[i];
+    unexpected += !expected;
+  }
+  besu_native_ec_low_latency_set_enabled(0);
+
+  qsort(samples, calls, sizeof(uint64_t), compare_samples);
+  printf("  %-14s %-11s %9.0f %9llu %9llu %9llu", name,
+         low_latency ? "on" : "off", (double)total / calls,
+         (unsigned long long)percentile(samples, calls, 50),
+         (unsigned long long)percentile(samples, calls, 90),
+         (unsigned long long)percentile(samples, calls, 99));
+  if (unexpected != 0) {
+    printf("  %d unexpected results", unexpected);
+  }
+  printf("\n");
+  return unexpected != 0;
+}
+
+int main(int argc, char **argv) {
+  char error_message[256] = {0};
+  int calls = argc > 1 ? atoi(argv[1]) : 2000;
+  int thread_count = argc > 2 ? atoi(argv[2]) : 1;
+  int failed = 0;
+
+  if (calls <= 0 || thread_count < 0) {
+    fprintf(stderr, "usage: %s [calls] [worker threads]\n", argv[0]);
+    return 1;
+  }
+  if (worker_pool_init(error_message, thread_count) != 1) {
+    fprintf(stderr, "%s", error_message);
+    return 1;
+  }
+  if (create_inputs() != 0) {
+    return 1;
+  }
+
+  uint64_t *samples = malloc((size_t)calls * sizeof(uint64_t));
+
+  printf("Low latency mode with %d calls and %d worker threads\n", calls,
+         worker_pool_thread_count());
+  printf("  %-14s %-11s %9s %9s %9s %9s\n", "operation", "low latency",
+         "ns mean", "ns p50", "ns p90", "ns p99");
+  for (int low_latency = 0; low_latency <= 1; low_latency++) {
+    failed |= run("verify", VERIFY, low_latency, samples, calls);
+  }
+  for (int low_latency = 0; low_latency <= 1; low_latency++) {
+    failed |= run("key recovery", KEY_RECOVERY, low_latency, samples, calls);
+  }
+
+  free(samples);
+  return failed;
+}
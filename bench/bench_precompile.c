@@ -0,0 +1,271 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "besu_native_ec.h"
+
+/**
+ * Measures the cost of the P256VERIFY precompile for the input classes that
+ * its gas price has to cover and compares it with p256_ecrecover, which runs
+ * the ecrecover precompile on the same machine. Every call is timed on its
+ * own, so that the percentiles show the spread within a class. The gas column
+ * scales the mean by the 3000 gas of ecrecover. Run it with "make bench", the
+ * number of calls per class can be passed as an argument.
+ *
+ * Cycles are read from the time stamp counter on x86 and are not reported on
+ * other architectures.
+ */
+
+#define KEY_COUNT 16
+#define INPUT_COUNT 64
+#define WORD_LEN 32
+#define VERIFY_INPUT_LEN (5 * WORD_LEN)
+#define ECRECOVER_INPUT_LEN (4 * WORD_LEN)
+#define ECRECOVER_GAS 3000
+
+enum precompile { P256VERIFY, ECRECOVER };
+
+struct input_class {
+  const char *name;
+  enum precompile precompile;
+  int key_cache;
+  int input_len;
+  // 1 if the precompile must return an output for the inputs of the class
+  int valid;
+  unsigned char inputs[INPUT_COUNT][VERIFY_INPUT_LEN];
+};
+
+struct samples {
+  uint64_t *nanoseconds;
+  uint64_t *cycles;
+  double mean_nanoseconds;
+};
+
+// n of P-256
+static const unsigned char order[WORD_LEN] = {
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17,
+    0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static uint64_t now_nanoseconds(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+static uint64_t now_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static int compare_samples(const void *a, const void *b) {
+  uint64_t left = *(const uint64_t *)a, right = *(const uint64_t *)b;
+  return (left > right) - (left < right);
+}
+
+static uint64_t percentile(const uint64_t sorted[], int count, int percent) {
+  return sorted[(size_t)count * percent / 100 -
+                ((size_t)count * percent % 100 == 0 ? 1 : 0)];
+}
+
+// replaces the word by n - word
+static void negate(unsigned char word[WORD_LEN]) {
+  int borrow = 0;
+
+  for (int i = WORD_LEN - 1; i >= 0; i--) {
+    int difference = order[i] - word[i] - borrow;
+    borrow = difference < 0;
+    word[i] = (unsigned char)(difference + (borrow ? 256 : 0));
+  }
+}
+
+// Signs random hashes with KEY_COUNT keys and stores them as the valid
+// P256VERIFY inputs hash || r || s || x || y and the matching ecrecover inputs
+// hash || v || r || s.
+static int create_inputs(struct input_class *verify,
+                         struct input_class *recover) {
+  char error_message[256] = {0};
+  char private_keys[KEY_COUNT * WORD_LEN];
+  char public_keys[KEY_COUNT * 2 * WORD_LEN];
+  uint64_t seed = 0x2545f4914f6cdd1dULL;
+
+  if (p256_generate_keypairs(private_keys, public_keys, error_message,
+                             KEY_COUNT) != 1) {
+    fprintf(stderr, "%s", error_message);
+    return 1;
+  }
+
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    int key = i % KEY_COUNT;
+    unsigned char *input = verify->inputs[i];
+    unsigned char *ecrecover_input = recover->inputs[i];
+
+    for (int j = 0; j < WORD_LEN; j++) {
+      input[j] = (unsigned char)next_random(&seed);
+    }
+    struct sign_result result =
+        p256_sign((const char *)input, WORD_LEN,
+                  private_keys + (size_t)key * WORD_LEN,
+                  public_keys + (size_t)key * 2 * WORD_LEN);
+    if (result.error_message[0] != '\0') {
+      fprintf(stderr, "%s", result.error_message);
+      return 1;
+    }
+    memcpy(input + WORD_LEN, result.signature_r, WORD_LEN);
+    memcpy(input + 2 * WORD_LEN, result.signature_s, WORD_LEN);
+    memcpy(input + 3 * WORD_LEN, public_keys + (size_t)key * 2 * WORD_LEN,
+           2 * WORD_LEN);
+
+    memset(ecrecover_input, 0, ECRECOVER_INPUT_LEN);
+    memcpy(ecrecover_input, input, WORD_LEN);
+    ecrecover_input[2 * WORD_LEN - 1] = 27 + result.signature_v;
+    memcpy(ecrecover_input + 2 * WORD_LEN, input + WORD_LEN, 2 * WORD_LEN);
+  }
+  return 0;
+}
+
+static int call(const struct input_class *class, int index) {
+  char output[WORD_LEN];
+  const char *input = (const char *)class->inputs[index % INPUT_COUNT];
+
+  if (class->precompile == ECRECOVER) {
+    return p256_ecrecover(output, input, class->input_len);
+  }
+  return p256_verify_precompile(output, input, class->input_len);
+}
+
+static int run(const struct input_class *class, struct samples *samples,
+               int calls) {
+  uint64_t total = 0;
+  int unexpected = 0;
+
+  besu_native_ec_key_cache_set_enabled(class->key_cache);
+  // imports the keys into the cache before the measurement
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    call(class, i);
+  }
+
+  for (int i = 0; i < calls; i++) {
+    uint64_t start_cycles = now_cycles();
+    uint64_t start = now_nanoseconds();
+    int output_len = call(class, i);
+    samples->nanoseconds[i] = now_nanoseconds() - start;
+    samples->cycles[i] = now_cycles() - start_cycles;
+
+    total += samples->nanoseconds[i];
+    unexpected += (output_len != 0) != class->valid;
+  }
+  besu_native_ec_key_cache_set_enabled(1);
+
+  qsort(samples->nanoseconds, calls, sizeof(uint64_t), compare_samples);
+  qsort(samples->cycles, calls, sizeof(uint64_t), compare_samples);
+  samples->mean_nanoseconds = (double)total / calls;
+  return unexpected;
+}
+
+static void print(const struct input_class *class,
+                  const struct samples *samples, int calls,
+                  double reference_nanoseconds, int unexpected) {
+  double ratio = samples->mean_nanoseconds / reference_nanoseconds;
+
+  printf("  %-22s %9.0f %9llu %9llu %9llu %10llu %6.2f %6.0f", class->name,
+         samples->mean_nanoseconds,
+         (unsigned long long)percentile(samples->nanoseconds, calls, 50),
+         (unsigned long long)percentile(samples->nanoseconds, calls, 90),
+         (unsigned long long)percentile(samples->nanoseconds, calls, 99),
+         (unsigned long long)percentile(samples->cycles, calls, 50), ratio,
+         ratio * ECRECOVER_GAS);
+  if (unexpected != 0) {
+    printf("  %d unexpected results", unexpected);
+  }
+  printf("\n");
+}
+
+int main(int argc, char **argv) {
+  int calls = argc > 1 ? atoi(argv[1]) : 2000;
+  static struct input_class classes[] = {
+      {"ecrecover (reference)", ECRECOVER, 1, ECRECOVER_INPUT_LEN, 1, {{0}}},
+      {"valid, key cached", P256VERIFY, 1, VERIFY_INPUT_LEN, 1, {{0}}},
+      {"valid, key not cached", P256VERIFY, 0, VERIFY_INPUT_LEN, 1, {{0}}},
+      {"valid, high s", P256VERIFY, 1, VERIFY_INPUT_LEN, 1, {{0}}},
+      {"wrong hash", P256VERIFY, 1, VERIFY_INPUT_LEN, 0, {{0}}},
+      {"r out of range", P256VERIFY, 1, VERIFY_INPUT_LEN, 0, {{0}}},
+      {"s out of range", P256VERIFY, 1, VERIFY_INPUT_LEN, 0, {{0}}},
+      {"key not on curve", P256VERIFY, 1, VERIFY_INPUT_LEN, 0, {{0}}},
+      {"invalid input length", P256VERIFY, 1, VERIFY_INPUT_LEN - 1, 0, {{0}}},
+  };
+  const int class_count = sizeof(classes) / sizeof(classes[0]);
+  struct samples samples;
+  double reference_nanoseconds = 0;
+  int failed = 0;
+
+  if (calls <= 0) {
+    fprintf(stderr, "usage: %s [calls per input class]\n", argv[0]);
+    return 1;
+  }
+
+  if (create_inputs(&classes[1], &classes[0]) != 0) {
+    return 1;
+  }
+  for (int i = 2; i < class_count; i++) {
+    memcpy(classes[i].inputs, classes[1].inputs, sizeof(classes[1].inputs));
+  }
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    negate(classes[3].inputs[i] + 2 * WORD_LEN);
+    classes[4].inputs[i][0] ^= 1;
+    memset(classes[5].inputs[i] + WORD_LEN, 0, WORD_LEN);
+    memcpy(classes[6].inputs[i] + 2 * WORD_LEN, order, WORD_LEN);
+    classes[7].inputs[i][VERIFY_INPUT_LEN - 1] ^= 1;
+  }
+
+  samples.nanoseconds = malloc((size_t)calls * sizeof(uint64_t));
+  samples.cycles = malloc((size_t)calls * sizeof(uint64_t));
+
+  printf("P256VERIFY with %d calls per input class\n", calls);
+  printf("  %-22s %9s %9s %9s %9s %10s %6s %6s\n", "input class", "ns mean",
+         "ns p50", "ns p90", "ns p99", "cycles p50", "ratio", "gas");
+  for (int i = 0; i < class_count; i++) {
+    int unexpected = run(&classes[i], &samples, calls);
+    if (i == 0) {
+      reference_nanoseconds = samples.mean_nanoseconds;
+    }
+    print(&classes[i], &samples, calls, reference_nanoseconds, unexpected);
+    failed |= unexpected != 0;
+  }
+
+  free(samples.nanoseconds);
+  free(samples.cycles);
+  return failed;
+}
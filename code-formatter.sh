@@ -2,6 +2,15 @@ cd src
 clang-format -i *.c *.h
 
 cd ../test
+clang-format -i *.c
+
+cd ../tools
+clang-format -i *.c
+
+cd ../test/support
+clang-format -i *.c *.h
+
+cd ../../fuzz
 clang-format -i *.c *.h
 
 cd ..
\ No newline at end of file
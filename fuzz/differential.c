@@ -0,0 +1,579 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mkstemp is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "openssl/include/openssl/bn.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "differential.h"
+#include "keccak.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+#define KNOWN_KEY_COUNT 4
+#define RECOVERY_INDEX_CAPACITY 65536
+// the low latency mode splits the multiplications with a worker, which needs
+// at least one worker thread on any machine
+#define WORKER_THREAD_COUNT 2
+
+// layout of the bytes that are mapped to an input, missing bytes are zero
+#define INPUT_MODE 0
+#define INPUT_HASH_LEN 1
+#define INPUT_HASH 2
+#define INPUT_R 66
+#define INPUT_S 98
+#define INPUT_V 130
+#define INPUT_PUBLIC_KEY 131
+#define INPUT_MUTATION 195
+#define INPUT_LEN 197
+
+#define MODE_KEY_MASK 0x03
+#define MODE_SIGN 0x04
+#define MODE_MUTATE 0x08
+#define MODE_RANDOM_KEY 0x10
+#define MODE_NEGATE_S 0x20
+
+// the precompiles take the hash, r, s and v as 32 byte words
+#define WORD_LEN 32
+#define ECRECOVER_INPUT_LEN (4 * WORD_LEN)
+#define P256VERIFY_INPUT_LEN (5 * WORD_LEN)
+#define ADDRESS_OFFSET (KECCAK_256_DIGEST_LEN - 20)
+
+static const char *curve_order_hex =
+    "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551";
+
+// the first keys of [P-256,SHA-256] from SigGen.txt of the CAVP test vectors
+static const char *known_key_hex[KNOWN_KEY_COUNT][2] = {
+    {"519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464",
+     "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+     "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9"},
+    {"0f56db78ca460b055c500064824bed999a25aaf48ebb519ac201537b85479813",
+     "e266ddfdc12668db30d4ca3e8f7749432c416044f2d2b8c10bf3d4012aeffa8a"
+     "bfa86404a2e9ffe67d47c587ef7a97a7f456b863b4d02cfc6928973ab5b1cb39"},
+    {"e283871239837e13b95f789e6e1af63bf61c918c992e62bca040d64cad1fc2ef",
+     "74ccd8a62fba0e667c50929a53f78c21b8ff0c3c737b0b40b1750b2302b0bde8"
+     "29074e21f3a0ef88b9efdf10d06aa4c295cc1671f758ca0e4cd108803d0f2614"},
+    {"a3d2d3b7596f6592ce98b4bfe10d41837f10027a90d7bb75349490018cf72d07",
+     "322f80371bf6e044bc49391d97c1714ab87f990b949bc178cb7c43b7c22d89e1"
+     "3c15d54a5cc6b9f09de8457e873eb3deb1fceb54b0b295da6050294fae7fd999"},
+};
+
+static char known_private_keys[KNOWN_KEY_COUNT][32];
+static char known_public_keys[KNOWN_KEY_COUNT * 64];
+static struct p256_key_table *known_key_table = NULL;
+static struct p256_key_table *known_compact_key_table = NULL;
+static struct p256_validated_key *known_validated_keys[KNOWN_KEY_COUNT];
+static BIGNUM *curve_order = NULL;
+static struct p256_recovery_index *recovery_index = NULL;
+static char recovery_index_path[] = "/tmp/besu_native_ec_differential_XXXXXX";
+
+int differential_init(char *error_message) {
+  if (worker_pool_init(error_message, WORKER_THREAD_COUNT) != SUCCESS) {
+    return FAILURE;
+  }
+
+  for (int i = 0; i < KNOWN_KEY_COUNT; i++) {
+    unsigned char *private_key = hex_to_bin(known_key_hex[i][0]);
+    unsigned char *public_key = hex_to_bin(known_key_hex[i][1]);
+    memcpy(known_private_keys[i], private_key, 32);
+    memcpy(known_public_keys + i * 64, public_key, 64);
+    free(private_key);
+    free(public_key);
+  }
+
+  // the checks compare the fast paths with p256_verify as the reference,
+  // which imports each key and verifies with EVP_PKEY_verify while the key
+  // cache and the low latency mode are disabled. The checks of these fast
+  // paths enable them for their own calls only.
+  besu_native_ec_key_cache_set_enabled(0);
+  besu_native_ec_low_latency_set_enabled(0);
+
+  if (p256_key_table_create(&known_key_table, error_message,
+                            known_public_keys, KNOWN_KEY_COUNT) != SUCCESS ||
+      p256_key_table_create_with_format(
+          &known_compact_key_table, error_message, known_public_keys,
+          KNOWN_KEY_COUNT, KEY_TABLE_COMPACT) != SUCCESS) {
+    return FAILURE;
+  }
+  for (int i = 0; i < KNOWN_KEY_COUNT; i++) {
+    if (p256_validated_key_create(&known_validated_keys[i], error_message,
+                                  known_public_keys + i * 64) != SUCCESS) {
+      return FAILURE;
+    }
+  }
+  if (BN_hex2bn(&curve_order, curve_order_hex) == 0) {
+    snprintf(error_message, 256, "Could not convert the curve order\n");
+    return FAILURE;
+  }
+
+  // the index is created by p256_recovery_index_open, mkstemp only reserves
+  // its name
+  int fd = mkstemp(recovery_index_path);
+  if (fd < 0) {
+    snprintf(error_message, 256, "Could not create recovery index file\n");
+    return FAILURE;
+  }
+  close(fd);
+  unlink(recovery_index_path);
+
+  return p256_recovery_index_open(&recovery_index, error_message,
+                                  recovery_index_path,
+                                  RECOVERY_INDEX_CAPACITY);
+}
+
+void differential_cleanup(void) {
+  if (recovery_index != NULL) {
+    p256_recovery_index_close(recovery_index);
+    unlink(recovery_index_path);
+    recovery_index = NULL;
+  }
+  p256_key_table_free(known_key_table);
+  known_key_table = NULL;
+  p256_key_table_free(known_compact_key_table);
+  known_compact_key_table = NULL;
+  for (int i = 0; i < KNOWN_KEY_COUNT; i++) {
+    p256_validated_key_free(known_validated_keys[i]);
+    known_validated_keys[i] = NULL;
+  }
+  BN_free(curve_order);
+  curve_order = NULL;
+}
+
+// replaces s by n - s, a valid signature stays valid
+static void negate_s(char s[32]) {
+  BIGNUM *value = BN_bin2bn((const unsigned char *)s, 32, NULL);
+
+  if (value != NULL && BN_cmp(value, curve_order) < 0 &&
+      BN_sub(value, curve_order, value)) {
+    BN_bn2binpad(value, (unsigned char *)s, 32);
+  }
+  BN_free(value);
+}
+
+void differential_input_from_bytes(struct differential_input *input,
+                                   const unsigned char *data, size_t size) {
+  static const int signature_vs[] = {0, 1, 27, 28, 2};
+  unsigned char bytes[INPUT_LEN] = {0};
+  memcpy(bytes, data, size < INPUT_LEN ? size : INPUT_LEN);
+
+  const unsigned char mode = bytes[INPUT_MODE];
+  const int key = mode & MODE_KEY_MASK;
+
+  memset(input, 0, sizeof(*input));
+  input->data_hash_len = 1 + bytes[INPUT_HASH_LEN] % 64;
+  memcpy(input->data_hash, bytes + INPUT_HASH, 64);
+  memcpy(input->signature_r, bytes + INPUT_R, 32);
+  memcpy(input->signature_s, bytes + INPUT_S, 32);
+  input->signature_v = signature_vs[bytes[INPUT_V] % 5];
+
+  if (mode & MODE_RANDOM_KEY) {
+    memcpy(input->public_key, bytes + INPUT_PUBLIC_KEY, 64);
+  } else {
+    memcpy(input->public_key, known_public_keys + key * 64, 64);
+    memcpy(input->private_key, known_private_keys[key], 32);
+    input->has_private_key = 1;
+  }
+
+  if ((mode & MODE_SIGN) && input->has_private_key) {
+    struct sign_result signature =
+        p256_sign(input->data_hash, input->data_hash_len, input->private_key,
+                  input->public_key);
+    if (strlen(signature.error_message) == 0) {
+      memcpy(input->signature_r, signature.signature_r, 32);
+      memcpy(input->signature_s, signature.signature_s, 32);
+      input->signature_v = signature.signature_v;
+    }
+  }
+
+  // the precompiles accept s greater than n / 2, verify doesn't
+  if (mode & MODE_NEGATE_S) {
+    negate_s(input->signature_s);
+  }
+
+  // flips bits of r, s or the hash of an otherwise valid signature
+  if (mode & MODE_MUTATE) {
+    int position = bytes[INPUT_MUTATION] % (64 + input->data_hash_len);
+    char bits = (char)(bytes[INPUT_MUTATION + 1] | 1);
+    if (position < 32) {
+      input->signature_r[position] ^= bits;
+    } else if (position < 64) {
+      input->signature_s[position - 32] ^= bits;
+    } else {
+      input->data_hash[position - 64] ^= bits;
+    }
+  }
+}
+
+// the reference while the key cache and the low latency mode are disabled
+static struct verify_result
+verify_input(const struct differential_input *input) {
+  return p256_verify(input->data_hash, input->data_hash_len,
+                     input->signature_r, input->signature_s,
+                     input->public_key);
+}
+
+static int compare_verify_results(const char *name,
+                                  const struct verify_result *actual,
+                                  const struct verify_result *expected,
+                                  char *error_message) {
+  if (actual->verified != expected->verified ||
+      strcmp(actual->error_message, expected->error_message) != 0) {
+    snprintf(error_message, 256,
+             "%s returned %d (%.80s), verify returned %d (%.80s)\n", name,
+             actual->verified, actual->error_message, expected->verified,
+             expected->error_message);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+// the key table must give the same results as verify, including the error
+// messages
+static int verify_with_key_table(const struct differential_input *input,
+                                 char *error_message,
+                                 struct p256_key_table *table,
+                                 const int format) {
+  struct p256_key_table *input_table = NULL;
+  char table_error_message[256] = {0};
+
+  struct verify_result expected = verify_input(input);
+
+  int key_index = p256_key_table_find(table, input->public_key);
+  if (key_index < 0) {
+    // other keys are verified with a table of their own, which is rejected
+    // if the key is invalid
+    if (p256_key_table_create_with_format(&input_table, table_error_message,
+                                          input->public_key, 1,
+                                          format) != SUCCESS) {
+      if (expected.verified == -1) {
+        return SUCCESS;
+      }
+      snprintf(error_message, 256,
+               "Key table rejected a key that verify accepted: %.128s",
+               table_error_message);
+      return FAILURE;
+    }
+    table = input_table;
+    key_index = 0;
+  }
+
+  struct verify_result actual = p256_key_table_verify(
+      table, key_index, input->data_hash, input->data_hash_len,
+      input->signature_r, input->signature_s);
+  p256_key_table_free(input_table);
+
+  return compare_verify_results("Key table verify", &actual, &expected,
+                                error_message);
+}
+
+static int check_key_table_verify(const struct differential_input *input,
+                                  char *error_message) {
+  return verify_with_key_table(input, error_message, known_key_table,
+                               KEY_TABLE_FULL);
+}
+
+static int
+check_compact_key_table_verify(const struct differential_input *input,
+                               char *error_message) {
+  return verify_with_key_table(input, error_message, known_compact_key_table,
+                               KEY_TABLE_COMPACT);
+}
+
+// a validated key must give the same results as verify, which validates the
+// key with every signature
+static int check_validated_key_verify(const struct differential_input *input,
+                                      char *error_message) {
+  struct p256_validated_key *key = NULL;
+  char key_error_message[256] = {0};
+  int created = 0;
+
+  struct verify_result expected = verify_input(input);
+
+  for (int i = 0; i < KNOWN_KEY_COUNT && key == NULL; i++) {
+    if (memcmp(input->public_key, known_public_keys + i * 64, 64) == 0) {
+      key = known_validated_keys[i];
+    }
+  }
+  if (key == NULL) {
+    if (p256_validated_key_create(&key, key_error_message,
+                                  input->public_key) != SUCCESS) {
+      if (expected.verified == -1) {
+        return SUCCESS;
+      }
+      snprintf(error_message, 256,
+               "Validated key rejected a key that verify accepted: %.128s",
+               key_error_message);
+      return FAILURE;
+    }
+    created = 1;
+  }
+
+  struct verify_result actual = p256_validated_key_verify(
+      key, input->data_hash, input->data_hash_len, input->signature_r,
+      input->signature_s);
+  if (created) {
+    p256_validated_key_free(key);
+  }
+
+  return compare_verify_results("Validated key verify", &actual, &expected,
+                                error_message);
+}
+
+// the first lookup imports the key into the cache, the second one verifies
+// with the cached key
+static int check_key_cache_verify(const struct differential_input *input,
+                                  char *error_message) {
+  struct verify_result expected = verify_input(input);
+  int ret = SUCCESS;
+
+  besu_native_ec_key_cache_set_enabled(1);
+  for (int i = 0; i < 2 && ret == SUCCESS; i++) {
+    struct verify_result actual = verify_input(input);
+    ret = compare_verify_results("Cached key verify", &actual, &expected,
+                                 error_message);
+  }
+  besu_native_ec_key_cache_set_enabled(0);
+
+  return ret;
+}
+
+// The low latency mode verifies with the multiplications of SEC1 4.1.4
+// instead of EVP_PKEY_verify, it must accept and reject the same signatures
+// with the same error messages.
+static int check_low_latency_verify(const struct differential_input *input,
+                                    char *error_message) {
+  struct verify_result expected = verify_input(input);
+
+  besu_native_ec_low_latency_set_enabled(1);
+  struct verify_result actual = verify_input(input);
+  besu_native_ec_low_latency_set_enabled(0);
+
+  return compare_verify_results("Low latency verify", &actual, &expected,
+                                error_message);
+}
+
+// The precompiles take a hash of 32 bytes. ECDSA uses the leftmost 256 bits
+// of a longer hash, and a shorter hash is the same number as the hash padded
+// with leading zeros, so that the signature stays valid.
+static void hash_word(unsigned char word[WORD_LEN],
+                      const struct differential_input *input) {
+  memset(word, 0, WORD_LEN);
+  if (input->data_hash_len < WORD_LEN) {
+    memcpy(word + WORD_LEN - input->data_hash_len, input->data_hash,
+           input->data_hash_len);
+  } else {
+    memcpy(word, input->data_hash, WORD_LEN);
+  }
+}
+
+// 0 < scalar < n
+static int is_scalar_in_range(const char scalar[WORD_LEN]) {
+  BIGNUM *value = BN_bin2bn((const unsigned char *)scalar, WORD_LEN, NULL);
+  int in_range =
+      value != NULL && !BN_is_zero(value) && BN_cmp(value, curve_order) < 0;
+  BN_free(value);
+  return in_range;
+}
+
+// replaces s by n - s if s is greater than n / 2
+static void normalize_s(char s[WORD_LEN]) {
+  BIGNUM *value = BN_bin2bn((const unsigned char *)s, WORD_LEN, NULL);
+  BIGNUM *doubled = BN_new();
+
+  if (value != NULL && doubled != NULL && BN_lshift1(doubled, value) &&
+      BN_cmp(doubled, curve_order) > 0 &&
+      BN_sub(value, curve_order, value)) {
+    BN_bn2binpad(value, (unsigned char *)s, WORD_LEN);
+  }
+  BN_free(value);
+  BN_free(doubled);
+}
+
+// The ecrecover precompile must return the address of the key that key
+// recovery returns, if v is 27 or 28 and r and s are between 1 and n - 1
+static int check_ecrecover(const struct differential_input *input,
+                           char *error_message) {
+  unsigned char precompile_input[ECRECOVER_INPUT_LEN] = {0};
+  char expected_output[WORD_LEN] = {0};
+  char actual_output[WORD_LEN] = {0};
+  int expected_len = 0;
+  const int v = input->signature_v < 27 ? input->signature_v + 27
+                                        : input->signature_v;
+
+  hash_word(precompile_input, input);
+  precompile_input[2 * WORD_LEN - 1] = (unsigned char)v;
+  memcpy(precompile_input + 2 * WORD_LEN, input->signature_r, WORD_LEN);
+  memcpy(precompile_input + 3 * WORD_LEN, input->signature_s, WORD_LEN);
+
+  if ((v == 27 || v == 28) && is_scalar_in_range(input->signature_r) &&
+      is_scalar_in_range(input->signature_s)) {
+    struct key_recovery_result expected = p256_key_recovery(
+        (const char *)precompile_input, WORD_LEN, input->signature_r,
+        input->signature_s, v);
+    if (expected.error_message[0] == '\0') {
+      unsigned char public_key_hash[KECCAK_256_DIGEST_LEN];
+      keccak_256((const unsigned char *)expected.public_key, 64,
+                 public_key_hash);
+      memcpy(expected_output + ADDRESS_OFFSET,
+             public_key_hash + ADDRESS_OFFSET,
+             KECCAK_256_DIGEST_LEN - ADDRESS_OFFSET);
+      expected_len = WORD_LEN;
+    }
+  }
+
+  int actual_len = p256_ecrecover(
+      actual_output, (const char *)precompile_input, ECRECOVER_INPUT_LEN);
+
+  if (actual_len != expected_len ||
+      memcmp(actual_output, expected_output, WORD_LEN) != 0) {
+    snprintf(error_message, 256,
+             "ecrecover returned %d bytes, key recovery %d bytes or another "
+             "address\n",
+             actual_len, expected_len);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+// The P256VERIFY precompile must accept a signature if r and s are between
+// 1 and n - 1 and verify accepts it with s or n - s, whichever is lower
+static int check_verify_precompile(const struct differential_input *input,
+                                   char *error_message) {
+  unsigned char precompile_input[P256VERIFY_INPUT_LEN];
+  char normalized_s[WORD_LEN];
+  char expected_output[WORD_LEN] = {0};
+  char actual_output[WORD_LEN] = {0};
+  int expected_len = 0;
+
+  hash_word(precompile_input, input);
+  memcpy(precompile_input + WORD_LEN, input->signature_r, WORD_LEN);
+  memcpy(precompile_input + 2 * WORD_LEN, input->signature_s, WORD_LEN);
+  memcpy(precompile_input + 3 * WORD_LEN, input->public_key, 64);
+
+  if (is_scalar_in_range(input->signature_r) &&
+      is_scalar_in_range(input->signature_s)) {
+    memcpy(normalized_s, input->signature_s, WORD_LEN);
+    normalize_s(normalized_s);
+    struct verify_result expected =
+        p256_verify((const char *)precompile_input, WORD_LEN,
+                    input->signature_r, normalized_s, input->public_key);
+    if (expected.verified == 1) {
+      expected_output[WORD_LEN - 1] = 1;
+      expected_len = WORD_LEN;
+    }
+  }
+
+  int actual_len = p256_verify_precompile(
+      actual_output, (const char *)precompile_input, P256VERIFY_INPUT_LEN);
+
+  if (actual_len != expected_len ||
+      memcmp(actual_output, expected_output, WORD_LEN) != 0) {
+    snprintf(error_message, 256,
+             "P256VERIFY returned %d bytes, verify %d bytes\n", actual_len,
+             expected_len);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+// the index must return the recovered key, whether it is already stored in
+// the index or not
+static int check_indexed_key_recovery(const struct differential_input *input,
+                                      char *error_message) {
+  struct key_recovery_result expected = p256_key_recovery(
+      input->data_hash, input->data_hash_len, input->signature_r,
+      input->signature_s, input->signature_v);
+
+  // the second lookup finds the key in the index once it has been written
+  for (int i = 0; i < 2; i++) {
+    struct key_recovery_result actual = p256_key_recovery_indexed(
+        recovery_index, input->data_hash, input->data_hash_len,
+        input->signature_r, input->signature_s, input->signature_v);
+
+    if (strcmp(actual.error_message, expected.error_message) != 0) {
+      snprintf(error_message, 256,
+               "Indexed key recovery failed with (%.90s), key recovery "
+               "with (%.90s)\n",
+               actual.error_message, expected.error_message);
+      return FAILURE;
+    }
+    if (strlen(expected.error_message) == 0 &&
+        memcmp(actual.public_key, expected.public_key, 64) != 0) {
+      snprintf(error_message, 256,
+               "Indexed key recovery returned another public key\n");
+      return FAILURE;
+    }
+  }
+  return SUCCESS;
+}
+
+// signatures are not deterministic, therefore they are compared by verifying
+// them and recovering the public key from them
+static int check_sign(const struct differential_input *input,
+                      char *error_message) {
+  struct sign_result signature =
+      p256_sign(input->data_hash, input->data_hash_len, input->private_key,
+                input->public_key);
+  if (strlen(signature.error_message) != 0) {
+    snprintf(error_message, 256, "Sign failed: %.200s",
+             signature.error_message);
+    return FAILURE;
+  }
+
+  struct verify_result verified = p256_verify(
+      input->data_hash, input->data_hash_len, signature.signature_r,
+      signature.signature_s, input->public_key);
+  if (verified.verified != 1) {
+    snprintf(error_message, 256, "Signature is not verified: %.200s",
+             verified.error_message);
+    return FAILURE;
+  }
+
+  struct key_recovery_result recovered = p256_key_recovery(
+      input->data_hash, input->data_hash_len, signature.signature_r,
+      signature.signature_s, signature.signature_v);
+  if (memcmp(recovered.public_key, input->public_key, 64) != 0) {
+    snprintf(error_message, 256,
+             "Public key recovered from signature differs: %.180s",
+             recovered.error_message);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+const struct differential_check differential_checks[] = {
+    {"key_table_verify", 0, check_key_table_verify},
+    {"compact_key_table_verify", 0, check_compact_key_table_verify},
+    {"validated_key_verify", 0, check_validated_key_verify},
+    {"key_cache_verify", 0, check_key_cache_verify},
+    {"low_latency_verify", 0, check_low_latency_verify},
+    {"ecrecover", 0, check_ecrecover},
+    {"verify_precompile", 0, check_verify_precompile},
+    {"indexed_key_recovery", 0, check_indexed_key_recovery},
+    {"sign", 1, check_sign},
+};
+
+const int differential_check_count =
+    sizeof(differential_checks) / sizeof(differential_checks[0]);
@@ -0,0 +1,76 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Differential checks of the fast paths of the library. Each check runs a
+ * fast path, like the key tables, validated keys, the key cache, the low
+ * latency mode, the precompiles or the recovery index, and the reference
+ * implementation based on EVP (p256_verify, p256_key_recovery and p256_sign)
+ * with the same input and fails if their results differ. The reference runs
+ * with the key cache and the low latency mode disabled. The checks are run by
+ * the libFuzzer target (fuzz_differential.c) and by the standalone driver
+ * (differential_main.c), which also runs them on the test vector corpora.
+ */
+
+struct differential_input {
+  char data_hash[64];
+  int data_hash_len;
+  char signature_r[32];
+  char signature_s[32];
+  int signature_v;
+  char public_key[64];
+  // set if private_key belongs to public_key
+  int has_private_key;
+  char private_key[32];
+};
+
+struct differential_check {
+  const char *name;
+  // checks that need a private key are skipped for other inputs
+  int needs_private_key;
+  // returns SUCCESS if the fast path behaves like the reference, otherwise
+  // FAILURE and the difference is written to error_message
+  int (*run)(const struct differential_input *input, char *error_message);
+};
+
+extern const struct differential_check differential_checks[];
+extern const int differential_check_count;
+
+// creates the key table and the recovery index that are used by the checks
+int differential_init(char *error_message);
+
+void differential_cleanup(void);
+
+// Maps arbitrary bytes, e.g. from the fuzzer, to an input. Depending on the
+// first byte, the input is signed with one of the known keys, s is replaced
+// by n - s and the input is mutated afterwards, so that valid and almost
+// valid signatures are checked as well as random ones.
+void differential_input_from_bytes(struct differential_input *input,
+                                   const unsigned char *data, size_t size);
+
+#ifdef __cplusplus
+extern
+}
+#endif
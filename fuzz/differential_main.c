@@ -0,0 +1,219 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// clock_gettime is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "constants.h"
+#include "corpus.h"
+#include "differential.h"
+
+// Runs the differential checks on random inputs and on test vector corpora
+// without libFuzzer, so that they can be run with gcc and in CI. The
+// executions per second of each check are reported, which makes the driver a
+// throughput check of the fast paths as well.
+//
+// usage: differential [--iterations N] [--seed N] [corpus files...]
+
+#define DEFAULT_ITERATIONS 10000
+#define DEFAULT_SEED 1
+#define MAX_CHECKS 16
+#define MAX_REPORTED_FAILURES 10
+#define RANDOM_INPUT_LEN 256
+
+struct check_stats {
+  unsigned long long executions;
+  unsigned long long failures;
+  unsigned long long nanoseconds;
+};
+
+static struct check_stats stats[MAX_CHECKS];
+static unsigned long long total_failures = 0;
+
+static unsigned long long now_ns(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (unsigned long long)time.tv_sec * 1000000000ULL + time.tv_nsec;
+}
+
+static void run_checks(const struct differential_input *input,
+                       const char *origin) {
+  char error_message[256];
+
+  for (int i = 0; i < differential_check_count; i++) {
+    if (differential_checks[i].needs_private_key && !input->has_private_key) {
+      continue;
+    }
+    error_message[0] = '\0';
+
+    unsigned long long start = now_ns();
+    int result = differential_checks[i].run(input, error_message);
+    stats[i].nanoseconds += now_ns() - start;
+    stats[i].executions++;
+
+    if (result != SUCCESS) {
+      stats[i].failures++;
+      if (total_failures++ < MAX_REPORTED_FAILURES) {
+        fprintf(stderr, "%s: %s: %s", origin, differential_checks[i].name,
+                error_message);
+      }
+    }
+  }
+}
+
+static void print_stats(const char *title) {
+  printf("%s\n", title);
+  for (int i = 0; i < differential_check_count; i++) {
+    double seconds = stats[i].nanoseconds / 1e9;
+    printf("  %-24s %10llu executions %10.0f exec/s %6llu failures\n",
+           differential_checks[i].name, stats[i].executions,
+           seconds > 0 ? stats[i].executions / seconds : 0.0,
+           stats[i].failures);
+  }
+  memset(stats, 0, sizeof(stats));
+}
+
+// xorshift64*, the inputs only need to be reproducible, not unpredictable
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state >> 12;
+  *state ^= *state << 25;
+  *state ^= *state >> 27;
+  return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static void run_random_inputs(unsigned long long iterations, uint64_t seed) {
+  unsigned char bytes[RANDOM_INPUT_LEN];
+  struct differential_input input;
+  char origin[64];
+  uint64_t state = seed != 0 ? seed : DEFAULT_SEED;
+
+  for (unsigned long long i = 0; i < iterations; i++) {
+    for (size_t j = 0; j < sizeof(bytes); j += 8) {
+      uint64_t value = next_random(&state);
+      memcpy(bytes + j, &value, 8);
+    }
+    differential_input_from_bytes(&input, bytes, sizeof(bytes));
+
+    snprintf(origin, sizeof(origin), "random input %llu", i);
+    run_checks(&input, origin);
+  }
+}
+
+static int run_corpus_case(const struct corpus_case *test_case,
+                           void *context) {
+  const char *path = context;
+  struct differential_input input = {0};
+  unsigned int data_hash_len = 0;
+  char origin[256];
+
+  // only P-256 signatures can be passed to the library
+  if (test_case->curve_nid != NID_X9_62_prime256v1 || test_case->md == NULL ||
+      EVP_MD_get_size(test_case->md) > (int)sizeof(input.data_hash) ||
+      test_case->public_key_len != 64 || !test_case->signature_decoded) {
+    return 1;
+  }
+
+  if (EVP_Digest(test_case->message, test_case->message_len,
+                 (unsigned char *)input.data_hash, &data_hash_len,
+                 test_case->md, NULL) != 1) {
+    return 1;
+  }
+  input.data_hash_len = (int)data_hash_len;
+  memcpy(input.signature_r, test_case->signature_r, 32);
+  memcpy(input.signature_s, test_case->signature_s, 32);
+  memcpy(input.public_key, test_case->public_key, 64);
+  if (test_case->private_key_len == 32) {
+    memcpy(input.private_key, test_case->private_key, 32);
+    input.has_private_key = 1;
+  }
+
+  snprintf(origin, sizeof(origin), "%.200s:%ld", path, test_case->id);
+
+  // the recovery id is only known for SigGen vectors, otherwise both are
+  // checked
+  int recovery_id = corpus_recovery_id(test_case);
+  for (int v = 0; v < 2; v++) {
+    if (recovery_id < 0 || recovery_id == v) {
+      input.signature_v = v;
+      run_checks(&input, origin);
+    }
+  }
+
+  return 1;
+}
+
+int main(int argc, char **argv) {
+  char error_message[256] = {0};
+  char title[256];
+  unsigned long long iterations = DEFAULT_ITERATIONS;
+  uint64_t seed = DEFAULT_SEED;
+  int first_path = argc;
+  int status = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      iterations = strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (argv[i][0] == '-') {
+      fprintf(stderr,
+              "usage: %s [--iterations N] [--seed N] [corpus files...]\n",
+              argv[0]);
+      return 2;
+    } else {
+      first_path = i;
+      break;
+    }
+  }
+
+  if (differential_init(error_message) != SUCCESS) {
+    fprintf(stderr, "%s", error_message);
+    return 1;
+  }
+
+  run_random_inputs(iterations, seed);
+  snprintf(title, sizeof(title), "random inputs (seed %llu)",
+           (unsigned long long)seed);
+  print_stats(title);
+
+  for (int i = first_path; i < argc; i++) {
+    long count = corpus_load(argv[i], run_corpus_case, argv[i]);
+    if (count < 0) {
+      status = 1;
+      continue;
+    }
+    snprintf(title, sizeof(title), "%.200s (%ld test cases)", argv[i], count);
+    print_stats(title);
+  }
+
+  differential_cleanup();
+
+  if (total_failures > 0) {
+    fprintf(stderr, "%llu differences found\n", total_failures);
+    status = 1;
+  }
+  return status;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "constants.h"
+#include "differential.h"
+
+// libFuzzer target that runs all differential checks with each input. It is
+// built with clang by `make fuzz`, libFuzzer reports the executions per
+// second itself.
+
+int LLVMFuzzerInitialize(int *argc, char ***argv) {
+  char error_message[256] = {0};
+
+  if (differential_init(error_message) != SUCCESS) {
+    fprintf(stderr, "%s", error_message);
+    exit(1);
+  }
+  atexit(differential_cleanup);
+
+  return 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  struct differential_input input;
+  char error_message[256];
+
+  differential_input_from_bytes(&input, data, size);
+
+  for (int i = 0; i < differential_check_count; i++) {
+    if (differential_checks[i].needs_private_key && !input.has_private_key) {
+      continue;
+    }
+    error_message[0] = '\0';
+    if (differential_checks[i].run(&input, error_message) != SUCCESS) {
+      fprintf(stderr, "%s: %s", differential_checks[i].name, error_message);
+      // libFuzzer stores the input that caused the crash
+      abort();
+    }
+  }
+
+  return 0;
+}
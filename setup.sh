@@ -11,13 +11,23 @@ fi
 git submodule init
 git submodule update
 
+# STATIC_CRYPTO=1 builds a static libcrypto to link into libbesu_native_ec. Its objects end up in a shared library,
+# so they are compiled as position independent code.
+if [[ "$STATIC_CRYPTO" == "1" ]]; then
+  CONFIGURE_FLAGS=-fPIC
+  CRYPTO_TARGET=libcrypto.a
+else
+  CONFIGURE_FLAGS=
+  CRYPTO_TARGET=libcrypto.$LIBRARY_EXTENSION
+fi
+
 cd openssl
-./Configure enable-ec_nistp_64_gcc_128 no-stdio no-ocsp no-nextprotoneg no-module \
+./Configure $CONFIGURE_FLAGS enable-ec_nistp_64_gcc_128 no-stdio no-ocsp no-nextprotoneg no-module \
             no-legacy no-gost no-engine no-dynamic-engine no-deprecated no-comp \
             no-cmp no-capieng no-ui-console no-tls no-ssl no-dtls no-aria no-bf \
             no-blake2 no-camellia no-cast no-chacha no-cmac no-des no-dh no-dsa \
             no-ecdh no-idea no-md4 no-mdc2 no-ocb no-poly1305 no-rc2 no-rc4 no-rmd160 \
             no-scrypt no-seed no-siphash no-siv no-sm2 no-sm3 no-sm4 no-whirlpool
-make build_generated libcrypto.$LIBRARY_EXTENSION
+make build_generated $CRYPTO_TARGET
 
 cd ../
\ No newline at end of file
@@ -45,6 +45,175 @@ struct verify_result {
   char error_message[256];
 };
 
+// memory usage of the precomputation tables, split by the kind of pages that
+// back them
+struct table_memory_stats {
+  // explicitly reserved 2 MB pages (MAP_HUGETLB)
+  unsigned long long huge_page_bytes;
+  // 2 MB aligned memory advised for transparent huge pages (MADV_HUGEPAGE),
+  // the kernel might still back parts of it with regular pages
+  unsigned long long transparent_huge_page_bytes;
+  // regular pages, used for small tables and if huge pages are not available
+  unsigned long long regular_page_bytes;
+  // number of tables that are currently allocated
+  unsigned long long tables;
+};
+
+// counters of the cache of imported public keys that is used by p256_verify
+struct key_cache_stats {
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+  // misses whose key was not cached, because it missed less often than the
+  // admission threshold
+  unsigned long long rejections;
+  unsigned long long entries;
+  unsigned long long capacity;
+  int admission_threshold;
+  int enabled;
+};
+
+// The subsystems whose native memory is accounted against the memory budget,
+// in the order in which they are evicted if it is exhausted. Only the key
+// cache can be evicted, the tables and pools of the callers stay until they
+// are freed.
+enum memory_subsystem {
+  MEMORY_SUBSYSTEM_KEY_CACHE,
+  MEMORY_SUBSYSTEM_ECDH_KEY_POOLS,
+  MEMORY_SUBSYSTEM_RECOVERY_INDEXES,
+  MEMORY_SUBSYSTEM_KEY_TABLES,
+  MEMORY_SUBSYSTEM_COUNT
+};
+
+struct memory_subsystem_stats {
+  unsigned long long used;
+  unsigned long long peak;
+  // 0 is unlimited
+  unsigned long long quota;
+  // allocations that failed because of the quota or the budget
+  unsigned long long rejected;
+  // evictions to make room for other subsystems
+  unsigned long long reclaimed;
+};
+
+struct memory_budget_stats {
+  // 0 is unlimited
+  unsigned long long budget;
+  unsigned long long used;
+  struct memory_subsystem_stats subsystems[MEMORY_SUBSYSTEM_COUNT];
+};
+
+// Full key tables store x || y and keep every imported key resident. Compact
+// tables store compressed points, about half the size, and import the keys
+// through the key cache, so that only the keys in use take more memory.
+enum key_table_format { KEY_TABLE_FULL, KEY_TABLE_COMPACT };
+
+// A sorted table of validated public keys, e.g. of a validator set, which
+// can be saved to a file and mapped read-only by other processes. It holds at
+// least one key.
+struct p256_key_table;
+
+// An append-only file that maps the inputs of a key recovery to the recovered
+// public key, so that recovering the sender of a historical transaction
+// becomes a lookup
+struct p256_recovery_index;
+
+struct recovery_index_stats {
+  // records stored in the index file
+  unsigned long long records;
+  // maximal number of records of the index file
+  unsigned long long capacity;
+  // recovered keys waiting to be written with the next batch
+  unsigned long long pending;
+  unsigned long long hits;
+  unsigned long long misses;
+  // recovered keys that were not stored, because the index is full or a full
+  // batch could not be written
+  unsigned long long dropped;
+};
+
+// A public key that is validated once when it is created, so that verifying,
+// comparing recovered keys and key agreement skip the validation
+struct p256_validated_key;
+
+struct transaction_sender_result {
+  // the last 20 bytes of the Keccak-256 hash of the public key of the sender
+  char address[20];
+  char error_message[256];
+};
+
+// Rules of p256_verify_multisig, which can be combined
+enum multisig_flags {
+  // The signers must be sorted by ascending address, or public key if the
+  // owners are public keys, which also rules out duplicates. Safe requires it.
+  MULTISIG_ASCENDING_SIGNERS = 1,
+  // recovers the signatures that are still needed for the threshold in
+  // parallel
+  MULTISIG_PARALLEL = 2
+};
+
+struct multisig_result {
+  // 1 if the threshold is met, 0 if not, -1 if the input or the order of the
+  // signers is invalid
+  int verified;
+  // number of distinct owners that signed, at most the threshold
+  int signer_count;
+  // number of signatures that have been recovered before the check stopped
+  int recovered_count;
+  char error_message[256];
+};
+
+struct public_key_result {
+  // 132 bytes are needed for a P-521 public key
+  char public_key[132];
+  char error_message[256];
+};
+
+struct ecdh_result {
+  // 66 bytes are needed for a P-521 shared secret
+  char shared_secret[66];
+  char error_message[256];
+};
+
+struct p256_ecdh_key_pair {
+  char private_key[32];
+  // x || y
+  char public_key[64];
+};
+
+// Ephemeral key pairs for key agreement, generated ahead of time by a
+// background thread
+struct p256_ecdh_key_pool;
+
+struct ecdh_key_pool_stats {
+  // key pairs that can be taken without generating them
+  unsigned long long available;
+  unsigned long long capacity;
+  // key pairs generated by the background thread
+  unsigned long long generated;
+  unsigned long long taken;
+  // key pairs that had to be generated by the caller, because the pool was
+  // empty
+  unsigned long long misses;
+};
+
+// A WebAuthn assertion of a passkey, as it is returned by
+// navigator.credentials.get()
+struct p256_webauthn_assertion {
+  const char *authenticator_data;
+  int authenticator_data_len;
+  const char *client_data_json;
+  int client_data_json_len;
+  // the challenge that was sent to the client, not base64url encoded
+  const char *challenge;
+  int challenge_len;
+  // DER encoded as returned by the authenticator or r || s
+  const char *signature;
+  int signature_len;
+  // x || y of the credential public key
+  const char *public_key;
+};
+
 struct key_recovery_result p256_key_recovery(const char data_hash[],
                                              const int data_hash_len,
                                              const char signature_r[],
@@ -61,7 +230,262 @@ struct verify_result p256_verify(const char data_hash[],
                                  const char signature_s[],
                                  const char public_key_data[]);
 
+struct table_memory_stats besu_native_ec_table_memory_stats(void);
+
+// Enables or disables the cache of imported public keys. It is enabled by
+// default, disabling it releases all cached keys.
+void besu_native_ec_key_cache_set_enabled(const int enable);
+
+// sets the maximal number of cached keys and releases all cached keys
+int besu_native_ec_key_cache_set_capacity(char *error_message,
+                                          const long long new_capacity);
+
+// Sets how often a key has to miss recently before it is cached, which keeps
+// keys that are seen once from evicting the keys of repeat signers. The misses
+// are estimated with a sketch that forgets older misses. The default of 1
+// caches every key.
+int besu_native_ec_key_cache_set_admission_threshold(
+    char *error_message, const long long threshold);
+
+struct key_cache_stats besu_native_ec_key_cache_stats(void);
+
+// Sets the ceiling of the native memory of all tables, caches and pools, 0
+// removes it. If more memory is used, the caches are evicted until it fits.
+int besu_native_ec_memory_set_budget(char *error_message,
+                                     const long long bytes);
+
+// sets the ceiling of the memory of one subsystem, 0 removes it
+int besu_native_ec_memory_set_quota(char *error_message, const int subsystem,
+                                    const long long bytes);
+
+struct memory_budget_stats besu_native_ec_memory_budget_stats(void);
+
+// Lowers the latency of single verifications and key recoveries, e.g. of
+// consensus messages. Each of them computes u1 * G on a worker thread while
+// the calling thread computes the multiple of the public key, and waits for
+// the worker before the multiples are added. Without worker threads, both are
+// computed by the calling thread. The idle worker threads spin while it is
+// enabled. It is disabled by default.
+void besu_native_ec_low_latency_set_enabled(const int enable);
+
+// Frees the contexts that the calling thread keeps for reuse. They are freed
+// automatically when the thread exits, so this is only needed by threads that
+// stop using the library but keep running.
+void besu_native_ec_release_thread_context(void);
+
+int p256_key_table_create(struct p256_key_table **table, char *error_message,
+                          const char public_keys[], const int key_count);
+
+int p256_key_table_create_with_format(struct p256_key_table **table,
+                                      char *error_message,
+                                      const char public_keys[],
+                                      const int key_count, const int format);
+
+int p256_key_table_save(const struct p256_key_table *table,
+                        char *error_message, const char *path);
+
+// Maps a saved table. The keys of full tables are imported on the worker pool
+// before it returns, compact tables import their keys through the key cache
+// when they are used.
+int p256_key_table_load(struct p256_key_table **table, char *error_message,
+                        const char *path);
+
+void p256_key_table_free(struct p256_key_table *table);
+
+// returns the index of the public key in the table or -1 if it is not part of
+// it
+int p256_key_table_find(const struct p256_key_table *table,
+                        const char public_key_data[]);
+
+struct verify_result p256_key_table_verify(struct p256_key_table *table,
+                                           const int key_index,
+                                           const char data_hash[],
+                                           const int data_hash_length,
+                                           const char signature_r[],
+                                           const char signature_s[]);
+
+// opens the index file at path or creates it with the given capacity if it
+// does not exist yet
+int p256_recovery_index_open(struct p256_recovery_index **index,
+                             char *error_message, const char *path,
+                             const long long capacity);
+
+// writes all pending records and closes the index
+void p256_recovery_index_close(struct p256_recovery_index *index);
+
+int p256_recovery_index_flush(struct p256_recovery_index *index,
+                              char *error_message);
+
+// rewrites the index file with the given capacity and without duplicates.
+// lookups and additions of other threads may run concurrently, but not
+// p256_recovery_index_close.
+int p256_recovery_index_compact(struct p256_recovery_index *index,
+                                char *error_message,
+                                const long long capacity);
+
+struct recovery_index_stats
+p256_recovery_index_stats(struct p256_recovery_index *index);
+
+// same as p256_key_recovery, but looks up the public key in the index first
+// and adds it to the index if it had to be recovered
+struct key_recovery_result
+p256_key_recovery_indexed(struct p256_recovery_index *index,
+                          const char data_hash[], const int data_hash_len,
+                          const char signature_r[], const char signature_s[],
+                          const int signature_v);
+
+// Recovers the sender of a signed transaction as it is sent over the network:
+// a legacy transaction with or without the chain id of EIP-155, or a typed
+// transaction of EIP-2930 (0x01) or EIP-1559 (0x02). r and s must be between
+// 1 and n - 1 and, as required by EIP-2, s must not be greater than n / 2.
+struct transaction_sender_result
+p256_recover_transaction_sender(const char transaction[],
+                                const int transaction_len);
+
+// Recovers the senders of transactions that are stored one after another.
+// Transaction i starts at transaction_offsets[i] and ends before
+// transaction_offsets[i + 1], so there are transaction_count + 1 offsets.
+// Returns the number of transactions whose sender was recovered.
+int p256_recover_transaction_senders(
+    struct transaction_sender_result results[], const char transactions[],
+    const int transaction_offsets[], const int transaction_count);
+
+// Returns 1 if the signature recovers to the public key of expected_address
+// (20 bytes), otherwise 0, e.g. to check the claimed sender of a transaction
+// without returning the public key. r and s must be between 1 and n - 1, s
+// greater than n / 2 is accepted.
+int p256_verify_sender_address(const char data_hash[], const int data_hash_len,
+                               const char signature_r[],
+                               const char signature_s[], const int signature_v,
+                               const char expected_address[]);
+
+// Checks count claimed senders in parallel. The data hashes are Keccak-256
+// hashes (32 bytes each), the signatures r || s || v (65 bytes each) and the
+// expected addresses 20 bytes each. results[i] is set to 1 if signature i
+// recovers to address i, otherwise to 0. Returns the number of matches.
+int p256_verify_sender_addresses(char results[], const char data_hashes[],
+                                 const char signatures[],
+                                 const char expected_addresses[],
+                                 const int count);
+
+// Checks that at least threshold distinct owners signed the data hash. The
+// signatures r || s || v (65 bytes each) are stored one after another and are
+// recovered in order until the threshold is met or can't be met anymore.
+// owner_len is 20 if the owners are addresses or 64 if they are public keys
+// x || y. Signatures of other keys and signatures whose r or s is not between
+// 1 and n - 1 are not counted, s greater than n / 2 is accepted. flags
+// combines the rules of enum multisig_flags.
+struct multisig_result
+p256_verify_multisig(const char data_hash[], const int data_hash_len,
+                     const char signatures[], const int signatures_len,
+                     const char owners[], const int owner_len,
+                     const int owner_count, const int threshold,
+                     const int flags);
+
+// The ecrecover precompile of the EVM on P-256: input is hash || v || r || s
+// as 32 byte words, shorter inputs are padded with zeros. Writes the address
+// of the signer, left padded with zeros to 32 bytes, to output and returns 32,
+// or returns 0 without any output if the input is invalid.
+int p256_ecrecover(char output[], const char input[], const int input_len);
+
+// The P256VERIFY precompile (RIP-7212): input is hash || r || s || x || y as
+// 32 byte words and must be exactly 160 bytes. r and s must be between 1 and
+// n - 1, s greater than n / 2 is accepted. Writes 1 as a 32 byte word to output
+// and returns 32 if the signature is valid, otherwise returns 0 without any
+// output.
+int p256_verify_precompile(char output[], const char input[],
+                           const int input_len);
+
+// Verifies the type and challenge of the client data and the signature over
+// the authenticator data and the client data. The origin, the rpIdHash and
+// the flags of the authenticator data have to be checked by the caller.
+// Authenticators don't canonicalize signatures, so with allow_high_s an s
+// greater than n / 2 is accepted. r and s must be less than n either way.
+struct verify_result
+p256_verify_webauthn(const struct p256_webauthn_assertion *assertion,
+                     const int allow_high_s);
+
+// Verifies the assertions in parallel and returns the number of verified
+// assertions
+int p256_verify_webauthn_batch(
+    struct verify_result results[],
+    const struct p256_webauthn_assertion assertions[],
+    const int assertion_count, const int allow_high_s);
+
+// validates the public key x || y and imports it
+int p256_validated_key_create(struct p256_validated_key **key,
+                              char *error_message,
+                              const char public_key_data[]);
+
+// Validates key_count public keys (64 bytes each) in parallel, e.g. of a
+// validator list. keys[i] is NULL if public key i is invalid. Returns the
+// number of valid keys.
+int p256_validated_keys_create(struct p256_validated_key *keys[],
+                               const char public_keys[], const int key_count);
+
+void p256_validated_key_free(struct p256_validated_key *key);
+
+struct verify_result
+p256_validated_key_verify(const struct p256_validated_key *key,
+                          const char data_hash[], const int data_hash_length,
+                          const char signature_r[], const char signature_s[]);
+
+// recovers the public key of the signature and sets verified to 1 if it is the
+// validated key
+struct verify_result
+p256_validated_key_matches_recovery(const struct p256_validated_key *key,
+                                    const char data_hash[],
+                                    const int data_hash_length,
+                                    const char signature_r[],
+                                    const char signature_s[],
+                                    const int signature_v);
+
+// computes the shared secret of the private key and the validated public key
+// of the peer
+struct ecdh_result
+p256_validated_key_ecdh(const struct p256_validated_key *peer_key,
+                        const char private_key_data[]);
+
+// derives the public key x || y of a private key
+struct public_key_result p256_derive_public_key(const char private_key_data[]);
+
+// Derives the public keys of count private keys (32 bytes each) in parallel
+// and returns the number of derived public keys
+int p256_derive_public_keys(struct public_key_result results[],
+                            const char private_keys[], const int count);
+
+// Generates count key pairs in parallel. The private keys (32 bytes each) and
+// the public keys x || y (64 bytes each) are stored one after another.
+int p256_generate_keypairs(char private_keys[], char public_keys[],
+                           char *error_message, const int count);
+
+// Computes the shared secret, the x coordinate of private_key * peer public
+// key. The public key x || y of the peer must be a point on the curve.
+struct ecdh_result p256_ecdh(const char private_key_data[],
+                             const char peer_public_key_data[]);
+
+// Computes the shared secrets of count private keys (32 bytes each) and peer
+// public keys (64 bytes each) in parallel and returns the number of computed
+// secrets
+int p256_ecdh_batch(struct ecdh_result results[], const char private_keys[],
+                    const char peer_public_keys[], const int count);
+
+// creates a pool with the given capacity, which is filled in the background
+int p256_ecdh_key_pool_create(struct p256_ecdh_key_pool **pool,
+                              char *error_message, const int capacity);
+
+// stops the background thread and clears all key pairs of the pool
+void p256_ecdh_key_pool_free(struct p256_ecdh_key_pool *pool);
+
+// Hands out a key pair that is removed from the pool. If the pool is empty,
+// the key pair is generated on the calling thread.
+int p256_ecdh_key_pool_take(struct p256_ecdh_key_pool *pool,
+                            char *error_message,
+                            struct p256_ecdh_key_pair *key_pair);
+
+struct ecdh_key_pool_stats
+p256_ecdh_key_pool_stats(struct p256_ecdh_key_pool *pool);
+
 #ifdef __cplusplus
-extern
 }
 #endif
@@ -0,0 +1,528 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <execution>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+/**
+ * Header-only C++20 front end of the besu-native-ec library. Inputs are
+ * passed as spans and handed to the C functions without copying them, key
+ * handles free their C counterparts when they go out of scope and errors that
+ * the C functions report in error_message are thrown as
+ * besu::native_ec::error.
+ */
+
+namespace besu::native_ec {
+
+class error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+template <std::size_t Size> using bytes = std::array<std::byte, Size>;
+
+namespace detail {
+
+inline const char *chars(std::span<const std::byte> data) {
+  return reinterpret_cast<const char *>(data.data());
+}
+
+inline int length(std::span<const std::byte> data) {
+  if (data.size() >
+      static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::length_error("besu::native_ec: input is too large");
+  }
+  return static_cast<int>(data.size());
+}
+
+// the error messages of the C functions end with a new line
+[[noreturn]] inline void raise(const char *error_message) {
+  std::string message(error_message);
+  if (!message.empty() && message.back() == '\n') {
+    message.pop_back();
+  }
+  throw error(message.empty() ? "besu::native_ec: unknown error" : message);
+}
+
+inline void check(const char *error_message) {
+  if (error_message[0] != '\0') {
+    raise(error_message);
+  }
+}
+
+template <std::size_t Size> bytes<Size> to_bytes(const char *data) {
+  bytes<Size> result;
+  std::memcpy(result.data(), data, Size);
+  return result;
+}
+
+} // namespace detail
+
+// The curves of the C library. Each curve describes the sizes of its keys and
+// forwards to the C functions, so that the templates below stay independent
+// of the curve.
+struct P256 {
+  static constexpr std::size_t scalar_size = 32;
+  // x || y
+  static constexpr std::size_t public_key_size = 64;
+
+  using validated_key_type = p256_validated_key;
+  using key_table_type = p256_key_table;
+  using ecdh_key_pool_type = p256_ecdh_key_pool;
+  using key_pair_type = p256_ecdh_key_pair;
+
+  static verify_result verify(const char data_hash[], int data_hash_length,
+                              const char signature_r[],
+                              const char signature_s[],
+                              const char public_key_data[]) {
+    return p256_verify(data_hash, data_hash_length, signature_r, signature_s,
+                       public_key_data);
+  }
+
+  static key_recovery_result recover(const char data_hash[],
+                                     int data_hash_length,
+                                     const char signature_r[],
+                                     const char signature_s[],
+                                     int signature_v) {
+    return p256_key_recovery(data_hash, data_hash_length, signature_r,
+                             signature_s, signature_v);
+  }
+
+  static sign_result sign(const char data_hash[], int data_hash_length,
+                          const char private_key_data[],
+                          const char public_key_data[]) {
+    return p256_sign(data_hash, data_hash_length, private_key_data,
+                     public_key_data);
+  }
+
+  static public_key_result derive_public_key(const char private_key_data[]) {
+    return p256_derive_public_key(private_key_data);
+  }
+
+  static ecdh_result ecdh(const char private_key_data[],
+                          const char peer_public_key_data[]) {
+    return p256_ecdh(private_key_data, peer_public_key_data);
+  }
+
+  static int validated_key_create(validated_key_type **key,
+                                  char *error_message,
+                                  const char public_key_data[]) {
+    return p256_validated_key_create(key, error_message, public_key_data);
+  }
+
+  static void validated_key_free(validated_key_type *key) {
+    p256_validated_key_free(key);
+  }
+
+  static verify_result validated_key_verify(const validated_key_type *key,
+                                            const char data_hash[],
+                                            int data_hash_length,
+                                            const char signature_r[],
+                                            const char signature_s[]) {
+    return p256_validated_key_verify(key, data_hash, data_hash_length,
+                                     signature_r, signature_s);
+  }
+
+  static ecdh_result validated_key_ecdh(const validated_key_type *peer_key,
+                                        const char private_key_data[]) {
+    return p256_validated_key_ecdh(peer_key, private_key_data);
+  }
+
+  static int key_table_create(key_table_type **table, char *error_message,
+                              const char public_keys[], int key_count,
+                              key_table_format format) {
+    return p256_key_table_create_with_format(table, error_message,
+                                             public_keys, key_count, format);
+  }
+
+  static int key_table_load(key_table_type **table, char *error_message,
+                            const char *path) {
+    return p256_key_table_load(table, error_message, path);
+  }
+
+  static int key_table_save(const key_table_type *table, char *error_message,
+                            const char *path) {
+    return p256_key_table_save(table, error_message, path);
+  }
+
+  static void key_table_free(key_table_type *table) {
+    p256_key_table_free(table);
+  }
+
+  static int key_table_find(const key_table_type *table,
+                            const char public_key_data[]) {
+    return p256_key_table_find(table, public_key_data);
+  }
+
+  static verify_result key_table_verify(key_table_type *table, int key_index,
+                                        const char data_hash[],
+                                        int data_hash_length,
+                                        const char signature_r[],
+                                        const char signature_s[]) {
+    return p256_key_table_verify(table, key_index, data_hash,
+                                 data_hash_length, signature_r, signature_s);
+  }
+
+  static int ecdh_key_pool_create(ecdh_key_pool_type **pool,
+                                  char *error_message, int capacity) {
+    return p256_ecdh_key_pool_create(pool, error_message, capacity);
+  }
+
+  static void ecdh_key_pool_free(ecdh_key_pool_type *pool) {
+    p256_ecdh_key_pool_free(pool);
+  }
+
+  static int ecdh_key_pool_take(ecdh_key_pool_type *pool, char *error_message,
+                                key_pair_type *key_pair) {
+    return p256_ecdh_key_pool_take(pool, error_message, key_pair);
+  }
+
+  static ::ecdh_key_pool_stats
+  ecdh_key_pool_stats(ecdh_key_pool_type *pool) {
+    return p256_ecdh_key_pool_stats(pool);
+  }
+};
+
+template <typename Curve>
+using private_key_view = std::span<const std::byte, Curve::scalar_size>;
+
+template <typename Curve>
+using public_key_view = std::span<const std::byte, Curve::public_key_size>;
+
+template <typename Curve>
+using scalar_view = std::span<const std::byte, Curve::scalar_size>;
+
+template <typename Curve> struct signature {
+  bytes<Curve::scalar_size> r;
+  bytes<Curve::scalar_size> s;
+  // the recovery id, -1 if it is not known
+  int v = -1;
+};
+
+template <typename Curve> struct key_pair {
+  bytes<Curve::scalar_size> private_key;
+  bytes<Curve::public_key_size> public_key;
+};
+
+// An element of a batch verification. The request only refers to the data of
+// the caller, which must outlive the batch.
+template <typename Curve> struct verify_request {
+  std::span<const std::byte> data_hash;
+  scalar_view<Curve> signature_r;
+  scalar_view<Curve> signature_s;
+  public_key_view<Curve> public_key;
+};
+
+// An element of a batch key recovery, see verify_request
+template <typename Curve> struct recover_request {
+  std::span<const std::byte> data_hash;
+  scalar_view<Curve> signature_r;
+  scalar_view<Curve> signature_s;
+  int signature_v;
+};
+
+// Returns true if the signature is valid. Malformed inputs, e.g. an s greater
+// than n / 2, are thrown as error.
+template <typename Curve>
+bool verify(std::span<const std::byte> data_hash, scalar_view<Curve> r,
+            scalar_view<Curve> s, public_key_view<Curve> public_key) {
+  verify_result result =
+      Curve::verify(detail::chars(data_hash), detail::length(data_hash),
+                    detail::chars(r), detail::chars(s),
+                    detail::chars(public_key));
+  detail::check(result.error_message);
+  return result.verified == 1;
+}
+
+template <typename Curve>
+bool verify(std::span<const std::byte> data_hash,
+            const signature<Curve> &signature,
+            public_key_view<Curve> public_key) {
+  return verify<Curve>(data_hash, signature.r, signature.s, public_key);
+}
+
+template <typename Curve>
+bytes<Curve::public_key_size>
+recover(std::span<const std::byte> data_hash, scalar_view<Curve> r,
+        scalar_view<Curve> s, int v) {
+  key_recovery_result result =
+      Curve::recover(detail::chars(data_hash), detail::length(data_hash),
+                     detail::chars(r), detail::chars(s), v);
+  detail::check(result.error_message);
+  return detail::to_bytes<Curve::public_key_size>(result.public_key);
+}
+
+template <typename Curve>
+bytes<Curve::public_key_size> recover(std::span<const std::byte> data_hash,
+                                      const signature<Curve> &signature) {
+  return recover<Curve>(data_hash, signature.r, signature.s, signature.v);
+}
+
+template <typename Curve>
+signature<Curve> sign(std::span<const std::byte> data_hash,
+                      private_key_view<Curve> private_key,
+                      public_key_view<Curve> public_key) {
+  sign_result result =
+      Curve::sign(detail::chars(data_hash), detail::length(data_hash),
+                  detail::chars(private_key), detail::chars(public_key));
+  detail::check(result.error_message);
+  return {detail::to_bytes<Curve::scalar_size>(result.signature_r),
+          detail::to_bytes<Curve::scalar_size>(result.signature_s),
+          result.signature_v};
+}
+
+template <typename Curve>
+bytes<Curve::public_key_size>
+derive_public_key(private_key_view<Curve> private_key) {
+  public_key_result result =
+      Curve::derive_public_key(detail::chars(private_key));
+  detail::check(result.error_message);
+  return detail::to_bytes<Curve::public_key_size>(result.public_key);
+}
+
+// returns the x coordinate of private_key * peer_public_key
+template <typename Curve>
+bytes<Curve::scalar_size> ecdh(private_key_view<Curve> private_key,
+                               public_key_view<Curve> peer_public_key) {
+  ecdh_result result = Curve::ecdh(detail::chars(private_key),
+                                   detail::chars(peer_public_key));
+  detail::check(result.error_message);
+  return detail::to_bytes<Curve::scalar_size>(result.shared_secret);
+}
+
+// Verifies the requests with the execution policy, e.g. std::execution::par,
+// and writes the result of request i to results[i]. Errors are reported in
+// the results and not thrown. Returns the number of verified signatures.
+template <typename Curve, typename ExecutionPolicy>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+std::size_t verify_batch(ExecutionPolicy &&policy,
+                         std::span<const verify_request<Curve>> requests,
+                         std::span<verify_result> results) {
+  if (results.size() < requests.size()) {
+    throw std::length_error("besu::native_ec: fewer results than requests");
+  }
+  std::transform(policy, requests.begin(), requests.end(), results.begin(),
+                 [](const verify_request<Curve> &request) {
+                   return Curve::verify(
+                       detail::chars(request.data_hash),
+                       detail::length(request.data_hash),
+                       detail::chars(request.signature_r),
+                       detail::chars(request.signature_s),
+                       detail::chars(request.public_key));
+                 });
+  return static_cast<std::size_t>(
+      std::count_if(policy, results.begin(),
+                    results.begin() + requests.size(),
+                    [](const verify_result &result) {
+                      return result.verified == 1;
+                    }));
+}
+
+// Recovers the public keys of the requests with the execution policy, see
+// verify_batch. Returns the number of recovered public keys.
+template <typename Curve, typename ExecutionPolicy>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+std::size_t recover_batch(ExecutionPolicy &&policy,
+                          std::span<const recover_request<Curve>> requests,
+                          std::span<key_recovery_result> results) {
+  if (results.size() < requests.size()) {
+    throw std::length_error("besu::native_ec: fewer results than requests");
+  }
+  std::transform(policy, requests.begin(), requests.end(), results.begin(),
+                 [](const recover_request<Curve> &request) {
+                   return Curve::recover(
+                       detail::chars(request.data_hash),
+                       detail::length(request.data_hash),
+                       detail::chars(request.signature_r),
+                       detail::chars(request.signature_s),
+                       request.signature_v);
+                 });
+  return static_cast<std::size_t>(
+      std::count_if(policy, results.begin(),
+                    results.begin() + requests.size(),
+                    [](const key_recovery_result &result) {
+                      return result.error_message[0] == '\0';
+                    }));
+}
+
+// A public key that is validated once, see p256_validated_key_create
+template <typename Curve> class validated_key {
+public:
+  explicit validated_key(public_key_view<Curve> public_key) {
+    char error_message[256] = {0};
+    typename Curve::validated_key_type *key = nullptr;
+    if (Curve::validated_key_create(&key, error_message,
+                                    detail::chars(public_key)) != 1) {
+      detail::raise(error_message);
+    }
+    key_.reset(key);
+  }
+
+  bool verify(std::span<const std::byte> data_hash, scalar_view<Curve> r,
+              scalar_view<Curve> s) const {
+    verify_result result = Curve::validated_key_verify(
+        key_.get(), detail::chars(data_hash), detail::length(data_hash),
+        detail::chars(r), detail::chars(s));
+    detail::check(result.error_message);
+    return result.verified == 1;
+  }
+
+  bool verify(std::span<const std::byte> data_hash,
+              const signature<Curve> &signature) const {
+    return verify(data_hash, signature.r, signature.s);
+  }
+
+  // the shared secret of the private key and this key of the peer
+  bytes<Curve::scalar_size> ecdh(private_key_view<Curve> private_key) const {
+    ecdh_result result =
+        Curve::validated_key_ecdh(key_.get(), detail::chars(private_key));
+    detail::check(result.error_message);
+    return detail::to_bytes<Curve::scalar_size>(result.shared_secret);
+  }
+
+  const typename Curve::validated_key_type *get() const { return key_.get(); }
+
+private:
+  struct deleter {
+    void operator()(typename Curve::validated_key_type *key) const {
+      Curve::validated_key_free(key);
+    }
+  };
+
+  std::unique_ptr<typename Curve::validated_key_type, deleter> key_;
+};
+
+// A sorted table of validated public keys, see p256_key_table_create
+template <typename Curve> class key_table {
+public:
+  // public_keys are stored one after another
+  explicit key_table(std::span<const std::byte> public_keys,
+                     key_table_format format = KEY_TABLE_FULL) {
+    if (public_keys.size() % Curve::public_key_size != 0) {
+      throw error("Length of public keys must be a multiple of " +
+                  std::to_string(Curve::public_key_size));
+    }
+    char error_message[256] = {0};
+    typename Curve::key_table_type *table = nullptr;
+    if (Curve::key_table_create(
+            &table, error_message, detail::chars(public_keys),
+            detail::length(public_keys) /
+                static_cast<int>(Curve::public_key_size),
+            format) != 1) {
+      detail::raise(error_message);
+    }
+    table_.reset(table);
+  }
+
+  static key_table load(const std::string &path) {
+    char error_message[256] = {0};
+    typename Curve::key_table_type *table = nullptr;
+    if (Curve::key_table_load(&table, error_message, path.c_str()) != 1) {
+      detail::raise(error_message);
+    }
+    return key_table(table);
+  }
+
+  void save(const std::string &path) const {
+    char error_message[256] = {0};
+    if (Curve::key_table_save(table_.get(), error_message, path.c_str()) !=
+        1) {
+      detail::raise(error_message);
+    }
+  }
+
+  // returns the index of the public key or -1 if it is not part of the table
+  int find(public_key_view<Curve> public_key) const {
+    return Curve::key_table_find(table_.get(), detail::chars(public_key));
+  }
+
+  bool verify(int key_index, std::span<const std::byte> data_hash,
+              scalar_view<Curve> r, scalar_view<Curve> s) {
+    verify_result result = Curve::key_table_verify(
+        table_.get(), key_index, detail::chars(data_hash),
+        detail::length(data_hash), detail::chars(r), detail::chars(s));
+    detail::check(result.error_message);
+    return result.verified == 1;
+  }
+
+  typename Curve::key_table_type *get() const { return table_.get(); }
+
+private:
+  explicit key_table(typename Curve::key_table_type *table) : table_(table) {}
+
+  struct deleter {
+    void operator()(typename Curve::key_table_type *table) const {
+      Curve::key_table_free(table);
+    }
+  };
+
+  std::unique_ptr<typename Curve::key_table_type, deleter> table_;
+};
+
+// Ephemeral key pairs for key agreement, see p256_ecdh_key_pool_create
+template <typename Curve> class ecdh_key_pool {
+public:
+  explicit ecdh_key_pool(int capacity) {
+    char error_message[256] = {0};
+    typename Curve::ecdh_key_pool_type *pool = nullptr;
+    if (Curve::ecdh_key_pool_create(&pool, error_message, capacity) != 1) {
+      detail::raise(error_message);
+    }
+    pool_.reset(pool);
+  }
+
+  key_pair<Curve> take() {
+    char error_message[256] = {0};
+    typename Curve::key_pair_type taken;
+    if (Curve::ecdh_key_pool_take(pool_.get(), error_message, &taken) != 1) {
+      detail::raise(error_message);
+    }
+    key_pair<Curve> result = {
+        detail::to_bytes<Curve::scalar_size>(taken.private_key),
+        detail::to_bytes<Curve::public_key_size>(taken.public_key)};
+    std::memset(&taken, 0, sizeof(taken));
+    return result;
+  }
+
+  ecdh_key_pool_stats stats() const {
+    return Curve::ecdh_key_pool_stats(pool_.get());
+  }
+
+private:
+  struct deleter {
+    void operator()(typename Curve::ecdh_key_pool_type *pool) const {
+      Curve::ecdh_key_pool_free(pool);
+    }
+  };
+
+  std::unique_ptr<typename Curve::ecdh_key_pool_type, deleter> pool_;
+};
+
+} // namespace besu::native_ec
@@ -0,0 +1,398 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/rand.h"
+
+#include "besu_native_ec.h"
+#include "concurrent_table.h"
+#include "constants.h"
+#include "epoch.h"
+
+// readers yield after spinning this often on a shard that is being written
+#define SPINS_BEFORE_YIELD 64
+
+#define WORDS(size) (((size) + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+
+// splitmix64 finalizer
+static uint64_t mix(uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+// keys might be chosen by an attacker, so the hash is seeded to keep them from
+// filling one probe window. The lowest bit is set, as a tag of 0 marks empty
+// slots.
+static uint64_t hash_key(const struct concurrent_table *table,
+                         const uint64_t key_words[]) {
+  uint64_t h = mix(table->hash_seed);
+
+  for (size_t i = 0; i < table->key_words; i++) {
+    h = mix(h ^ key_words[i]);
+  }
+  return h | 1;
+}
+
+static struct concurrent_table_shard *
+shard_of(struct concurrent_table *table, uint64_t hash) {
+  return &table->shards[(hash >> 32) % CONCURRENT_TABLE_SHARD_COUNT];
+}
+
+static size_t window_of(const struct concurrent_table_shard *shard) {
+  return shard->slot_count < CONCURRENT_TABLE_PROBE_LIMIT
+             ? shard->slot_count
+             : CONCURRENT_TABLE_PROBE_LIMIT;
+}
+
+static size_t slot_at(const struct concurrent_table_shard *shard,
+                      uint64_t hash, size_t position) {
+  return (hash % shard->slot_count + position) % shard->slot_count;
+}
+
+static atomic_ullong *slot_words(const struct concurrent_table *table,
+                                 const struct concurrent_table_shard *shard,
+                                 size_t slot) {
+  return &shard->words[slot * (table->key_words + table->value_words)];
+}
+
+// Returns the slot of the key or -1 and copies its value. Readers call it
+// without the lock, so all loads are atomic and the result is only valid if
+// the sequence of the shard didn't change.
+static long find_slot(const struct concurrent_table *table,
+                      const struct concurrent_table_shard *shard,
+                      const uint64_t key_words[], uint64_t hash,
+                      uint64_t value_words[]) {
+  size_t window = window_of(shard);
+
+  for (size_t position = 0; position < window; position++) {
+    size_t slot = slot_at(shard, hash, position);
+    if (atomic_load_explicit(&shard->tags[slot], memory_order_relaxed) !=
+        hash) {
+      continue;
+    }
+
+    atomic_ullong *words = slot_words(table, shard, slot);
+    size_t i = 0;
+    while (i < table->key_words &&
+           atomic_load_explicit(&words[i], memory_order_relaxed) ==
+               key_words[i]) {
+      i++;
+    }
+    if (i < table->key_words) {
+      continue;
+    }
+
+    for (i = 0; i < table->value_words; i++) {
+      value_words[i] = atomic_load_explicit(&words[table->key_words + i],
+                                            memory_order_relaxed);
+    }
+    return (long)slot;
+  }
+  return -1;
+}
+
+static void *object_of(const uint64_t value_words[]) {
+  return (void *)(uintptr_t)value_words[0];
+}
+
+struct concurrent_table *concurrent_table_new(char *error_message,
+                                              const size_t capacity,
+                                              const size_t key_size,
+                                              const size_t value_size,
+                                              epoch_release release) {
+  if (capacity == 0 || key_size == 0 ||
+      key_size > CONCURRENT_TABLE_MAX_KEY_SIZE || value_size == 0 ||
+      value_size > CONCURRENT_TABLE_MAX_VALUE_SIZE ||
+      (release != NULL && value_size != sizeof(void *))) {
+    snprintf(error_message, 256,
+             "Invalid capacity, key or value size of concurrent table\n");
+    return NULL;
+  }
+
+  struct concurrent_table *table =
+      aligned_alloc(_Alignof(struct concurrent_table),
+                    sizeof(struct concurrent_table));
+  if (table == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for concurrent table\n");
+    return NULL;
+  }
+  memset(table, 0, sizeof(struct concurrent_table));
+  table->key_size = key_size;
+  table->key_words = WORDS(key_size);
+  table->value_size = value_size;
+  table->value_words = WORDS(value_size);
+  table->release = release;
+  if (RAND_bytes((unsigned char *)&table->hash_seed,
+                 sizeof(table->hash_seed)) != SUCCESS) {
+    table->hash_seed = (uint64_t)(uintptr_t)table;
+  }
+
+  size_t slot_count = (capacity + CONCURRENT_TABLE_SHARD_COUNT - 1) /
+                      CONCURRENT_TABLE_SHARD_COUNT;
+  size_t slot_size = table->key_words + table->value_words;
+  for (int i = 0; i < CONCURRENT_TABLE_SHARD_COUNT; i++) {
+    pthread_mutex_init(&table->shards[i].lock, NULL);
+  }
+  for (int i = 0; i < CONCURRENT_TABLE_SHARD_COUNT; i++) {
+    struct concurrent_table_shard *shard = &table->shards[i];
+
+    shard->slot_count = slot_count;
+    shard->tags = calloc(slot_count, sizeof(atomic_ullong));
+    shard->words = calloc(slot_count * slot_size, sizeof(atomic_ullong));
+    shard->referenced = calloc(slot_count, sizeof(atomic_uchar));
+    if (shard->tags == NULL || shard->words == NULL ||
+        shard->referenced == NULL) {
+      concurrent_table_free(table);
+      snprintf(error_message, 256,
+               "Could not allocate memory for slots of concurrent table\n");
+      return NULL;
+    }
+  }
+  return table;
+}
+
+void concurrent_table_free(void *data) {
+  struct concurrent_table *table = data;
+
+  if (table == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < CONCURRENT_TABLE_SHARD_COUNT; i++) {
+    struct concurrent_table_shard *shard = &table->shards[i];
+
+    for (size_t slot = 0; table->release != NULL && shard->tags != NULL &&
+                          shard->words != NULL && slot < shard->slot_count;
+         slot++) {
+      if (atomic_load(&shard->tags[slot]) != 0) {
+        uint64_t value_word = atomic_load(
+            &slot_words(table, shard, slot)[table->key_words]);
+        table->release(object_of(&value_word));
+      }
+    }
+    free(shard->tags);
+    free(shard->words);
+    free(shard->referenced);
+    pthread_mutex_destroy(&shard->lock);
+  }
+  free(table);
+}
+
+size_t concurrent_table_memory_size(const size_t capacity,
+                                    const size_t key_size,
+                                    const size_t value_size) {
+  size_t slot_count = (capacity + CONCURRENT_TABLE_SHARD_COUNT - 1) /
+                      CONCURRENT_TABLE_SHARD_COUNT;
+  size_t slot_size = WORDS(key_size) + WORDS(value_size);
+
+  return sizeof(struct concurrent_table) +
+         CONCURRENT_TABLE_SHARD_COUNT * slot_count *
+             ((1 + slot_size) * sizeof(atomic_ullong) + sizeof(atomic_uchar));
+}
+
+static void mark_referenced(struct concurrent_table_shard *shard,
+                            size_t slot) {
+  // only written if not set yet, to keep the cache line shared
+  if (!atomic_load_explicit(&shard->referenced[slot], memory_order_relaxed)) {
+    atomic_store_explicit(&shard->referenced[slot], 1, memory_order_relaxed);
+  }
+}
+
+int concurrent_table_get(struct concurrent_table *table, char *error_message,
+                         const void *key, void *value,
+                         concurrent_table_acquire acquire) {
+  uint64_t key_words[WORDS(CONCURRENT_TABLE_MAX_KEY_SIZE)] = {0};
+  uint64_t value_words[WORDS(CONCURRENT_TABLE_MAX_VALUE_SIZE)];
+
+  memcpy(key_words, key, table->key_size);
+  uint64_t hash = hash_key(table, key_words);
+  struct concurrent_table_shard *shard = shard_of(table, hash);
+
+  if (epoch_enter(error_message) != SUCCESS) {
+    return GENERIC_ERROR;
+  }
+
+  long slot = -1;
+  for (int spins = 0;; spins++) {
+    unsigned int sequence =
+        atomic_load_explicit(&shard->sequence, memory_order_acquire);
+    if ((sequence & 1) == 0) {
+      slot = find_slot(table, shard, key_words, hash, value_words);
+      atomic_thread_fence(memory_order_acquire);
+      if (atomic_load_explicit(&shard->sequence, memory_order_relaxed) ==
+          sequence) {
+        break;
+      }
+    }
+    if (spins >= SPINS_BEFORE_YIELD) {
+      sched_yield();
+    }
+  }
+
+  if (slot >= 0) {
+    // the object can't be released before the read section ends
+    if (acquire != NULL) {
+      acquire(object_of(value_words));
+    }
+    mark_referenced(shard, (size_t)slot);
+    memcpy(value, value_words, table->value_size);
+    atomic_fetch_add_explicit(&shard->hits, 1, memory_order_relaxed);
+  } else {
+    atomic_fetch_add_explicit(&shard->misses, 1, memory_order_relaxed);
+  }
+
+  epoch_exit();
+  return slot >= 0;
+}
+
+// returns an empty slot of the probe window or the slot to evict
+static size_t choose_slot(const struct concurrent_table *table,
+                          struct concurrent_table_shard *shard,
+                          uint64_t hash) {
+  size_t window = window_of(shard);
+
+  for (size_t position = 0; position < window; position++) {
+    size_t slot = slot_at(shard, hash, position);
+    if (atomic_load_explicit(&shard->tags[slot], memory_order_relaxed) == 0) {
+      return slot;
+    }
+  }
+
+  // the hand clears the reference bits until it finds a slot without one,
+  // which it finds within two rounds
+  for (size_t i = 0;; i++) {
+    size_t position = (shard->clock_hand + i) % window;
+    size_t slot = slot_at(shard, hash, position);
+    if (!atomic_exchange_explicit(&shard->referenced[slot], 0,
+                                  memory_order_relaxed) ||
+        i >= 2 * window) {
+      shard->clock_hand = (position + 1) % window;
+      return slot;
+    }
+  }
+}
+
+int concurrent_table_insert(struct concurrent_table *table,
+                            char *error_message, const void *key,
+                            const void *value, void *existing,
+                            concurrent_table_acquire acquire) {
+  uint64_t key_words[WORDS(CONCURRENT_TABLE_MAX_KEY_SIZE)] = {0};
+  uint64_t value_words[WORDS(CONCURRENT_TABLE_MAX_VALUE_SIZE)] = {0};
+  int result = GENERIC_ERROR;
+
+  memcpy(key_words, key, table->key_size);
+  uint64_t hash = hash_key(table, key_words);
+  struct concurrent_table_shard *shard = shard_of(table, hash);
+
+  // an evicted object must not be released before its slot is overwritten
+  if (epoch_enter(error_message) != SUCCESS) {
+    return GENERIC_ERROR;
+  }
+  pthread_mutex_lock(&shard->lock);
+
+  if (find_slot(table, shard, key_words, hash, value_words) >= 0) {
+    if (acquire != NULL) {
+      acquire(object_of(value_words));
+    }
+    memcpy(existing, value_words, table->value_size);
+    result = CONCURRENT_TABLE_EXISTS;
+    goto end_concurrent_table_insert;
+  }
+
+  size_t slot = choose_slot(table, shard, hash);
+  atomic_ullong *words = slot_words(table, shard, slot);
+  int evicted = atomic_load_explicit(&shard->tags[slot],
+                                     memory_order_relaxed) != 0;
+  if (evicted && table->release != NULL) {
+    uint64_t evicted_word = atomic_load_explicit(&words[table->key_words],
+                                                 memory_order_relaxed);
+    if (epoch_retire(error_message, object_of(&evicted_word),
+                     table->release) != SUCCESS) {
+      goto end_concurrent_table_insert;
+    }
+  }
+
+  memcpy(value_words, value, table->value_size);
+  unsigned int sequence =
+      atomic_load_explicit(&shard->sequence, memory_order_relaxed);
+  atomic_store_explicit(&shard->sequence, sequence + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&shard->tags[slot], hash, memory_order_relaxed);
+  for (size_t i = 0; i < table->key_words; i++) {
+    atomic_store_explicit(&words[i], key_words[i], memory_order_relaxed);
+  }
+  for (size_t i = 0; i < table->value_words; i++) {
+    atomic_store_explicit(&words[table->key_words + i], value_words[i],
+                          memory_order_relaxed);
+  }
+  atomic_store_explicit(&shard->referenced[slot], 0, memory_order_relaxed);
+  atomic_store_explicit(&shard->sequence, sequence + 2, memory_order_release);
+
+  if (evicted) {
+    atomic_fetch_add_explicit(&shard->evictions, 1, memory_order_relaxed);
+  } else {
+    atomic_fetch_add_explicit(&shard->entries, 1, memory_order_relaxed);
+  }
+  atomic_fetch_add_explicit(&shard->inserts, 1, memory_order_relaxed);
+  result = CONCURRENT_TABLE_INSERTED;
+
+end_concurrent_table_insert:
+  pthread_mutex_unlock(&shard->lock);
+  epoch_exit();
+  return result;
+}
+
+void concurrent_table_shard_stats(const struct concurrent_table *table,
+                                  const int shard_index,
+                                  struct concurrent_table_shard_stats *stats) {
+  const struct concurrent_table_shard *shard = &table->shards[shard_index];
+
+  stats->hits = atomic_load_explicit(&shard->hits, memory_order_relaxed);
+  stats->misses = atomic_load_explicit(&shard->misses, memory_order_relaxed);
+  stats->inserts = atomic_load_explicit(&shard->inserts, memory_order_relaxed);
+  stats->evictions =
+      atomic_load_explicit(&shard->evictions, memory_order_relaxed);
+  stats->entries = atomic_load_explicit(&shard->entries, memory_order_relaxed);
+  stats->capacity = shard->slot_count;
+}
+
+void concurrent_table_stats(const struct concurrent_table *table,
+                            struct concurrent_table_shard_stats *stats) {
+  memset(stats, 0, sizeof(struct concurrent_table_shard_stats));
+
+  for (int i = 0; i < CONCURRENT_TABLE_SHARD_COUNT; i++) {
+    struct concurrent_table_shard_stats shard_stats;
+    concurrent_table_shard_stats(table, i, &shard_stats);
+    stats->hits += shard_stats.hits;
+    stats->misses += shard_stats.misses;
+    stats->inserts += shard_stats.inserts;
+    stats->evictions += shard_stats.evictions;
+    stats->entries += shard_stats.entries;
+    stats->capacity += shard_stats.capacity;
+  }
+}
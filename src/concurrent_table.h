@@ -0,0 +1,134 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "epoch.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CONCURRENT_TABLE_SHARD_COUNT 16
+// a key is stored in one of the slots following its hash
+#define CONCURRENT_TABLE_PROBE_LIMIT 16
+#define CONCURRENT_TABLE_MAX_KEY_SIZE 256
+#define CONCURRENT_TABLE_MAX_VALUE_SIZE 256
+
+#define CONCURRENT_TABLE_INSERTED 1
+#define CONCURRENT_TABLE_EXISTS 0
+
+// takes another reference of a value that is an object, e.g. EVP_PKEY_up_ref
+typedef int (*concurrent_table_acquire)(void *object);
+
+struct concurrent_table_shard_stats {
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long inserts;
+  unsigned long long evictions;
+  unsigned long long entries;
+  unsigned long long capacity;
+};
+
+// Writers of a shard hold its lock and increment sequence before and after
+// they change a slot, so that readers don't take any lock: they copy the slots
+// and retry if sequence was odd or changed in the meantime.
+struct concurrent_table_shard {
+  _Alignas(64) atomic_uint sequence;
+  pthread_mutex_t lock;
+  size_t slot_count;
+  // position of the CLOCK hand within the probe window
+  size_t clock_hand;
+  // hash | 1 of the key in the slot, 0 if the slot is empty
+  atomic_ullong *tags;
+  // key and value words of every slot
+  atomic_ullong *words;
+  // the CLOCK reference bits, set by readers on a hit
+  atomic_uchar *referenced;
+
+  atomic_ullong hits;
+  atomic_ullong misses;
+  atomic_ullong inserts;
+  atomic_ullong evictions;
+  atomic_ullong entries;
+};
+
+// A fixed capacity hash table with open addressing, for caches that are read
+// by many threads. Keys and values are copied into the table. If release is
+// set, values are pointers to objects that the table holds a reference of,
+// which is released with epoch based reclamation once the value is evicted
+// and no reader can access it anymore.
+struct concurrent_table {
+  struct concurrent_table_shard shards[CONCURRENT_TABLE_SHARD_COUNT];
+  size_t key_size;
+  size_t key_words;
+  size_t value_size;
+  size_t value_words;
+  uint64_t hash_seed;
+  epoch_release release;
+};
+
+struct concurrent_table *concurrent_table_new(char *error_message,
+                                              const size_t capacity,
+                                              const size_t key_size,
+                                              const size_t value_size,
+                                              epoch_release release);
+
+// Frees the table and releases all values. No other thread may use it
+// anymore, e.g. because it was retired with epoch_retire.
+void concurrent_table_free(void *table);
+
+// returns the number of bytes that a table of the capacity allocates
+size_t concurrent_table_memory_size(const size_t capacity,
+                                    const size_t key_size,
+                                    const size_t value_size);
+
+// Copies the value of the key to value and returns 1, or returns 0 if the key
+// is not in the table. For tables of objects, acquire is called on the object
+// before the object can be released.
+int concurrent_table_get(struct concurrent_table *table, char *error_message,
+                         const void *key, void *value,
+                         concurrent_table_acquire acquire);
+
+// Adds the key with the value and returns CONCURRENT_TABLE_INSERTED. For
+// tables of objects, the table takes over the reference of the caller. If the
+// key is in the table already, its value is copied to existing, acquired like
+// in concurrent_table_get and CONCURRENT_TABLE_EXISTS is returned. If the probe
+// window of the key is full, the first value whose reference bit is not set is
+// evicted (CLOCK).
+int concurrent_table_insert(struct concurrent_table *table,
+                            char *error_message, const void *key,
+                            const void *value, void *existing,
+                            concurrent_table_acquire acquire);
+
+void concurrent_table_shard_stats(const struct concurrent_table *table,
+                                  const int shard_index,
+                                  struct concurrent_table_shard_stats *stats);
+
+// sums up the stats of all shards
+void concurrent_table_stats(const struct concurrent_table *table,
+                            struct concurrent_table_shard_stats *stats);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -23,6 +23,10 @@
 extern "C" {
 #endif
 
+// the order of P-521, the largest supported curve, has 66 bytes. It is a macro,
+// so that it can size arrays.
+#define MAX_ORDER_LEN 66
+
 extern const int8_t SUCCESS;
 extern const int8_t FAILURE;
 extern const int8_t GENERIC_ERROR;
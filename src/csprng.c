@@ -0,0 +1,192 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// getrandom and getentropy are not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+
+#include "openssl/include/openssl/crypto.h"
+
+#include "constants.h"
+#include "csprng.h"
+
+// "expand 32-byte k"
+static const uint32_t sigma[4] = {0x61707865, 0x3320646e, 0x79622d32,
+                                  0x6b206574};
+
+// incremented in the child after every fork, so that each generator notices
+// that its state was copied
+static atomic_ulong fork_generation = 0;
+static pthread_once_t fork_handler_registered = PTHREAD_ONCE_INIT;
+
+static void count_fork(void) { atomic_fetch_add(&fork_generation, 1); }
+
+static void register_fork_handler(void) {
+  pthread_atfork(NULL, NULL, count_fork);
+}
+
+static inline uint32_t rotate(const uint32_t value, const int bits) {
+  return (value << bits) | (value >> (32 - bits));
+}
+
+#define QUARTER_ROUND(a, b, c, d)                                              \
+  a += b;                                                                      \
+  d = rotate(d ^ a, 16);                                                       \
+  c += d;                                                                      \
+  b = rotate(b ^ c, 12);                                                       \
+  a += b;                                                                      \
+  d = rotate(d ^ a, 8);                                                        \
+  c += d;                                                                      \
+  b = rotate(b ^ c, 7);
+
+void chacha20_block(unsigned char out[CHACHA20_BLOCK_LEN],
+                    const uint32_t key[8], const uint32_t counter,
+                    const uint32_t nonce[3]) {
+  uint32_t input[16], x[16];
+
+  memcpy(input, sigma, sizeof(sigma));
+  memcpy(input + 4, key, 8 * sizeof(uint32_t));
+  input[12] = counter;
+  memcpy(input + 13, nonce, 3 * sizeof(uint32_t));
+  memcpy(x, input, sizeof(x));
+
+  for (int i = 0; i < 10; i++) {
+    QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+    QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+    QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+    QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+    QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+    QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+    QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+    QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+  }
+
+  // the words are serialized in little-endian order
+  for (int i = 0; i < 16; i++) {
+    uint32_t word = x[i] + input[i];
+    out[4 * i] = (unsigned char)word;
+    out[4 * i + 1] = (unsigned char)(word >> 8);
+    out[4 * i + 2] = (unsigned char)(word >> 16);
+    out[4 * i + 3] = (unsigned char)(word >> 24);
+  }
+  OPENSSL_cleanse(x, sizeof(x));
+  OPENSSL_cleanse(input, sizeof(input));
+}
+
+static int read_entropy(char *error_message, unsigned char out[],
+                        const size_t len) {
+#ifdef __linux__
+  size_t read_len = 0;
+
+  while (read_len < len) {
+    ssize_t ret = getrandom(out + read_len, len - read_len, 0);
+    if (ret < 0 && errno != EINTR) {
+      snprintf(error_message, 256, "Could not read entropy: %s\n",
+               strerror(errno));
+      return FAILURE;
+    }
+    read_len += ret > 0 ? (size_t)ret : 0;
+  }
+#else
+  if (getentropy(out, len) != 0) {
+    snprintf(error_message, 256, "Could not read entropy: %s\n",
+             strerror(errno));
+    return FAILURE;
+  }
+#endif
+  return SUCCESS;
+}
+
+// XORs fresh entropy into the key, a key that was already derived from
+// entropy stays at least as strong if the new entropy is weak
+static int reseed(struct csprng *csprng, char *error_message) {
+  uint32_t entropy[8];
+
+  if (read_entropy(error_message, (unsigned char *)entropy, sizeof(entropy)) !=
+      SUCCESS) {
+    return FAILURE;
+  }
+  for (int i = 0; i < 8; i++) {
+    csprng->key[i] ^= entropy[i];
+  }
+  OPENSSL_cleanse(entropy, sizeof(entropy));
+
+  csprng->output_since_seed = 0;
+  csprng->fork_generation = atomic_load(&fork_generation);
+  csprng->seeded = 1;
+  // the rest of the buffer was generated from the old key
+  csprng->position = CSPRNG_BUFFER_LEN;
+  return SUCCESS;
+}
+
+static void refill(struct csprng *csprng) {
+  static const uint32_t nonce[3] = {0, 0, 0};
+
+  for (uint32_t i = 0; i < CSPRNG_BUFFER_LEN / CHACHA20_BLOCK_LEN; i++) {
+    chacha20_block(csprng->buffer + i * CHACHA20_BLOCK_LEN, csprng->key, i,
+                   nonce);
+  }
+  memcpy(csprng->key, csprng->buffer, sizeof(csprng->key));
+  OPENSSL_cleanse(csprng->buffer, sizeof(csprng->key));
+  csprng->position = sizeof(csprng->key);
+}
+
+int csprng_bytes(struct csprng *csprng, char *error_message,
+                 unsigned char out[], const size_t len) {
+  size_t written = 0;
+
+  pthread_once(&fork_handler_registered, register_fork_handler);
+
+  if (!csprng->seeded ||
+      csprng->fork_generation != atomic_load(&fork_generation) ||
+      csprng->output_since_seed >= CSPRNG_RESEED_INTERVAL) {
+    if (reseed(csprng, error_message) != SUCCESS) {
+      return FAILURE;
+    }
+  }
+
+  while (written < len) {
+    if (csprng->position == CSPRNG_BUFFER_LEN) {
+      refill(csprng);
+    }
+
+    size_t available = CSPRNG_BUFFER_LEN - csprng->position;
+    size_t chunk = len - written < available ? len - written : available;
+
+    memcpy(out + written, csprng->buffer + csprng->position, chunk);
+    // bytes that were handed out are not kept
+    OPENSSL_cleanse(csprng->buffer + csprng->position, chunk);
+    csprng->position += chunk;
+    written += chunk;
+  }
+  csprng->output_since_seed += len;
+
+  return SUCCESS;
+}
+
+void csprng_cleanse(struct csprng *csprng) {
+  OPENSSL_cleanse(csprng, sizeof(struct csprng));
+}
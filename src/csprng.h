@@ -0,0 +1,66 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHACHA20_BLOCK_LEN 64
+// 16 blocks are generated at once, the first 32 bytes become the next key
+#define CSPRNG_BUFFER_LEN (16 * CHACHA20_BLOCK_LEN)
+// fresh entropy is mixed into the key after this many bytes of output
+#define CSPRNG_RESEED_INTERVAL (1 << 20)
+
+/**
+ * A ChaCha20 based generator with fast key erasure: every refill of the buffer
+ * replaces the key with the first bytes of the output, so that bytes that were
+ * handed out can't be reconstructed from the state. It is seeded from the
+ * entropy of the kernel (getrandom) and reseeded periodically and after a
+ * fork, so that parent and child never return the same bytes.
+ *
+ * A generator is owned by one thread, see thread_random_bytes.
+ */
+struct csprng {
+  uint32_t key[8];
+  unsigned char buffer[CSPRNG_BUFFER_LEN];
+  // position of the next unused byte of the buffer
+  size_t position;
+  unsigned long long output_since_seed;
+  unsigned long fork_generation;
+  int seeded;
+};
+
+// the block function of RFC 8439 with a 32 bit counter and a 96 bit nonce
+void chacha20_block(unsigned char out[CHACHA20_BLOCK_LEN],
+                    const uint32_t key[8], const uint32_t counter,
+                    const uint32_t nonce[3]);
+
+int csprng_bytes(struct csprng *csprng, char *error_message,
+                 unsigned char out[], const size_t len);
+
+// erases the state, the next call seeds the generator again
+void csprng_cleanse(struct csprng *csprng);
+
+#ifdef __cplusplus
+extern
+}
+#endif
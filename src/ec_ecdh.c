@@ -0,0 +1,382 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/crypto.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_ecdh.h"
+#include "ec_key_derivation.h"
+#include "memory_budget.h"
+#include "side_channel.h"
+#include "thread_context.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+static const int P256_CURVE_BYTE_LENGTH = 32;
+#define MAX_KEY_POOL_CAPACITY 65536
+
+struct ecdh_result p256_ecdh(const char private_key_data[],
+                             const char peer_public_key_data[]) {
+  return ecdh((const unsigned char *)private_key_data,
+              (const unsigned char *)peer_public_key_data,
+              NID_X9_62_prime256v1, P256_CURVE_BYTE_LENGTH);
+}
+
+int p256_ecdh_batch(struct ecdh_result results[], const char private_keys[],
+                    const char peer_public_keys[], const int count) {
+  return ecdh_batch(results, (const unsigned char *)private_keys,
+                    (const unsigned char *)peer_public_keys, count,
+                    NID_X9_62_prime256v1, P256_CURVE_BYTE_LENGTH);
+}
+
+// Computes the x coordinate of d * Q, where d is the private key and Q is the
+// public key of the peer, according to SEC1v2 section 3.3.1. The public key
+// must be a point on the curve, which also rules out the point at infinity.
+//
+// http://www.secg.org/sec1-v2.pdf
+struct ecdh_result ecdh(const unsigned char private_key_data[],
+                        const unsigned char peer_public_key_data[],
+                        const int curve_nid, const int curve_byte_length) {
+  struct ecdh_result result = {.shared_secret = {0}, .error_message = {0}};
+
+  const EC_GROUP *group = NULL;
+  BN_CTX *bn_context = NULL;
+  EC_POINT *Q = NULL;
+  // 0x04 || x || y
+  unsigned char Q_octet[133];
+  size_t Q_octet_len = 2 * curve_byte_length + 1;
+
+  // group and BIGNUM context are owned by the thread
+  if ((group = thread_group(result.error_message, curve_nid)) == NULL ||
+      (bn_context = thread_bn_context(result.error_message)) == NULL) {
+    goto end_ecdh;
+  }
+
+  Q_octet[0] = POINT_CONVERSION_UNCOMPRESSED;
+  memcpy(Q_octet + 1, peer_public_key_data, 2 * curve_byte_length);
+  if ((Q = EC_POINT_new(group)) == NULL) {
+    set_error_message(result.error_message,
+                      "Could not allocate memory for point Q: ");
+    goto end_ecdh;
+  }
+  if (EC_POINT_oct2point(group, Q, Q_octet, Q_octet_len, bn_context) !=
+      SUCCESS) {
+    set_error_message(result.error_message,
+                      "Public key of peer is not a point on the curve: ");
+    goto end_ecdh;
+  }
+
+  ecdh_with_point(&result, private_key_data, Q, group, bn_context,
+                  curve_byte_length);
+
+end_ecdh:
+  EC_POINT_free(Q);
+  return result;
+}
+
+void ecdh_with_point(struct ecdh_result *result,
+                     const unsigned char private_key_data[], const EC_POINT *Q,
+                     const EC_GROUP *group, BN_CTX *bn_context,
+                     const int curve_byte_length) {
+  BIGNUM *d = NULL, *x = NULL;
+  EC_POINT *S = NULL;
+
+  if ((d = BN_bin2bn(private_key_data, curve_byte_length, NULL)) == NULL) {
+    set_error_message(result->error_message,
+                      "Could not convert private key to BIGNUM: ");
+    goto end_ecdh_with_point;
+  }
+  side_channel_mark_secret(d);
+  if (BN_is_zero(d) || BN_cmp(d, EC_GROUP_get0_order(group)) >= 0) {
+    snprintf(result->error_message, 256,
+             "Private key must be between 1 and n - 1\n");
+    goto end_ecdh_with_point;
+  }
+
+  if ((S = EC_POINT_new(group)) == NULL) {
+    set_error_message(result->error_message,
+                      "Could not allocate memory for point S: ");
+    goto end_ecdh_with_point;
+  }
+  if (side_channel_point_mul(S, result->error_message, EC_OPERATION_ECDH,
+                             group, NULL, Q, d, bn_context) != SUCCESS) {
+    goto end_ecdh_with_point;
+  }
+  if (EC_POINT_is_at_infinity(group, S)) {
+    snprintf(result->error_message, 256,
+             "Shared secret is the point at infinity\n");
+    goto end_ecdh_with_point;
+  }
+
+  if ((x = BN_new()) == NULL ||
+      EC_POINT_get_affine_coordinates(group, S, x, NULL, bn_context) !=
+          SUCCESS ||
+      BN_bn2binpad(x, (unsigned char *)result->shared_secret,
+                   curve_byte_length) < 0) {
+    set_error_message(result->error_message,
+                      "Could not get x coordinate of shared point: ");
+    goto end_ecdh_with_point;
+  }
+
+end_ecdh_with_point:
+  BN_clear_free(x);
+  EC_POINT_clear_free(S);
+  BN_clear_free(d);
+}
+
+struct ecdh_batch {
+  struct ecdh_result *results;
+  const unsigned char *private_keys;
+  const unsigned char *peer_public_keys;
+  int curve_nid;
+  int curve_byte_length;
+  atomic_int computed;
+};
+
+static void compute_shared_secret_range(void *context, size_t begin,
+                                        size_t end) {
+  struct ecdh_batch *batch = context;
+  size_t key_len = batch->curve_byte_length;
+  int computed = 0;
+
+  for (size_t i = begin; i < end; i++) {
+    batch->results[i] = ecdh(batch->private_keys + i * key_len,
+                             batch->peer_public_keys + 2 * i * key_len,
+                             batch->curve_nid, batch->curve_byte_length);
+    computed += strlen(batch->results[i].error_message) == 0;
+  }
+
+  atomic_fetch_add(&batch->computed, computed);
+}
+
+// Computes the shared secrets of the private keys and peer public keys, which
+// are stored one after another, on the worker pool. Returns the number of
+// computed secrets.
+int ecdh_batch(struct ecdh_result results[],
+               const unsigned char private_keys[],
+               const unsigned char peer_public_keys[], const int count,
+               const int curve_nid, const int curve_byte_length) {
+  struct ecdh_batch batch = {.results = results,
+                             .private_keys = private_keys,
+                             .peer_public_keys = peer_public_keys,
+                             .curve_nid = curve_nid,
+                             .curve_byte_length = curve_byte_length};
+  atomic_init(&batch.computed, 0);
+
+  if (count <= 0) {
+    return 0;
+  }
+  worker_pool_run(count, compute_shared_secret_range, &batch);
+
+  return atomic_load(&batch.computed);
+}
+
+static int generate_key_pool_entry(struct p256_ecdh_key_pair *key_pair,
+                                   char *error_message, const EC_GROUP *group,
+                                   BN_CTX *bn_context) {
+  return generate_key_pair((unsigned char *)key_pair->private_key,
+                           (unsigned char *)key_pair->public_key, error_message,
+                           group, bn_context, P256_CURVE_BYTE_LENGTH);
+}
+
+// Fills the pool up to its capacity and waits until the number of key pairs
+// drops to the low watermark again. If a key pair can't be generated, the
+// thread waits for the next key pair to be taken before it tries again. If the
+// group or the BIGNUM context can't be created, the thread ends and the key
+// pairs are generated by the callers of p256_ecdh_key_pool_take.
+static void *refill_key_pool(void *context) {
+  struct p256_ecdh_key_pool *pool = context;
+  struct p256_ecdh_key_pair key_pair;
+  char error_message[256];
+  EC_GROUP *group = EC_GROUP_new_by_curve_name(pool->curve_nid);
+  BN_CTX *bn_context = BN_CTX_new();
+  int filling = 1;
+  // set when a generation failed, cleared by the next refill signal
+  int failed = 0;
+
+  if (group == NULL || bn_context == NULL) {
+    goto end_refill_key_pool;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  while (!pool->stopping) {
+    if (!failed && pool->count <= ECDH_KEY_POOL_LOW_WATERMARK(pool->capacity)) {
+      filling = 1;
+    }
+    if (failed || !filling || pool->count == pool->capacity) {
+      filling = 0;
+      pthread_cond_wait(&pool->refill, &pool->lock);
+      failed = 0;
+      continue;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    int generated = generate_key_pool_entry(&key_pair, error_message, group,
+                                            bn_context) == SUCCESS;
+    pthread_mutex_lock(&pool->lock);
+
+    if (!generated) {
+      failed = 1;
+      continue;
+    }
+    if (pool->count < pool->capacity) {
+      pool->key_pairs[pool->count++] = key_pair;
+      atomic_fetch_add(&pool->generated, 1);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+end_refill_key_pool:
+  OPENSSL_cleanse(&key_pair, sizeof(key_pair));
+  BN_CTX_free(bn_context);
+  EC_GROUP_free(group);
+  return NULL;
+}
+
+static size_t key_pool_size(size_t capacity) {
+  return sizeof(struct p256_ecdh_key_pool) +
+         capacity * sizeof(struct p256_ecdh_key_pair);
+}
+
+int p256_ecdh_key_pool_create(struct p256_ecdh_key_pool **pool,
+                              char *error_message, const int capacity) {
+  if (capacity <= 0 || capacity > MAX_KEY_POOL_CAPACITY) {
+    snprintf(error_message, 256,
+             "Capacity of key pool must be between 1 and %d\n",
+             MAX_KEY_POOL_CAPACITY);
+    return FAILURE;
+  }
+
+  if (memory_budget_reserve(error_message, MEMORY_SUBSYSTEM_ECDH_KEY_POOLS,
+                            key_pool_size(capacity)) != SUCCESS) {
+    return FAILURE;
+  }
+
+  struct p256_ecdh_key_pool *new_pool =
+      calloc(1, sizeof(struct p256_ecdh_key_pool));
+  if (new_pool == NULL ||
+      (new_pool->key_pairs =
+           calloc(capacity, sizeof(struct p256_ecdh_key_pair))) == NULL) {
+    snprintf(error_message, 256, "Could not allocate memory for key pool\n");
+    free(new_pool);
+    memory_budget_release(MEMORY_SUBSYSTEM_ECDH_KEY_POOLS,
+                          key_pool_size(capacity));
+    return FAILURE;
+  }
+  new_pool->capacity = capacity;
+  new_pool->curve_nid = NID_X9_62_prime256v1;
+  pthread_mutex_init(&new_pool->lock, NULL);
+  pthread_cond_init(&new_pool->refill, NULL);
+
+  if (pthread_create(&new_pool->thread, NULL, refill_key_pool, new_pool) !=
+      0) {
+    snprintf(error_message, 256, "Could not start thread of key pool\n");
+    pthread_cond_destroy(&new_pool->refill);
+    pthread_mutex_destroy(&new_pool->lock);
+    free(new_pool->key_pairs);
+    free(new_pool);
+    memory_budget_release(MEMORY_SUBSYSTEM_ECDH_KEY_POOLS,
+                          key_pool_size(capacity));
+    return FAILURE;
+  }
+
+  *pool = new_pool;
+  return SUCCESS;
+}
+
+void p256_ecdh_key_pool_free(struct p256_ecdh_key_pool *pool) {
+  if (pool == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  pool->stopping = 1;
+  pthread_cond_signal(&pool->refill);
+  pthread_mutex_unlock(&pool->lock);
+  pthread_join(pool->thread, NULL);
+
+  OPENSSL_cleanse(pool->key_pairs,
+                  pool->capacity * sizeof(struct p256_ecdh_key_pair));
+  pthread_cond_destroy(&pool->refill);
+  pthread_mutex_destroy(&pool->lock);
+  memory_budget_release(MEMORY_SUBSYSTEM_ECDH_KEY_POOLS,
+                        key_pool_size(pool->capacity));
+  free(pool->key_pairs);
+  free(pool);
+}
+
+// Takes a key pair of the pool. If the pool is empty, the key pair is
+// generated on the calling thread.
+int p256_ecdh_key_pool_take(struct p256_ecdh_key_pool *pool,
+                            char *error_message,
+                            struct p256_ecdh_key_pair *key_pair) {
+  int taken = 0;
+
+  pthread_mutex_lock(&pool->lock);
+  if (pool->count > 0) {
+    pool->count--;
+    *key_pair = pool->key_pairs[pool->count];
+    OPENSSL_cleanse(&pool->key_pairs[pool->count],
+                    sizeof(struct p256_ecdh_key_pair));
+    taken = 1;
+  }
+  if (pool->count <= ECDH_KEY_POOL_LOW_WATERMARK(pool->capacity)) {
+    pthread_cond_signal(&pool->refill);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  atomic_fetch_add(&pool->taken, 1);
+  if (taken) {
+    return SUCCESS;
+  }
+  atomic_fetch_add(&pool->misses, 1);
+
+  const EC_GROUP *group = NULL;
+  BN_CTX *bn_context = NULL;
+
+  if ((group = thread_group(error_message, pool->curve_nid)) == NULL ||
+      (bn_context = thread_bn_context(error_message)) == NULL) {
+    return FAILURE;
+  }
+  return generate_key_pool_entry(key_pair, error_message, group, bn_context);
+}
+
+struct ecdh_key_pool_stats
+p256_ecdh_key_pool_stats(struct p256_ecdh_key_pool *pool) {
+  pthread_mutex_lock(&pool->lock);
+
+  struct ecdh_key_pool_stats stats = {
+      .available = pool->count,
+      .capacity = pool->capacity,
+      .generated = atomic_load(&pool->generated),
+      .taken = atomic_load(&pool->taken),
+      .misses = atomic_load(&pool->misses)};
+
+  pthread_mutex_unlock(&pool->lock);
+
+  return stats;
+}
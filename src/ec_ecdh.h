@@ -0,0 +1,71 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "openssl/include/openssl/ec.h"
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the pool is refilled once half of its keys have been taken
+#define ECDH_KEY_POOL_LOW_WATERMARK(capacity) ((capacity) / 2)
+
+// Ephemeral key pairs that are generated ahead of time by a background thread.
+// Every key pair is handed out once and cleared from the pool afterwards.
+struct p256_ecdh_key_pool {
+  struct p256_ecdh_key_pair *key_pairs;
+  size_t capacity;
+  size_t count;
+  int curve_nid;
+
+  pthread_mutex_t lock;
+  pthread_cond_t refill;
+  pthread_t thread;
+  int stopping;
+
+  _Atomic unsigned long long generated;
+  _Atomic unsigned long long taken;
+  _Atomic unsigned long long misses;
+};
+
+struct ecdh_result ecdh(const unsigned char private_key_data[],
+                        const unsigned char peer_public_key_data[],
+                        const int curve_nid, const int curve_byte_length);
+
+// computes the shared secret with a public key that has already been validated
+void ecdh_with_point(struct ecdh_result *result,
+                     const unsigned char private_key_data[], const EC_POINT *Q,
+                     const EC_GROUP *group, BN_CTX *bn_context,
+                     const int curve_byte_length);
+
+int ecdh_batch(struct ecdh_result results[],
+               const unsigned char private_keys[],
+               const unsigned char peer_public_keys[], const int count,
+               const int curve_nid, const int curve_byte_length);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -58,6 +58,17 @@ int create_public_key(EVP_PKEY **key, char *error_message,
   return ret;
 }
 
+int create_public_key_from_encoding(EVP_PKEY **key, char *error_message,
+                                    const unsigned char encoded_key[],
+                                    size_t encoded_key_len,
+                                    const char *group_name) {
+  OSSL_PARAM_BLD *param_bld = OSSL_PARAM_BLD_new();
+  OSSL_PARAM_BLD_push_octet_string(param_bld, OSSL_PKEY_PARAM_PUB_KEY,
+                                   encoded_key, encoded_key_len);
+
+  return create_key(key, error_message, group_name, param_bld);
+}
+
 int create_key(EVP_PKEY **key, char *error_message, const char *group_name,
                OSSL_PARAM_BLD *param_bld) {
   int ret = FAILURE;
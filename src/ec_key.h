@@ -34,6 +34,12 @@ int create_public_key(EVP_PKEY **key, char *error_message,
                       const unsigned char public_key_data[],
                       uint8_t public_key_len, const char *group_name);
 
+// imports a public key that is encoded as in SEC 1, compressed or not
+int create_public_key_from_encoding(EVP_PKEY **key, char *error_message,
+                                    const unsigned char encoded_key[],
+                                    size_t encoded_key_len,
+                                    const char *group_name);
+
 int create_key(EVP_PKEY **key, char *error_message, const char *group_name,
                OSSL_PARAM_BLD *param_bld);
 
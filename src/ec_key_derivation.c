@@ -0,0 +1,318 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/crypto.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_key_derivation.h"
+#include "side_channel.h"
+#include "thread_context.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+static const int P256_CURVE_BYTE_LENGTH = 32;
+
+struct public_key_result p256_derive_public_key(const char private_key_data[]) {
+  struct public_key_result result = {.public_key = {0}, .error_message = {0}};
+
+  derive_public_keys(&result, (const unsigned char *)private_key_data, 1,
+                     NID_X9_62_prime256v1, P256_CURVE_BYTE_LENGTH);
+
+  return result;
+}
+
+int p256_derive_public_keys(struct public_key_result results[],
+                            const char private_keys[], const int count) {
+  return derive_public_keys(results, (const unsigned char *)private_keys,
+                            count, NID_X9_62_prime256v1,
+                            P256_CURVE_BYTE_LENGTH);
+}
+
+int p256_generate_keypairs(char private_keys[], char public_keys[],
+                           char *error_message, const int count) {
+  return generate_key_pairs((unsigned char *)private_keys,
+                            (unsigned char *)public_keys, error_message, count,
+                            NID_X9_62_prime256v1, P256_CURVE_BYTE_LENGTH);
+}
+
+// Computes d * G with the constant time kernel, which uses the tables that
+// OpenSSL precomputes for G, for P-256 a built-in table of multiples of G.
+static int multiply_generator(unsigned char public_key[], char *error_message,
+                              const BIGNUM *d, const EC_GROUP *group,
+                              BN_CTX *bn_context,
+                              const int curve_byte_length) {
+  int ret = FAILURE;
+  EC_POINT *Q = NULL;
+  // 0x04 || x || y
+  unsigned char Q_octet[133];
+  size_t Q_octet_len = 2 * curve_byte_length + 1;
+
+  if ((Q = EC_POINT_new(group)) == NULL) {
+    set_error_message(error_message, "Could not allocate memory for point Q: ");
+    goto end_multiply_generator;
+  }
+  if (side_channel_point_mul(Q, error_message, EC_OPERATION_KEY_GENERATION,
+                             group, d, NULL, NULL, bn_context) != SUCCESS) {
+    goto end_multiply_generator;
+  }
+  if (EC_POINT_point2oct(group, Q, POINT_CONVERSION_UNCOMPRESSED, Q_octet,
+                         Q_octet_len, bn_context) != Q_octet_len) {
+    set_error_message(error_message, "Could not calculate public key: ");
+    goto end_multiply_generator;
+  }
+  memcpy(public_key, Q_octet + 1, 2 * curve_byte_length);
+  ret = SUCCESS;
+
+end_multiply_generator:
+  EC_POINT_free(Q);
+  return ret;
+}
+
+int derive_public_key(unsigned char public_key[], char *error_message,
+                      const unsigned char private_key[], const EC_GROUP *group,
+                      BN_CTX *bn_context, const int curve_byte_length) {
+  int ret = FAILURE;
+  BIGNUM *d = NULL;
+
+  if ((d = BN_bin2bn(private_key, curve_byte_length, NULL)) == NULL) {
+    set_error_message(error_message,
+                      "Could not convert private key to BIGNUM: ");
+    goto end_derive_public_key;
+  }
+  side_channel_mark_secret(d);
+  if (BN_is_zero(d) || BN_cmp(d, EC_GROUP_get0_order(group)) >= 0) {
+    snprintf(error_message, 256, "Private key must be between 1 and n - 1\n");
+    goto end_derive_public_key;
+  }
+
+  ret = multiply_generator(public_key, error_message, d, group, bn_context,
+                           curve_byte_length);
+
+end_derive_public_key:
+  BN_clear_free(d);
+  return ret;
+}
+
+// Draws candidates with the bit length of the order from the generator of the
+// thread until one is between 1 and n - 1. For the supported curves less than
+// half of the candidates are rejected.
+static int random_private_key(BIGNUM *d, char *error_message,
+                              const EC_GROUP *group) {
+  const BIGNUM *order = EC_GROUP_get0_order(group);
+  const int order_bits = BN_num_bits(order);
+  const int order_len = BN_num_bytes(order);
+  unsigned char candidate[MAX_ORDER_LEN];
+  int ret = FAILURE;
+
+  if (order_len > MAX_ORDER_LEN) {
+    snprintf(error_message, 256, "Order of the curve is too large\n");
+    return FAILURE;
+  }
+
+  do {
+    if (thread_random_bytes(error_message, candidate, order_len) != SUCCESS) {
+      goto end_random_private_key;
+    }
+    if (order_bits % 8 != 0) {
+      candidate[0] &= (unsigned char)((1 << (order_bits % 8)) - 1);
+    }
+    if (BN_bin2bn(candidate, order_len, d) == NULL) {
+      set_error_message(error_message, "Could not generate private key: ");
+      goto end_random_private_key;
+    }
+  } while (BN_is_zero(d) || BN_cmp(d, order) >= 0);
+  ret = SUCCESS;
+
+end_random_private_key:
+  OPENSSL_cleanse(candidate, sizeof(candidate));
+  return ret;
+}
+
+int generate_key_pair(unsigned char private_key[], unsigned char public_key[],
+                      char *error_message, const EC_GROUP *group,
+                      BN_CTX *bn_context, const int curve_byte_length) {
+  int ret = FAILURE;
+  BIGNUM *d = NULL;
+
+  if ((d = BN_new()) == NULL) {
+    set_error_message(error_message,
+                      "Could not allocate memory for private key: ");
+    goto end_generate_key_pair;
+  }
+  side_channel_mark_secret(d);
+  if (random_private_key(d, error_message, group) != SUCCESS) {
+    goto end_generate_key_pair;
+  }
+
+  if (multiply_generator(public_key, error_message, d, group, bn_context,
+                         curve_byte_length) != SUCCESS) {
+    goto end_generate_key_pair;
+  }
+  if (BN_bn2binpad(d, private_key, curve_byte_length) < 0) {
+    set_error_message(error_message, "Could not convert private key: ");
+    goto end_generate_key_pair;
+  }
+  ret = SUCCESS;
+
+end_generate_key_pair:
+  BN_clear_free(d);
+  return ret;
+}
+
+// The group and the BIGNUM context are those of the thread that processes a
+// chunk of keys, so that the work per key is the multiplication and its
+// conversion to x || y.
+struct key_derivation_batch {
+  struct public_key_result *results;
+  unsigned char *private_keys;
+  unsigned char *public_keys;
+  int curve_nid;
+  int curve_byte_length;
+  atomic_int succeeded;
+  atomic_int failed;
+  char error_message[256];
+};
+
+static int thread_group_context(const EC_GROUP **group, BN_CTX **bn_context,
+                                char *error_message, const int curve_nid) {
+  if ((*group = thread_group(error_message, curve_nid)) == NULL ||
+      (*bn_context = thread_bn_context(error_message)) == NULL) {
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+static void derive_public_key_range(void *context, size_t begin, size_t end) {
+  struct key_derivation_batch *batch = context;
+  size_t key_len = batch->curve_byte_length;
+  const EC_GROUP *group = NULL;
+  BN_CTX *bn_context = NULL;
+  int succeeded = 0;
+
+  memset(&batch->results[begin], 0,
+         (end - begin) * sizeof(struct public_key_result));
+  if (thread_group_context(&group, &bn_context,
+                           batch->results[begin].error_message,
+                           batch->curve_nid) != SUCCESS) {
+    for (size_t i = begin + 1; i < end; i++) {
+      memcpy(batch->results[i].error_message,
+             batch->results[begin].error_message, 256);
+    }
+    goto end_derive_public_key_range;
+  }
+
+  for (size_t i = begin; i < end; i++) {
+    struct public_key_result *result = &batch->results[i];
+    succeeded += derive_public_key((unsigned char *)result->public_key,
+                                   result->error_message,
+                                   batch->private_keys + i * key_len, group,
+                                   bn_context, batch->curve_byte_length) ==
+                 SUCCESS;
+  }
+
+end_derive_public_key_range:
+  atomic_fetch_add(&batch->succeeded, succeeded);
+}
+
+// Derives the public keys of the private keys, which are stored one after
+// another, on the worker pool. Returns the number of derived public keys.
+int derive_public_keys(struct public_key_result results[],
+                       const unsigned char private_keys[], const int count,
+                       const int curve_nid, const int curve_byte_length) {
+  struct key_derivation_batch batch = {
+      .results = results,
+      .private_keys = (unsigned char *)private_keys,
+      .curve_nid = curve_nid,
+      .curve_byte_length = curve_byte_length};
+  atomic_init(&batch.succeeded, 0);
+
+  if (count <= 0) {
+    return 0;
+  }
+  if (count == 1) {
+    derive_public_key_range(&batch, 0, 1);
+  } else {
+    worker_pool_run(count, derive_public_key_range, &batch);
+  }
+
+  return atomic_load(&batch.succeeded);
+}
+
+static void generate_key_pair_range(void *context, size_t begin, size_t end) {
+  struct key_derivation_batch *batch = context;
+  size_t key_len = batch->curve_byte_length;
+  const EC_GROUP *group = NULL;
+  BN_CTX *bn_context = NULL;
+  char error_message[256] = {0};
+
+  if (thread_group_context(&group, &bn_context, error_message,
+                           batch->curve_nid) != SUCCESS) {
+    goto end_generate_key_pair_range;
+  }
+
+  for (size_t i = begin; i < end && !atomic_load(&batch->failed); i++) {
+    if (generate_key_pair(batch->private_keys + i * key_len,
+                          batch->public_keys + 2 * i * key_len, error_message,
+                          group, bn_context,
+                          batch->curve_byte_length) != SUCCESS) {
+      goto end_generate_key_pair_range;
+    }
+  }
+
+end_generate_key_pair_range:
+  // only the first error is reported
+  if (strlen(error_message) > 0 && atomic_exchange(&batch->failed, 1) == 0) {
+    memcpy(batch->error_message, error_message, sizeof(error_message));
+  }
+}
+
+// Generates count key pairs on the worker pool. The private keys and the
+// public keys x || y are stored one after another.
+int generate_key_pairs(unsigned char private_keys[],
+                       unsigned char public_keys[], char *error_message,
+                       const int count, const int curve_nid,
+                       const int curve_byte_length) {
+  struct key_derivation_batch batch = {.private_keys = private_keys,
+                                       .public_keys = public_keys,
+                                       .curve_nid = curve_nid,
+                                       .curve_byte_length = curve_byte_length,
+                                       .error_message = {0}};
+  atomic_init(&batch.failed, 0);
+
+  if (count < 0) {
+    snprintf(error_message, 256, "Number of key pairs must not be negative\n");
+    return FAILURE;
+  }
+  if (count == 0) {
+    return SUCCESS;
+  }
+  worker_pool_run(count, generate_key_pair_range, &batch);
+
+  if (atomic_load(&batch.failed)) {
+    memcpy(error_message, batch.error_message, 256);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#include "openssl/include/openssl/ec.h"
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// derives the public key x || y of a private key between 1 and n - 1
+int derive_public_key(unsigned char public_key[], char *error_message,
+                      const unsigned char private_key[], const EC_GROUP *group,
+                      BN_CTX *bn_context, const int curve_byte_length);
+
+// generates a private key between 1 and n - 1 and the public key x || y of it
+int generate_key_pair(unsigned char private_key[], unsigned char public_key[],
+                      char *error_message, const EC_GROUP *group,
+                      BN_CTX *bn_context, const int curve_byte_length);
+
+int derive_public_keys(struct public_key_result results[],
+                       const unsigned char private_keys[], const int count,
+                       const int curve_nid, const int curve_byte_length);
+
+int generate_key_pairs(unsigned char private_keys[],
+                       unsigned char public_keys[], char *error_message,
+                       const int count, const int curve_nid,
+                       const int curve_byte_length);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -25,6 +25,8 @@
 #include "besu_native_ec.h"
 #include "constants.h"
 #include "ec_key_recovery.h"
+#include "side_channel.h"
+#include "thread_context.h"
 #include "utils.h"
 
 struct key_recovery_result p256_key_recovery(const char data_hash[],
@@ -50,13 +52,13 @@ struct key_recovery_result key_recovery(const char data_hash[],
                                         const int curve_byte_length) {
   struct key_recovery_result result = {.public_key = {0}, .error_message = {0}};
 
-  EC_GROUP *group = NULL;
+  const EC_GROUP *group = NULL;
   const BIGNUM *n = NULL; // curve order
   BIGNUM *r = NULL, *x = NULL, *p = NULL, *e = NULL, *inverse_r = NULL,
          *s = NULL;
   BN_CTX *bn_context = NULL;
-  EC_POINT *R = NULL, *nR = NULL, *sR = NULL, *negative_eG = NULL,
-           *sR_minus_eG = NULL, *Q = NULL;
+  BIGNUM *u1 = NULL, *u2 = NULL;
+  EC_POINT *R = NULL, *nR = NULL, *Q = NULL;
   char *Q_octet = NULL;
 
   int signature_arr_len = curve_byte_length;
@@ -82,15 +84,13 @@ struct key_recovery_result key_recovery(const char data_hash[],
     data_hash_len = curve_byte_length;
   }
 
-  if ((group = EC_GROUP_new_by_curve_name(curve_nid)) == NULL) {
-    set_error_message(result.error_message,
-                      "Could not get EC_GROUP for requested curve: ");
+  // group and BIGNUM context are owned by the thread and reused by the next
+  // recovery
+  if ((group = thread_group(result.error_message, curve_nid)) == NULL) {
     goto end;
   }
 
-  if ((bn_context = BN_CTX_new()) == NULL) {
-    set_error_message(result.error_message,
-                      "Could not allocate memory for BIGNUM context: ");
+  if ((bn_context = thread_bn_context(result.error_message)) == NULL) {
     goto end;
   }
 
@@ -142,21 +142,25 @@ struct key_recovery_result key_recovery(const char data_hash[],
     goto end;
   }
 
-  // 1.4. If nR != point at infinity, then do another iteration of Step 1
-  if ((nR = EC_POINT_new(group)) == NULL) {
-    set_error_message(result.error_message,
-                      "Could not allocate memory for point nR: ");
-    goto end;
-  }
-  if (EC_POINT_mul(group, nR, NULL, R, n, bn_context) != SUCCESS) {
-    set_error_message(result.error_message,
-                      "Could not multiply curve point R with curve order n: ");
-    goto end;
-  }
-  if (!EC_POINT_is_at_infinity(group, nR)) {
-    set_error_message(result.error_message,
-                      "Point nR should be at infinity, but is not: ");
-    goto end;
+  // 1.4. If nR != point at infinity, then do another iteration of Step 1.
+  // On curves with cofactor 1 every point has order n, so nR is always the
+  // point at infinity.
+  if (!BN_is_one(EC_GROUP_get0_cofactor(group))) {
+    if ((nR = EC_POINT_new(group)) == NULL) {
+      set_error_message(result.error_message,
+                        "Could not allocate memory for point nR: ");
+      goto end;
+    }
+    if (side_channel_point_mul(nR, result.error_message,
+                               EC_OPERATION_KEY_RECOVERY, group, NULL, R, n,
+                               bn_context) != SUCCESS) {
+      goto end;
+    }
+    if (!EC_POINT_is_at_infinity(group, nR)) {
+      set_error_message(result.error_message,
+                        "Point nR should be at infinity, but is not: ");
+      goto end;
+    }
   }
 
   // 1.5. Compute e from M using Steps 2 and 3 of ECDSA signature verification.
@@ -169,7 +173,9 @@ struct key_recovery_result key_recovery(const char data_hash[],
 
   // 1.6. For k from 1 to 2 do the following. (loop is outside this function)
   // 1.6.1. Compute a candidate public key as:
-  // Q = r^-1 * (s * R - e * G)
+  // Q = r^-1 * (s * R - e * G) = (-e * r^-1) * G + (s * r^-1) * R
+  // All inputs are public, so that Q is computed with a single variable time
+  // multiplication.
 
   // r^⁻1
   if ((inverse_r = BN_mod_inverse(NULL, r, n, bn_context)) == NULL) {
@@ -178,59 +184,30 @@ struct key_recovery_result key_recovery(const char data_hash[],
     goto end;
   }
 
-  // s * R
   if (BN_hex2bn(&s, signature_s_str) == FAILURE) {
     set_error_message(result.error_message,
                       "Could not convert s of signature to BIGNUM: ");
     goto end;
   }
-  if ((sR = EC_POINT_new(group)) == NULL) {
-    set_error_message(result.error_message,
-                      "Could not allocate memory for point sR: ");
-    goto end;
-  }
-  if (EC_POINT_mul(group, sR, NULL, R, s, bn_context) != SUCCESS) {
-    set_error_message(result.error_message,
-                      "Could not multiply curve point R with signature s: ");
-    goto end;
-  }
 
-  // -e * G
-  BN_set_negative(e, 1);
-  if ((negative_eG = EC_POINT_new(group)) == NULL) {
+  // u1 = -e * r^-1 mod n, u2 = s * r^-1 mod n
+  if ((u1 = BN_new()) == NULL || (u2 = BN_new()) == NULL ||
+      BN_mod_mul(u1, e, inverse_r, n, bn_context) != SUCCESS ||
+      BN_mod_sub(u1, n, u1, n, bn_context) != SUCCESS ||
+      BN_mod_mul(u2, s, inverse_r, n, bn_context) != SUCCESS) {
     set_error_message(result.error_message,
-                      "Could not allocate memory for point eG: ");
-    goto end;
-  }
-  if (EC_POINT_mul(group, negative_eG, e, NULL, NULL, bn_context) != SUCCESS) {
-    set_error_message(result.error_message,
-                      "Could not multiply curve point R with signature s: ");
+                      "Could not calculate the scalars of Q: ");
     goto end;
   }
 
-  // sR + (-eG)
-  if ((sR_minus_eG = EC_POINT_new(group)) == NULL) {
-    set_error_message(result.error_message,
-                      "Could not allocate memory for point sR_minus_eG: ");
-    goto end;
-  }
-  if (EC_POINT_add(group, sR_minus_eG, sR, negative_eG, bn_context) !=
-      SUCCESS) {
-    set_error_message(result.error_message,
-                      "Could not calculate point sR_minus_eG: ");
-    goto end;
-  }
-
-  // Q = r^⁻1 * (sR - eG)
   if ((Q = EC_POINT_new(group)) == NULL) {
     set_error_message(result.error_message,
                       "Could not allocate memory for point Q: ");
     goto end;
   }
-  if (EC_POINT_mul(group, Q, NULL, sR_minus_eG, inverse_r, bn_context) !=
-      SUCCESS) {
-    set_error_message(result.error_message,
-                      "Could not multiply curve point sR_minus_eG with r^⁻1: ");
+  if (side_channel_point_mul(Q, result.error_message,
+                             EC_OPERATION_KEY_RECOVERY, group, u1, R, u2,
+                             bn_context) != SUCCESS) {
     goto end;
   }
 
@@ -265,19 +242,16 @@ struct key_recovery_result key_recovery(const char data_hash[],
 end:
   free(signature_r_str);
   free(signature_s_str);
-  EC_GROUP_free(group);
-  BN_CTX_free(bn_context);
   BN_free(p);
   BN_free(r);
   BN_free(s);
   BN_free(e);
   BN_free(inverse_r);
+  BN_free(u1);
+  BN_free(u2);
   EC_POINT_free(R);
   EC_POINT_free(nR);
-  EC_POINT_free(negative_eG);
-  EC_POINT_free(sR);
   EC_POINT_free(Q);
-  EC_POINT_free(sR_minus_eG);
   OPENSSL_free(Q_octet);
 
   return result;
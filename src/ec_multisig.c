@@ -0,0 +1,206 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_key_recovery.h"
+#include "ec_multisig.h"
+#include "ec_transaction.h"
+#include "keccak.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+#define ADDRESS_OFFSET (KECCAK_256_DIGEST_LEN - ADDRESS_LEN)
+
+struct multisig_result
+p256_verify_multisig(const char data_hash[], const int data_hash_len,
+                     const char signatures[], const int signatures_len,
+                     const char owners[], const int owner_len,
+                     const int owner_count, const int threshold,
+                     const int flags) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return verify_multisig(
+      (const unsigned char *)data_hash, data_hash_len,
+      (const unsigned char *)signatures, signatures_len,
+      (const unsigned char *)owners, owner_len, owner_count, threshold, flags,
+      NID_X9_62_prime256v1, CURVE_BYTE_LENGTH);
+}
+
+// the signatures of one round, which are recovered in parallel
+struct multisig_round {
+  struct key_recovery_result *keys;
+  const unsigned char *data_hash;
+  int data_hash_len;
+  const unsigned char *signatures;
+  int curve_nid;
+  int curve_byte_length;
+};
+
+static void recover_signer_range(void *context, size_t begin, size_t end) {
+  struct multisig_round *round = context;
+  const size_t signature_len = 2 * round->curve_byte_length + 1;
+
+  for (size_t i = begin; i < end; i++) {
+    const unsigned char *signature = round->signatures + i * signature_len;
+
+    // key_recovery returns a key for r or s outside of the range as well
+    if (check_signature_range(
+            round->keys[i].error_message, (const char *)signature,
+            (const char *)signature + round->curve_byte_length,
+            round->curve_byte_length, round->curve_nid, 1) != SUCCESS) {
+      continue;
+    }
+    round->keys[i] = key_recovery(
+        (const char *)round->data_hash, round->data_hash_len,
+        (const char *)signature,
+        (const char *)signature + round->curve_byte_length,
+        signature[signature_len - 1], round->curve_nid,
+        round->curve_byte_length);
+  }
+}
+
+// returns the index of the owner of the recovered key or -1 if the key could
+// not be recovered or does not belong to an owner
+static int find_owner(const struct key_recovery_result *key,
+                      const unsigned char owners[], const int owner_len,
+                      const int owner_count, const int public_key_len) {
+  unsigned char public_key_hash[KECCAK_256_DIGEST_LEN];
+  const unsigned char *signer = (const unsigned char *)key->public_key;
+
+  if (strlen(key->error_message) != 0) {
+    return -1;
+  }
+
+  if (owner_len == ADDRESS_LEN) {
+    keccak_256(signer, public_key_len, public_key_hash);
+    signer = public_key_hash + ADDRESS_OFFSET;
+  }
+
+  for (int i = 0; i < owner_count; i++) {
+    if (memcmp(owners + (size_t)i * owner_len, signer, owner_len) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Recovers the signatures in rounds. Without MULTISIG_PARALLEL a round is a
+// single signature, otherwise it has as many signatures as are still missing
+// for the threshold, so that no signature is recovered in vain if all of them
+// are valid. The results are checked in the order of the signatures.
+struct multisig_result
+verify_multisig(const unsigned char data_hash[], const int data_hash_len,
+                const unsigned char signatures[], const int signatures_len,
+                const unsigned char owners[], const int owner_len,
+                const int owner_count, const int threshold, const int flags,
+                const int curve_nid, const int curve_byte_length) {
+  struct multisig_result result = {.verified = GENERIC_ERROR,
+                                   .signer_count = 0,
+                                   .recovered_count = 0,
+                                   .error_message = {0}};
+
+  const int signature_len = 2 * curve_byte_length + 1;
+  const int public_key_len = 2 * curve_byte_length;
+  unsigned char *signed_owners = NULL;
+  struct key_recovery_result *keys = NULL;
+  int last_owner = -1;
+
+  if (signatures_len < 0 || signatures_len % signature_len != 0) {
+    snprintf(result.error_message, 256,
+             "Length of the signatures must be a multiple of %d\n",
+             signature_len);
+    goto end_verify_multisig;
+  }
+  if (owner_len != ADDRESS_LEN && owner_len != public_key_len) {
+    snprintf(result.error_message, 256,
+             "Owners must be addresses of %d bytes or public keys of %d "
+             "bytes\n",
+             ADDRESS_LEN, public_key_len);
+    goto end_verify_multisig;
+  }
+  if (threshold < 1 || threshold > owner_count) {
+    snprintf(result.error_message, 256,
+             "Threshold must be between 1 and the number of owners\n");
+    goto end_verify_multisig;
+  }
+
+  const int signature_count = signatures_len / signature_len;
+  const int max_round = flags & MULTISIG_PARALLEL ? threshold : 1;
+
+  if ((signed_owners = calloc(owner_count, 1)) == NULL ||
+      (keys = malloc(max_round * sizeof(struct key_recovery_result))) ==
+          NULL) {
+    snprintf(result.error_message, 256,
+             "Could not allocate memory for the signers\n");
+    goto end_verify_multisig;
+  }
+
+  // stops as soon as the remaining signatures can't reach the threshold
+  while (result.signer_count < threshold &&
+         result.signer_count + signature_count - result.recovered_count >=
+             threshold) {
+    int missing = threshold - result.signer_count;
+    struct multisig_round round = {
+        .keys = keys,
+        .data_hash = data_hash,
+        .data_hash_len = data_hash_len,
+        .signatures =
+            signatures + (size_t)result.recovered_count * signature_len,
+        .curve_nid = curve_nid,
+        .curve_byte_length = curve_byte_length};
+    int round_len = missing < max_round ? missing : max_round;
+
+    worker_pool_run(round_len, recover_signer_range, &round);
+
+    for (int i = 0; i < round_len && result.signer_count < threshold; i++) {
+      int owner = find_owner(&keys[i], owners, owner_len, owner_count,
+                             public_key_len);
+      result.recovered_count++;
+
+      if (owner < 0) {
+        continue;
+      }
+      if ((flags & MULTISIG_ASCENDING_SIGNERS) && last_owner >= 0 &&
+          memcmp(owners + (size_t)owner * owner_len,
+                 owners + (size_t)last_owner * owner_len, owner_len) <= 0) {
+        snprintf(result.error_message, 256,
+                 "Signer of signature %d is not in ascending order\n",
+                 result.recovered_count - 1);
+        goto end_verify_multisig;
+      }
+      if (!signed_owners[owner]) {
+        signed_owners[owner] = 1;
+        result.signer_count++;
+        last_owner = owner;
+      }
+    }
+  }
+
+  result.verified = result.signer_count >= threshold;
+
+end_verify_multisig:
+  free(signed_owners);
+  free(keys);
+
+  return result;
+}
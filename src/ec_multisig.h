@@ -0,0 +1,39 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Implements p256_verify_multisig for curves with curve_byte_length long
+// scalars. The signatures are r || s || v and the owners addresses or public
+// keys x || y.
+struct multisig_result
+verify_multisig(const unsigned char data_hash[], const int data_hash_len,
+                const unsigned char signatures[], const int signatures_len,
+                const unsigned char owners[], const int owner_len,
+                const int owner_count, const int threshold, const int flags,
+                const int curve_nid, const int curve_byte_length);
+
+#ifdef __cplusplus
+extern
+}
+#endif
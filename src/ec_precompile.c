@@ -0,0 +1,188 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/obj_mac.h"
+#include "openssl/include/openssl/objects.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_key_recovery.h"
+#include "ec_precompile.h"
+#include "ec_verify.h"
+#include "keccak.h"
+#include "thread_context.h"
+
+#define ECRECOVER_V_OFFSET 27
+
+#define ADDRESS_OFFSET (KECCAK_256_DIGEST_LEN - 20)
+
+int p256_ecrecover(char output[], const char input[], const int input_len) {
+  return ecrecover((unsigned char *)output, (const unsigned char *)input,
+                   input_len < 0 ? 0 : (size_t)input_len,
+                   NID_X9_62_prime256v1);
+}
+
+int p256_verify_precompile(char output[], const char input[],
+                           const int input_len) {
+  return precompile_verify((unsigned char *)output,
+                           (const unsigned char *)input,
+                           input_len < 0 ? 0 : (size_t)input_len,
+                           NID_X9_62_prime256v1);
+}
+
+// 0 < scalar < n, compared as big-endian words
+static int is_scalar_in_range(const unsigned char scalar[],
+                              const unsigned char order[]) {
+  unsigned char any = 0;
+
+  for (int i = 0; i < ECRECOVER_WORD_LEN; i++) {
+    any |= scalar[i];
+  }
+  return any != 0 && memcmp(scalar, order, ECRECOVER_WORD_LEN) < 0;
+}
+
+// Like the precompile of the EVM, a shorter input is padded with zeros and
+// bytes after the first 128 are ignored. v must be 27 or 28 and r and s must
+// be between 1 and n - 1, s greater than n / 2 is accepted. The input is
+// validated without allocating anything, before the key is recovered.
+int ecrecover(unsigned char output[ECRECOVER_OUTPUT_LEN],
+              const unsigned char input[], const size_t input_len,
+              const int curve_nid) {
+  unsigned char padded_input[ECRECOVER_INPUT_LEN] = {0};
+  unsigned char order[ECRECOVER_WORD_LEN];
+  char error_message[256];
+
+  if (input_len > 0) {
+    memcpy(padded_input, input,
+           input_len < ECRECOVER_INPUT_LEN ? input_len : ECRECOVER_INPUT_LEN);
+  }
+  const unsigned char *data_hash = padded_input;
+  const unsigned char *v = padded_input + ECRECOVER_WORD_LEN;
+  const unsigned char *r = padded_input + 2 * ECRECOVER_WORD_LEN;
+  const unsigned char *s = padded_input + 3 * ECRECOVER_WORD_LEN;
+
+  for (int i = 0; i < ECRECOVER_WORD_LEN - 1; i++) {
+    if (v[i] != 0) {
+      return 0;
+    }
+  }
+  if (v[ECRECOVER_WORD_LEN - 1] != ECRECOVER_V_OFFSET &&
+      v[ECRECOVER_WORD_LEN - 1] != ECRECOVER_V_OFFSET + 1) {
+    return 0;
+  }
+
+  // the group is owned by the thread, so that the order is read without
+  // allocating
+  const EC_GROUP *group = thread_group(error_message, curve_nid);
+  if (group == NULL ||
+      BN_bn2binpad(EC_GROUP_get0_order(group), order, ECRECOVER_WORD_LEN) !=
+          ECRECOVER_WORD_LEN ||
+      !is_scalar_in_range(r, order) || !is_scalar_in_range(s, order)) {
+    return 0;
+  }
+
+  struct key_recovery_result key = key_recovery(
+      (const char *)data_hash, ECRECOVER_WORD_LEN, (const char *)r,
+      (const char *)s, v[ECRECOVER_WORD_LEN - 1] - ECRECOVER_V_OFFSET,
+      curve_nid, ECRECOVER_WORD_LEN);
+  if (key.error_message[0] != '\0') {
+    return 0;
+  }
+
+  unsigned char public_key_hash[KECCAK_256_DIGEST_LEN];
+  keccak_256((const unsigned char *)key.public_key, 2 * ECRECOVER_WORD_LEN,
+             public_key_hash);
+  memset(output, 0, ADDRESS_OFFSET);
+  memcpy(output + ADDRESS_OFFSET, public_key_hash + ADDRESS_OFFSET,
+         KECCAK_256_DIGEST_LEN - ADDRESS_OFFSET);
+  return ECRECOVER_OUTPUT_LEN;
+}
+
+// coordinate < p, compared as big-endian words
+static int is_coordinate_in_range(const unsigned char coordinate[],
+                                  const unsigned char field[]) {
+  return memcmp(coordinate, field, ECRECOVER_WORD_LEN) < 0;
+}
+
+// Replaces s by n - s if s is greater than n / 2, so that the signature passes
+// the canonicalization check of verify. Both are valid signatures of the same
+// hash and key.
+static void normalize_s(unsigned char s[], const unsigned char order[]) {
+  unsigned char negated_s[ECRECOVER_WORD_LEN];
+  int borrow = 0;
+
+  for (int i = ECRECOVER_WORD_LEN - 1; i >= 0; i--) {
+    int difference = order[i] - s[i] - borrow;
+    borrow = difference < 0;
+    negated_s[i] = (unsigned char)(difference + (borrow ? 256 : 0));
+  }
+  if (memcmp(s, negated_s, ECRECOVER_WORD_LEN) > 0) {
+    memcpy(s, negated_s, ECRECOVER_WORD_LEN);
+  }
+}
+
+// Unlike ecrecover, the input must have exactly 160 bytes. r and s are
+// validated without allocating anything and the coordinates of the key must be
+// less than p, before the key is imported through the key cache. Keys that are
+// not on the curve, including the point at infinity (0, 0), fail the import.
+int precompile_verify(unsigned char output[P256VERIFY_OUTPUT_LEN],
+                      const unsigned char input[], const size_t input_len,
+                      const int curve_nid) {
+  unsigned char signature_s[ECRECOVER_WORD_LEN];
+  unsigned char order[ECRECOVER_WORD_LEN];
+  unsigned char field[ECRECOVER_WORD_LEN];
+  char error_message[256];
+
+  if (input_len != P256VERIFY_INPUT_LEN) {
+    return 0;
+  }
+  const unsigned char *data_hash = input;
+  const unsigned char *r = input + ECRECOVER_WORD_LEN;
+  const unsigned char *s = input + 2 * ECRECOVER_WORD_LEN;
+  const unsigned char *public_key = input + 3 * ECRECOVER_WORD_LEN;
+
+  const EC_GROUP *group = thread_group(error_message, curve_nid);
+  if (group == NULL ||
+      BN_bn2binpad(EC_GROUP_get0_order(group), order, ECRECOVER_WORD_LEN) !=
+          ECRECOVER_WORD_LEN ||
+      BN_bn2binpad(EC_GROUP_get0_field(group), field, ECRECOVER_WORD_LEN) !=
+          ECRECOVER_WORD_LEN ||
+      !is_scalar_in_range(r, order) || !is_scalar_in_range(s, order) ||
+      !is_coordinate_in_range(public_key, field) ||
+      !is_coordinate_in_range(public_key + ECRECOVER_WORD_LEN, field)) {
+    return 0;
+  }
+
+  memcpy(signature_s, s, ECRECOVER_WORD_LEN);
+  normalize_s(signature_s, order);
+
+  struct verify_result result =
+      verify((const char *)data_hash, ECRECOVER_WORD_LEN, (const char *)r,
+             (const char *)signature_s, (const char *)public_key,
+             2 * ECRECOVER_WORD_LEN, OBJ_nid2sn(curve_nid), curve_nid);
+  if (result.verified != 1) {
+    return 0;
+  }
+
+  memset(output, 0, P256VERIFY_OUTPUT_LEN);
+  output[P256VERIFY_OUTPUT_LEN - 1] = 1;
+  return P256VERIFY_OUTPUT_LEN;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the input of ecrecover is hash || v || r || s, each a 32 byte word
+#define ECRECOVER_WORD_LEN 32
+#define ECRECOVER_INPUT_LEN (4 * ECRECOVER_WORD_LEN)
+// the address, left padded with zeros to a word
+#define ECRECOVER_OUTPUT_LEN ECRECOVER_WORD_LEN
+
+// the input of P256VERIFY is hash || r || s || x || y, each a 32 byte word
+#define P256VERIFY_INPUT_LEN (5 * ECRECOVER_WORD_LEN)
+// 1 as a word if the signature is valid
+#define P256VERIFY_OUTPUT_LEN ECRECOVER_WORD_LEN
+
+// Implements the ecrecover precompile for curves with 32 byte scalars. Returns
+// the length of the output, which is 0 if the input is invalid.
+int ecrecover(unsigned char output[ECRECOVER_OUTPUT_LEN],
+              const unsigned char input[], const size_t input_len,
+              const int curve_nid);
+
+// Implements the signature verification precompile of RIP-7212 for curves with
+// 32 byte scalars. Returns the length of the output, which is 0 if the input
+// or the signature is invalid.
+int precompile_verify(unsigned char output[P256VERIFY_OUTPUT_LEN],
+                      const unsigned char input[], const size_t input_len,
+                      const int curve_nid);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,397 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/crypto.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_key_recovery.h"
+#include "ec_transaction.h"
+#include "keccak.h"
+#include "rlp.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+// number of fields that are signed, the signature v, r and s follows them
+#define LEGACY_SIGNED_FIELD_COUNT 6
+#define ACCESS_LIST_SIGNED_FIELD_COUNT 8
+#define EIP1559_SIGNED_FIELD_COUNT 9
+#define SIGNATURE_FIELD_COUNT 3
+#define MAX_FIELD_COUNT (EIP1559_SIGNED_FIELD_COUNT + SIGNATURE_FIELD_COUNT)
+
+#define LEGACY_V_OFFSET 27
+#define EIP155_V_OFFSET 35
+
+#define ADDRESS_OFFSET (KECCAK_256_DIGEST_LEN - ADDRESS_LEN)
+
+struct transaction_sender_result
+p256_recover_transaction_sender(const char transaction[],
+                                const int transaction_len) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return recover_transaction_sender(
+      (const unsigned char *)transaction,
+      transaction_len < 0 ? 0 : (size_t)transaction_len, NID_X9_62_prime256v1,
+      CURVE_BYTE_LENGTH);
+}
+
+int p256_recover_transaction_senders(
+    struct transaction_sender_result results[], const char transactions[],
+    const int transaction_offsets[], const int transaction_count) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return recover_transaction_senders(
+      results, (const unsigned char *)transactions, transaction_offsets,
+      transaction_count, NID_X9_62_prime256v1, CURVE_BYTE_LENGTH);
+}
+
+int p256_verify_sender_address(const char data_hash[],
+                               const int data_hash_len,
+                               const char signature_r[],
+                               const char signature_s[],
+                               const int signature_v,
+                               const char expected_address[]) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return recovered_address_matches(
+      (const unsigned char *)data_hash, data_hash_len, signature_r,
+      signature_s, signature_v, (const unsigned char *)expected_address,
+      NID_X9_62_prime256v1, CURVE_BYTE_LENGTH);
+}
+
+int p256_verify_sender_addresses(char results[], const char data_hashes[],
+                                 const char signatures[],
+                                 const char expected_addresses[],
+                                 const int count) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return verify_sender_addresses(
+      results, (const unsigned char *)data_hashes,
+      (const unsigned char *)signatures,
+      (const unsigned char *)expected_addresses, count, NID_X9_62_prime256v1,
+      CURVE_BYTE_LENGTH);
+}
+
+// copies a big-endian scalar of the signature into a buffer of the length of
+// the curve, the scalar must not have leading zeros
+static int read_scalar(char *scalar, const struct rlp_item *item,
+                       const int curve_byte_length) {
+  if (item->is_list || item->payload_len > (size_t)curve_byte_length ||
+      (item->payload_len > 0 && item->payload[0] == 0)) {
+    return FAILURE;
+  }
+  memset(scalar, 0, curve_byte_length);
+  memcpy(scalar + curve_byte_length - item->payload_len, item->payload,
+         item->payload_len);
+  return SUCCESS;
+}
+
+// Recovers the sender of a transaction in the encoding of the network, which
+// is either a legacy transaction (an RLP list) or a typed transaction, that is
+// the type followed by an RLP list. The signed payload is hashed directly
+// from the transaction, only the list header is rebuilt, as its length does
+// not include the signature. EIP-155 transactions additionally sign the chain
+// id, which is derived from v, followed by two empty strings.
+struct transaction_sender_result
+recover_transaction_sender(const unsigned char transaction[],
+                           const size_t transaction_len, const int curve_nid,
+                           const int curve_byte_length) {
+  struct transaction_sender_result result = {.address = {0},
+                                             .error_message = {0}};
+  struct rlp_item list;
+  struct rlp_item fields[MAX_FIELD_COUNT];
+  size_t field_count = 0;
+  size_t signed_field_count = 0;
+  int type = -1;
+  uint64_t v = 0;
+  int recovery_id = 0;
+  char signature_r[66];
+  char signature_s[66];
+
+  if (transaction_len == 0) {
+    snprintf(result.error_message, 256, "Transaction is empty\n");
+    return result;
+  }
+
+  const unsigned char *encoding = transaction;
+  size_t encoding_len = transaction_len;
+  if (transaction[0] == TRANSACTION_TYPE_ACCESS_LIST) {
+    signed_field_count = ACCESS_LIST_SIGNED_FIELD_COUNT;
+  } else if (transaction[0] == TRANSACTION_TYPE_EIP1559) {
+    signed_field_count = EIP1559_SIGNED_FIELD_COUNT;
+  } else if (transaction[0] >= 0xc0) {
+    signed_field_count = LEGACY_SIGNED_FIELD_COUNT;
+  } else {
+    snprintf(result.error_message, 256,
+             "Transaction type %d is not supported\n", transaction[0]);
+    return result;
+  }
+  if (transaction[0] < 0xc0) {
+    type = transaction[0];
+    encoding++;
+    encoding_len--;
+  }
+
+  if (rlp_decode_item(&list, encoding, encoding_len) != SUCCESS ||
+      !list.is_list || list.encoding_len != encoding_len) {
+    snprintf(result.error_message, 256,
+             "Transaction is not a valid RLP list\n");
+    return result;
+  }
+
+  const unsigned char *cursor = list.payload;
+  const unsigned char *end = list.payload + list.payload_len;
+  while (cursor < end) {
+    if (field_count == MAX_FIELD_COUNT ||
+        rlp_next_item(&fields[field_count], &cursor, end) != SUCCESS) {
+      snprintf(result.error_message, 256,
+               "Transaction has invalid or too many fields\n");
+      return result;
+    }
+    field_count++;
+  }
+  if (field_count != signed_field_count + SIGNATURE_FIELD_COUNT) {
+    snprintf(result.error_message, 256,
+             "Transaction has %zu fields, but %zu are expected\n",
+             field_count, signed_field_count + SIGNATURE_FIELD_COUNT);
+    return result;
+  }
+
+  const struct rlp_item *v_item = &fields[signed_field_count];
+  if (rlp_item_to_uint64(&v, v_item) != SUCCESS ||
+      read_scalar(signature_r, &fields[signed_field_count + 1],
+                  curve_byte_length) != SUCCESS ||
+      read_scalar(signature_s, &fields[signed_field_count + 2],
+                  curve_byte_length) != SUCCESS) {
+    snprintf(result.error_message, 256,
+             "Transaction signature is not encoded correctly\n");
+    return result;
+  }
+  // key_recovery accepts any r and s, and the signatures of transactions
+  // must have a low s since EIP-2
+  if (check_signature_range(result.error_message, signature_r, signature_s,
+                            curve_byte_length, curve_nid, 0) != SUCCESS) {
+    return result;
+  }
+
+  // the signed fields are stored in one piece in front of the signature
+  const unsigned char *signed_fields = fields[0].encoding;
+  const size_t signed_fields_len = v_item->encoding - signed_fields;
+  unsigned char chain_id_suffix[9 + 2];
+  size_t chain_id_suffix_len = 0;
+
+  if (type >= 0) {
+    if (v > 1) {
+      snprintf(result.error_message, 256,
+               "y parity of signature must be either 0 or 1\n");
+      return result;
+    }
+    recovery_id = (int)v;
+  } else if (v == LEGACY_V_OFFSET || v == LEGACY_V_OFFSET + 1) {
+    recovery_id = (int)(v - LEGACY_V_OFFSET);
+  } else if (v >= EIP155_V_OFFSET) {
+    recovery_id = (int)((v - EIP155_V_OFFSET) % 2);
+    chain_id_suffix_len = rlp_encode_uint64(
+        chain_id_suffix, (v - EIP155_V_OFFSET) / 2);
+    // r and s are signed as empty strings
+    chain_id_suffix[chain_id_suffix_len++] = 0x80;
+    chain_id_suffix[chain_id_suffix_len++] = 0x80;
+  } else {
+    snprintf(result.error_message, 256,
+             "v of legacy transaction must be 27, 28 or at least 35\n");
+    return result;
+  }
+
+  unsigned char header[9];
+  size_t header_len =
+      rlp_list_header(header, signed_fields_len + chain_id_suffix_len);
+  unsigned char data_hash[KECCAK_256_DIGEST_LEN];
+  struct keccak_256_ctx keccak;
+
+  keccak_256_init(&keccak);
+  if (type >= 0) {
+    const unsigned char type_byte = (unsigned char)type;
+    keccak_256_update(&keccak, &type_byte, 1);
+  }
+  keccak_256_update(&keccak, header, header_len);
+  keccak_256_update(&keccak, signed_fields, signed_fields_len);
+  keccak_256_update(&keccak, chain_id_suffix, chain_id_suffix_len);
+  keccak_256_final(&keccak, data_hash);
+
+  struct key_recovery_result key =
+      key_recovery((const char *)data_hash, sizeof(data_hash), signature_r,
+                   signature_s, recovery_id, curve_nid, curve_byte_length);
+  if (strlen(key.error_message) != 0) {
+    memcpy(result.error_message, key.error_message,
+           sizeof(result.error_message));
+    return result;
+  }
+
+  unsigned char public_key_hash[KECCAK_256_DIGEST_LEN];
+  keccak_256((const unsigned char *)key.public_key, 2 * curve_byte_length,
+             public_key_hash);
+  memcpy(result.address, public_key_hash + ADDRESS_OFFSET,
+         sizeof(result.address));
+
+  return result;
+}
+
+struct sender_batch {
+  struct transaction_sender_result *results;
+  const unsigned char *transactions;
+  const int *transaction_offsets;
+  int curve_nid;
+  int curve_byte_length;
+  atomic_int recovered;
+};
+
+static void recover_sender_range(void *context, size_t begin, size_t end) {
+  struct sender_batch *batch = context;
+  int recovered = 0;
+
+  for (size_t i = begin; i < end; i++) {
+    const int offset = batch->transaction_offsets[i];
+    const int next_offset = batch->transaction_offsets[i + 1];
+
+    if (offset < 0 || next_offset < offset) {
+      memset(&batch->results[i], 0, sizeof(batch->results[i]));
+      snprintf(batch->results[i].error_message, 256,
+               "Transaction offsets must be ascending\n");
+      continue;
+    }
+
+    batch->results[i] = recover_transaction_sender(
+        batch->transactions + offset, next_offset - offset, batch->curve_nid,
+        batch->curve_byte_length);
+    if (strlen(batch->results[i].error_message) == 0) {
+      recovered++;
+    }
+  }
+
+  atomic_fetch_add(&batch->recovered, recovered);
+}
+
+// The transactions are recovered on the worker pool. Returns the number of
+// transactions whose sender was recovered, the others have an error message
+// in their result.
+int recover_transaction_senders(struct transaction_sender_result results[],
+                                const unsigned char transactions[],
+                                const int transaction_offsets[],
+                                const int transaction_count,
+                                const int curve_nid,
+                                const int curve_byte_length) {
+  struct sender_batch batch = {.results = results,
+                               .transactions = transactions,
+                               .transaction_offsets = transaction_offsets,
+                               .curve_nid = curve_nid,
+                               .curve_byte_length = curve_byte_length};
+  atomic_init(&batch.recovered, 0);
+
+  if (transaction_count <= 0) {
+    return 0;
+  }
+  worker_pool_run(transaction_count, recover_sender_range, &batch);
+
+  return atomic_load(&batch.recovered);
+}
+
+int recovered_address_matches(const unsigned char data_hash[],
+                              const int data_hash_len,
+                              const char signature_r[],
+                              const char signature_s[], const int signature_v,
+                              const unsigned char expected_address[],
+                              const int curve_nid,
+                              const int curve_byte_length) {
+  char error_message[256];
+
+  // key_recovery accepts any r and s
+  if (check_signature_range(error_message, signature_r, signature_s,
+                            curve_byte_length, curve_nid, 1) != SUCCESS) {
+    return 0;
+  }
+
+  struct key_recovery_result key =
+      key_recovery((const char *)data_hash, data_hash_len, signature_r,
+                   signature_s, signature_v, curve_nid, curve_byte_length);
+  if (strlen(key.error_message) != 0) {
+    return 0;
+  }
+
+  unsigned char public_key_hash[KECCAK_256_DIGEST_LEN];
+  keccak_256((const unsigned char *)key.public_key, 2 * curve_byte_length,
+             public_key_hash);
+  return CRYPTO_memcmp(public_key_hash + ADDRESS_OFFSET, expected_address,
+                       ADDRESS_LEN) == 0;
+}
+
+struct address_batch {
+  char *results;
+  const unsigned char *data_hashes;
+  const unsigned char *signatures;
+  const unsigned char *expected_addresses;
+  int curve_nid;
+  int curve_byte_length;
+  atomic_int matched;
+};
+
+static void verify_address_range(void *context, size_t begin, size_t end) {
+  struct address_batch *batch = context;
+  const size_t signature_len = 2 * batch->curve_byte_length + 1;
+  int matched = 0;
+
+  for (size_t i = begin; i < end; i++) {
+    const unsigned char *signature = batch->signatures + i * signature_len;
+
+    batch->results[i] = (char)recovered_address_matches(
+        batch->data_hashes + i * KECCAK_256_DIGEST_LEN, KECCAK_256_DIGEST_LEN,
+        (const char *)signature,
+        (const char *)signature + batch->curve_byte_length,
+        signature[signature_len - 1],
+        batch->expected_addresses + i * ADDRESS_LEN, batch->curve_nid,
+        batch->curve_byte_length);
+    matched += batch->results[i];
+  }
+
+  atomic_fetch_add(&batch->matched, matched);
+}
+
+// The data hashes are Keccak-256 hashes and the signatures r || s || v, all
+// stored one after another. The signatures are recovered on the worker pool,
+// results[i] is set to 1 if signature i recovers to expected address i.
+// Returns the number of matching addresses.
+int verify_sender_addresses(char results[], const unsigned char data_hashes[],
+                            const unsigned char signatures[],
+                            const unsigned char expected_addresses[],
+                            const int count, const int curve_nid,
+                            const int curve_byte_length) {
+  struct address_batch batch = {.results = results,
+                                .data_hashes = data_hashes,
+                                .signatures = signatures,
+                                .expected_addresses = expected_addresses,
+                                .curve_nid = curve_nid,
+                                .curve_byte_length = curve_byte_length};
+  atomic_init(&batch.matched, 0);
+
+  if (count <= 0) {
+    return 0;
+  }
+  worker_pool_run(count, verify_address_range, &batch);
+
+  return atomic_load(&batch.matched);
+}
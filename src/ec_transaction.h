@@ -0,0 +1,64 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRANSACTION_TYPE_ACCESS_LIST 0x01
+#define TRANSACTION_TYPE_EIP1559 0x02
+
+#define ADDRESS_LEN 20
+
+struct transaction_sender_result
+recover_transaction_sender(const unsigned char transaction[],
+                           const size_t transaction_len, const int curve_nid,
+                           const int curve_byte_length);
+
+int recover_transaction_senders(struct transaction_sender_result results[],
+                                const unsigned char transactions[],
+                                const int transaction_offsets[],
+                                const int transaction_count,
+                                const int curve_nid,
+                                const int curve_byte_length);
+
+// Returns 1 if the signature recovers to the public key whose address is
+// expected_address, otherwise 0. The addresses are compared in constant time.
+int recovered_address_matches(const unsigned char data_hash[],
+                              const int data_hash_len,
+                              const char signature_r[],
+                              const char signature_s[], const int signature_v,
+                              const unsigned char expected_address[],
+                              const int curve_nid,
+                              const int curve_byte_length);
+
+int verify_sender_addresses(char results[], const unsigned char data_hashes[],
+                            const unsigned char signatures[],
+                            const unsigned char expected_addresses[],
+                            const int count, const int curve_nid,
+                            const int curve_byte_length);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -24,6 +24,9 @@
 #include "constants.h"
 #include "ec_key.h"
 #include "ec_verify.h"
+#include "key_cache.h"
+#include "side_channel.h"
+#include "thread_context.h"
 #include "utils.h"
 
 struct verify_result p256_verify(const char data_hash[],
@@ -47,68 +50,203 @@ struct verify_result verify(const char data_hash[], const int data_hash_length,
                                  .error_message = {0}};
 
   EVP_PKEY *key = NULL;
-  unsigned char *der_encoded_signature = NULL;
-  EVP_PKEY_CTX *verify_context = NULL;
 
   int signature_arr_len = public_key_len / 2;
-  int is_canonicalized = 0;
 
-  if ((is_canonicalized = is_signature_canonicalized(
-           signature_s_arr, signature_arr_len, curve_nid,
-           result.error_message)) == GENERIC_ERROR) {
+  if (check_signature_canonicalized(result.error_message, signature_s_arr,
+                                    signature_arr_len,
+                                    curve_nid) != SUCCESS) {
     goto end;
   }
 
-  if (!is_canonicalized) {
-    set_error_message(result.error_message,
-                      "Signature is not canonicalized. s of signature must not "
-                      "be greater than n / 2: ");
+  // repeat signers get the key that has been imported for a previous
+  // signature
+  if ((key = key_cache_get(result.error_message,
+                           (const unsigned char *)public_key_data,
+                           public_key_len, group_name, curve_nid)) == NULL) {
     goto end;
   }
 
-  if (create_public_key(&key, result.error_message,
-                        (const unsigned char *)public_key_data, public_key_len,
-                        group_name) != SUCCESS) {
-    goto end;
+  verify_with_key(&result, key, data_hash, data_hash_length, signature_r_arr,
+                  signature_s_arr, signature_arr_len);
+
+end:
+  EVP_PKEY_free(key);
+
+  return result;
+}
+
+// Verifies the signature according to the algorithm in SEC1v2 section 4.1.4
+// with side_channel_point_mul, which splits u1 * G + u2 * Q across two threads
+// in the low latency mode. EVP_PKEY_verify computes the same sum on the
+// calling thread. The point Q is decoded once per key and thread, the scalars
+// are taken from the BIGNUM context of the thread.
+//
+// http://www.secg.org/sec1-v2.pdf
+static void verify_with_point_mul(struct verify_result *result, EVP_PKEY *key,
+                                  const char data_hash[],
+                                  const int data_hash_length,
+                                  const char signature_r_arr[],
+                                  const char signature_s_arr[],
+                                  int signature_arr_len) {
+  const EC_GROUP *group = NULL;
+  const EC_POINT *Q = NULL;
+  const BIGNUM *n = NULL; // curve order
+  BN_CTX *bn_context = NULL;
+  BIGNUM *r = NULL, *s = NULL, *e = NULL, *w = NULL, *u1 = NULL, *u2 = NULL,
+         *x = NULL;
+  EC_POINT *X = NULL;
+
+  // group, point and BIGNUM context are owned by the thread and reused by the
+  // next verification
+  if ((Q = thread_verify_point(result->error_message, key, &group)) == NULL ||
+      (bn_context = thread_bn_context(result->error_message)) == NULL) {
+    return;
+  }
+  n = EC_GROUP_get0_order(group);
+
+  BN_CTX_start(bn_context);
+  if ((r = BN_CTX_get(bn_context)) == NULL ||
+      (s = BN_CTX_get(bn_context)) == NULL ||
+      (e = BN_CTX_get(bn_context)) == NULL ||
+      (w = BN_CTX_get(bn_context)) == NULL ||
+      (u1 = BN_CTX_get(bn_context)) == NULL ||
+      (u2 = BN_CTX_get(bn_context)) == NULL ||
+      (x = BN_CTX_get(bn_context)) == NULL) {
+    set_error_message(result->error_message,
+                      "Could not allocate memory for the scalars: ");
+    goto end_verify_with_point_mul;
+  }
+
+  if (BN_bin2bn((const unsigned char *)signature_r_arr, signature_arr_len,
+                r) == NULL ||
+      BN_bin2bn((const unsigned char *)signature_s_arr, signature_arr_len,
+                s) == NULL) {
+    set_error_message(result->error_message,
+                      "Could not convert signature to BIGNUM: ");
+    goto end_verify_with_point_mul;
+  }
+
+  // 1. r and s must be in [1, n - 1]
+  if (BN_is_zero(r) || BN_is_negative(r) || BN_cmp(r, n) >= 0 ||
+      BN_is_zero(s) || BN_is_negative(s) || BN_cmp(s, n) >= 0) {
+    result->verified = 0;
+    goto end_verify_with_point_mul;
+  }
+
+  // 2. - 3. e are the left most bits of the hash, as many as n has
+  int order_bits = BN_num_bits(n);
+  if (BN_bin2bn((const unsigned char *)data_hash, data_hash_length, e) ==
+          NULL ||
+      (8 * data_hash_length > order_bits &&
+       BN_rshift(e, e, 8 * data_hash_length - order_bits) != SUCCESS)) {
+    set_error_message(result->error_message,
+                      "Could not convert data hash to BIGNUM: ");
+    goto end_verify_with_point_mul;
+  }
+
+  // 4. u1 = e * s^-1 mod n, u2 = r * s^-1 mod n
+  if (BN_mod_inverse(w, s, n, bn_context) == NULL ||
+      BN_mod_mul(u1, e, w, n, bn_context) != SUCCESS ||
+      BN_mod_mul(u2, r, w, n, bn_context) != SUCCESS) {
+    set_error_message(result->error_message,
+                      "Could not calculate the scalars of X: ");
+    goto end_verify_with_point_mul;
+  }
+
+  // 5. X = u1 * G + u2 * Q
+  if ((X = EC_POINT_new(group)) == NULL) {
+    set_error_message(result->error_message,
+                      "Could not allocate memory for point X: ");
+    goto end_verify_with_point_mul;
+  }
+  if (side_channel_point_mul(X, result->error_message, EC_OPERATION_VERIFY,
+                             group, u1, Q, u2, bn_context) != SUCCESS) {
+    goto end_verify_with_point_mul;
+  }
+  if (EC_POINT_is_at_infinity(group, X)) {
+    result->verified = 0;
+    goto end_verify_with_point_mul;
+  }
+
+  // 6. - 8. the signature is valid if x of X mod n equals r
+  if (EC_POINT_get_affine_coordinates(group, X, x, NULL, bn_context) !=
+          SUCCESS ||
+      BN_nnmod(x, x, n, bn_context) != SUCCESS) {
+    set_error_message(result->error_message,
+                      "Could not get x coordinate of point X: ");
+    goto end_verify_with_point_mul;
+  }
+  result->verified = BN_cmp(x, r) == 0;
+
+end_verify_with_point_mul:
+  BN_CTX_end(bn_context);
+  EC_POINT_free(X);
+}
+
+void verify_with_key(struct verify_result *result, EVP_PKEY *key,
+                     const char data_hash[], const int data_hash_length,
+                     const char signature_r_arr[], const char signature_s_arr[],
+                     int signature_arr_len) {
+  unsigned char *der_encoded_signature = NULL;
+  EVP_PKEY_CTX *verify_context = NULL;
+
+  if (side_channel_low_latency()) {
+    verify_with_point_mul(result, key, data_hash, data_hash_length,
+                          signature_r_arr, signature_s_arr, signature_arr_len);
+    return;
   }
 
   int der_encoded_signature_len = 0;
   if (create_der_encoded_signature(
           &der_encoded_signature, &der_encoded_signature_len,
-          result.error_message, signature_r_arr, signature_s_arr,
+          result->error_message, signature_r_arr, signature_s_arr,
           signature_arr_len) != SUCCESS) {
-    goto end;
-  }
-
-  if ((verify_context = EVP_PKEY_CTX_new(key, NULL)) == NULL) {
-    set_error_message(result.error_message,
-                      "Could not create a context for verifying: ");
-    goto end;
+    goto end_verify_with_key;
   }
 
-  if (EVP_PKEY_verify_init(verify_context) != SUCCESS) {
-    set_error_message(result.error_message,
-                      "Could not initialize a context for verifying: ");
-    goto end;
+  // the context is kept by the thread and reused for the next signature of
+  // the same key
+  if ((verify_context = thread_verify_context(result->error_message, key)) ==
+      NULL) {
+    goto end_verify_with_key;
   }
 
   // verify signature: 1 = successfully verified, 0 = not successfully verified,
   // < 0 = error
-  result.verified = EVP_PKEY_verify(
+  result->verified = EVP_PKEY_verify(
       verify_context, der_encoded_signature, der_encoded_signature_len,
       (const unsigned char *)data_hash, data_hash_length);
 
-  if (result.verified < 0) {
-    set_error_message(result.error_message,
+  if (result->verified < 0) {
+    set_error_message(result->error_message,
                       "Error while verifying signature: ");
+    thread_verify_context_discard(key);
   }
 
-end:
+end_verify_with_key:
   OPENSSL_free(der_encoded_signature);
-  EVP_PKEY_free(key);
-  EVP_PKEY_CTX_free(verify_context);
+}
 
-  return result;
+int check_signature_canonicalized(char *error_message,
+                                  const char signature_s_arr[],
+                                  const int signature_arr_len,
+                                  const int curve_nid) {
+  int is_canonicalized = is_signature_canonicalized(
+      signature_s_arr, signature_arr_len, curve_nid, error_message);
+
+  if (is_canonicalized == GENERIC_ERROR) {
+    return FAILURE;
+  }
+
+  if (!is_canonicalized) {
+    set_error_message(error_message,
+                      "Signature is not canonicalized. s of signature must not "
+                      "be greater than n / 2: ");
+    return FAILURE;
+  }
+
+  return SUCCESS;
 }
 
 int is_signature_canonicalized(const char signature_s_arr[],
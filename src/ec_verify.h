@@ -17,6 +17,10 @@
  */
 #include <stdint.h>
 
+#include "openssl/include/openssl/evp.h"
+
+#include "besu_native_ec.h"
+
 #pragma once
 
 #ifdef __cplusplus
@@ -29,6 +33,18 @@ struct verify_result verify(const char data_hash[], const int data_hash_length,
                             const char public_key_data[], int public_key_len,
                             const char *group_name, int curve_nid);
 
+// verifies a signature against an already imported public key. The caller has
+// to make sure that the signature is canonicalized.
+void verify_with_key(struct verify_result *result, EVP_PKEY *key,
+                     const char data_hash[], const int data_hash_length,
+                     const char signature_r_arr[], const char signature_s_arr[],
+                     int signature_arr_len);
+
+int check_signature_canonicalized(char *error_message,
+                                  const char signature_s_arr[],
+                                  const int signature_arr_len,
+                                  const int curve_nid);
+
 int create_der_encoded_signature(unsigned char **der_encoded_signature,
                                  int *der_encoded_signature_len,
                                  char *error_message,
@@ -0,0 +1,465 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ecdsa.h"
+#include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_verify.h"
+#include "ec_webauthn.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+// rpIdHash (32 bytes), flags (1 byte) and signCount (4 bytes)
+#define MIN_AUTHENTICATOR_DATA_LEN 37
+#define SHA256_DIGEST_LEN 32
+// client data is a flat object, but unknown members might be nested
+#define MAX_JSON_DEPTH 16
+
+#define WEBAUTHN_GET_TYPE "webauthn.get"
+
+struct verify_result
+p256_verify_webauthn(const struct p256_webauthn_assertion *assertion,
+                     const int allow_high_s) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return webauthn_verify(assertion, allow_high_s, "prime256v1",
+                         NID_X9_62_prime256v1, CURVE_BYTE_LENGTH);
+}
+
+int p256_verify_webauthn_batch(
+    struct verify_result results[],
+    const struct p256_webauthn_assertion assertions[],
+    const int assertion_count, const int allow_high_s) {
+  unsigned int CURVE_BYTE_LENGTH = 32;
+  return webauthn_verify_batch(results, assertions, assertion_count,
+                               allow_high_s, "prime256v1",
+                               NID_X9_62_prime256v1, CURVE_BYTE_LENGTH);
+}
+
+/*
+ * The client data is only scanned, values are not unescaped. The type and the
+ * challenge never contain characters that need to be escaped, so that
+ * comparing them in their escaped form is enough.
+ */
+
+struct json_cursor {
+  const char *p;
+  const char *end;
+};
+
+static void json_skip_whitespace(struct json_cursor *cursor) {
+  while (cursor->p < cursor->end &&
+         (*cursor->p == ' ' || *cursor->p == '\t' || *cursor->p == '\n' ||
+          *cursor->p == '\r')) {
+    cursor->p++;
+  }
+}
+
+static int json_consume(struct json_cursor *cursor, char c) {
+  json_skip_whitespace(cursor);
+  if (cursor->p == cursor->end || *cursor->p != c) {
+    return FAILURE;
+  }
+  cursor->p++;
+  return SUCCESS;
+}
+
+// returns the content of a string without the quotes
+static int json_string(struct json_cursor *cursor, const char **value,
+                       size_t *value_len) {
+  if (json_consume(cursor, '"') != SUCCESS) {
+    return FAILURE;
+  }
+  *value = cursor->p;
+
+  while (cursor->p < cursor->end && *cursor->p != '"') {
+    if ((unsigned char)*cursor->p < 0x20) {
+      return FAILURE;
+    }
+    // the escaped character can't end the string
+    if (*cursor->p == '\\' && ++cursor->p == cursor->end) {
+      return FAILURE;
+    }
+    cursor->p++;
+  }
+  if (cursor->p == cursor->end) {
+    return FAILURE;
+  }
+
+  *value_len = cursor->p - *value;
+  cursor->p++;
+  return SUCCESS;
+}
+
+static int json_skip_value(struct json_cursor *cursor, int depth) {
+  const char *value = NULL;
+  size_t value_len = 0;
+
+  json_skip_whitespace(cursor);
+  if (cursor->p == cursor->end || depth > MAX_JSON_DEPTH) {
+    return FAILURE;
+  }
+
+  const char open = *cursor->p;
+  if (open == '"') {
+    return json_string(cursor, &value, &value_len);
+  }
+  if (open == '{' || open == '[') {
+    const char close = open == '{' ? '}' : ']';
+    cursor->p++;
+    json_skip_whitespace(cursor);
+    if (cursor->p < cursor->end && *cursor->p == close) {
+      cursor->p++;
+      return SUCCESS;
+    }
+    while (1) {
+      if (open == '{' && (json_string(cursor, &value, &value_len) != SUCCESS ||
+                          json_consume(cursor, ':') != SUCCESS)) {
+        return FAILURE;
+      }
+      if (json_skip_value(cursor, depth + 1) != SUCCESS) {
+        return FAILURE;
+      }
+      if (json_consume(cursor, ',') != SUCCESS) {
+        return json_consume(cursor, close);
+      }
+    }
+  }
+
+  // numbers, true, false and null
+  const char *start = cursor->p;
+  while (cursor->p < cursor->end &&
+         strchr("+-.0123456789eEabcdfilnrstu", *cursor->p) != NULL) {
+    cursor->p++;
+  }
+  return cursor->p > start ? SUCCESS : FAILURE;
+}
+
+static int json_key_equals(const char *key, size_t key_len,
+                           const char *expected) {
+  return key_len == strlen(expected) && memcmp(key, expected, key_len) == 0;
+}
+
+// extracts type and challenge of the client data, which must occur exactly
+// once
+static int parse_client_data(const char **type, size_t *type_len,
+                             const char **challenge, size_t *challenge_len,
+                             const char *client_data, size_t client_data_len) {
+  struct json_cursor cursor = {.p = client_data,
+                               .end = client_data + client_data_len};
+  *type = NULL;
+  *challenge = NULL;
+
+  if (json_consume(&cursor, '{') != SUCCESS) {
+    return FAILURE;
+  }
+  json_skip_whitespace(&cursor);
+  if (cursor.p < cursor.end && *cursor.p == '}') {
+    return FAILURE;
+  }
+
+  while (1) {
+    const char *key = NULL;
+    size_t key_len = 0;
+    if (json_string(&cursor, &key, &key_len) != SUCCESS ||
+        json_consume(&cursor, ':') != SUCCESS) {
+      return FAILURE;
+    }
+
+    int result;
+    if (json_key_equals(key, key_len, "type")) {
+      result = *type == NULL ? json_string(&cursor, type, type_len) : FAILURE;
+    } else if (json_key_equals(key, key_len, "challenge")) {
+      result = *challenge == NULL
+                   ? json_string(&cursor, challenge, challenge_len)
+                   : FAILURE;
+    } else {
+      result = json_skip_value(&cursor, 1);
+    }
+    if (result != SUCCESS) {
+      return FAILURE;
+    }
+
+    if (json_consume(&cursor, ',') != SUCCESS) {
+      break;
+    }
+  }
+
+  if (json_consume(&cursor, '}') != SUCCESS) {
+    return FAILURE;
+  }
+  json_skip_whitespace(&cursor);
+  return cursor.p == cursor.end && *type != NULL && *challenge != NULL
+             ? SUCCESS
+             : FAILURE;
+}
+
+// compares the base64url encoding without padding of the expected challenge
+// with the challenge of the client data
+static int challenge_matches(const char *encoded, size_t encoded_len,
+                             const unsigned char *challenge,
+                             size_t challenge_len) {
+  static const char alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+  if (encoded_len != (4 * challenge_len + 2) / 3) {
+    return 0;
+  }
+
+  for (size_t i = 0, j = 0; i < challenge_len; i += 3) {
+    unsigned long group = (unsigned long)challenge[i] << 16;
+    if (i + 1 < challenge_len) {
+      group |= (unsigned long)challenge[i + 1] << 8;
+    }
+    if (i + 2 < challenge_len) {
+      group |= challenge[i + 2];
+    }
+    // 3 bytes are encoded by 4 characters, the last group might be shorter
+    size_t chars = challenge_len - i >= 3 ? 4 : challenge_len - i + 1;
+    for (size_t k = 0; k < chars; k++, j++) {
+      if (encoded[j] != alphabet[(group >> (18 - 6 * k)) & 0x3f]) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+// accepts r || s or a strict DER encoding
+static int decode_signature(char *signature_r, char *signature_s,
+                            const struct p256_webauthn_assertion *assertion,
+                            const int curve_byte_length) {
+  if (assertion->signature_len == 2 * curve_byte_length) {
+    memcpy(signature_r, assertion->signature, curve_byte_length);
+    memcpy(signature_s, assertion->signature + curve_byte_length,
+           curve_byte_length);
+    return SUCCESS;
+  }
+
+  int ret = FAILURE;
+  const unsigned char *p = (const unsigned char *)assertion->signature;
+  unsigned char *der = NULL;
+  ECDSA_SIG *signature =
+      d2i_ECDSA_SIG(NULL, &p, (long)assertion->signature_len);
+  if (signature == NULL ||
+      i2d_ECDSA_SIG(signature, &der) != assertion->signature_len ||
+      memcmp(der, assertion->signature, assertion->signature_len) != 0) {
+    goto end_decode_signature;
+  }
+
+  if (BN_bn2binpad(ECDSA_SIG_get0_r(signature), (unsigned char *)signature_r,
+                   curve_byte_length) < 0 ||
+      BN_bn2binpad(ECDSA_SIG_get0_s(signature), (unsigned char *)signature_s,
+                   curve_byte_length) < 0) {
+    goto end_decode_signature;
+  }
+  ret = SUCCESS;
+
+end_decode_signature:
+  OPENSSL_free(der);
+  ECDSA_SIG_free(signature);
+  return ret;
+}
+
+// replaces s by n - s, which is a valid signature as well
+static int normalize_signature_s(char *signature_s, char *error_message,
+                                 const int curve_nid,
+                                 const int curve_byte_length) {
+  int ret = FAILURE;
+  BIGNUM *s = NULL;
+  BIGNUM *n = NULL;
+
+  if ((n = get_curve_order(curve_nid, error_message)) == NULL) {
+    goto end_normalize_signature_s;
+  }
+  if ((s = BN_bin2bn((const unsigned char *)signature_s, curve_byte_length,
+                     NULL)) == NULL ||
+      BN_sub(s, n, s) != SUCCESS ||
+      BN_bn2binpad(s, (unsigned char *)signature_s, curve_byte_length) < 0) {
+    set_error_message(error_message, "Could not normalize s of signature: ");
+    goto end_normalize_signature_s;
+  }
+  ret = SUCCESS;
+
+end_normalize_signature_s:
+  BN_free(s);
+  BN_free(n);
+  return ret;
+}
+
+// The signature of an assertion signs authenticatorData followed by the
+// SHA-256 hash of clientDataJSON. As ECDSA hashes the signed data with
+// SHA-256 as well, the hash that is verified is
+// sha256(authenticatorData || sha256(clientDataJSON)).
+static int hash_assertion(unsigned char data_hash[SHA256_DIGEST_LEN],
+                          char *error_message,
+                          const struct p256_webauthn_assertion *assertion) {
+  int ret = FAILURE;
+  unsigned char client_data_hash[SHA256_DIGEST_LEN];
+  EVP_MD_CTX *md_context = NULL;
+
+  if (EVP_Digest(assertion->client_data_json, assertion->client_data_json_len,
+                 client_data_hash, NULL, EVP_sha256(), NULL) != SUCCESS) {
+    set_error_message(error_message, "Could not hash client data: ");
+    goto end_hash_assertion;
+  }
+
+  if ((md_context = EVP_MD_CTX_new()) == NULL ||
+      EVP_DigestInit_ex(md_context, EVP_sha256(), NULL) != SUCCESS ||
+      EVP_DigestUpdate(md_context, assertion->authenticator_data,
+                       assertion->authenticator_data_len) != SUCCESS ||
+      EVP_DigestUpdate(md_context, client_data_hash,
+                       sizeof(client_data_hash)) != SUCCESS ||
+      EVP_DigestFinal_ex(md_context, data_hash, NULL) != SUCCESS) {
+    set_error_message(error_message, "Could not hash assertion: ");
+    goto end_hash_assertion;
+  }
+  ret = SUCCESS;
+
+end_hash_assertion:
+  EVP_MD_CTX_free(md_context);
+  return ret;
+}
+
+// Verifies a WebAuthn assertion according to the steps of the specification
+// that concern the signature: the type and challenge of the client data and
+// the signature over the authenticator data and the client data. Checking the
+// origin, the rpIdHash and the flags is up to the caller. Authenticators don't
+// create canonical signatures, therefore high s values can be allowed.
+struct verify_result
+webauthn_verify(const struct p256_webauthn_assertion *assertion,
+                const int allow_high_s, const char *group_name,
+                const int curve_nid, const int curve_byte_length) {
+  struct verify_result result = {.verified = GENERIC_ERROR,
+                                 .error_message = {0}};
+  const char *type = NULL;
+  const char *challenge = NULL;
+  size_t type_len = 0;
+  size_t challenge_len = 0;
+  char signature_r[66];
+  char signature_s[66];
+  unsigned char data_hash[SHA256_DIGEST_LEN];
+
+  if (assertion->authenticator_data_len < MIN_AUTHENTICATOR_DATA_LEN) {
+    snprintf(result.error_message, 256, "Authenticator data is too short\n");
+    return result;
+  }
+
+  if (assertion->client_data_json_len < 0 ||
+      parse_client_data(&type, &type_len, &challenge, &challenge_len,
+                        assertion->client_data_json,
+                        assertion->client_data_json_len) != SUCCESS) {
+    snprintf(result.error_message, 256,
+             "Client data is not a JSON object with type and challenge\n");
+    return result;
+  }
+  if (!json_key_equals(type, type_len, WEBAUTHN_GET_TYPE)) {
+    snprintf(result.error_message, 256,
+             "Type of client data must be webauthn.get\n");
+    return result;
+  }
+  if (assertion->challenge_len < 0 ||
+      !challenge_matches(challenge, challenge_len,
+                         (const unsigned char *)assertion->challenge,
+                         assertion->challenge_len)) {
+    snprintf(result.error_message, 256,
+             "Challenge of client data does not match\n");
+    return result;
+  }
+
+  if (decode_signature(signature_r, signature_s, assertion,
+                       curve_byte_length) != SUCCESS) {
+    snprintf(result.error_message, 256,
+             "Signature must be DER encoded or r || s\n");
+    return result;
+  }
+  // n - s of an s greater than n would be negative, so the range is checked
+  // before s is normalized
+  if (check_signature_range(result.error_message, signature_r, signature_s,
+                            curve_byte_length, curve_nid, 1) != SUCCESS) {
+    return result;
+  }
+  if (allow_high_s &&
+      is_signature_canonicalized(signature_s, curve_byte_length, curve_nid,
+                                 result.error_message) == 0 &&
+      normalize_signature_s(signature_s, result.error_message, curve_nid,
+                            curve_byte_length) != SUCCESS) {
+    return result;
+  }
+
+  if (hash_assertion(data_hash, result.error_message, assertion) != SUCCESS) {
+    return result;
+  }
+
+  return verify((const char *)data_hash, sizeof(data_hash), signature_r,
+                signature_s, assertion->public_key, 2 * curve_byte_length,
+                group_name, curve_nid);
+}
+
+struct webauthn_batch {
+  struct verify_result *results;
+  const struct p256_webauthn_assertion *assertions;
+  int allow_high_s;
+  const char *group_name;
+  int curve_nid;
+  int curve_byte_length;
+  atomic_int verified;
+};
+
+static void verify_assertion_range(void *context, size_t begin, size_t end) {
+  struct webauthn_batch *batch = context;
+  int verified = 0;
+
+  for (size_t i = begin; i < end; i++) {
+    batch->results[i] = webauthn_verify(
+        &batch->assertions[i], batch->allow_high_s, batch->group_name,
+        batch->curve_nid, batch->curve_byte_length);
+    verified += batch->results[i].verified == 1;
+  }
+
+  atomic_fetch_add(&batch->verified, verified);
+}
+
+// Verifies the assertions on the worker pool and returns the number of
+// verified assertions.
+int webauthn_verify_batch(struct verify_result results[],
+                          const struct p256_webauthn_assertion assertions[],
+                          const int assertion_count, const int allow_high_s,
+                          const char *group_name, const int curve_nid,
+                          const int curve_byte_length) {
+  struct webauthn_batch batch = {.results = results,
+                                 .assertions = assertions,
+                                 .allow_high_s = allow_high_s,
+                                 .group_name = group_name,
+                                 .curve_nid = curve_nid,
+                                 .curve_byte_length = curve_byte_length};
+  atomic_init(&batch.verified, 0);
+
+  if (assertion_count <= 0) {
+    return 0;
+  }
+  worker_pool_run(assertion_count, verify_assertion_range, &batch);
+
+  return atomic_load(&batch.verified);
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct verify_result
+webauthn_verify(const struct p256_webauthn_assertion *assertion,
+                const int allow_high_s, const char *group_name,
+                const int curve_nid, const int curve_byte_length);
+
+int webauthn_verify_batch(struct verify_result results[],
+                          const struct p256_webauthn_assertion assertions[],
+                          const int assertion_count, const int allow_high_s,
+                          const char *group_name, const int curve_nid,
+                          const int curve_byte_length);
+
+#ifdef __cplusplus
+extern
+}
+#endif
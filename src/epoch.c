@@ -0,0 +1,207 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "epoch.h"
+
+// Epoch based reclamation: every thread announces the global epoch when it
+// enters a read section. The global epoch is only advanced once all threads
+// in a read section have announced it, so an object that was retired in epoch
+// e can't be accessed anymore once the global epoch reached e + 2.
+
+#define INACTIVE 0
+
+// one per thread, records of exited threads are reused by new threads
+struct epoch_record {
+  // (epoch << 1) | 1 while the thread is in a read section, otherwise 0
+  atomic_ullong announced;
+  atomic_int in_use;
+  int nesting;
+  struct epoch_record *next;
+};
+
+struct retired_object {
+  void *object;
+  epoch_release release;
+  unsigned long long epoch;
+  struct retired_object *next;
+};
+
+static atomic_ullong global_epoch = 1;
+static _Atomic(struct epoch_record *) records = NULL;
+
+static pthread_mutex_t retired_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct retired_object *retired = NULL;
+static unsigned long long retired_count = 0;
+
+static pthread_key_t record_key;
+static pthread_once_t record_key_created = PTHREAD_ONCE_INIT;
+static _Thread_local struct epoch_record *thread_record = NULL;
+
+static void release_record(void *data) {
+  struct epoch_record *record = data;
+
+  atomic_store(&record->announced, INACTIVE);
+  atomic_store_explicit(&record->in_use, 0, memory_order_release);
+}
+
+static void create_record_key(void) {
+  pthread_key_create(&record_key, release_record);
+}
+
+// Records are never freed, as other threads might be reading them
+static struct epoch_record *get_record(char *error_message) {
+  if (thread_record != NULL) {
+    return thread_record;
+  }
+
+  pthread_once(&record_key_created, create_record_key);
+
+  struct epoch_record *record = NULL;
+  for (record = atomic_load(&records); record != NULL; record = record->next) {
+    int unused = 0;
+    if (atomic_compare_exchange_strong(&record->in_use, &unused, 1)) {
+      break;
+    }
+  }
+
+  if (record == NULL) {
+    if ((record = calloc(1, sizeof(struct epoch_record))) == NULL) {
+      snprintf(error_message, 256,
+               "Could not allocate memory for epoch record\n");
+      return NULL;
+    }
+    atomic_init(&record->in_use, 1);
+    record->next = atomic_load(&records);
+    while (!atomic_compare_exchange_weak(&records, &record->next, record)) {
+    }
+  }
+
+  record->nesting = 0;
+  pthread_setspecific(record_key, record);
+  thread_record = record;
+  return record;
+}
+
+int epoch_enter(char *error_message) {
+  struct epoch_record *record = get_record(error_message);
+
+  if (record == NULL) {
+    return FAILURE;
+  }
+  if (record->nesting++ == 0) {
+    atomic_store(&record->announced, (atomic_load(&global_epoch) << 1) | 1);
+    // the announcement must be visible before any shared object is read
+    atomic_thread_fence(memory_order_seq_cst);
+  }
+  return SUCCESS;
+}
+
+void epoch_exit(void) {
+  struct epoch_record *record = thread_record;
+
+  if (--record->nesting == 0) {
+    atomic_store_explicit(&record->announced, INACTIVE, memory_order_release);
+  }
+}
+
+// advances the global epoch if all threads in a read section announced it
+static unsigned long long try_advance(void) {
+  unsigned long long epoch = atomic_load(&global_epoch);
+
+  atomic_thread_fence(memory_order_seq_cst);
+  for (struct epoch_record *record = atomic_load(&records); record != NULL;
+       record = record->next) {
+    unsigned long long announced = atomic_load(&record->announced);
+    if (announced != INACTIVE && (announced >> 1) != epoch) {
+      return epoch;
+    }
+  }
+
+  atomic_compare_exchange_strong(&global_epoch, &epoch, epoch + 1);
+  return atomic_load(&global_epoch);
+}
+
+// removes the objects that can be released from the list, the caller releases
+// them without holding the lock
+static struct retired_object *take_releasable(unsigned long long epoch) {
+  struct retired_object *releasable = NULL;
+  struct retired_object **link = &retired;
+
+  while (*link != NULL) {
+    struct retired_object *object = *link;
+    if (object->epoch + 2 <= epoch) {
+      *link = object->next;
+      object->next = releasable;
+      releasable = object;
+      retired_count--;
+    } else {
+      link = &object->next;
+    }
+  }
+  return releasable;
+}
+
+static void release_all(struct retired_object *releasable) {
+  while (releasable != NULL) {
+    struct retired_object *next = releasable->next;
+    releasable->release(releasable->object);
+    free(releasable);
+    releasable = next;
+  }
+}
+
+int epoch_retire(char *error_message, void *object, epoch_release release) {
+  struct retired_object *entry = malloc(sizeof(struct retired_object));
+
+  if (entry == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for retired object\n");
+    return FAILURE;
+  }
+  entry->object = object;
+  entry->release = release;
+
+  pthread_mutex_lock(&retired_lock);
+  entry->epoch = atomic_load(&global_epoch);
+  entry->next = retired;
+  retired = entry;
+  retired_count++;
+  struct retired_object *releasable = take_releasable(try_advance());
+  pthread_mutex_unlock(&retired_lock);
+
+  release_all(releasable);
+  return SUCCESS;
+}
+
+unsigned long long epoch_reclaim(void) {
+  pthread_mutex_lock(&retired_lock);
+  // two advances are needed for objects retired in the current epoch
+  try_advance();
+  struct retired_object *releasable = take_releasable(try_advance());
+  unsigned long long waiting = retired_count;
+  pthread_mutex_unlock(&retired_lock);
+
+  release_all(releasable);
+  return waiting;
+}
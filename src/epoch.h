@@ -0,0 +1,48 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// releases an object once no reader can access it anymore
+typedef void (*epoch_release)(void *object);
+
+// Marks the start of a read section of the calling thread. Objects that are
+// retired after it started are not released before it ends. Sections can be
+// nested and must not block on other threads. Every successful call must be
+// followed by a call to epoch_exit on the same thread.
+int epoch_enter(char *error_message);
+
+void epoch_exit(void);
+
+// Schedules the release of an object that can't be reached by new readers
+// anymore. The release function is called by a later call to epoch_retire or
+// epoch_reclaim, after all read sections that might still access the object
+// have ended. It must not retire objects itself.
+int epoch_retire(char *error_message, void *object, epoch_release release);
+
+// releases the retired objects that can't be accessed anymore and returns the
+// number of objects that are still waiting
+unsigned long long epoch_reclaim(void);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+
+#include "keccak.h"
+
+#define KECCAK_ROUNDS 24
+
+static const uint64_t round_constants[KECCAK_ROUNDS] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+// rotation offsets and target lanes of the combined rho and pi steps, in the
+// order in which the lanes are visited starting with lane 1
+static const unsigned int rotations[24] = {1,  3,  6,  10, 15, 21, 28, 36,
+                                           45, 55, 2,  14, 27, 41, 56, 8,
+                                           25, 43, 62, 18, 39, 61, 20, 44};
+static const unsigned int pi_lanes[24] = {10, 7,  11, 17, 18, 3,  5,  16,
+                                          8,  21, 24, 4,  15, 23, 19, 13,
+                                          12, 2,  20, 14, 22, 9,  6,  1};
+
+static uint64_t rotate_left(uint64_t value, unsigned int shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+static void keccak_f1600(uint64_t state[25]) {
+  uint64_t c[5];
+
+  for (int round = 0; round < KECCAK_ROUNDS; round++) {
+    // theta
+    for (int x = 0; x < 5; x++) {
+      c[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^
+             state[x + 20];
+    }
+    for (int x = 0; x < 5; x++) {
+      uint64_t d = c[(x + 4) % 5] ^ rotate_left(c[(x + 1) % 5], 1);
+      for (int y = 0; y < 25; y += 5) {
+        state[y + x] ^= d;
+      }
+    }
+
+    // rho and pi
+    uint64_t current = state[1];
+    for (int i = 0; i < 24; i++) {
+      unsigned int lane = pi_lanes[i];
+      uint64_t next = state[lane];
+      state[lane] = rotate_left(current, rotations[i]);
+      current = next;
+    }
+
+    // chi
+    for (int y = 0; y < 25; y += 5) {
+      for (int x = 0; x < 5; x++) {
+        c[x] = state[y + x];
+      }
+      for (int x = 0; x < 5; x++) {
+        state[y + x] = c[x] ^ (~c[(x + 1) % 5] & c[(x + 2) % 5]);
+      }
+    }
+
+    // iota
+    state[0] ^= round_constants[round];
+  }
+}
+
+// the lanes are little-endian, independent of the byte order of the host
+static void xor_byte(uint64_t state[25], size_t offset, unsigned char byte) {
+  state[offset / 8] ^= (uint64_t)byte << (8 * (offset % 8));
+}
+
+static uint64_t load_lane(const unsigned char *data) {
+  uint64_t lane = 0;
+  for (int i = 7; i >= 0; i--) {
+    lane = (lane << 8) | data[i];
+  }
+  return lane;
+}
+
+void keccak_256_init(struct keccak_256_ctx *ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+void keccak_256_update(struct keccak_256_ctx *ctx, const unsigned char *data,
+                       size_t len) {
+  // completes the current block
+  while (len > 0 && ctx->offset != 0) {
+    xor_byte(ctx->state, ctx->offset++, *data++);
+    len--;
+    if (ctx->offset == KECCAK_256_RATE) {
+      keccak_f1600(ctx->state);
+      ctx->offset = 0;
+    }
+  }
+
+  // absorbs full blocks a lane at a time
+  while (len >= KECCAK_256_RATE) {
+    for (int i = 0; i < KECCAK_256_RATE / 8; i++) {
+      ctx->state[i] ^= load_lane(data + 8 * i);
+    }
+    keccak_f1600(ctx->state);
+    data += KECCAK_256_RATE;
+    len -= KECCAK_256_RATE;
+  }
+
+  while (len > 0) {
+    xor_byte(ctx->state, ctx->offset++, *data++);
+    len--;
+  }
+}
+
+void keccak_256_final(struct keccak_256_ctx *ctx,
+                      unsigned char digest[KECCAK_256_DIGEST_LEN]) {
+  // the original Keccak padding, SHA-3 uses 0x06 instead of 0x01
+  xor_byte(ctx->state, ctx->offset, 0x01);
+  xor_byte(ctx->state, KECCAK_256_RATE - 1, 0x80);
+  keccak_f1600(ctx->state);
+
+  for (int i = 0; i < KECCAK_256_DIGEST_LEN; i++) {
+    digest[i] = (unsigned char)(ctx->state[i / 8] >> (8 * (i % 8)));
+  }
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+void keccak_256(const unsigned char *data, size_t len,
+                unsigned char digest[KECCAK_256_DIGEST_LEN]) {
+  struct keccak_256_ctx ctx;
+  keccak_256_init(&ctx);
+  keccak_256_update(&ctx, data, len);
+  keccak_256_final(&ctx, digest);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Keccak-256 as used by Ethereum, which differs from SHA3-256 only in the
+// padding. It is implemented here, because OpenSSL only provides it since
+// version 3.2.
+#define KECCAK_256_DIGEST_LEN 32
+// size of the blocks that are absorbed by one permutation
+#define KECCAK_256_RATE 136
+
+struct keccak_256_ctx {
+  uint64_t state[25];
+  // number of bytes absorbed into the current block
+  size_t offset;
+};
+
+void keccak_256_init(struct keccak_256_ctx *ctx);
+
+void keccak_256_update(struct keccak_256_ctx *ctx, const unsigned char *data,
+                       size_t len);
+
+void keccak_256_final(struct keccak_256_ctx *ctx,
+                      unsigned char digest[KECCAK_256_DIGEST_LEN]);
+
+void keccak_256(const unsigned char *data, size_t len,
+                unsigned char digest[KECCAK_256_DIGEST_LEN]);
+
+#ifdef __cplusplus
+extern
+}
+#endif
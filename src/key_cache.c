@@ -0,0 +1,417 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/rand.h"
+
+#include "besu_native_ec.h"
+#include "concurrent_table.h"
+#include "constants.h"
+#include "ec_key.h"
+#include "epoch.h"
+#include "key_cache.h"
+#include "memory_budget.h"
+
+// The imported keys are held by a concurrent table, so that verifying with a
+// cached key doesn't take any lock. Changing the capacity replaces the table,
+// the old one is freed once no reader uses it anymore.
+static _Atomic(struct concurrent_table *) table = NULL;
+static pthread_once_t table_initialized = PTHREAD_ONCE_INIT;
+static pthread_mutex_t configuration_lock = PTHREAD_MUTEX_INITIALIZER;
+// memory of the current table, changed with the configuration lock
+static size_t reserved = 0;
+
+static atomic_int enabled = 1;
+static atomic_ullong capacity = KEY_CACHE_DEFAULT_CAPACITY;
+// counters of the replaced tables and of misses without a table
+static atomic_ullong retired_hits = 0;
+static atomic_ullong retired_misses = 0;
+static atomic_ullong retired_evictions = 0;
+
+// A count-min sketch of the misses of each key. With an admission threshold
+// above 1, a key is only cached once it missed that often, so that a flood of
+// keys that are seen once doesn't evict the keys of repeat signers. Only
+// misses are counted, which pay for an import anyway, hits don't write to it.
+static _Atomic uint8_t sketch[KEY_CACHE_SKETCH_ROWS][KEY_CACHE_SKETCH_WIDTH];
+// keys might be chosen by an attacker, so the hash is seeded
+static uint64_t sketch_seed = 0;
+static atomic_ullong sketch_misses = 0;
+static atomic_int admission_threshold = KEY_CACHE_DEFAULT_ADMISSION_THRESHOLD;
+static atomic_ullong rejections = 0;
+
+static int acquire_key(void *key) { return EVP_PKEY_up_ref(key); }
+
+static void release_key(void *key) { EVP_PKEY_free(key); }
+
+// memory of the table and of the keys it can hold
+static size_t table_size(size_t table_capacity) {
+  return concurrent_table_memory_size(table_capacity,
+                                      sizeof(struct key_cache_key),
+                                      sizeof(EVP_PKEY *)) +
+         table_capacity * MEMORY_BUDGET_KEY_OBJECT_SIZE;
+}
+
+static struct concurrent_table *new_table(char *error_message) {
+  struct concurrent_table *new_cache = NULL;
+  size_t table_capacity = atomic_load(&capacity);
+
+  if (!atomic_load(&enabled) || table_capacity == 0 ||
+      memory_budget_reserve(error_message, MEMORY_SUBSYSTEM_KEY_CACHE,
+                            table_size(table_capacity)) != SUCCESS) {
+    return NULL;
+  }
+  if ((new_cache = concurrent_table_new(
+           error_message, table_capacity, sizeof(struct key_cache_key),
+           sizeof(EVP_PKEY *), release_key)) == NULL) {
+    memory_budget_release(MEMORY_SUBSYSTEM_KEY_CACHE,
+                          table_size(table_capacity));
+    return NULL;
+  }
+  reserved = table_size(table_capacity);
+  return new_cache;
+}
+
+static void reclaim_table(void);
+
+// without a table the keys are not cached
+static void initialize_table(void) {
+  char error_message[256];
+
+  if (RAND_bytes((unsigned char *)&sketch_seed, sizeof(sketch_seed)) !=
+      SUCCESS) {
+    sketch_seed = (uint64_t)(uintptr_t)&sketch_seed;
+  }
+  memory_budget_set_reclaim(MEMORY_SUBSYSTEM_KEY_CACHE, reclaim_table);
+  atomic_store(&table, new_table(error_message));
+}
+
+// must be called with the configuration lock
+static int retire_table(char *error_message) {
+  struct concurrent_table *replaced = atomic_exchange(&table, NULL);
+  if (replaced == NULL) {
+    return SUCCESS;
+  }
+
+  struct concurrent_table_shard_stats stats;
+  concurrent_table_stats(replaced, &stats);
+  atomic_fetch_add(&retired_hits, stats.hits);
+  atomic_fetch_add(&retired_misses, stats.misses);
+  atomic_fetch_add(&retired_evictions, stats.evictions);
+
+  // if it can't be retired, it can't be freed safely and is leaked
+  if (epoch_retire(error_message, replaced, concurrent_table_free) !=
+      SUCCESS) {
+    return FAILURE;
+  }
+  memory_budget_release(MEMORY_SUBSYSTEM_KEY_CACHE, reserved);
+  reserved = 0;
+  return SUCCESS;
+}
+
+// Must be called with the configuration lock. The table is retired before
+// the replacement is created, so that its memory counts for the replacement.
+static int replace_table(char *error_message) {
+  if (retire_table(error_message) != SUCCESS) {
+    return FAILURE;
+  }
+  if (!atomic_load(&enabled) || atomic_load(&capacity) == 0) {
+    return SUCCESS;
+  }
+
+  struct concurrent_table *replacement = new_table(error_message);
+  if (replacement == NULL) {
+    return FAILURE;
+  }
+  atomic_store(&table, replacement);
+  return SUCCESS;
+}
+
+// evicts all keys if the memory budget is exhausted, the keys are not cached
+// until the cache is configured again
+static void reclaim_table(void) {
+  char error_message[256];
+
+  pthread_mutex_lock(&configuration_lock);
+  retire_table(error_message);
+  pthread_mutex_unlock(&configuration_lock);
+}
+
+// adds the key to the cache and returns the cached key if another thread
+// added it in the meantime
+static EVP_PKEY *insert_key(struct concurrent_table *cache, EVP_PKEY *key,
+                            const struct key_cache_key *cache_key) {
+  char error_message[256];
+  EVP_PKEY *cached = NULL;
+
+  // the reference of the cache
+  EVP_PKEY_up_ref(key);
+  int result = concurrent_table_insert(cache, error_message, cache_key, &key,
+                                       &cached, acquire_key);
+  if (result == CONCURRENT_TABLE_EXISTS) {
+    EVP_PKEY_free(key);
+    EVP_PKEY_free(key);
+    return cached;
+  }
+  if (result != CONCURRENT_TABLE_INSERTED) {
+    // the key is still valid, but not cached
+    EVP_PKEY_free(key);
+  }
+  return key;
+}
+
+// splitmix64 finalizer
+static uint64_t mix(uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+// After the first KEY_CACHE_SKETCH_AGING misses, every counter is halved once
+// per KEY_CACHE_SKETCH_AGING misses, so that the estimates follow recent use.
+// One counter is halved at a time, so that no miss pays for aging the whole
+// sketch.
+static void age_sketch(void) {
+  const unsigned long long counters =
+      KEY_CACHE_SKETCH_ROWS * KEY_CACHE_SKETCH_WIDTH;
+  const unsigned long long misses_per_counter =
+      KEY_CACHE_SKETCH_AGING / counters;
+  unsigned long long miss = atomic_fetch_add(&sketch_misses, 1);
+
+  if (miss < KEY_CACHE_SKETCH_AGING || miss % misses_per_counter != 0) {
+    return;
+  }
+  size_t counter = (miss / misses_per_counter) % counters;
+  _Atomic uint8_t *aged = &sketch[counter / KEY_CACHE_SKETCH_WIDTH]
+                                 [counter % KEY_CACHE_SKETCH_WIDTH];
+  uint8_t count = atomic_load(aged);
+  // a concurrent increment wins, the counter is halved again next time
+  atomic_compare_exchange_strong(aged, &count, count / 2);
+}
+
+// Counts a miss of the key and returns the estimated number of its recent
+// misses. Only the smallest counters are incremented (conservative update),
+// which keeps the estimates of rare keys from growing with collisions.
+static unsigned int count_miss(const struct key_cache_key *cache_key) {
+  uint64_t words[(sizeof(struct key_cache_key) + 7) / 8] = {0};
+  _Atomic uint8_t *counters[KEY_CACHE_SKETCH_ROWS];
+  uint64_t h = mix(sketch_seed);
+  unsigned int estimate = UINT8_MAX;
+
+  memcpy(words, cache_key, sizeof(*cache_key));
+  for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+    h = mix(h ^ words[i]);
+  }
+  for (int row = 0; row < KEY_CACHE_SKETCH_ROWS; row++) {
+    counters[row] = &sketch[row][(h >> (16 * row)) % KEY_CACHE_SKETCH_WIDTH];
+    unsigned int count = atomic_load(counters[row]);
+    estimate = count < estimate ? count : estimate;
+  }
+  if (estimate < UINT8_MAX) {
+    for (int row = 0; row < KEY_CACHE_SKETCH_ROWS; row++) {
+      uint8_t count = (uint8_t)estimate;
+      atomic_compare_exchange_strong(counters[row], &count, count + 1);
+    }
+    estimate++;
+  }
+
+  age_sketch();
+  return estimate;
+}
+
+// keys are cached once they missed as often as the admission threshold
+static int admit_key(const struct key_cache_key *cache_key) {
+  int threshold = atomic_load(&admission_threshold);
+
+  if (threshold <= 1 || (int)count_miss(cache_key) >= threshold) {
+    return 1;
+  }
+  atomic_fetch_add(&rejections, 1);
+  return 0;
+}
+
+static int import_key(EVP_PKEY **key, char *error_message,
+                      const unsigned char public_key_data[],
+                      const size_t public_key_len, const int encoded,
+                      const char *group_name) {
+  if (encoded) {
+    return create_public_key_from_encoding(key, error_message, public_key_data,
+                                           public_key_len, group_name);
+  }
+  return create_public_key(key, error_message, public_key_data,
+                           (uint8_t)public_key_len, group_name);
+}
+
+int key_cache_import(EVP_PKEY **key, char *error_message,
+                     const struct key_cache_key *cache_key,
+                     const char *group_name) {
+  return import_key(key, error_message, cache_key->public_key,
+                    cache_key->public_key_len, cache_key->encoded, group_name);
+}
+
+static EVP_PKEY *get_key(char *error_message,
+                         const unsigned char public_key_data[],
+                         const size_t public_key_len, const int encoded,
+                         const char *group_name, const int curve_nid) {
+  EVP_PKEY *key = NULL;
+
+  if (!atomic_load(&enabled) ||
+      public_key_len > KEY_CACHE_MAX_PUBLIC_KEY_LEN) {
+    import_key(&key, error_message, public_key_data, public_key_len, encoded,
+               group_name);
+    return key;
+  }
+
+  pthread_once(&table_initialized, initialize_table);
+  struct key_cache_key cache_key;
+  memset(&cache_key, 0, sizeof(cache_key));
+  cache_key.curve_nid = curve_nid;
+  cache_key.public_key_len = (uint16_t)public_key_len;
+  cache_key.encoded = (uint16_t)encoded;
+  memcpy(cache_key.public_key, public_key_data, public_key_len);
+
+  // the table can't be freed while it is used
+  if (epoch_enter(error_message) != SUCCESS) {
+    return NULL;
+  }
+  struct concurrent_table *cache = atomic_load(&table);
+  int found = 0;
+  if (cache == NULL) {
+    atomic_fetch_add(&retired_misses, 1);
+  } else if ((found = concurrent_table_get(cache, error_message, &cache_key,
+                                           &key, acquire_key)) < 0) {
+    epoch_exit();
+    return NULL;
+  }
+  epoch_exit();
+
+  if (found) {
+    return key;
+  }
+
+  // the import is the expensive part and is done outside of the read section
+  if (key_cache_import(&key, error_message, &cache_key, group_name) !=
+      SUCCESS) {
+    return NULL;
+  }
+  if (!admit_key(&cache_key)) {
+    return key;
+  }
+
+  if (epoch_enter(error_message) != SUCCESS) {
+    // the key is valid, but not cached
+    error_message[0] = '\0';
+    return key;
+  }
+  if ((cache = atomic_load(&table)) != NULL) {
+    key = insert_key(cache, key, &cache_key);
+  }
+  epoch_exit();
+
+  return key;
+}
+
+EVP_PKEY *key_cache_get(char *error_message,
+                        const unsigned char public_key_data[],
+                        const size_t public_key_len, const char *group_name,
+                        const int curve_nid) {
+  return get_key(error_message, public_key_data, public_key_len, 0,
+                 group_name, curve_nid);
+}
+
+EVP_PKEY *key_cache_get_encoded(char *error_message,
+                                const unsigned char encoded_key[],
+                                const size_t encoded_key_len,
+                                const char *group_name, const int curve_nid) {
+  return get_key(error_message, encoded_key, encoded_key_len, 1, group_name,
+                 curve_nid);
+}
+
+void besu_native_ec_key_cache_set_enabled(const int enable) {
+  char error_message[256];
+
+  pthread_once(&table_initialized, initialize_table);
+  pthread_mutex_lock(&configuration_lock);
+  if (atomic_exchange(&enabled, enable != 0) != (enable != 0)) {
+    replace_table(error_message);
+  }
+  pthread_mutex_unlock(&configuration_lock);
+}
+
+int besu_native_ec_key_cache_set_capacity(char *error_message,
+                                          const long long new_capacity) {
+  if (new_capacity < 0 || new_capacity > (1LL << 24)) {
+    snprintf(error_message, 256,
+             "Capacity of key cache must be between 0 and %lld\n", 1LL << 24);
+    return FAILURE;
+  }
+
+  pthread_once(&table_initialized, initialize_table);
+  pthread_mutex_lock(&configuration_lock);
+  atomic_store(&capacity, new_capacity);
+  int result = replace_table(error_message);
+  pthread_mutex_unlock(&configuration_lock);
+  return result;
+}
+
+int besu_native_ec_key_cache_set_admission_threshold(
+    char *error_message, const long long threshold) {
+  if (threshold < 1 || threshold > UINT8_MAX) {
+    snprintf(error_message, 256,
+             "Admission threshold of key cache must be between 1 and %d\n",
+             UINT8_MAX);
+    return FAILURE;
+  }
+
+  atomic_store(&admission_threshold, (int)threshold);
+  return SUCCESS;
+}
+
+struct key_cache_stats besu_native_ec_key_cache_stats(void) {
+  char error_message[256];
+  struct key_cache_stats stats = {
+      .hits = atomic_load(&retired_hits),
+      .misses = atomic_load(&retired_misses),
+      .evictions = atomic_load(&retired_evictions),
+      .rejections = atomic_load(&rejections),
+      .capacity = atomic_load(&capacity),
+      .admission_threshold = atomic_load(&admission_threshold),
+      .enabled = atomic_load(&enabled)};
+
+  pthread_once(&table_initialized, initialize_table);
+  if (epoch_enter(error_message) != SUCCESS) {
+    return stats;
+  }
+  struct concurrent_table *cache = atomic_load(&table);
+  if (cache != NULL) {
+    struct concurrent_table_shard_stats table_stats;
+    concurrent_table_stats(cache, &table_stats);
+    stats.hits += table_stats.hits;
+    stats.misses += table_stats.misses;
+    stats.evictions += table_stats.evictions;
+    stats.entries = table_stats.entries;
+  }
+  epoch_exit();
+
+  return stats;
+}
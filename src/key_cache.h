@@ -0,0 +1,71 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#include "openssl/include/openssl/evp.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KEY_CACHE_DEFAULT_CAPACITY 4096
+#define KEY_CACHE_MAX_PUBLIC_KEY_LEN 132
+// every key is cached on its first miss
+#define KEY_CACHE_DEFAULT_ADMISSION_THRESHOLD 1
+// the sketch of the misses of each key, 16 KiB of 8-bit counters
+#define KEY_CACHE_SKETCH_ROWS 4
+#define KEY_CACHE_SKETCH_WIDTH 4096
+// number of misses after which every counter of the sketch has been halved
+#define KEY_CACHE_SKETCH_AGING (16 * KEY_CACHE_SKETCH_WIDTH)
+
+// the key of the concurrent table that holds the imported keys, unused bytes
+// of public_key are 0
+struct key_cache_key {
+  int32_t curve_nid;
+  uint16_t public_key_len;
+  // 1 if public_key is encoded as in SEC 1, otherwise it is x || y
+  uint16_t encoded;
+  unsigned char public_key[KEY_CACHE_MAX_PUBLIC_KEY_LEN];
+};
+
+// Returns the imported public key with a reference that the caller has to
+// release with EVP_PKEY_free. The key is imported and added to the cache if it
+// is not cached yet. Keys that can't be imported are not cached.
+EVP_PKEY *key_cache_get(char *error_message,
+                        const unsigned char public_key_data[],
+                        const size_t public_key_len, const char *group_name,
+                        const int curve_nid);
+
+// like key_cache_get, for a public key that is encoded as in SEC 1
+EVP_PKEY *key_cache_get_encoded(char *error_message,
+                                const unsigned char encoded_key[],
+                                const size_t encoded_key_len,
+                                const char *group_name, const int curve_nid);
+
+// imports the public key of a cache key without caching it
+int key_cache_import(EVP_PKEY **key, char *error_message,
+                     const struct key_cache_key *cache_key,
+                     const char *group_name);
+
+#ifdef __cplusplus
+extern
+}
+#endif
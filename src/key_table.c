@@ -0,0 +1,688 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mmap and fsync are not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "openssl/include/openssl/crypto.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_key.h"
+#include "ec_verify.h"
+#include "key_cache.h"
+#include "key_table.h"
+#include "memory_budget.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+static const uint8_t P256_PUBLIC_KEY_LENGTH = 64;
+
+// x of the largest supported curve, P-521, and the prefix of the encoding
+#define MAX_COMPRESSED_KEY_LEN 67
+
+// key_count is converted to size_t by key_table_create, a negative count
+// would become a huge one
+static int check_key_count(char *error_message, const int key_count) {
+  if (key_count <= 0) {
+    snprintf(error_message, 256,
+             "Number of keys of key table must be at least 1, but is %d\n",
+             key_count);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+int p256_key_table_create(struct p256_key_table **table, char *error_message,
+                          const char public_keys[], const int key_count) {
+  if (check_key_count(error_message, key_count) != SUCCESS) {
+    return FAILURE;
+  }
+
+  return key_table_create(table, error_message,
+                          (const unsigned char *)public_keys, key_count,
+                          P256_PUBLIC_KEY_LENGTH, KEY_TABLE_FULL, "prime256v1",
+                          NID_X9_62_prime256v1);
+}
+
+int p256_key_table_create_with_format(struct p256_key_table **table,
+                                      char *error_message,
+                                      const char public_keys[],
+                                      const int key_count, const int format) {
+  if (format != KEY_TABLE_FULL && format != KEY_TABLE_COMPACT) {
+    snprintf(error_message, 256, "Unknown key table format %d\n", format);
+    return FAILURE;
+  }
+  if (check_key_count(error_message, key_count) != SUCCESS) {
+    return FAILURE;
+  }
+
+  return key_table_create(table, error_message,
+                          (const unsigned char *)public_keys, key_count,
+                          P256_PUBLIC_KEY_LENGTH, format, "prime256v1",
+                          NID_X9_62_prime256v1);
+}
+
+int p256_key_table_save(const struct p256_key_table *table,
+                        char *error_message, const char *path) {
+  return key_table_save(table, error_message, path);
+}
+
+int p256_key_table_load(struct p256_key_table **table, char *error_message,
+                        const char *path) {
+  return key_table_load(table, error_message, path, P256_PUBLIC_KEY_LENGTH,
+                        "prime256v1", NID_X9_62_prime256v1);
+}
+
+void p256_key_table_free(struct p256_key_table *table) {
+  key_table_free(table);
+}
+
+int p256_key_table_find(const struct p256_key_table *table,
+                        const char public_key_data[]) {
+  return (int)key_table_find(table, (const unsigned char *)public_key_data);
+}
+
+struct verify_result p256_key_table_verify(struct p256_key_table *table,
+                                           const int key_index,
+                                           const char data_hash[],
+                                           const int data_hash_length,
+                                           const char signature_r[],
+                                           const char signature_s[]) {
+  struct verify_result result = {.verified = GENERIC_ERROR,
+                                 .error_message = {0}};
+
+  EVP_PKEY *key = NULL;
+  int signature_arr_len = table->public_key_len / 2;
+
+  if (key_index < 0 || (size_t)key_index >= table->entry_count) {
+    snprintf(result.error_message, 256,
+             "Key index %d is out of bounds of the key table\n", key_index);
+    return result;
+  }
+
+  if (check_signature_canonicalized(result.error_message, signature_s,
+                                    signature_arr_len,
+                                    table->curve_nid) != SUCCESS) {
+    return result;
+  }
+
+  if ((key = key_table_get_key(table, result.error_message, key_index)) ==
+      NULL) {
+    return result;
+  }
+
+  verify_with_key(&result, key, data_hash, data_hash_length, signature_r,
+                  signature_s, signature_arr_len);
+  EVP_PKEY_free(key);
+
+  return result;
+}
+
+struct key_table_sort_entry {
+  const unsigned char *key;
+  size_t len;
+};
+
+static int compare_sort_entries(const void *a, const void *b) {
+  const struct key_table_sort_entry *entry_a = a;
+  const struct key_table_sort_entry *entry_b = b;
+
+  return memcmp(entry_a->key, entry_b->key, entry_a->len);
+}
+
+// the compressed encoding is x with the parity of y in its prefix
+static size_t compressed_key_len(size_t public_key_len) {
+  return 1 + public_key_len / 2;
+}
+
+static void compress_key(unsigned char compressed_key[],
+                         const unsigned char public_key[],
+                         size_t public_key_len) {
+  compressed_key[0] =
+      POINT_CONVERSION_COMPRESSED | (public_key[public_key_len - 1] & 1);
+  memcpy(compressed_key + 1, public_key, public_key_len / 2);
+}
+
+static int validate_key(char *error_message, const unsigned char public_key[],
+                        size_t public_key_len, const char *group_name) {
+  EVP_PKEY *key = NULL;
+  int ret = create_public_key(&key, error_message, public_key,
+                              (uint8_t)public_key_len, group_name);
+
+  EVP_PKEY_free(key);
+  return ret;
+}
+
+static struct p256_key_table *new_key_table(size_t public_key_len,
+                                            enum key_table_format format,
+                                            const char *group_name,
+                                            int curve_nid) {
+  struct p256_key_table *table = calloc(1, sizeof(struct p256_key_table));
+
+  if (table != NULL) {
+    table->entry_len = format == KEY_TABLE_COMPACT
+                           ? compressed_key_len(public_key_len)
+                           : public_key_len;
+    table->public_key_len = public_key_len;
+    table->format = format;
+    table->group_name = group_name;
+    table->curve_nid = curve_nid;
+  }
+
+  return table;
+}
+
+// the keys are imported by OpenSSL, so their memory can only be estimated
+static int reserve_keys(struct p256_key_table *table, char *error_message,
+                        size_t key_count) {
+  size_t len =
+      key_count * (sizeof(EVP_PKEY *) + MEMORY_BUDGET_KEY_OBJECT_SIZE);
+
+  if (memory_budget_reserve(error_message, MEMORY_SUBSYSTEM_KEY_TABLES, len) !=
+      SUCCESS) {
+    return FAILURE;
+  }
+  table->keys_reserved_len = len;
+  return SUCCESS;
+}
+
+struct key_table_import {
+  struct p256_key_table *table;
+  atomic_int failed;
+  // the error of the first key that could not be imported
+  char error_message[256];
+};
+
+static void import_key_range(void *context, size_t begin, size_t end) {
+  struct key_table_import *import = context;
+  char error_message[256];
+
+  for (size_t i = begin; i < end && !atomic_load(&import->failed); i++) {
+    EVP_PKEY *key = key_table_get_key(import->table, error_message, i);
+    if (key == NULL) {
+      if (atomic_exchange(&import->failed, 1) == 0) {
+        memcpy(import->error_message, error_message, 256);
+      }
+      return;
+    }
+    EVP_PKEY_free(key);
+  }
+}
+
+// Imports all keys of a full table on the worker pool. Importing validates the
+// keys and precomputes them for verification, so that no verification pays
+// for it.
+static int import_keys(struct p256_key_table *table, char *error_message) {
+  struct key_table_import import = {.table = table};
+  atomic_init(&import.failed, 0);
+
+  worker_pool_run(table->entry_count, import_key_range, &import);
+
+  if (atomic_load(&import.failed)) {
+    memcpy(error_message, import.error_message, 256);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+int key_table_create(struct p256_key_table **table, char *error_message,
+                     const unsigned char public_keys[], size_t key_count,
+                     size_t public_key_len, enum key_table_format format,
+                     const char *group_name, int curve_nid) {
+  int ret = FAILURE;
+
+  struct key_table_sort_entry *sort_entries = NULL;
+  unsigned char *compressed_keys = NULL;
+  struct p256_key_table *new_table = NULL;
+  const unsigned char *keys = public_keys;
+
+  if ((new_table = new_key_table(public_key_len, format, group_name,
+                                 curve_nid)) == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for key table of %zu keys\n",
+             key_count);
+    goto end_key_table_create;
+  }
+  size_t entry_len = new_table->entry_len;
+  if (format == KEY_TABLE_FULL &&
+      reserve_keys(new_table, error_message, key_count) != SUCCESS) {
+    goto end_key_table_create;
+  }
+  if ((sort_entries = calloc(key_count,
+                             sizeof(struct key_table_sort_entry))) == NULL ||
+      (format == KEY_TABLE_FULL &&
+       (new_table->keys = calloc(key_count, sizeof(EVP_PKEY *))) == NULL) ||
+      (format == KEY_TABLE_COMPACT &&
+       (compressed_keys = malloc(key_count * entry_len)) == NULL)) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for key table of %zu keys\n",
+             key_count);
+    goto end_key_table_create;
+  }
+
+  // compressing drops y, so the keys are validated before
+  if (format == KEY_TABLE_COMPACT) {
+    for (size_t i = 0; i < key_count; i++) {
+      const unsigned char *public_key = public_keys + i * public_key_len;
+      if (validate_key(error_message, public_key, public_key_len,
+                       group_name) != SUCCESS) {
+        goto end_key_table_create;
+      }
+      compress_key(compressed_keys + i * entry_len, public_key,
+                   public_key_len);
+    }
+    keys = compressed_keys;
+  }
+
+  if (table_memory_alloc(&new_table->memory, error_message,
+                         MEMORY_SUBSYSTEM_KEY_TABLES,
+                         key_count * entry_len) != SUCCESS) {
+    goto end_key_table_create;
+  }
+
+  for (size_t i = 0; i < key_count; i++) {
+    sort_entries[i].key = keys + i * entry_len;
+    sort_entries[i].len = entry_len;
+  }
+  qsort(sort_entries, key_count, sizeof(struct key_table_sort_entry),
+        compare_sort_entries);
+
+  // duplicates are dropped, so that every key has exactly one index
+  unsigned char *entries = new_table->memory.data;
+  for (size_t i = 0; i < key_count; i++) {
+    if (i > 0 && compare_sort_entries(&sort_entries[i - 1],
+                                      &sort_entries[i]) == 0) {
+      continue;
+    }
+
+    memcpy(entries + new_table->entry_count * entry_len, sort_entries[i].key,
+           entry_len);
+    new_table->entry_count++;
+  }
+  new_table->entries = entries;
+
+  if (format == KEY_TABLE_FULL &&
+      import_keys(new_table, error_message) != SUCCESS) {
+    goto end_key_table_create;
+  }
+
+  *table = new_table;
+  new_table = NULL;
+  ret = SUCCESS;
+
+end_key_table_create:
+  free(sort_entries);
+  free(compressed_keys);
+  key_table_free(new_table);
+
+  return ret;
+}
+
+static int calculate_checksum(unsigned char checksum[32], char *error_message,
+                              const struct key_table_file_header *header,
+                              const unsigned char *entries,
+                              size_t entries_len) {
+  int ret = FAILURE;
+
+  struct key_table_file_header header_without_checksum = *header;
+  memset(header_without_checksum.checksum, 0,
+         sizeof(header_without_checksum.checksum));
+
+  EVP_MD_CTX *md_context = NULL;
+
+  if ((md_context = EVP_MD_CTX_new()) == NULL) {
+    set_error_message(error_message,
+                      "Could not allocate memory for checksum context: ");
+    goto end_calculate_checksum;
+  }
+
+  if (EVP_DigestInit_ex(md_context, EVP_sha256(), NULL) != SUCCESS ||
+      EVP_DigestUpdate(md_context, &header_without_checksum,
+                       sizeof(header_without_checksum)) != SUCCESS ||
+      EVP_DigestUpdate(md_context, entries, entries_len) != SUCCESS ||
+      EVP_DigestFinal_ex(md_context, checksum, NULL) != SUCCESS) {
+    set_error_message(error_message,
+                      "Could not calculate checksum of key table: ");
+    goto end_calculate_checksum;
+  }
+
+  ret = SUCCESS;
+
+end_calculate_checksum:
+  EVP_MD_CTX_free(md_context);
+
+  return ret;
+}
+
+static int write_fully(int fd, const void *data, size_t len) {
+  const char *p = data;
+
+  while (len > 0) {
+    ssize_t written = write(fd, p, len);
+
+    if (written < 0) {
+      return FAILURE;
+    }
+
+    p += written;
+    len -= written;
+  }
+
+  return SUCCESS;
+}
+
+int key_table_save(const struct p256_key_table *table, char *error_message,
+                   const char *path) {
+  int ret = FAILURE;
+
+  struct key_table_file_header header = {.version = KEY_TABLE_FILE_VERSION,
+                                         .curve_nid = table->curve_nid,
+                                         .entry_len = table->entry_len,
+                                         .entry_count = table->entry_count};
+  memcpy(header.magic, KEY_TABLE_FILE_MAGIC, sizeof(header.magic));
+
+  size_t entries_len = table->entry_count * table->entry_len;
+  if (calculate_checksum(header.checksum, error_message, &header,
+                         table->entries, entries_len) != SUCCESS) {
+    return FAILURE;
+  }
+
+  // The table is written to a temporary file first and renamed afterwards, so
+  // that processes loading the table never see a partially written file. The
+  // temporary file has a unique name in the same directory, so that concurrent
+  // saves don't write to the same file.
+  char temporary_path[4096];
+  if (snprintf(temporary_path, sizeof(temporary_path), "%s.XXXXXX", path) >=
+      (int)sizeof(temporary_path)) {
+    snprintf(error_message, 256, "Path of key table file is too long\n");
+    return FAILURE;
+  }
+
+  int fd = mkstemp(temporary_path);
+  if (fd < 0) {
+    snprintf(error_message, 256, "Could not create key table file %s\n",
+             path);
+    return FAILURE;
+  }
+
+  // mkstemp creates the file readable by its owner only
+  if (fchmod(fd, 0644) != 0 ||
+      write_fully(fd, &header, sizeof(header)) != SUCCESS ||
+      write_fully(fd, table->entries, entries_len) != SUCCESS ||
+      fsync(fd) != 0) {
+    snprintf(error_message, 256, "Could not write key table file %s\n", path);
+    goto end_key_table_save;
+  }
+
+  if (rename(temporary_path, path) != 0) {
+    snprintf(error_message, 256, "Could not rename key table file to %s\n",
+             path);
+    goto end_key_table_save;
+  }
+
+  ret = SUCCESS;
+
+end_key_table_save:
+  close(fd);
+  if (ret != SUCCESS) {
+    unlink(temporary_path);
+  }
+
+  return ret;
+}
+
+static int validate_key_table_file(char *error_message,
+                                   const unsigned char *mapping,
+                                   size_t mapping_len, size_t public_key_len,
+                                   int curve_nid) {
+  const struct key_table_file_header *header =
+      (const struct key_table_file_header *)mapping;
+
+  if (mapping_len < sizeof(struct key_table_file_header) ||
+      memcmp(header->magic, KEY_TABLE_FILE_MAGIC, sizeof(header->magic)) !=
+          0) {
+    snprintf(error_message, 256, "File is not a key table\n");
+    return FAILURE;
+  }
+
+  if (header->version != KEY_TABLE_FILE_VERSION) {
+    snprintf(error_message, 256,
+             "Unsupported key table version %u, expected %u\n",
+             header->version, KEY_TABLE_FILE_VERSION);
+    return FAILURE;
+  }
+
+  // the length of the entries tells full and compact tables apart
+  size_t entry_len = header->entry_len;
+  if (header->curve_nid != (uint32_t)curve_nid ||
+      (entry_len != public_key_len &&
+       entry_len != compressed_key_len(public_key_len))) {
+    snprintf(error_message, 256, "Key table was created for another curve\n");
+    return FAILURE;
+  }
+
+  size_t entries_len = mapping_len - sizeof(struct key_table_file_header);
+  if (header->entry_count != entries_len / entry_len ||
+      entries_len % entry_len != 0) {
+    snprintf(error_message, 256,
+             "Key table file is truncated or has trailing data\n");
+    return FAILURE;
+  }
+
+  if (header->entry_count == 0) {
+    snprintf(error_message, 256, "Key table file holds no keys\n");
+    return FAILURE;
+  }
+
+  const unsigned char *entries = mapping + sizeof(struct key_table_file_header);
+  unsigned char checksum[32];
+  if (calculate_checksum(checksum, error_message, header, entries,
+                         entries_len) != SUCCESS) {
+    return FAILURE;
+  }
+
+  if (CRYPTO_memcmp(checksum, header->checksum, sizeof(checksum)) != 0) {
+    snprintf(error_message, 256, "Checksum of key table file does not match\n");
+    return FAILURE;
+  }
+
+  // lookups rely on sorted and distinct entries
+  for (size_t i = 1; i < header->entry_count; i++) {
+    if (memcmp(entries + (i - 1) * entry_len, entries + i * entry_len,
+               entry_len) >= 0) {
+      snprintf(error_message, 256, "Entries of key table are not sorted\n");
+      return FAILURE;
+    }
+  }
+
+  return SUCCESS;
+}
+
+int key_table_load(struct p256_key_table **table, char *error_message,
+                   const char *path, size_t public_key_len,
+                   const char *group_name, int curve_nid) {
+  int ret = FAILURE;
+
+  struct p256_key_table *new_table = NULL;
+  struct stat file_stat;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    snprintf(error_message, 256, "Could not open key table file %s\n", path);
+    return FAILURE;
+  }
+
+  if ((new_table = new_key_table(public_key_len, KEY_TABLE_FULL, group_name,
+                                 curve_nid)) == NULL) {
+    snprintf(error_message, 256, "Could not allocate memory for key table\n");
+    goto end_key_table_load;
+  }
+
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    snprintf(error_message, 256, "File is not a key table\n");
+    goto end_key_table_load;
+  }
+
+  // the mapping is read-only and shared, so that all processes of a host that
+  // load the same table use the same physical pages
+  void *mapping =
+      mmap(NULL, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    snprintf(error_message, 256, "Could not map key table file %s\n", path);
+    goto end_key_table_load;
+  }
+  new_table->mapping = mapping;
+  new_table->mapping_len = file_stat.st_size;
+
+  if (validate_key_table_file(error_message, mapping, file_stat.st_size,
+                              public_key_len, curve_nid) != SUCCESS) {
+    goto end_key_table_load;
+  }
+
+  const struct key_table_file_header *header = mapping;
+  new_table->entries =
+      (const unsigned char *)mapping + sizeof(struct key_table_file_header);
+  new_table->entry_count = header->entry_count;
+  if (header->entry_len != public_key_len) {
+    new_table->entry_len = header->entry_len;
+    new_table->format = KEY_TABLE_COMPACT;
+  }
+
+  if (new_table->format == KEY_TABLE_FULL &&
+      (reserve_keys(new_table, error_message, new_table->entry_count) !=
+           SUCCESS ||
+       (new_table->keys = calloc(new_table->entry_count,
+                                 sizeof(EVP_PKEY *))) == NULL)) {
+    if (new_table->keys_reserved_len > 0) {
+      snprintf(error_message, 256,
+               "Could not allocate memory for key table\n");
+    }
+    goto end_key_table_load;
+  }
+
+  // The checksum only detects corruption, a file can still hold keys that are
+  // not on the curve. Importing the keys rejects them, as key_table_create
+  // does.
+  if (new_table->format == KEY_TABLE_FULL &&
+      import_keys(new_table, error_message) != SUCCESS) {
+    goto end_key_table_load;
+  }
+
+  *table = new_table;
+  new_table = NULL;
+  ret = SUCCESS;
+
+end_key_table_load:
+  close(fd);
+  key_table_free(new_table);
+
+  return ret;
+}
+
+void key_table_free(struct p256_key_table *table) {
+  if (table == NULL) {
+    return;
+  }
+
+  if (table->keys != NULL) {
+    for (size_t i = 0; i < table->entry_count; i++) {
+      EVP_PKEY_free(atomic_load(&table->keys[i]));
+    }
+    free(table->keys);
+  }
+
+  memory_budget_release(MEMORY_SUBSYSTEM_KEY_TABLES, table->keys_reserved_len);
+  table_memory_free(&table->memory);
+  if (table->mapping != NULL) {
+    munmap(table->mapping, table->mapping_len);
+  }
+
+  free(table);
+}
+
+long key_table_find(const struct p256_key_table *table,
+                    const unsigned char public_key_data[]) {
+  unsigned char compressed_key[MAX_COMPRESSED_KEY_LEN];
+  const unsigned char *entry = public_key_data;
+  size_t low = 0;
+  size_t high = table->entry_count;
+
+  if (table->format == KEY_TABLE_COMPACT) {
+    compress_key(compressed_key, public_key_data, table->public_key_len);
+    entry = compressed_key;
+  }
+
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    int cmp = memcmp(table->entries + middle * table->entry_len, entry,
+                     table->entry_len);
+
+    if (cmp == 0) {
+      return (long)middle;
+    } else if (cmp < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return -1;
+}
+
+EVP_PKEY *key_table_get_key(struct p256_key_table *table, char *error_message,
+                            size_t index) {
+  const unsigned char *entry = table->entries + index * table->entry_len;
+
+  // only the keys that are used are imported and kept by the key cache
+  if (table->format == KEY_TABLE_COMPACT) {
+    return key_cache_get_encoded(error_message, entry, table->entry_len,
+                                 table->group_name, table->curve_nid);
+  }
+
+  EVP_PKEY *key = atomic_load_explicit(&table->keys[index],
+                                       memory_order_acquire);
+
+  if (key == NULL) {
+    if (create_public_key(&key, error_message, entry, table->entry_len,
+                          table->group_name) != SUCCESS) {
+      return NULL;
+    }
+
+    // another thread might have imported the same key in the meantime, in
+    // which case its key is used and this one is dropped
+    EVP_PKEY *expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(
+            &table->keys[index], &expected, key, memory_order_acq_rel,
+            memory_order_acquire)) {
+      EVP_PKEY_free(key);
+      key = expected;
+    }
+  }
+
+  EVP_PKEY_up_ref(key);
+  return key;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "openssl/include/openssl/evp.h"
+
+#include "table_memory.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KEY_TABLE_FILE_MAGIC "BNECKTBL"
+#define KEY_TABLE_FILE_VERSION 1
+
+// All fields are stored in the byte order of the host. The checksum is the
+// SHA-256 hash of the header, with the checksum itself set to zero, followed
+// by all entries.
+struct key_table_file_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t curve_nid;
+  uint32_t entry_len;
+  uint32_t reserved;
+  uint64_t entry_count;
+  unsigned char checksum[32];
+};
+
+// A table of validated public keys of one curve, e.g. a validator set. The
+// entries are sorted, so that a signer can be found by its key. The only
+// per-key precomputation OpenSSL allows for is the imported and validated
+// EVP_PKEY, which is created for each entry on its first use and shared by
+// all threads afterwards.
+struct p256_key_table {
+  // sorted and distinct keys, either in table memory or in a mapped file
+  const unsigned char *entries;
+  size_t entry_count;
+  size_t entry_len;
+  // length of x || y, the entries of compact tables are compressed points
+  size_t public_key_len;
+  enum key_table_format format;
+  int curve_nid;
+  const char *group_name;
+
+  // owns the entries, if the table has been created in memory
+  struct table_memory memory;
+  // owns the entries, if the table has been loaded from a file
+  void *mapping;
+  size_t mapping_len;
+
+  // the imported keys of full tables, compact tables use the key cache
+  _Atomic(EVP_PKEY *) *keys;
+  // estimated memory of the imported keys, accounted with the memory budget
+  size_t keys_reserved_len;
+};
+
+int key_table_create(struct p256_key_table **table, char *error_message,
+                     const unsigned char public_keys[], size_t key_count,
+                     size_t public_key_len, enum key_table_format format,
+                     const char *group_name, int curve_nid);
+
+int key_table_save(const struct p256_key_table *table, char *error_message,
+                   const char *path);
+
+int key_table_load(struct p256_key_table **table, char *error_message,
+                   const char *path, size_t public_key_len,
+                   const char *group_name, int curve_nid);
+
+void key_table_free(struct p256_key_table *table);
+
+long key_table_find(const struct p256_key_table *table,
+                    const unsigned char public_key_data[]);
+
+// returns the imported key of the entry with a reference that the caller has
+// to release with EVP_PKEY_free
+EVP_PKEY *key_table_get_key(struct p256_key_table *table, char *error_message,
+                            size_t index);
+
+#ifdef __cplusplus
+extern
+}
+#endif
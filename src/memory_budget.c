@@ -0,0 +1,172 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdio.h>
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "epoch.h"
+#include "memory_budget.h"
+
+static const char *subsystem_names[MEMORY_SUBSYSTEM_COUNT] = {
+    "key cache", "ECDH key pools", "recovery indexes", "key tables"};
+
+// The counters are only changed when tables, caches or pools are created or
+// freed, so a single lock is enough.
+static pthread_mutex_t budget_lock = PTHREAD_MUTEX_INITIALIZER;
+// 0 is unlimited
+static unsigned long long budget = 0;
+static unsigned long long used = 0;
+static struct memory_subsystem_stats subsystems[MEMORY_SUBSYSTEM_COUNT];
+static memory_budget_reclaim reclaims[MEMORY_SUBSYSTEM_COUNT];
+
+static int exceeds(unsigned long long limit, unsigned long long current,
+                   size_t bytes) {
+  return limit != 0 && (current > limit || bytes > limit - current);
+}
+
+// Evicts the first subsystem before the given one that uses memory. Returns 0
+// if there is none.
+static int reclaim_before(enum memory_subsystem subsystem) {
+  memory_budget_reclaim reclaim = NULL;
+  int evicted = -1;
+
+  pthread_mutex_lock(&budget_lock);
+  for (int i = 0; i < (int)subsystem && reclaim == NULL; i++) {
+    if (reclaims[i] != NULL && subsystems[i].used > 0) {
+      reclaim = reclaims[i];
+      evicted = i;
+    }
+  }
+  pthread_mutex_unlock(&budget_lock);
+
+  if (reclaim == NULL) {
+    return 0;
+  }
+  reclaim();
+  // the evicted memory is freed once no reader uses it anymore
+  epoch_reclaim();
+
+  pthread_mutex_lock(&budget_lock);
+  subsystems[evicted].reclaimed++;
+  // a subsystem that didn't release its memory is not evicted again
+  int released = subsystems[evicted].used == 0;
+  pthread_mutex_unlock(&budget_lock);
+  return released;
+}
+
+int memory_budget_reserve(char *error_message,
+                          enum memory_subsystem subsystem, size_t bytes) {
+  for (;;) {
+    pthread_mutex_lock(&budget_lock);
+    struct memory_subsystem_stats *stats = &subsystems[subsystem];
+    if (exceeds(stats->quota, stats->used, bytes)) {
+      stats->rejected++;
+      pthread_mutex_unlock(&budget_lock);
+      snprintf(error_message, 256, "Memory quota of %s exceeded\n",
+               subsystem_names[subsystem]);
+      return FAILURE;
+    }
+    if (!exceeds(budget, used, bytes)) {
+      stats->used += bytes;
+      if (stats->used > stats->peak) {
+        stats->peak = stats->used;
+      }
+      used += bytes;
+      pthread_mutex_unlock(&budget_lock);
+      return SUCCESS;
+    }
+    pthread_mutex_unlock(&budget_lock);
+
+    if (!reclaim_before(subsystem)) {
+      pthread_mutex_lock(&budget_lock);
+      stats->rejected++;
+      pthread_mutex_unlock(&budget_lock);
+      snprintf(error_message, 256, "Memory budget exceeded by %s\n",
+               subsystem_names[subsystem]);
+      return FAILURE;
+    }
+  }
+}
+
+void memory_budget_release(enum memory_subsystem subsystem, size_t bytes) {
+  pthread_mutex_lock(&budget_lock);
+  subsystems[subsystem].used -= bytes;
+  used -= bytes;
+  pthread_mutex_unlock(&budget_lock);
+}
+
+void memory_budget_set_reclaim(enum memory_subsystem subsystem,
+                               memory_budget_reclaim reclaim) {
+  pthread_mutex_lock(&budget_lock);
+  reclaims[subsystem] = reclaim;
+  pthread_mutex_unlock(&budget_lock);
+}
+
+int besu_native_ec_memory_set_budget(char *error_message,
+                                     const long long bytes) {
+  if (bytes < 0) {
+    snprintf(error_message, 256, "Memory budget must not be negative\n");
+    return FAILURE;
+  }
+
+  pthread_mutex_lock(&budget_lock);
+  budget = (unsigned long long)bytes;
+  int over_budget = exceeds(budget, used, 0);
+  pthread_mutex_unlock(&budget_lock);
+
+  // the caches are evicted until the used memory fits into the new budget,
+  // the tables and pools of the callers stay until they are freed
+  while (over_budget && reclaim_before(MEMORY_SUBSYSTEM_COUNT)) {
+    pthread_mutex_lock(&budget_lock);
+    over_budget = exceeds(budget, used, 0);
+    pthread_mutex_unlock(&budget_lock);
+  }
+  return SUCCESS;
+}
+
+int besu_native_ec_memory_set_quota(char *error_message, const int subsystem,
+                                    const long long bytes) {
+  if (subsystem < 0 || subsystem >= MEMORY_SUBSYSTEM_COUNT) {
+    snprintf(error_message, 256, "Unknown memory subsystem %d\n", subsystem);
+    return FAILURE;
+  }
+  if (bytes < 0) {
+    snprintf(error_message, 256, "Memory quota must not be negative\n");
+    return FAILURE;
+  }
+
+  pthread_mutex_lock(&budget_lock);
+  subsystems[subsystem].quota = (unsigned long long)bytes;
+  pthread_mutex_unlock(&budget_lock);
+  return SUCCESS;
+}
+
+struct memory_budget_stats besu_native_ec_memory_budget_stats(void) {
+  struct memory_budget_stats stats;
+
+  pthread_mutex_lock(&budget_lock);
+  stats.budget = budget;
+  stats.used = used;
+  for (int i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++) {
+    stats.subsystems[i] = subsystems[i];
+  }
+  pthread_mutex_unlock(&budget_lock);
+
+  return stats;
+}
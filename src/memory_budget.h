@@ -0,0 +1,55 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Estimate of the memory of an imported public key. OpenSSL allocates it
+// internally, so it can't be measured.
+#define MEMORY_BUDGET_KEY_OBJECT_SIZE 1024
+
+// releases all memory of an evictable subsystem, the memory must be released
+// with memory_budget_release before it returns
+typedef void (*memory_budget_reclaim)(void);
+
+// Accounts memory of the subsystem before it is allocated. If the budget is
+// exhausted, the subsystems that are evicted before it are reclaimed in their
+// order. Fails if the quota of the subsystem or the budget would be exceeded
+// anyway.
+int memory_budget_reserve(char *error_message,
+                          enum memory_subsystem subsystem, size_t bytes);
+
+void memory_budget_release(enum memory_subsystem subsystem, size_t bytes);
+
+// Registers the function that evicts the subsystem under pressure. It is
+// called without any lock of the budget held, but possibly while the caller
+// of memory_budget_reserve holds the locks of a subsystem that is evicted
+// later, so it must not wait for those.
+void memory_budget_set_reclaim(enum memory_subsystem subsystem,
+                               memory_budget_reclaim reclaim);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,716 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mmap, msync and flock are not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "constants.h"
+#include "ec_key_recovery.h"
+#include "epoch.h"
+#include "recovery_index.h"
+#include "utils.h"
+
+static const uint8_t P256_PUBLIC_KEY_LENGTH = 64;
+static const uint8_t P256_CURVE_BYTE_LENGTH = 32;
+
+int p256_recovery_index_open(struct p256_recovery_index **index,
+                             char *error_message, const char *path,
+                             const long long capacity) {
+  if (capacity <= 0 || capacity >= UINT32_MAX / 2) {
+    snprintf(error_message, 256,
+             "Capacity of recovery index must be between 1 and %u\n",
+             UINT32_MAX / 2 - 1);
+    return FAILURE;
+  }
+
+  return recovery_index_open(index, error_message, path, capacity,
+                             P256_PUBLIC_KEY_LENGTH, NID_X9_62_prime256v1);
+}
+
+void p256_recovery_index_close(struct p256_recovery_index *index) {
+  recovery_index_close(index);
+}
+
+int p256_recovery_index_flush(struct p256_recovery_index *index,
+                              char *error_message) {
+  return recovery_index_flush(index, error_message);
+}
+
+int p256_recovery_index_compact(struct p256_recovery_index *index,
+                                char *error_message,
+                                const long long capacity) {
+  if (capacity <= 0 || capacity >= UINT32_MAX / 2) {
+    snprintf(error_message, 256,
+             "Capacity of recovery index must be between 1 and %u\n",
+             UINT32_MAX / 2 - 1);
+    return FAILURE;
+  }
+
+  return recovery_index_compact(index, error_message, capacity);
+}
+
+struct recovery_index_stats
+p256_recovery_index_stats(struct p256_recovery_index *index) {
+  pthread_mutex_lock(&index->write_lock);
+
+  struct recovery_index_file *file = atomic_load(&index->file);
+  struct recovery_index_stats stats = {
+      .records = file->header->record_count,
+      .capacity = file->header->capacity,
+      .pending = index->pending_count,
+      .hits = atomic_load(&index->hits),
+      .misses = atomic_load(&index->misses),
+      .dropped = atomic_load(&index->dropped)};
+
+  pthread_mutex_unlock(&index->write_lock);
+
+  return stats;
+}
+
+struct key_recovery_result
+p256_key_recovery_indexed(struct p256_recovery_index *index,
+                          const char data_hash[], const int data_hash_len,
+                          const char signature_r[], const char signature_s[],
+                          const int signature_v) {
+  return key_recovery_indexed(index, data_hash, data_hash_len, signature_r,
+                              signature_s, signature_v, NID_X9_62_prime256v1,
+                              P256_CURVE_BYTE_LENGTH);
+}
+
+struct key_recovery_result
+key_recovery_indexed(struct p256_recovery_index *index,
+                     const char data_hash[], int data_hash_len,
+                     const char signature_r[], const char signature_s[],
+                     int signature_v, int curve_nid, int curve_byte_len) {
+  struct key_recovery_result result = {.public_key = {0}, .error_message = {0}};
+  unsigned char digest[RECOVERY_INDEX_DIGEST_LEN];
+
+  int has_digest =
+      recovery_index_digest(digest, data_hash, data_hash_len, signature_r,
+                            signature_s, signature_v, curve_byte_len) ==
+      SUCCESS;
+
+  if (has_digest && recovery_index_lookup(index, digest, result.public_key)) {
+    atomic_fetch_add(&index->hits, 1);
+    return result;
+  }
+
+  atomic_fetch_add(&index->misses, 1);
+
+  result = key_recovery(data_hash, data_hash_len, signature_r, signature_s,
+                        signature_v, curve_nid, curve_byte_len);
+
+  if (has_digest && strlen(result.error_message) == 0) {
+    recovery_index_add(index, digest, result.public_key);
+  }
+
+  return result;
+}
+
+static size_t record_len_for(size_t public_key_len) {
+  return RECOVERY_INDEX_DIGEST_LEN + public_key_len +
+         RECOVERY_INDEX_CHECKSUM_LEN;
+}
+
+static unsigned char *record_at(struct recovery_index_file *file,
+                                uint64_t record_number) {
+  return file->records + record_number * file->record_len;
+}
+
+static size_t first_slot(struct recovery_index_file *file,
+                         const unsigned char digest[]) {
+  // the digest is a SHA-256 hash, so any of its bytes are evenly distributed
+  uint64_t hash;
+  memcpy(&hash, digest, sizeof(hash));
+
+  return hash & file->slot_mask;
+}
+
+static int calculate_record_checksum(const unsigned char *record,
+                                     size_t public_key_len,
+                                     unsigned char checksum[]) {
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+
+  if (EVP_Digest(record, RECOVERY_INDEX_DIGEST_LEN + public_key_len, md_value,
+                 NULL, EVP_sha256(), NULL) != SUCCESS) {
+    return FAILURE;
+  }
+
+  memcpy(checksum, md_value, RECOVERY_INDEX_CHECKSUM_LEN);
+
+  return SUCCESS;
+}
+
+int recovery_index_digest(unsigned char digest[RECOVERY_INDEX_DIGEST_LEN],
+                          const char data_hash[], int data_hash_len,
+                          const char signature_r[], const char signature_s[],
+                          int signature_v, int curve_byte_len) {
+  int ret = FAILURE;
+
+  // 27 and 28 select the same keys as 0 and 1
+  unsigned char v = (unsigned char)(signature_v >= 27 ? signature_v - 27
+                                                      : signature_v);
+  EVP_MD_CTX *md_context = NULL;
+
+  if ((md_context = EVP_MD_CTX_new()) == NULL) {
+    goto end_recovery_index_digest;
+  }
+
+  if (EVP_DigestInit_ex(md_context, EVP_sha256(), NULL) != SUCCESS ||
+      EVP_DigestUpdate(md_context, data_hash, data_hash_len) != SUCCESS ||
+      EVP_DigestUpdate(md_context, signature_r, curve_byte_len) != SUCCESS ||
+      EVP_DigestUpdate(md_context, signature_s, curve_byte_len) != SUCCESS ||
+      EVP_DigestUpdate(md_context, &v, 1) != SUCCESS ||
+      EVP_DigestFinal_ex(md_context, digest, NULL) != SUCCESS) {
+    goto end_recovery_index_digest;
+  }
+
+  ret = SUCCESS;
+
+end_recovery_index_digest:
+  EVP_MD_CTX_free(md_context);
+
+  return ret;
+}
+
+// returns the record number + 1 of the record published for the digest or 0 if
+// there is none
+static uint32_t find_record(struct recovery_index_file *file,
+                            const unsigned char digest[]) {
+  for (size_t slot = first_slot(file, digest);;
+       slot = (slot + 1) & file->slot_mask) {
+    // the acquire load pairs with the release store in publish_record, which
+    // makes the record visible before its slot
+    uint32_t record_number =
+        atomic_load_explicit(&file->slots[slot], memory_order_acquire);
+
+    if (record_number == 0 ||
+        memcmp(record_at(file, record_number - 1), digest,
+               RECOVERY_INDEX_DIGEST_LEN) == 0) {
+      return record_number;
+    }
+  }
+}
+
+int recovery_index_lookup(struct p256_recovery_index *index,
+                          const unsigned char digest[], char public_key[]) {
+  char error_message[256];
+  int found = 0;
+
+  // the file can't be unmapped by a compaction while it is read, without a
+  // read section the key is recovered instead
+  if (epoch_enter(error_message) != SUCCESS) {
+    return 0;
+  }
+
+  struct recovery_index_file *file = atomic_load(&index->file);
+  uint32_t record_number = find_record(file, digest);
+  if (record_number != 0) {
+    memcpy(public_key,
+           record_at(file, record_number - 1) + RECOVERY_INDEX_DIGEST_LEN,
+           index->public_key_len);
+    found = 1;
+  }
+
+  epoch_exit();
+
+  return found;
+}
+
+static void publish_record(struct recovery_index_file *file,
+                           uint64_t record_number) {
+  size_t slot = first_slot(file, record_at(file, record_number));
+
+  while (atomic_load_explicit(&file->slots[slot], memory_order_relaxed) != 0) {
+    slot = (slot + 1) & file->slot_mask;
+  }
+
+  atomic_store_explicit(&file->slots[slot], (uint32_t)(record_number + 1),
+                        memory_order_release);
+}
+
+static int sync_range(void *start, size_t len, int flags) {
+  uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+  uintptr_t aligned_start = (uintptr_t)start & ~(page_size - 1);
+
+  return msync((void *)aligned_start, len + ((uintptr_t)start - aligned_start),
+               flags);
+}
+
+static int pwrite_fully(int fd, const void *data, size_t len, off_t offset) {
+  const char *p = data;
+
+  while (len > 0) {
+    ssize_t written = pwrite(fd, p, len, offset);
+
+    if (written < 0) {
+      return FAILURE;
+    }
+
+    p += written;
+    len -= written;
+    offset += written;
+  }
+
+  return SUCCESS;
+}
+
+// has to be called with the write lock held
+static int flush_pending(struct p256_recovery_index *index,
+                         char *error_message) {
+  struct recovery_index_file *file = atomic_load(&index->file);
+
+  if (index->pending_count == 0) {
+    return SUCCESS;
+  }
+
+  uint64_t first_record = file->header->record_count;
+  size_t pending_len = index->pending_count * index->record_len;
+
+  // The records are written to the file rather than to the mapping, so that
+  // an error is returned instead of raising a signal. They have to be on disk
+  // before the header counts them, otherwise a crash could leave counted
+  // records that were never written.
+  if (pwrite_fully(file->fd, index->pending, pending_len,
+                   (off_t)(record_at(file, first_record) - file->mapping)) !=
+          SUCCESS ||
+      fdatasync(file->fd) != 0) {
+    snprintf(error_message, 256, "Could not write records of recovery index\n");
+    return FAILURE;
+  }
+
+  for (size_t i = 0; i < index->pending_count; i++) {
+    publish_record(file, first_record + i);
+  }
+
+  file->header->record_count += index->pending_count;
+  index->pending_count = 0;
+
+  sync_range(file->header, sizeof(struct recovery_index_file_header),
+             MS_ASYNC);
+
+  return SUCCESS;
+}
+
+void recovery_index_add(struct p256_recovery_index *index,
+                        const unsigned char digest[],
+                        const char public_key[]) {
+  char error_message[256];
+
+  pthread_mutex_lock(&index->write_lock);
+
+  // the file is only replaced with the write lock held
+  struct recovery_index_file *file = atomic_load(&index->file);
+
+  // another thread might have recovered the same key in the meantime
+  if (find_record(file, digest) != 0) {
+    goto end_recovery_index_add;
+  }
+  for (size_t i = 0; i < index->pending_count; i++) {
+    if (memcmp(index->pending + i * index->record_len, digest,
+               RECOVERY_INDEX_DIGEST_LEN) == 0) {
+      goto end_recovery_index_add;
+    }
+  }
+
+  // a batch that could not be written is retried before a key is added to it,
+  // the key is dropped if it still can't be written
+  if (index->pending_count == RECOVERY_INDEX_BATCH_SIZE &&
+      flush_pending(index, error_message) != SUCCESS) {
+    atomic_fetch_add(&index->dropped, 1);
+    goto end_recovery_index_add;
+  }
+
+  if (file->header->record_count + index->pending_count >=
+      file->header->capacity) {
+    atomic_fetch_add(&index->dropped, 1);
+    goto end_recovery_index_add;
+  }
+
+  unsigned char *record = index->pending + index->pending_count *
+                                               index->record_len;
+  memcpy(record, digest, RECOVERY_INDEX_DIGEST_LEN);
+  memcpy(record + RECOVERY_INDEX_DIGEST_LEN, public_key,
+         index->public_key_len);
+  if (calculate_record_checksum(record, index->public_key_len,
+                                record + RECOVERY_INDEX_DIGEST_LEN +
+                                    index->public_key_len) != SUCCESS) {
+    goto end_recovery_index_add;
+  }
+  index->pending_count++;
+
+  // if the batch can't be written, it stays pending and is retried with the
+  // next key
+  if (index->pending_count == RECOVERY_INDEX_BATCH_SIZE) {
+    flush_pending(index, error_message);
+  }
+
+end_recovery_index_add:
+  pthread_mutex_unlock(&index->write_lock);
+}
+
+int recovery_index_flush(struct p256_recovery_index *index,
+                         char *error_message) {
+  pthread_mutex_lock(&index->write_lock);
+  int ret = flush_pending(index, error_message);
+  pthread_mutex_unlock(&index->write_lock);
+
+  return ret;
+}
+
+// releases a file that was replaced by a compaction or closed
+static void free_index_file(void *object) {
+  struct recovery_index_file *file = object;
+
+  if (file->mapping != NULL) {
+    munmap(file->mapping, file->mapping_len);
+  }
+
+  // closing the file releases the lock on it as well
+  if (file->fd >= 0) {
+    close(file->fd);
+  }
+
+  table_memory_free(&file->slot_memory);
+  free(file);
+}
+
+static int create_index_file(int fd, char *error_message, uint64_t capacity,
+                             size_t public_key_len, int curve_nid) {
+  struct recovery_index_file_header header = {
+      .version = RECOVERY_INDEX_FILE_VERSION,
+      .curve_nid = curve_nid,
+      .public_key_len = public_key_len,
+      .capacity = capacity};
+  memcpy(header.magic, RECOVERY_INDEX_FILE_MAGIC, sizeof(header.magic));
+
+  // the space of all records is reserved, so that a full disk fails here
+  // rather than when a record is written through the mapping
+  if (pwrite(fd, &header, sizeof(header), 0) != sizeof(header) ||
+      posix_fallocate(fd, 0,
+                      sizeof(header) +
+                          capacity * record_len_for(public_key_len)) != 0) {
+    snprintf(error_message, 256, "Could not create recovery index file\n");
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+static int map_index_file(struct recovery_index_file *file,
+                          struct p256_recovery_index *index,
+                          char *error_message, uint64_t capacity) {
+  struct recovery_index_file_header header;
+  struct stat file_stat;
+
+  if ((file->fd = open(index->path, O_RDWR | O_CREAT, 0644)) < 0) {
+    snprintf(error_message, 256, "Could not open recovery index file %s\n",
+             index->path);
+    return FAILURE;
+  }
+
+  // only one writer at a time may append to the file
+  if (flock(file->fd, LOCK_EX | LOCK_NB) != 0) {
+    snprintf(error_message, 256,
+             "Recovery index file %s is used by another process\n",
+             index->path);
+    return FAILURE;
+  }
+
+  if (fstat(file->fd, &file_stat) != 0) {
+    snprintf(error_message, 256, "Could not read recovery index file %s\n",
+             index->path);
+    return FAILURE;
+  }
+
+  if (file_stat.st_size == 0 &&
+      create_index_file(file->fd, error_message, capacity,
+                        index->public_key_len,
+                        index->curve_nid) != SUCCESS) {
+    return FAILURE;
+  }
+
+  if (pread(file->fd, &header, sizeof(header), 0) != sizeof(header) ||
+      memcmp(header.magic, RECOVERY_INDEX_FILE_MAGIC, sizeof(header.magic)) !=
+          0) {
+    snprintf(error_message, 256, "File is not a recovery index\n");
+    return FAILURE;
+  }
+
+  if (header.version != RECOVERY_INDEX_FILE_VERSION ||
+      header.curve_nid != (uint32_t)index->curve_nid ||
+      header.public_key_len != index->public_key_len) {
+    snprintf(error_message, 256,
+             "Recovery index was created for another version or curve\n");
+    return FAILURE;
+  }
+
+  file->mapping_len = sizeof(header) + header.capacity * file->record_len;
+  if (fstat(file->fd, &file_stat) != 0 ||
+      (uint64_t)file_stat.st_size != file->mapping_len ||
+      header.record_count > header.capacity) {
+    snprintf(error_message, 256, "Recovery index file is truncated\n");
+    return FAILURE;
+  }
+
+  void *mapping = mmap(NULL, file->mapping_len, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, file->fd, 0);
+  if (mapping == MAP_FAILED) {
+    snprintf(error_message, 256, "Could not map recovery index file %s\n",
+             index->path);
+    return FAILURE;
+  }
+  file->mapping = mapping;
+  file->header = mapping;
+  file->records = file->mapping + sizeof(header);
+
+  // the slot table is kept at most half full to keep the probe sequences short
+  size_t slot_count = 16;
+  while (slot_count < 2 * header.capacity) {
+    slot_count *= 2;
+  }
+  if (table_memory_alloc(&file->slot_memory, error_message,
+                         MEMORY_SUBSYSTEM_RECOVERY_INDEXES,
+                         slot_count * sizeof(uint32_t)) != SUCCESS) {
+    return FAILURE;
+  }
+  file->slots = file->slot_memory.data;
+  file->slot_mask = slot_count - 1;
+
+  unsigned char checksum[RECOVERY_INDEX_CHECKSUM_LEN];
+  for (uint64_t i = 0; i < header.record_count; i++) {
+    const unsigned char *record = record_at(file, i);
+
+    // a record that does not match its checksum ends the valid part of the
+    // file, the records after it are overwritten by the next batch
+    if (calculate_record_checksum(record, index->public_key_len, checksum) !=
+            SUCCESS ||
+        memcmp(checksum, record + RECOVERY_INDEX_DIGEST_LEN +
+                             index->public_key_len,
+               RECOVERY_INDEX_CHECKSUM_LEN) != 0) {
+      file->header->record_count = i;
+      break;
+    }
+
+    if (find_record(file, record) == 0) {
+      publish_record(file, i);
+    }
+  }
+
+  return SUCCESS;
+}
+
+// returns the mapped index file at the path of the index or NULL
+static struct recovery_index_file *open_index_file(
+    struct p256_recovery_index *index, char *error_message, uint64_t capacity) {
+  struct recovery_index_file *file = NULL;
+
+  if ((file = calloc(1, sizeof(struct recovery_index_file))) == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for recovery index\n");
+    return NULL;
+  }
+  file->fd = -1;
+  file->record_len = index->record_len;
+
+  if (map_index_file(file, index, error_message, capacity) != SUCCESS) {
+    free_index_file(file);
+    return NULL;
+  }
+
+  return file;
+}
+
+int recovery_index_open(struct p256_recovery_index **index,
+                        char *error_message, const char *path,
+                        uint64_t capacity, size_t public_key_len,
+                        int curve_nid) {
+  struct p256_recovery_index *new_index = NULL;
+
+  if ((new_index = calloc(1, sizeof(struct p256_recovery_index))) == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for recovery index\n");
+    return FAILURE;
+  }
+
+  new_index->public_key_len = public_key_len;
+  new_index->record_len = record_len_for(public_key_len);
+  new_index->curve_nid = curve_nid;
+  pthread_mutex_init(&new_index->write_lock, NULL);
+
+  if ((new_index->path = strdup(path)) == NULL ||
+      (new_index->pending = malloc(RECOVERY_INDEX_BATCH_SIZE *
+                                   new_index->record_len)) == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for recovery index\n");
+    recovery_index_close(new_index);
+    return FAILURE;
+  }
+
+  struct recovery_index_file *file =
+      open_index_file(new_index, error_message, capacity);
+  if (file == NULL) {
+    recovery_index_close(new_index);
+    return FAILURE;
+  }
+  atomic_store(&new_index->file, file);
+
+  *index = new_index;
+
+  return SUCCESS;
+}
+
+void recovery_index_close(struct p256_recovery_index *index) {
+  char error_message[256];
+
+  if (index == NULL) {
+    return;
+  }
+
+  // no lookup may run anymore, so that the file is released right away. Files
+  // that were replaced by compactions are released once their last lookup
+  // has ended.
+  struct recovery_index_file *file = atomic_load(&index->file);
+  if (file != NULL) {
+    recovery_index_flush(index, error_message);
+    free_index_file(file);
+  }
+  epoch_reclaim();
+
+  pthread_mutex_destroy(&index->write_lock);
+  free(index->pending);
+  free(index->path);
+  free(index);
+}
+
+static int write_fully(int fd, const void *data, size_t len) {
+  const char *p = data;
+
+  while (len > 0) {
+    ssize_t written = write(fd, p, len);
+
+    if (written < 0) {
+      return FAILURE;
+    }
+
+    p += written;
+    len -= written;
+  }
+
+  return SUCCESS;
+}
+
+// Rewrites the file with every digest stored once and the given capacity,
+// which also allows an index to grow once it is full. The compacted file is
+// published to the lookups, which don't take any lock, and the replaced file
+// is unmapped once no lookup reads it anymore. If mapping the compacted file
+// fails, the index keeps the replaced file, which is no longer at its path,
+// and has to be opened again.
+int recovery_index_compact(struct p256_recovery_index *index,
+                           char *error_message, uint64_t capacity) {
+  int ret = FAILURE;
+  int fd = -1;
+  char temporary_path[4096];
+  struct recovery_index_file *compacted = NULL;
+
+  pthread_mutex_lock(&index->write_lock);
+
+  struct recovery_index_file *file = atomic_load(&index->file);
+
+  if (flush_pending(index, error_message) != SUCCESS) {
+    goto end_recovery_index_compact;
+  }
+
+  struct recovery_index_file_header header = *file->header;
+  header.capacity = capacity;
+  header.record_count = 0;
+
+  if (snprintf(temporary_path, sizeof(temporary_path), "%s.tmp",
+               index->path) >= (int)sizeof(temporary_path) ||
+      (fd = open(temporary_path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+    snprintf(error_message, 256, "Could not create compacted recovery index\n");
+    goto end_recovery_index_compact;
+  }
+
+  if (lseek(fd, sizeof(header), SEEK_SET) < 0) {
+    snprintf(error_message, 256, "Could not write compacted recovery index\n");
+    goto end_recovery_index_compact;
+  }
+
+  for (uint64_t i = 0; i < file->header->record_count; i++) {
+    const unsigned char *record = record_at(file, i);
+
+    // only the record a digest is published with is kept
+    if (find_record(file, record) != i + 1) {
+      continue;
+    }
+
+    if (header.record_count == capacity) {
+      snprintf(error_message, 256,
+               "Capacity is too small for the records of the index\n");
+      goto end_recovery_index_compact;
+    }
+
+    if (write_fully(fd, record, index->record_len) != SUCCESS) {
+      snprintf(error_message, 256,
+               "Could not write compacted recovery index\n");
+      goto end_recovery_index_compact;
+    }
+    header.record_count++;
+  }
+
+  if (pwrite(fd, &header, sizeof(header), 0) != sizeof(header) ||
+      posix_fallocate(fd, 0, sizeof(header) + capacity * index->record_len) !=
+          0 ||
+      fsync(fd) != 0 || rename(temporary_path, index->path) != 0) {
+    snprintf(error_message, 256,
+             "Could not write compacted recovery index\n");
+    goto end_recovery_index_compact;
+  }
+
+  if ((compacted = open_index_file(index, error_message, capacity)) == NULL) {
+    goto end_recovery_index_compact;
+  }
+  atomic_store(&index->file, compacted);
+
+  // if the file can't be retired, it can't be unmapped safely and is leaked
+  epoch_retire(error_message, file, free_index_file);
+  ret = SUCCESS;
+
+end_recovery_index_compact:
+  if (fd >= 0) {
+    close(fd);
+    if (ret != SUCCESS) {
+      unlink(temporary_path);
+    }
+  }
+  pthread_mutex_unlock(&index->write_lock);
+
+  return ret;
+}
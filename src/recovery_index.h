@@ -0,0 +1,132 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "besu_native_ec.h"
+#include "table_memory.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECOVERY_INDEX_FILE_MAGIC "BNECRIDX"
+#define RECOVERY_INDEX_FILE_VERSION 1
+
+// number of recovered keys that are collected before they are written
+#define RECOVERY_INDEX_BATCH_SIZE 256
+
+// All fields are stored in the byte order of the host. Records with an index
+// below record_count have been synced to disk before record_count was
+// increased.
+struct recovery_index_file_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t curve_nid;
+  uint32_t public_key_len;
+  uint32_t reserved;
+  uint64_t capacity;
+  uint64_t record_count;
+  unsigned char padding[24];
+};
+
+// Every record is laid out as
+//   digest (32 bytes) | public key (public_key_len bytes) | checksum (8 bytes)
+// The digest is the SHA-256 hash of the recovery input, the checksum are the
+// first 8 bytes of the SHA-256 hash of digest and public key.
+#define RECOVERY_INDEX_DIGEST_LEN 32
+#define RECOVERY_INDEX_CHECKSUM_LEN 8
+
+// The mapping of an index file and the in-memory open addressing table of its
+// record numbers. A compaction replaces it, the replaced one is released
+// through the epochs once no lookup reads it anymore.
+struct recovery_index_file {
+  int fd;
+  unsigned char *mapping;
+  size_t mapping_len;
+  struct recovery_index_file_header *header;
+  unsigned char *records;
+  size_t record_len;
+
+  // record number + 1 of the record stored in a slot, 0 for empty slots
+  struct table_memory slot_memory;
+  _Atomic uint32_t *slots;
+  size_t slot_mask;
+};
+
+// An append-only file of recovered public keys, keyed by the digest of the
+// recovery input. Lookups read the current file in an epoch read section and
+// do not take any lock. Recovered keys are appended in batches by one writer
+// at a time, the file is only replaced with the write lock held.
+struct p256_recovery_index {
+  char *path;
+  size_t record_len;
+  size_t public_key_len;
+  int curve_nid;
+
+  _Atomic(struct recovery_index_file *) file;
+
+  pthread_mutex_t write_lock;
+  unsigned char *pending;
+  size_t pending_count;
+
+  atomic_ullong hits;
+  atomic_ullong misses;
+  atomic_ullong dropped;
+};
+
+int recovery_index_open(struct p256_recovery_index **index,
+                        char *error_message, const char *path,
+                        uint64_t capacity, size_t public_key_len,
+                        int curve_nid);
+
+void recovery_index_close(struct p256_recovery_index *index);
+
+int recovery_index_flush(struct p256_recovery_index *index,
+                         char *error_message);
+
+int recovery_index_compact(struct p256_recovery_index *index,
+                           char *error_message, uint64_t capacity);
+
+int recovery_index_digest(unsigned char digest[RECOVERY_INDEX_DIGEST_LEN],
+                          const char data_hash[], int data_hash_len,
+                          const char signature_r[], const char signature_s[],
+                          int signature_v, int curve_byte_len);
+
+int recovery_index_lookup(struct p256_recovery_index *index,
+                          const unsigned char digest[],
+                          char public_key[]);
+
+void recovery_index_add(struct p256_recovery_index *index,
+                        const unsigned char digest[],
+                        const char public_key[]);
+
+struct key_recovery_result
+key_recovery_indexed(struct p256_recovery_index *index,
+                     const char data_hash[], int data_hash_len,
+                     const char signature_r[], const char signature_s[],
+                     int signature_v, int curve_nid, int curve_byte_len);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "constants.h"
+#include "rlp.h"
+
+#define RLP_SHORT_STRING 0x80
+#define RLP_LONG_STRING 0xb7
+#define RLP_SHORT_LIST 0xc0
+#define RLP_LONG_LIST 0xf7
+#define RLP_MAX_SHORT_LEN 55
+
+int rlp_decode_item(struct rlp_item *item, const unsigned char *data,
+                    size_t len) {
+  if (len == 0) {
+    return FAILURE;
+  }
+
+  const unsigned char prefix = data[0];
+  size_t header_len = 1;
+  size_t payload_len = 0;
+
+  if (prefix < RLP_SHORT_STRING) {
+    // a single byte is its own encoding
+    item->encoding = data;
+    item->encoding_len = 1;
+    item->payload = data;
+    item->payload_len = 1;
+    item->is_list = 0;
+    return SUCCESS;
+  }
+
+  item->is_list = prefix >= RLP_SHORT_LIST;
+  const unsigned char short_base =
+      item->is_list ? RLP_SHORT_LIST : RLP_SHORT_STRING;
+  const unsigned char long_base =
+      item->is_list ? RLP_LONG_LIST : RLP_LONG_STRING;
+
+  if (prefix <= long_base) {
+    payload_len = prefix - short_base;
+  } else {
+    size_t length_len = prefix - long_base;
+    // lengths must not have leading zeros and must not fit the short form
+    if (length_len > sizeof(size_t) || len < 1 + length_len || data[1] == 0) {
+      return FAILURE;
+    }
+    for (size_t i = 0; i < length_len; i++) {
+      payload_len = (payload_len << 8) | data[1 + i];
+    }
+    if (payload_len <= RLP_MAX_SHORT_LEN) {
+      return FAILURE;
+    }
+    header_len += length_len;
+  }
+
+  if (payload_len > len - header_len) {
+    return FAILURE;
+  }
+  // a single byte below 0x80 must be encoded as itself
+  if (!item->is_list && payload_len == 1 &&
+      data[header_len] < RLP_SHORT_STRING) {
+    return FAILURE;
+  }
+
+  item->encoding = data;
+  item->encoding_len = header_len + payload_len;
+  item->payload = data + header_len;
+  item->payload_len = payload_len;
+  return SUCCESS;
+}
+
+int rlp_next_item(struct rlp_item *item, const unsigned char **cursor,
+                  const unsigned char *end) {
+  if (*cursor >= end ||
+      rlp_decode_item(item, *cursor, end - *cursor) != SUCCESS) {
+    return FAILURE;
+  }
+  *cursor += item->encoding_len;
+  return SUCCESS;
+}
+
+int rlp_item_to_uint64(uint64_t *value, const struct rlp_item *item) {
+  if (item->is_list || item->payload_len > 8 ||
+      (item->payload_len > 0 && item->payload[0] == 0)) {
+    return FAILURE;
+  }
+
+  *value = 0;
+  for (size_t i = 0; i < item->payload_len; i++) {
+    *value = (*value << 8) | item->payload[i];
+  }
+  return SUCCESS;
+}
+
+// writes value as big-endian bytes without leading zeros
+static size_t write_length(unsigned char *out, uint64_t value) {
+  size_t len = 0;
+  for (uint64_t rest = value; rest > 0; rest >>= 8) {
+    len++;
+  }
+  for (size_t i = 0; i < len; i++) {
+    out[i] = (unsigned char)(value >> (8 * (len - 1 - i)));
+  }
+  return len;
+}
+
+size_t rlp_list_header(unsigned char header[9], size_t payload_len) {
+  if (payload_len <= RLP_MAX_SHORT_LEN) {
+    header[0] = (unsigned char)(RLP_SHORT_LIST + payload_len);
+    return 1;
+  }
+  size_t length_len = write_length(header + 1, payload_len);
+  header[0] = (unsigned char)(RLP_LONG_LIST + length_len);
+  return 1 + length_len;
+}
+
+size_t rlp_encode_uint64(unsigned char encoding[9], uint64_t value) {
+  if (value > 0 && value < RLP_SHORT_STRING) {
+    encoding[0] = (unsigned char)value;
+    return 1;
+  }
+  size_t len = write_length(encoding + 1, value);
+  encoding[0] = (unsigned char)(RLP_SHORT_STRING + len);
+  return 1 + len;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// An item of an RLP encoding. The item points into the encoded data, nothing
+// is copied.
+struct rlp_item {
+  // the whole encoding of the item, including its header
+  const unsigned char *encoding;
+  size_t encoding_len;
+  // the payload, i.e. the bytes of a string or the encoded items of a list
+  const unsigned char *payload;
+  size_t payload_len;
+  int is_list;
+};
+
+// Decodes the item at the start of data. Only canonical encodings are
+// accepted, i.e. single bytes below 0x80 must not have a header and lengths
+// must use the shortest form. Returns SUCCESS or FAILURE.
+int rlp_decode_item(struct rlp_item *item, const unsigned char *data,
+                    size_t len);
+
+// Decodes the next item of the payload of a list and advances the cursor
+// behind it. Returns FAILURE if the list has no more items or the item is
+// invalid.
+int rlp_next_item(struct rlp_item *item, const unsigned char **cursor,
+                  const unsigned char *end);
+
+// reads a string of at most 8 bytes without leading zeros as an integer
+int rlp_item_to_uint64(uint64_t *value, const struct rlp_item *item);
+
+// writes the header of a list with the given payload length, returns the
+// length of the header which is at most 9 bytes
+size_t rlp_list_header(unsigned char header[9], size_t payload_len);
+
+// writes the encoding of an integer, which is at most 9 bytes long
+size_t rlp_encode_uint64(unsigned char encoding[9], uint64_t value);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "side_channel.h"
+#include "thread_context.h"
+#include "utils.h"
+#include "worker_pool.h"
+
+// only the operations that call side_channel_point_mul have a kernel,
+// verifications only call it in the low latency mode
+static const enum side_channel_kernel kernels[EC_OPERATION_COUNT] = {
+    [EC_OPERATION_ECDH] = SIDE_CHANNEL_CONSTANT_TIME,
+    [EC_OPERATION_KEY_GENERATION] = SIDE_CHANNEL_CONSTANT_TIME,
+    [EC_OPERATION_VERIFY] = SIDE_CHANNEL_VARIABLE_TIME,
+    [EC_OPERATION_KEY_RECOVERY] = SIDE_CHANNEL_VARIABLE_TIME,
+};
+
+static _Thread_local unsigned long long
+    kernel_calls[EC_OPERATION_COUNT][SIDE_CHANNEL_KERNEL_COUNT];
+
+static atomic_int low_latency = 0;
+
+// the two halves of a split multiplication, the multiple of G and the multiple
+// of the point
+struct split_mul {
+  int curve_nid;
+  const BIGNUM *g_scalar;
+  const EC_POINT *point;
+  const BIGNUM *p_scalar;
+  EC_POINT *multiples[2];
+  int ret[2];
+  char error_messages[2][256];
+};
+
+enum side_channel_kernel side_channel_kernel_of(enum ec_operation operation) {
+  return kernels[operation];
+}
+
+void side_channel_mark_secret(BIGNUM *scalar) {
+  BN_set_flags(scalar, BN_FLG_CONSTTIME);
+}
+
+static int is_secret(const BIGNUM *scalar) {
+  return scalar != NULL && BN_get_flags(scalar, BN_FLG_CONSTTIME) != 0;
+}
+
+// With a single scalar, EC_POINT_mul uses the Montgomery ladder for arbitrary
+// points and the precomputed table for G, which are both constant time. A sum
+// of two multiples is computed as two separate multiplications, as the double
+// multiplication of OpenSSL is variable time.
+static int constant_time_mul(EC_POINT *r, char *error_message,
+                             const EC_GROUP *group, const BIGNUM *g_scalar,
+                             const EC_POINT *point, const BIGNUM *p_scalar,
+                             BN_CTX *bn_context) {
+  int ret = FAILURE;
+  EC_POINT *p_multiple = NULL;
+
+  if ((g_scalar != NULL && !is_secret(g_scalar)) ||
+      (p_scalar != NULL && !is_secret(p_scalar))) {
+    snprintf(error_message, 256,
+             "Scalars of constant time multiplications must be marked as "
+             "secret\n");
+    goto end_constant_time_mul;
+  }
+
+  if (g_scalar == NULL || point == NULL) {
+    if (EC_POINT_mul(group, r, g_scalar, point, p_scalar, bn_context) !=
+        SUCCESS) {
+      set_error_message(error_message, "Could not multiply point: ");
+      goto end_constant_time_mul;
+    }
+    ret = SUCCESS;
+    goto end_constant_time_mul;
+  }
+
+  if ((p_multiple = EC_POINT_new(group)) == NULL ||
+      EC_POINT_mul(group, p_multiple, NULL, point, p_scalar, bn_context) !=
+          SUCCESS ||
+      EC_POINT_mul(group, r, g_scalar, NULL, NULL, bn_context) != SUCCESS ||
+      EC_POINT_add(group, r, r, p_multiple, bn_context) != SUCCESS) {
+    set_error_message(error_message, "Could not multiply points: ");
+    goto end_constant_time_mul;
+  }
+  ret = SUCCESS;
+
+end_constant_time_mul:
+  EC_POINT_clear_free(p_multiple);
+  return ret;
+}
+
+// Passes the scalars to EC_POINT_mul as they are, a sum of two multiples is
+// computed with the variable time double multiplication of OpenSSL. Single
+// multiplications take whatever algorithm OpenSSL picks for the group, the
+// kernel only makes sure that no secret scalar is passed.
+static int variable_time_mul(EC_POINT *r, char *error_message,
+                             const EC_GROUP *group, const BIGNUM *g_scalar,
+                             const EC_POINT *point, const BIGNUM *p_scalar,
+                             BN_CTX *bn_context) {
+  if (is_secret(g_scalar) || is_secret(p_scalar)) {
+    snprintf(error_message, 256,
+             "Secret scalars must not be used in variable time "
+             "multiplications\n");
+    return FAILURE;
+  }
+
+  if (EC_POINT_mul(group, r, g_scalar, point, p_scalar, bn_context) !=
+      SUCCESS) {
+    set_error_message(error_message, "Could not multiply points: ");
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+// Computes one half of a split multiplication. Groups and BIGNUM contexts are
+// owned by threads, the half uses those of the thread that computes it.
+static void split_mul_range(void *context, size_t begin, size_t end) {
+  struct split_mul *split = context;
+
+  for (size_t i = begin; i < end; i++) {
+    char *error_message = split->error_messages[i];
+    const EC_GROUP *group = NULL;
+    BN_CTX *bn_context = NULL;
+
+    if ((group = thread_group(error_message, split->curve_nid)) == NULL ||
+        (bn_context = thread_bn_context(error_message)) == NULL) {
+      continue;
+    }
+
+    if (i == 0) {
+      split->ret[i] =
+          variable_time_mul(split->multiples[i], error_message, group, NULL,
+                            split->point, split->p_scalar, bn_context);
+    } else {
+      split->ret[i] =
+          variable_time_mul(split->multiples[i], error_message, group,
+                            split->g_scalar, NULL, NULL, bn_context);
+    }
+  }
+}
+
+// Computes p_scalar * point (item 0) on the calling thread while a worker
+// computes g_scalar * G (item 1). The multiplication of G takes less time,
+// which leaves time to hand it over to the worker.
+static int split_variable_time_mul(EC_POINT *r, char *error_message,
+                                   const EC_GROUP *group,
+                                   const BIGNUM *g_scalar,
+                                   const EC_POINT *point,
+                                   const BIGNUM *p_scalar, BN_CTX *bn_context) {
+  int ret = FAILURE;
+  struct split_mul split = {.curve_nid = EC_GROUP_get_curve_name(group),
+                            .g_scalar = g_scalar,
+                            .point = point,
+                            .p_scalar = p_scalar,
+                            .multiples = {NULL, NULL},
+                            .ret = {FAILURE, FAILURE},
+                            .error_messages = {{0}, {0}}};
+
+  if ((split.multiples[0] = EC_POINT_new(group)) == NULL ||
+      (split.multiples[1] = EC_POINT_new(group)) == NULL) {
+    set_error_message(error_message,
+                      "Could not allocate memory for the multiples: ");
+    goto end_split_variable_time_mul;
+  }
+
+  worker_pool_run_pair(split_mul_range, &split);
+
+  for (int i = 0; i < 2; i++) {
+    if (split.ret[i] != SUCCESS) {
+      memcpy(error_message, split.error_messages[i], 256);
+      goto end_split_variable_time_mul;
+    }
+  }
+
+  if (EC_POINT_add(group, r, split.multiples[0], split.multiples[1],
+                   bn_context) != SUCCESS) {
+    set_error_message(error_message, "Could not add the multiples: ");
+    goto end_split_variable_time_mul;
+  }
+  ret = SUCCESS;
+
+end_split_variable_time_mul:
+  EC_POINT_free(split.multiples[0]);
+  EC_POINT_free(split.multiples[1]);
+  return ret;
+}
+
+int side_channel_point_mul(EC_POINT *r, char *error_message,
+                           enum ec_operation operation, const EC_GROUP *group,
+                           const BIGNUM *g_scalar, const EC_POINT *point,
+                           const BIGNUM *p_scalar, BN_CTX *bn_context) {
+  enum side_channel_kernel kernel = kernels[operation];
+  kernel_calls[operation][kernel]++;
+
+  if (kernel == SIDE_CHANNEL_CONSTANT_TIME) {
+    return constant_time_mul(r, error_message, group, g_scalar, point,
+                             p_scalar, bn_context);
+  }
+  // secret scalars are rejected by variable_time_mul, before they are handed
+  // to another thread
+  if (side_channel_low_latency() && g_scalar != NULL && point != NULL &&
+      !is_secret(g_scalar) && !is_secret(p_scalar) &&
+      EC_GROUP_get_curve_name(group) != NID_undef) {
+    return split_variable_time_mul(r, error_message, group, g_scalar, point,
+                                   p_scalar, bn_context);
+  }
+  return variable_time_mul(r, error_message, group, g_scalar, point, p_scalar,
+                           bn_context);
+}
+
+// without workers, there is nobody to split the multiplications with
+int side_channel_low_latency(void) {
+  return atomic_load(&low_latency) && worker_pool_thread_count() > 0;
+}
+
+void besu_native_ec_low_latency_set_enabled(const int enable) {
+  atomic_store(&low_latency, enable != 0);
+  worker_pool_set_spinning(enable);
+}
+
+unsigned long long side_channel_kernel_calls(enum ec_operation operation,
+                                             enum side_channel_kernel kernel) {
+  return kernel_calls[operation][kernel];
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Which operations handle secrets decides how their scalar multiplications are
+ * passed to OpenSSL. The kernels are labels with checks, not implementations of
+ * their own: EC_POINT_mul picks the algorithm from the group and the number of
+ * scalars.
+ *
+ * The constant time kernel only accepts scalars that are marked as secret and
+ * computes a sum of two multiples as two single multiplications, which OpenSSL
+ * computes with its ladder for arbitrary points and its table of multiples of
+ * G for the generator. The variable time kernel rejects marked scalars, so that
+ * a secret never reaches the double multiplication of OpenSSL or a worker
+ * thread.
+ *
+ * ECDH and key generation, which multiply with a private key, use the constant
+ * time kernel. Key recovery, which computes Q = u1 * G + u2 * R from public
+ * data only, uses the variable time kernel for that double multiplication, as
+ * do verifications in the low latency mode. Signing and all other
+ * verifications are done by EVP_PKEY_sign and EVP_PKEY_verify and don't pass
+ * through these kernels.
+ */
+
+enum ec_operation {
+  EC_OPERATION_ECDH,
+  EC_OPERATION_KEY_GENERATION,
+  EC_OPERATION_VERIFY,
+  EC_OPERATION_KEY_RECOVERY,
+  EC_OPERATION_COUNT
+};
+
+enum side_channel_kernel {
+  SIDE_CHANNEL_CONSTANT_TIME,
+  SIDE_CHANNEL_VARIABLE_TIME,
+  SIDE_CHANNEL_KERNEL_COUNT
+};
+
+enum side_channel_kernel side_channel_kernel_of(enum ec_operation operation);
+
+// Marks a scalar as secret. The constant time kernel only accepts marked
+// scalars and the variable time kernel rejects them.
+void side_channel_mark_secret(BIGNUM *scalar);
+
+// Computes r = g_scalar * G + p_scalar * point with the kernel of the
+// operation. g_scalar or point and p_scalar may be NULL.
+int side_channel_point_mul(EC_POINT *r, char *error_message,
+                           enum ec_operation operation, const EC_GROUP *group,
+                           const BIGNUM *g_scalar, const EC_POINT *point,
+                           const BIGNUM *p_scalar, BN_CTX *bn_context);
+
+// In the low latency mode, variable time multiplications of G and a point are
+// split across the calling thread and a worker thread. It is only active if
+// the worker pool has workers.
+int side_channel_low_latency(void);
+
+// number of multiplications computed by the calling thread with the kernel for
+// the operation
+unsigned long long side_channel_kernel_calls(enum ec_operation operation,
+                                             enum side_channel_kernel kernel);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mmap flags like MAP_ANONYMOUS are not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "memory_budget.h"
+#include "table_memory.h"
+
+static atomic_ullong huge_page_bytes = 0;
+static atomic_ullong transparent_huge_page_bytes = 0;
+static atomic_ullong regular_page_bytes = 0;
+static atomic_ullong tables = 0;
+
+static size_t round_up(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+static atomic_ullong *backing_counter(enum table_memory_backing backing) {
+  switch (backing) {
+  case TABLE_MEMORY_HUGETLB:
+    return &huge_page_bytes;
+  case TABLE_MEMORY_TRANSPARENT_HUGE_PAGES:
+    return &transparent_huge_page_bytes;
+  default:
+    return &regular_page_bytes;
+  }
+}
+
+static void *map_anonymous(size_t len, int extra_flags) {
+  void *data = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+
+  return data == MAP_FAILED ? NULL : data;
+}
+
+#ifdef MADV_HUGEPAGE
+// Transparent huge pages can only back a range that is aligned to the huge
+// page size. mmap does not guarantee that alignment, therefore one additional
+// huge page is mapped and the unaligned head and tail are unmapped again.
+static void *map_huge_page_aligned(size_t len) {
+  size_t oversized_len = len + TABLE_MEMORY_HUGE_PAGE_SIZE;
+  char *oversized = map_anonymous(oversized_len, 0);
+
+  if (oversized == NULL) {
+    return NULL;
+  }
+
+  char *aligned =
+      (char *)round_up((uintptr_t)oversized, TABLE_MEMORY_HUGE_PAGE_SIZE);
+  size_t head_len = aligned - oversized;
+  size_t tail_len = oversized_len - head_len - len;
+
+  if (head_len > 0) {
+    munmap(oversized, head_len);
+  }
+  if (tail_len > 0) {
+    munmap(aligned + len, tail_len);
+  }
+
+  return aligned;
+}
+#endif
+
+int table_memory_alloc(struct table_memory *table, char *error_message,
+                       enum memory_subsystem subsystem, size_t size) {
+  table->data = NULL;
+  table->mapped_len = 0;
+  table->backing = TABLE_MEMORY_REGULAR_PAGES;
+  table->subsystem = subsystem;
+
+  // the largest mapping that might be needed is accounted, the unused part
+  // is released again once the backing is known
+  size_t reserved_len =
+      round_up(size, size >= TABLE_MEMORY_HUGE_PAGE_SIZE
+                         ? TABLE_MEMORY_HUGE_PAGE_SIZE
+                         : (size_t)sysconf(_SC_PAGESIZE));
+  if (memory_budget_reserve(error_message, subsystem, reserved_len) !=
+      SUCCESS) {
+    return FAILURE;
+  }
+
+  // tables smaller than one huge page would waste most of it, so they are
+  // always backed by regular pages
+  if (size >= TABLE_MEMORY_HUGE_PAGE_SIZE) {
+    size_t huge_len = round_up(size, TABLE_MEMORY_HUGE_PAGE_SIZE);
+
+#ifdef MAP_HUGETLB
+    // fails immediately if the administrator has not reserved enough huge
+    // pages (vm.nr_hugepages), in which case the next option is tried
+    if ((table->data = map_anonymous(huge_len, MAP_HUGETLB)) != NULL) {
+      table->mapped_len = huge_len;
+      table->backing = TABLE_MEMORY_HUGETLB;
+    }
+#endif
+
+#ifdef MADV_HUGEPAGE
+    if (table->data == NULL &&
+        (table->data = map_huge_page_aligned(huge_len)) != NULL) {
+      table->mapped_len = huge_len;
+
+      if (madvise(table->data, huge_len, MADV_HUGEPAGE) == 0) {
+        table->backing = TABLE_MEMORY_TRANSPARENT_HUGE_PAGES;
+      }
+    }
+#endif
+  }
+
+  if (table->data == NULL) {
+    size_t page_len = round_up(size, (size_t)sysconf(_SC_PAGESIZE));
+
+    if ((table->data = map_anonymous(page_len, 0)) == NULL) {
+      memory_budget_release(subsystem, reserved_len);
+      snprintf(error_message, 256,
+               "Could not allocate %zu bytes of memory for table\n", size);
+      return FAILURE;
+    }
+
+    table->mapped_len = page_len;
+  }
+  memory_budget_release(subsystem, reserved_len - table->mapped_len);
+
+  atomic_fetch_add(backing_counter(table->backing), table->mapped_len);
+  atomic_fetch_add(&tables, 1);
+
+  return SUCCESS;
+}
+
+void table_memory_free(struct table_memory *table) {
+  if (table->data == NULL) {
+    return;
+  }
+
+  munmap(table->data, table->mapped_len);
+  memory_budget_release(table->subsystem, table->mapped_len);
+
+  atomic_fetch_sub(backing_counter(table->backing), table->mapped_len);
+  atomic_fetch_sub(&tables, 1);
+
+  table->data = NULL;
+  table->mapped_len = 0;
+}
+
+struct table_memory_stats besu_native_ec_table_memory_stats(void) {
+  struct table_memory_stats stats = {
+      .huge_page_bytes = atomic_load(&huge_page_bytes),
+      .transparent_huge_page_bytes = atomic_load(&transparent_huge_page_bytes),
+      .regular_page_bytes = atomic_load(&regular_page_bytes),
+      .tables = atomic_load(&tables)};
+
+  return stats;
+}
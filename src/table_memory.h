@@ -0,0 +1,59 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// size of the pages that are requested for large precomputation tables
+#define TABLE_MEMORY_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+enum table_memory_backing {
+  // explicitly reserved huge pages (MAP_HUGETLB)
+  TABLE_MEMORY_HUGETLB,
+  // regular mapping that is advised to be backed by transparent huge pages
+  // (MADV_HUGEPAGE)
+  TABLE_MEMORY_TRANSPARENT_HUGE_PAGES,
+  // regular pages, used for small tables and as the last fallback
+  TABLE_MEMORY_REGULAR_PAGES
+};
+
+struct table_memory {
+  void *data;
+  // length of the mapping, which is the requested size rounded up to the page
+  // size of the backing
+  size_t mapped_len;
+  enum table_memory_backing backing;
+  // the mapping is accounted with the memory budget of the subsystem
+  enum memory_subsystem subsystem;
+};
+
+int table_memory_alloc(struct table_memory *table, char *error_message,
+                       enum memory_subsystem subsystem, size_t size);
+
+void table_memory_free(struct table_memory *table);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,258 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/core_names.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/objects.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "thread_context.h"
+#include "utils.h"
+
+static pthread_key_t context_key;
+static pthread_once_t context_key_created = PTHREAD_ONCE_INIT;
+
+static void free_verify_slot(struct thread_verify_slot *slot) {
+  EVP_PKEY_CTX_free(slot->context);
+  EC_POINT_free(slot->point);
+  EVP_PKEY_free(slot->key);
+  slot->context = NULL;
+  slot->point = NULL;
+  slot->key = NULL;
+}
+
+static void free_thread_context(void *data) {
+  struct thread_context *context = data;
+
+  if (context == NULL) {
+    return;
+  }
+
+  BN_CTX_free(context->bn_context);
+  for (int i = 0; i < THREAD_CONTEXT_GROUP_COUNT; i++) {
+    EC_GROUP_free(context->groups[i].group);
+  }
+  for (int i = 0; i < THREAD_CONTEXT_VERIFY_SLOTS; i++) {
+    free_verify_slot(&context->verify_slots[i]);
+  }
+  csprng_cleanse(&context->csprng);
+  free(context);
+}
+
+static void create_context_key(void) {
+  pthread_key_create(&context_key, free_thread_context);
+}
+
+static struct thread_context *get_thread_context(char *error_message) {
+  pthread_once(&context_key_created, create_context_key);
+
+  struct thread_context *context = pthread_getspecific(context_key);
+  if (context != NULL) {
+    return context;
+  }
+
+  if ((context = calloc(1, sizeof(struct thread_context))) == NULL ||
+      pthread_setspecific(context_key, context) != 0) {
+    free(context);
+    set_error_message(error_message,
+                      "Could not allocate memory for thread context: ");
+    return NULL;
+  }
+  return context;
+}
+
+void besu_native_ec_release_thread_context(void) {
+  pthread_once(&context_key_created, create_context_key);
+
+  free_thread_context(pthread_getspecific(context_key));
+  pthread_setspecific(context_key, NULL);
+}
+
+BN_CTX *thread_bn_context(char *error_message) {
+  struct thread_context *context = get_thread_context(error_message);
+
+  if (context == NULL) {
+    return NULL;
+  }
+  if (context->bn_context == NULL &&
+      (context->bn_context = BN_CTX_new()) == NULL) {
+    set_error_message(error_message,
+                      "Could not allocate memory for BIGNUM context: ");
+  }
+  return context->bn_context;
+}
+
+const EC_GROUP *thread_group(char *error_message, const int curve_nid) {
+  struct thread_context *context = get_thread_context(error_message);
+
+  if (context == NULL) {
+    return NULL;
+  }
+
+  struct thread_group *free_slot = NULL;
+  for (int i = 0; i < THREAD_CONTEXT_GROUP_COUNT; i++) {
+    struct thread_group *slot = &context->groups[i];
+    if (slot->group != NULL && slot->curve_nid == curve_nid) {
+      return slot->group;
+    }
+    if (slot->group == NULL && free_slot == NULL) {
+      free_slot = slot;
+    }
+  }
+
+  EC_GROUP *group = EC_GROUP_new_by_curve_name(curve_nid);
+  if (group == NULL) {
+    set_error_message(error_message,
+                      "Could not get EC_GROUP for requested curve: ");
+    return NULL;
+  }
+
+  // the groups of more curves than slots are replaced in the first slot
+  if (free_slot == NULL) {
+    free_slot = &context->groups[0];
+    EC_GROUP_free(free_slot->group);
+  }
+  free_slot->curve_nid = curve_nid;
+  free_slot->group = group;
+  return group;
+}
+
+static struct thread_verify_slot *
+verify_slot_of(struct thread_context *context, const EVP_PKEY *key) {
+  return &context->verify_slots[((uintptr_t)key >> 4) %
+                                THREAD_CONTEXT_VERIFY_SLOTS];
+}
+
+// Contexts can't be bound to another key, so a slot is reused if the same key
+// is verified with again. With the key cache, repeat signers share one
+// EVP_PKEY and therefore the slot.
+static struct thread_verify_slot *bind_verify_slot(char *error_message,
+                                                   EVP_PKEY *key) {
+  struct thread_context *context = get_thread_context(error_message);
+
+  if (context == NULL) {
+    return NULL;
+  }
+
+  struct thread_verify_slot *slot = verify_slot_of(context, key);
+  if (slot->key != key) {
+    free_verify_slot(slot);
+    EVP_PKEY_up_ref(key);
+    slot->key = key;
+  }
+  return slot;
+}
+
+EVP_PKEY_CTX *thread_verify_context(char *error_message, EVP_PKEY *key) {
+  struct thread_verify_slot *slot = bind_verify_slot(error_message, key);
+
+  if (slot == NULL) {
+    return NULL;
+  }
+  if (slot->context != NULL) {
+    return slot->context;
+  }
+
+  EVP_PKEY_CTX *verify_context = NULL;
+  if ((verify_context = EVP_PKEY_CTX_new(key, NULL)) == NULL) {
+    set_error_message(error_message,
+                      "Could not create a context for verifying: ");
+    return NULL;
+  }
+  if (EVP_PKEY_verify_init(verify_context) != SUCCESS) {
+    set_error_message(error_message,
+                      "Could not initialize a context for verifying: ");
+    EVP_PKEY_CTX_free(verify_context);
+    return NULL;
+  }
+
+  slot->context = verify_context;
+  return verify_context;
+}
+
+const EC_POINT *thread_verify_point(char *error_message, EVP_PKEY *key,
+                                    const EC_GROUP **group) {
+  struct thread_verify_slot *slot = bind_verify_slot(error_message, key);
+  char group_name[64];
+  // 0x04 || x || y
+  unsigned char point_octet[133];
+  size_t point_octet_len = 0;
+
+  if (slot == NULL) {
+    return NULL;
+  }
+  if (slot->point != NULL) {
+    *group = thread_group(error_message, slot->curve_nid);
+    return *group == NULL ? NULL : slot->point;
+  }
+
+  if (EVP_PKEY_get_group_name(key, group_name, sizeof(group_name), NULL) !=
+      SUCCESS) {
+    set_error_message(error_message,
+                      "Could not get the curve of the public key: ");
+    return NULL;
+  }
+
+  int curve_nid = OBJ_sn2nid(group_name);
+  BN_CTX *bn_context = NULL;
+  EC_POINT *point = NULL;
+  if ((*group = thread_group(error_message, curve_nid)) == NULL ||
+      (bn_context = thread_bn_context(error_message)) == NULL) {
+    return NULL;
+  }
+  if (EVP_PKEY_get_octet_string_param(key, OSSL_PKEY_PARAM_PUB_KEY,
+                                      point_octet, sizeof(point_octet),
+                                      &point_octet_len) != SUCCESS ||
+      (point = EC_POINT_new(*group)) == NULL ||
+      EC_POINT_oct2point(*group, point, point_octet, point_octet_len,
+                         bn_context) != SUCCESS) {
+    set_error_message(error_message,
+                      "Could not convert the public key to a point: ");
+    EC_POINT_free(point);
+    return NULL;
+  }
+
+  slot->point = point;
+  slot->curve_nid = curve_nid;
+  return point;
+}
+
+void thread_verify_context_discard(EVP_PKEY *key) {
+  char error_message[256];
+  struct thread_context *context = get_thread_context(error_message);
+
+  if (context != NULL && verify_slot_of(context, key)->key == key) {
+    free_verify_slot(verify_slot_of(context, key));
+  }
+}
+
+int thread_random_bytes(char *error_message, unsigned char out[],
+                        const size_t len) {
+  struct thread_context *context = get_thread_context(error_message);
+
+  if (context == NULL) {
+    return FAILURE;
+  }
+  return csprng_bytes(&context->csprng, error_message, out, len);
+}
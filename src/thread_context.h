@@ -0,0 +1,86 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/evp.h"
+
+#include "csprng.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// number of curves whose group is kept per thread
+#define THREAD_CONTEXT_GROUP_COUNT 4
+// number of keys with an initialized verify context per thread
+#define THREAD_CONTEXT_VERIFY_SLOTS 8
+
+struct thread_group {
+  int curve_nid;
+  EC_GROUP *group;
+};
+
+// A verify context and the public key as a point, together with a reference
+// to the key they are bound to, so that the key can't be freed and its address
+// reused while they are cached. Both are created when they are first used.
+struct thread_verify_slot {
+  EVP_PKEY *key;
+  EVP_PKEY_CTX *context;
+  EC_POINT *point;
+  int curve_nid;
+};
+
+// Objects that are expensive to create and are reused by all operations of a
+// thread. They are freed when the thread exits.
+struct thread_context {
+  BN_CTX *bn_context;
+  struct thread_group groups[THREAD_CONTEXT_GROUP_COUNT];
+  struct thread_verify_slot verify_slots[THREAD_CONTEXT_VERIFY_SLOTS];
+  struct csprng csprng;
+};
+
+// The following functions return objects that are owned by the calling
+// thread. They must not be freed or passed to other threads.
+
+BN_CTX *thread_bn_context(char *error_message);
+
+const EC_GROUP *thread_group(char *error_message, const int curve_nid);
+
+// returns a context bound to the key that is initialized for verifying
+EVP_PKEY_CTX *thread_verify_context(char *error_message, EVP_PKEY *key);
+
+// Returns the public key of the key as a point and the group of its curve,
+// which are reused for the next signature of the same key like the verify
+// context.
+const EC_POINT *thread_verify_point(char *error_message, EVP_PKEY *key,
+                                    const EC_GROUP **group);
+
+// frees the verify context and the point of the key, e.g. after an error
+void thread_verify_context_discard(EVP_PKEY *key);
+
+// Fills out with bytes of the generator of the calling thread. Is used for
+// secrets that are generated by the library, e.g. private keys.
+int thread_random_bytes(char *error_message, unsigned char out[],
+                        const size_t len);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -22,6 +22,7 @@
 #include "openssl/include/openssl/err.h"
 
 #include "constants.h"
+#include "thread_context.h"
 #include "utils.h"
 
 void set_error_message(char *error_message, const char *message_prefix) {
@@ -81,19 +82,18 @@ char *hex_arr_to_str(const char *p, int p_len) {
 }
 
 BIGNUM *get_curve_order(const int curve_nid, char *error_message) {
-  EC_GROUP *group = NULL;
+  const EC_GROUP *group = NULL;
   const BIGNUM *n_internal =
       NULL;         // interal pointer to curve order of the group
   BIGNUM *n = NULL; // curve order
 
-  if ((group = EC_GROUP_new_by_curve_name(curve_nid)) == NULL) {
-    set_error_message(error_message,
-                      "Could not get EC_GROUP for requested curve: ");
+  // the group is owned by the thread
+  if ((group = thread_group(error_message, curve_nid)) == NULL) {
     goto end_get_curve_order;
   }
 
-  // returns the internal pointer of the curve order, which will be freed
-  // automatically by calling EC_GROUP_free
+  // returns the internal pointer of the curve order, which is owned by the
+  // group
   if ((n_internal = EC_GROUP_get0_order(group)) == NULL) {
     set_error_message(error_message,
                       "Could not convert curve order (n) to BIGNUM: ");
@@ -107,7 +107,68 @@ BIGNUM *get_curve_order(const int curve_nid, char *error_message) {
   }
 
 end_get_curve_order:
-  EC_GROUP_free(group);
-
   return n;
-}
\ No newline at end of file
+}
+
+// 0 < scalar < order, compared as big-endian arrays
+static int is_scalar_in_range(const unsigned char scalar[],
+                              const unsigned char order[], const int len) {
+  unsigned char any = 0;
+
+  for (int i = 0; i < len; i++) {
+    any |= scalar[i];
+  }
+  return any != 0 && memcmp(scalar, order, len) < 0;
+}
+
+// s > n / 2 if s > n - s
+static int is_scalar_high(const unsigned char scalar[],
+                          const unsigned char order[], const int len) {
+  unsigned char negated[MAX_ORDER_LEN];
+  int borrow = 0;
+
+  for (int i = len - 1; i >= 0; i--) {
+    int difference = order[i] - scalar[i] - borrow;
+    borrow = difference < 0;
+    negated[i] = (unsigned char)(difference + (borrow ? 256 : 0));
+  }
+  return memcmp(scalar, negated, len) > 0;
+}
+
+int check_signature_range(char *error_message, const char signature_r_arr[],
+                          const char signature_s_arr[],
+                          const int signature_arr_len, const int curve_nid,
+                          const int allow_high_s) {
+  const unsigned char *r = (const unsigned char *)signature_r_arr;
+  const unsigned char *s = (const unsigned char *)signature_s_arr;
+  unsigned char order[MAX_ORDER_LEN];
+  const EC_GROUP *group = NULL;
+
+  if (signature_arr_len <= 0 || signature_arr_len > MAX_ORDER_LEN) {
+    snprintf(error_message, 256, "Signature length %d is not supported\n",
+             signature_arr_len);
+    return FAILURE;
+  }
+  // the group is owned by the thread
+  if ((group = thread_group(error_message, curve_nid)) == NULL) {
+    return FAILURE;
+  }
+  if (BN_bn2binpad(EC_GROUP_get0_order(group), order, signature_arr_len) !=
+      signature_arr_len) {
+    set_error_message(error_message, "Could not convert curve order: ");
+    return FAILURE;
+  }
+
+  if (!is_scalar_in_range(r, order, signature_arr_len) ||
+      !is_scalar_in_range(s, order, signature_arr_len)) {
+    snprintf(error_message, 256,
+             "Signature r and s must be between 1 and n - 1\n");
+    return FAILURE;
+  }
+  if (!allow_high_s && is_scalar_high(s, order, signature_arr_len)) {
+    snprintf(error_message, 256,
+             "Signature s must not be greater than n / 2\n");
+    return FAILURE;
+  }
+  return SUCCESS;
+}
@@ -28,6 +28,14 @@ unsigned char *hex_to_bin(const char *hex_string);
 char *hex_arr_to_str(const char *p, int p_len);
 BIGNUM *get_curve_order(const int curve_nid, char *error_message);
 
+// Checks that r and s are between 1 and n - 1 and, unless allow_high_s is set,
+// that s is not greater than n / 2. Recovering a key from a signature outside
+// of the range succeeds, so it has to be checked before. Nothing is allocated.
+int check_signature_range(char *error_message, const char signature_r_arr[],
+                          const char signature_s_arr[],
+                          const int signature_arr_len, const int curve_nid,
+                          const int allow_high_s);
+
 #ifdef __cplusplus
 extern
 }
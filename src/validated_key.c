@@ -0,0 +1,229 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_ecdh.h"
+#include "ec_key.h"
+#include "ec_key_recovery.h"
+#include "ec_verify.h"
+#include "thread_context.h"
+#include "utils.h"
+#include "validated_key.h"
+#include "worker_pool.h"
+
+static const uint8_t P256_PUBLIC_KEY_LENGTH = 64;
+
+int p256_validated_key_create(struct p256_validated_key **key,
+                              char *error_message,
+                              const char public_key_data[]) {
+  return validated_key_create(key, error_message,
+                              (const unsigned char *)public_key_data,
+                              P256_PUBLIC_KEY_LENGTH, "prime256v1",
+                              NID_X9_62_prime256v1);
+}
+
+int p256_validated_keys_create(struct p256_validated_key *keys[],
+                               const char public_keys[], const int key_count) {
+  return validated_keys_create(keys, (const unsigned char *)public_keys,
+                               key_count, P256_PUBLIC_KEY_LENGTH,
+                               "prime256v1", NID_X9_62_prime256v1);
+}
+
+void p256_validated_key_free(struct p256_validated_key *key) {
+  validated_key_free(key);
+}
+
+struct verify_result
+p256_validated_key_verify(const struct p256_validated_key *key,
+                          const char data_hash[], const int data_hash_length,
+                          const char signature_r[], const char signature_s[]) {
+  struct verify_result result = {.verified = GENERIC_ERROR,
+                                 .error_message = {0}};
+  int signature_arr_len = key->len / 2;
+
+  if (check_signature_canonicalized(result.error_message, signature_s,
+                                    signature_arr_len,
+                                    key->curve_nid) != SUCCESS) {
+    return result;
+  }
+
+  verify_with_key(&result, key->key, data_hash, data_hash_length, signature_r,
+                  signature_s, signature_arr_len);
+
+  return result;
+}
+
+struct verify_result
+p256_validated_key_matches_recovery(const struct p256_validated_key *key,
+                                    const char data_hash[],
+                                    const int data_hash_length,
+                                    const char signature_r[],
+                                    const char signature_s[],
+                                    const int signature_v) {
+  struct verify_result result = {.verified = GENERIC_ERROR,
+                                 .error_message = {0}};
+
+  struct key_recovery_result recovery =
+      key_recovery(data_hash, data_hash_length, signature_r, signature_s,
+                   signature_v, key->curve_nid, key->len / 2);
+  if (strlen(recovery.error_message) > 0) {
+    memcpy(result.error_message, recovery.error_message, 256);
+    return result;
+  }
+
+  result.verified = memcmp(recovery.public_key, key->data, key->len) == 0;
+  return result;
+}
+
+struct ecdh_result
+p256_validated_key_ecdh(const struct p256_validated_key *peer_key,
+                        const char private_key_data[]) {
+  struct ecdh_result result = {.shared_secret = {0}, .error_message = {0}};
+  const EC_GROUP *group = NULL;
+  BN_CTX *bn_context = NULL;
+
+  if ((group = thread_group(result.error_message, peer_key->curve_nid)) ==
+          NULL ||
+      (bn_context = thread_bn_context(result.error_message)) == NULL) {
+    return result;
+  }
+
+  ecdh_with_point(&result, (const unsigned char *)private_key_data,
+                  peer_key->point, group, bn_context, peer_key->len / 2);
+
+  return result;
+}
+
+int validated_key_create(struct p256_validated_key **key, char *error_message,
+                         const unsigned char public_key_data[],
+                         const size_t public_key_len, const char *group_name,
+                         const int curve_nid) {
+  int ret = FAILURE;
+  const EC_GROUP *group = NULL;
+  BN_CTX *bn_context = NULL;
+  // 0x04 || x || y
+  unsigned char octet[133];
+  struct p256_validated_key *new_key = NULL;
+
+  if ((new_key = calloc(1, sizeof(struct p256_validated_key))) == NULL) {
+    snprintf(error_message, 256,
+             "Could not allocate memory for validated key\n");
+    goto end_validated_key_create;
+  }
+  memcpy(new_key->data, public_key_data, public_key_len);
+  new_key->len = public_key_len;
+  new_key->curve_nid = curve_nid;
+
+  if ((group = thread_group(error_message, curve_nid)) == NULL ||
+      (bn_context = thread_bn_context(error_message)) == NULL) {
+    goto end_validated_key_create;
+  }
+
+  // rejects coordinates that are not less than p and points that are not on
+  // the curve. The point at infinity can't be encoded as x || y.
+  octet[0] = POINT_CONVERSION_UNCOMPRESSED;
+  memcpy(octet + 1, public_key_data, public_key_len);
+  if ((new_key->point = EC_POINT_new(group)) == NULL ||
+      EC_POINT_oct2point(group, new_key->point, octet, public_key_len + 1,
+                         bn_context) != SUCCESS) {
+    set_error_message(error_message,
+                      "Public key is not a point on the curve: ");
+    goto end_validated_key_create;
+  }
+
+  if (create_public_key(&new_key->key, error_message, public_key_data,
+                        public_key_len, group_name) != SUCCESS) {
+    goto end_validated_key_create;
+  }
+
+  *key = new_key;
+  new_key = NULL;
+  ret = SUCCESS;
+
+end_validated_key_create:
+  validated_key_free(new_key);
+  return ret;
+}
+
+void validated_key_free(struct p256_validated_key *key) {
+  if (key == NULL) {
+    return;
+  }
+
+  EVP_PKEY_free(key->key);
+  EC_POINT_free(key->point);
+  free(key);
+}
+
+struct validated_key_batch {
+  struct p256_validated_key **keys;
+  const unsigned char *public_keys;
+  size_t public_key_len;
+  const char *group_name;
+  int curve_nid;
+  atomic_int created;
+};
+
+static void create_validated_key_range(void *context, size_t begin,
+                                       size_t end) {
+  struct validated_key_batch *batch = context;
+  char error_message[256];
+  int created = 0;
+
+  for (size_t i = begin; i < end; i++) {
+    batch->keys[i] = NULL;
+    created += validated_key_create(
+                   &batch->keys[i], error_message,
+                   batch->public_keys + i * batch->public_key_len,
+                   batch->public_key_len, batch->group_name,
+                   batch->curve_nid) == SUCCESS;
+  }
+
+  atomic_fetch_add(&batch->created, created);
+}
+
+// Validates the public keys, which are stored one after another, on the
+// worker pool. keys[i] is NULL if public key i is invalid. Returns the number
+// of valid keys.
+int validated_keys_create(struct p256_validated_key *keys[],
+                          const unsigned char public_keys[],
+                          const int key_count, const size_t public_key_len,
+                          const char *group_name, const int curve_nid) {
+  struct validated_key_batch batch = {.keys = keys,
+                                      .public_keys = public_keys,
+                                      .public_key_len = public_key_len,
+                                      .group_name = group_name,
+                                      .curve_nid = curve_nid};
+  atomic_init(&batch.created, 0);
+
+  if (key_count <= 0) {
+    return 0;
+  }
+  worker_pool_run(key_count, create_validated_key_range, &batch);
+
+  return atomic_load(&batch.created);
+}
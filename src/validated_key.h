@@ -0,0 +1,62 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/evp.h"
+
+#include "besu_native_ec.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A public key that has been checked once when it was created: x and y are
+// less than p and (x, y) is a point on the curve. As the cofactor of the
+// supported curves is 1, every such point is in the group generated by G. The
+// imported EVP_PKEY and EC_POINT are shared by all threads. A point is not
+// bound to the EC_GROUP it was created with, it is used with the group of the
+// calling thread, so that the keys don't hold a group each.
+struct p256_validated_key {
+  // x || y
+  unsigned char data[132];
+  size_t len;
+  int curve_nid;
+
+  EVP_PKEY *key;
+  EC_POINT *point;
+};
+
+int validated_key_create(struct p256_validated_key **key, char *error_message,
+                         const unsigned char public_key_data[],
+                         const size_t public_key_len, const char *group_name,
+                         const int curve_nid);
+
+void validated_key_free(struct p256_validated_key *key);
+
+int validated_keys_create(struct p256_validated_key *keys[],
+                          const unsigned char public_keys[],
+                          const int key_count, const size_t public_key_len,
+                          const char *group_name, const int curve_nid);
+
+#ifdef __cplusplus
+extern
+}
+#endif
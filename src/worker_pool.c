@@ -0,0 +1,260 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// sysconf is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "constants.h"
+#include "worker_pool.h"
+
+#define MAX_WORKER_THREADS 256
+
+// every thread takes this many chunks on average, which balances items that
+// take different amounts of time
+#define CHUNKS_PER_THREAD 8
+
+struct worker_pool_job {
+  worker_pool_work work;
+  void *context;
+  size_t item_count;
+  size_t chunk_size;
+  atomic_size_t next_item;
+  // workers that have taken the job and are not done with it yet
+  atomic_int active_workers;
+};
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_started = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_finished = PTHREAD_COND_INITIALIZER;
+// serializes the callers, so that there is at most one job at a time
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int thread_count = -1;
+static struct worker_pool_job *current_job = NULL;
+// is only changed while pool_lock is held, but read without it by spinning
+// threads
+static atomic_ulong job_generation = 0;
+static atomic_int spinning = 0;
+
+static void process_chunks(struct worker_pool_job *job) {
+  for (;;) {
+    size_t begin = atomic_fetch_add(&job->next_item, job->chunk_size);
+
+    if (begin >= job->item_count) {
+      return;
+    }
+
+    size_t end = begin + job->chunk_size;
+    job->work(job->context, begin,
+              end < job->item_count ? end : job->item_count);
+  }
+}
+
+// Waits until a job newer than seen_generation is started and takes it.
+// Returns NULL if the job was finished before the worker woke up.
+static struct worker_pool_job *take_job(unsigned long *seen_generation) {
+  struct worker_pool_job *job;
+
+  for (;;) {
+    while (atomic_load(&spinning) &&
+           atomic_load(&job_generation) == *seen_generation) {
+      sched_yield();
+    }
+
+    pthread_mutex_lock(&pool_lock);
+    while (!atomic_load(&spinning) &&
+           atomic_load(&job_generation) == *seen_generation) {
+      pthread_cond_wait(&job_started, &pool_lock);
+    }
+    if (atomic_load(&job_generation) != *seen_generation) {
+      break;
+    }
+    // woken up to spin
+    pthread_mutex_unlock(&pool_lock);
+  }
+  *seen_generation = atomic_load(&job_generation);
+
+  if ((job = current_job) != NULL) {
+    atomic_fetch_add(&job->active_workers, 1);
+  }
+  pthread_mutex_unlock(&pool_lock);
+
+  return job;
+}
+
+static void *worker_main(void *arg) {
+  unsigned long seen_generation = 0;
+
+  (void)arg;
+
+  for (;;) {
+    struct worker_pool_job *job = take_job(&seen_generation);
+
+    if (job == NULL) {
+      continue;
+    }
+
+    process_chunks(job);
+
+    pthread_mutex_lock(&pool_lock);
+    if (atomic_fetch_sub(&job->active_workers, 1) == 1) {
+      pthread_cond_signal(&job_finished);
+    }
+    pthread_mutex_unlock(&pool_lock);
+  }
+
+  return NULL;
+}
+
+int worker_pool_init(char *error_message, int requested_thread_count) {
+  int ret = SUCCESS;
+
+  pthread_mutex_lock(&pool_lock);
+
+  if (thread_count >= 0) {
+    goto end_worker_pool_init;
+  }
+
+  if (requested_thread_count < 0) {
+    requested_thread_count = (int)sysconf(_SC_NPROCESSORS_ONLN) - 1;
+  }
+  if (requested_thread_count > MAX_WORKER_THREADS) {
+    requested_thread_count = MAX_WORKER_THREADS;
+  }
+
+  thread_count = 0;
+  for (int i = 0; i < requested_thread_count; i++) {
+    pthread_t thread;
+
+    // the workers live as long as the process
+    if (pthread_create(&thread, NULL, worker_main, NULL) != 0) {
+      snprintf(error_message, 256, "Could only start %d of %d worker threads\n",
+               thread_count, requested_thread_count);
+      ret = FAILURE;
+      break;
+    }
+
+    pthread_detach(thread);
+    thread_count++;
+  }
+
+end_worker_pool_init:
+  pthread_mutex_unlock(&pool_lock);
+
+  return ret;
+}
+
+void worker_pool_set_spinning(const int enable) {
+  atomic_store(&spinning, enable != 0);
+
+  // wakes the workers, so that they start spinning
+  pthread_mutex_lock(&pool_lock);
+  pthread_cond_broadcast(&job_started);
+  pthread_mutex_unlock(&pool_lock);
+}
+
+int worker_pool_thread_count(void) {
+  char error_message[256];
+
+  worker_pool_init(error_message, -1);
+
+  return thread_count;
+}
+
+// Publishes the job to the workers. The caller must hold job_lock.
+static void start_job(struct worker_pool_job *job) {
+  pthread_mutex_lock(&pool_lock);
+  current_job = job;
+  atomic_fetch_add(&job_generation, 1);
+  pthread_cond_broadcast(&job_started);
+  pthread_mutex_unlock(&pool_lock);
+}
+
+// A worker takes the job before it takes items of it, once every item is
+// taken and no worker is active anymore, every item has been processed.
+static int job_done(struct worker_pool_job *job) {
+  return atomic_load(&job->next_item) >= job->item_count &&
+         atomic_load(&job->active_workers) == 0;
+}
+
+// The job lives on the stack of the caller, it must not return before every
+// worker that has taken it is done with it. Workers that wake up later don't
+// see it anymore.
+static void finish_job(struct worker_pool_job *job) {
+  while (atomic_load(&spinning) && !job_done(job)) {
+    sched_yield();
+  }
+
+  pthread_mutex_lock(&pool_lock);
+  while (!job_done(job)) {
+    pthread_cond_wait(&job_finished, &pool_lock);
+  }
+  current_job = NULL;
+  pthread_mutex_unlock(&pool_lock);
+
+  pthread_mutex_unlock(&job_lock);
+}
+
+void worker_pool_run(size_t item_count, worker_pool_work work, void *context) {
+  int threads = worker_pool_thread_count();
+
+  if (item_count == 0) {
+    return;
+  }
+
+  if (threads == 0 || item_count == 1 || pthread_mutex_trylock(&job_lock)) {
+    work(context, 0, item_count);
+    return;
+  }
+
+  size_t chunk_size = item_count / ((threads + 1) * CHUNKS_PER_THREAD);
+  struct worker_pool_job job = {.work = work,
+                                .context = context,
+                                .item_count = item_count,
+                                .chunk_size = chunk_size > 0 ? chunk_size : 1,
+                                .next_item = 0,
+                                .active_workers = 0};
+
+  start_job(&job);
+  process_chunks(&job);
+  finish_job(&job);
+}
+
+void worker_pool_run_pair(worker_pool_work work, void *context) {
+  if (worker_pool_thread_count() == 0 || pthread_mutex_trylock(&job_lock)) {
+    work(context, 0, 2);
+    return;
+  }
+
+  // the workers start at item 1, item 0 is left to the caller
+  struct worker_pool_job job = {.work = work,
+                                .context = context,
+                                .item_count = 2,
+                                .chunk_size = 1,
+                                .next_item = 1,
+                                .active_workers = 0};
+
+  start_job(&job);
+  work(context, 0, 1);
+  finish_job(&job);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// processes the items with the indices begin to end - 1
+typedef void (*worker_pool_work)(void *context, size_t begin, size_t end);
+
+// Starts the worker threads of the pool. Is called implicitly with the number
+// of online processors - 1 by the first call to worker_pool_run and has no
+// effect afterwards.
+int worker_pool_init(char *error_message, int thread_count);
+
+int worker_pool_thread_count(void);
+
+// While enabled, idle workers and callers waiting for workers spin instead of
+// sleeping, so that a job is taken up without the latency of waking a thread.
+// The idle workers keep their cores busy.
+void worker_pool_set_spinning(const int enable);
+
+// Splits the items into chunks and processes them on the worker threads and
+// the calling thread. Returns after all items have been processed. If the pool
+// is busy with items of another caller, all items are processed on the calling
+// thread.
+void worker_pool_run(size_t item_count, worker_pool_work work, void *context);
+
+// Processes item 0 on the calling thread and item 1 on a worker thread and
+// returns after both have been processed. The caller waits for the worker
+// rather than taking item 1 itself. Both items are processed on the calling
+// thread if there are no workers or the pool is busy with another caller.
+void worker_pool_run_pair(worker_pool_work work, void *context);
+
+#ifdef __cplusplus
+extern
+}
+#endif
@@ -0,0 +1,921 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// getline is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/bn.h"
+#include "openssl/include/openssl/ec.h"
+#include "openssl/include/openssl/ecdsa.h"
+#include "openssl/include/openssl/err.h"
+#include "openssl/include/openssl/obj_mac.h"
+
+#include "corpus.h"
+
+struct buffer {
+  unsigned char *data;
+  size_t len;
+  size_t capacity;
+};
+
+static const struct corpus_curve {
+  // name in CAVP files
+  const char *name;
+  // name in Wycheproof files
+  const char *alias;
+  int nid;
+  size_t field_len;
+} curves[] = {
+    {"P-224", "secp224r1", NID_secp224r1, 28},
+    {"P-256", "secp256r1", NID_X9_62_prime256v1, 32},
+    {"P-384", "secp384r1", NID_secp384r1, 48},
+    {"P-521", "secp521r1", NID_secp521r1, 66},
+};
+
+static const struct corpus_curve *find_curve(const char *name) {
+  for (size_t i = 0; i < sizeof(curves) / sizeof(curves[0]); i++) {
+    if (strcmp(name, curves[i].name) == 0 ||
+        strcmp(name, curves[i].alias) == 0) {
+      return &curves[i];
+    }
+  }
+  return NULL;
+}
+
+static EVP_MD *fetch_md(const char *name) {
+  EVP_MD *md = EVP_MD_fetch(NULL, name, NULL);
+  // a failed fetch must not show up in the error messages of the library
+  ERR_clear_error();
+  return md;
+}
+
+static int buffer_reserve(struct buffer *buffer, size_t capacity) {
+  if (capacity <= buffer->capacity) {
+    return 1;
+  }
+  unsigned char *data = realloc(buffer->data, capacity);
+  if (data == NULL) {
+    return 0;
+  }
+  buffer->data = data;
+  buffer->capacity = capacity;
+  return 1;
+}
+
+static void buffer_free(struct buffer *buffer) {
+  free(buffer->data);
+  memset(buffer, 0, sizeof(*buffer));
+}
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// decodes hex into buffer, an odd number of digits is read as if it had a
+// leading zero
+static int buffer_set_hex(struct buffer *buffer, const char *hex,
+                          size_t hex_len) {
+  size_t len = (hex_len + 1) / 2;
+  if (!buffer_reserve(buffer, len + 1)) {
+    return 0;
+  }
+  size_t digit = hex_len % 2 == 0 ? 0 : 1;
+  memset(buffer->data, 0, len);
+  for (size_t i = 0; i < hex_len; i++, digit++) {
+    int value = hex_value(hex[i]);
+    if (value < 0) {
+      return 0;
+    }
+    buffer->data[digit / 2] |= digit % 2 == 0 ? value << 4 : value;
+  }
+  buffer->len = len;
+  return 1;
+}
+
+// left pads buffer with zeros or removes leading zeros, so that it has
+// exactly len bytes
+static int buffer_pad(struct buffer *buffer, size_t len) {
+  size_t start = 0;
+  while (buffer->len - start > len && buffer->data[start] == 0) {
+    start++;
+  }
+  size_t value_len = buffer->len - start;
+  if (value_len > len || !buffer_reserve(buffer, len + 1)) {
+    return 0;
+  }
+  memmove(buffer->data + len - value_len, buffer->data + start, value_len);
+  memset(buffer->data, 0, len - value_len);
+  buffer->len = len;
+  return 1;
+}
+
+// splits a DER encoded signature into r and s, rejecting any encoding that is
+// not strict DER, like OpenSSL does when verifying signatures
+static int decode_der_signature(unsigned char *r, unsigned char *s,
+                                const struct buffer *signature,
+                                size_t field_len) {
+  int success = 0;
+  const unsigned char *p = signature->data;
+  unsigned char *der = NULL;
+  ECDSA_SIG *sig = d2i_ECDSA_SIG(NULL, &p, (long)signature->len);
+  if (sig == NULL || p != signature->data + signature->len) {
+    goto end_decode_der_signature;
+  }
+  int der_len = i2d_ECDSA_SIG(sig, &der);
+  if (der_len != (int)signature->len ||
+      memcmp(der, signature->data, der_len) != 0) {
+    goto end_decode_der_signature;
+  }
+  const BIGNUM *sig_r = ECDSA_SIG_get0_r(sig);
+  const BIGNUM *sig_s = ECDSA_SIG_get0_s(sig);
+  if (BN_is_negative(sig_r) || BN_is_negative(sig_s) ||
+      BN_bn2binpad(sig_r, r, field_len) < 0 ||
+      BN_bn2binpad(sig_s, s, field_len) < 0) {
+    goto end_decode_der_signature;
+  }
+  success = 1;
+
+end_decode_der_signature:
+  OPENSSL_free(der);
+  ECDSA_SIG_free(sig);
+  ERR_clear_error();
+  return success;
+}
+
+/*
+ * CAVP files
+ */
+
+struct rsp_parser {
+  const char *path;
+  long line;
+  char curve[32];
+  const struct corpus_curve *curve_info;
+  EVP_MD *md;
+  // values of the current test case
+  int value_count;
+  struct buffer message;
+  struct buffer qx;
+  struct buffer qy;
+  struct buffer private_key;
+  struct buffer nonce;
+  struct buffer r;
+  struct buffer s;
+  struct buffer public_key;
+  enum corpus_result result;
+  char comment[128];
+};
+
+static void rsp_reset_case(struct rsp_parser *parser) {
+  parser->value_count = 0;
+  parser->message.len = 0;
+  parser->qx.len = 0;
+  parser->qy.len = 0;
+  parser->private_key.len = 0;
+  parser->nonce.len = 0;
+  parser->r.len = 0;
+  parser->s.len = 0;
+  parser->result = CORPUS_VALID;
+  parser->comment[0] = '\0';
+}
+
+// returns 1 to continue, 0 if the callback stopped loading and -1 on errors
+static int rsp_emit_case(struct rsp_parser *parser, long id,
+                         corpus_callback callback, void *context) {
+  struct corpus_case test_case = {0};
+  size_t field_len =
+      parser->curve_info != NULL ? parser->curve_info->field_len : 0;
+
+  if (field_len > 0) {
+    if ((parser->qx.len > 0 && (!buffer_pad(&parser->qx, field_len) ||
+                                !buffer_pad(&parser->qy, field_len))) ||
+        (parser->r.len > 0 && (!buffer_pad(&parser->r, field_len) ||
+                               !buffer_pad(&parser->s, field_len)))) {
+      fprintf(stderr, "%s:%ld: value is too large for curve %s\n",
+              parser->path, parser->line, parser->curve);
+      return -1;
+    }
+  }
+
+  if (!buffer_reserve(&parser->public_key,
+                      parser->qx.len + parser->qy.len + 1)) {
+    fprintf(stderr, "%s:%ld: out of memory\n", parser->path, parser->line);
+    return -1;
+  }
+  if (parser->qx.len > 0) {
+    memcpy(parser->public_key.data, parser->qx.data, parser->qx.len);
+  }
+  if (parser->qy.len > 0) {
+    memcpy(parser->public_key.data + parser->qx.len, parser->qy.data,
+           parser->qy.len);
+  }
+  parser->public_key.len = parser->qx.len + parser->qy.len;
+
+  test_case.id = id;
+  test_case.curve = parser->curve;
+  test_case.curve_nid =
+      parser->curve_info != NULL ? parser->curve_info->nid : NID_undef;
+  test_case.md = parser->md;
+  test_case.message = parser->message.data;
+  test_case.message_len = parser->message.len;
+  test_case.public_key = parser->public_key.data;
+  test_case.public_key_len = parser->public_key.len;
+  test_case.private_key = parser->private_key.data;
+  test_case.private_key_len = parser->private_key.len;
+  test_case.nonce = parser->nonce.data;
+  test_case.nonce_len = parser->nonce.len;
+  test_case.signature_r = parser->r.data;
+  test_case.signature_s = parser->s.data;
+  test_case.signature_len = parser->r.len;
+  test_case.signature_decoded = parser->r.len > 0 && parser->s.len > 0;
+  test_case.result = parser->result;
+  test_case.comment = parser->comment;
+
+  return callback(&test_case, context) ? 1 : 0;
+}
+
+// parses a section like [P-256,SHA-224]
+static void rsp_set_section(struct rsp_parser *parser, char *section) {
+  char *end = strchr(section, ']');
+  if (end != NULL) {
+    *end = '\0';
+  }
+  char *hash = strchr(section, ',');
+  if (hash != NULL) {
+    *hash++ = '\0';
+  }
+
+  snprintf(parser->curve, sizeof(parser->curve), "%s", section);
+  parser->curve_info = find_curve(parser->curve);
+  EVP_MD_free(parser->md);
+  parser->md = hash != NULL ? fetch_md(hash) : NULL;
+}
+
+// stores a value like "Qx = 843f..." of the current test case
+static int rsp_set_value(struct rsp_parser *parser, const char *name,
+                         const char *value) {
+  struct buffer *buffer = NULL;
+
+  if (strcmp(name, "Result") == 0) {
+    parser->result = value[0] == 'P' ? CORPUS_VALID : CORPUS_INVALID;
+    const char *reason = strchr(value, '(');
+    if (reason != NULL) {
+      snprintf(parser->comment, sizeof(parser->comment), "%.*s",
+               (int)strcspn(reason + 1, ")"), reason + 1);
+    }
+    parser->value_count++;
+    return 1;
+  }
+
+  if (strcmp(name, "Msg") == 0) {
+    buffer = &parser->message;
+  } else if (strcmp(name, "Qx") == 0) {
+    buffer = &parser->qx;
+  } else if (strcmp(name, "Qy") == 0) {
+    buffer = &parser->qy;
+  } else if (strcmp(name, "d") == 0) {
+    buffer = &parser->private_key;
+  } else if (strcmp(name, "k") == 0) {
+    buffer = &parser->nonce;
+  } else if (strcmp(name, "R") == 0) {
+    buffer = &parser->r;
+  } else if (strcmp(name, "S") == 0) {
+    buffer = &parser->s;
+  } else {
+    // other values are not needed for ECDSA signatures
+    return 1;
+  }
+
+  parser->value_count++;
+  return buffer_set_hex(buffer, value, strlen(value));
+}
+
+static char *trim(char *text) {
+  while (*text == ' ' || *text == '\t') {
+    text++;
+  }
+  size_t len = strlen(text);
+  while (len > 0 && (text[len - 1] == ' ' || text[len - 1] == '\t' ||
+                     text[len - 1] == '\r' || text[len - 1] == '\n')) {
+    text[--len] = '\0';
+  }
+  return text;
+}
+
+long corpus_load_rsp(const char *path, corpus_callback callback,
+                     void *context) {
+  long count = -1;
+  long case_count = 0;
+  char *line = NULL;
+  size_t line_capacity = 0;
+  struct rsp_parser parser = {0};
+  parser.path = path;
+  rsp_reset_case(&parser);
+
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    fprintf(stderr, "%s: could not open file\n", path);
+    goto end_corpus_load_rsp;
+  }
+
+  int emitted = 1;
+  while (1) {
+    ssize_t line_len = getline(&line, &line_capacity, file);
+    char *text = line_len >= 0 ? trim(line) : "";
+    parser.line++;
+
+    // a test case ends with an empty line, a new section or the end of the
+    // file
+    if ((text[0] == '\0' || text[0] == '[') && parser.value_count > 0) {
+      emitted = rsp_emit_case(&parser, ++case_count, callback, context);
+      if (emitted < 0) {
+        goto end_corpus_load_rsp;
+      }
+      rsp_reset_case(&parser);
+    }
+    if (line_len < 0 || emitted == 0) {
+      break;
+    }
+
+    if (text[0] == '#' || text[0] == '\0') {
+      continue;
+    }
+    if (text[0] == '[') {
+      rsp_set_section(&parser, text + 1);
+      continue;
+    }
+
+    char *separator = strchr(text, '=');
+    if (separator == NULL) {
+      fprintf(stderr, "%s:%ld: expected name = value\n", path, parser.line);
+      goto end_corpus_load_rsp;
+    }
+    *separator = '\0';
+    if (!rsp_set_value(&parser, trim(text), trim(separator + 1))) {
+      fprintf(stderr, "%s:%ld: invalid hex value\n", path, parser.line);
+      goto end_corpus_load_rsp;
+    }
+  }
+
+  count = case_count;
+
+end_corpus_load_rsp:
+  if (file != NULL) {
+    fclose(file);
+  }
+  free(line);
+  EVP_MD_free(parser.md);
+  buffer_free(&parser.message);
+  buffer_free(&parser.qx);
+  buffer_free(&parser.qy);
+  buffer_free(&parser.private_key);
+  buffer_free(&parser.nonce);
+  buffer_free(&parser.r);
+  buffer_free(&parser.s);
+  buffer_free(&parser.public_key);
+  return count;
+}
+
+/*
+ * Wycheproof files
+ */
+
+struct json_parser {
+  FILE *file;
+  const char *path;
+  long line;
+  // the next character of the file
+  int c;
+  // set if the callback stopped loading, which is not an error
+  int stopped;
+  corpus_callback callback;
+  void *context;
+  long count;
+  // the last parsed string
+  struct buffer string;
+
+  // values of the current test group
+  char curve[32];
+  const struct corpus_curve *curve_info;
+  EVP_MD *md;
+  int p1363;
+  struct buffer wx;
+  struct buffer wy;
+  struct buffer public_key;
+
+  // values of the current test
+  long id;
+  struct buffer message;
+  struct buffer signature;
+  enum corpus_result result;
+  char comment[256];
+  unsigned char r[66];
+  unsigned char s[66];
+};
+
+typedef int (*json_member_handler)(struct json_parser *parser,
+                                   const char *name);
+typedef int (*json_element_handler)(struct json_parser *parser);
+
+static void json_next(struct json_parser *parser) {
+  parser->c = getc(parser->file);
+  if (parser->c == '\n') {
+    parser->line++;
+  }
+}
+
+static void json_skip_whitespace(struct json_parser *parser) {
+  while (parser->c == ' ' || parser->c == '\t' || parser->c == '\r' ||
+         parser->c == '\n') {
+    json_next(parser);
+  }
+}
+
+static int json_error(struct json_parser *parser, const char *reason) {
+  if (!parser->stopped) {
+    fprintf(stderr, "%s:%ld: %s\n", parser->path, parser->line, reason);
+  }
+  return 0;
+}
+
+static int json_expect(struct json_parser *parser, int c) {
+  json_skip_whitespace(parser);
+  if (parser->c != c) {
+    char reason[32];
+    snprintf(reason, sizeof(reason), "expected '%c'", c);
+    return json_error(parser, reason);
+  }
+  json_next(parser);
+  return 1;
+}
+
+static int json_append(struct json_parser *parser, int c) {
+  if (parser->string.len + 2 > parser->string.capacity &&
+      !buffer_reserve(&parser->string, 2 * parser->string.len + 64)) {
+    return json_error(parser, "out of memory");
+  }
+  parser->string.data[parser->string.len++] = (unsigned char)c;
+  parser->string.data[parser->string.len] = '\0';
+  return 1;
+}
+
+static int json_clear_string(struct json_parser *parser) {
+  if (!buffer_reserve(&parser->string, 64)) {
+    return json_error(parser, "out of memory");
+  }
+  parser->string.len = 0;
+  parser->string.data[0] = '\0';
+  return 1;
+}
+
+// reads a string into parser->string, escaped characters outside of ASCII are
+// replaced by '?' as they only occur in comments
+static int json_string(struct json_parser *parser) {
+  if (!json_expect(parser, '"')) {
+    return 0;
+  }
+  if (!json_clear_string(parser)) {
+    return 0;
+  }
+
+  while (parser->c != '"') {
+    int c = parser->c;
+    if (c == EOF) {
+      return json_error(parser, "unterminated string");
+    }
+    if (c == '\\') {
+      json_next(parser);
+      switch (parser->c) {
+      case 'n':
+        c = '\n';
+        break;
+      case 't':
+        c = '\t';
+        break;
+      case 'r':
+        c = '\r';
+        break;
+      case 'b':
+        c = '\b';
+        break;
+      case 'f':
+        c = '\f';
+        break;
+      case 'u': {
+        int value = 0;
+        for (int i = 0; i < 4; i++) {
+          json_next(parser);
+          int digit = hex_value((char)parser->c);
+          if (digit < 0) {
+            return json_error(parser, "invalid unicode escape");
+          }
+          value = value * 16 + digit;
+        }
+        c = value < 0x80 ? value : '?';
+        break;
+      }
+      default:
+        c = parser->c;
+      }
+    }
+    if (!json_append(parser, c)) {
+      return 0;
+    }
+    json_next(parser);
+  }
+  json_next(parser);
+  return 1;
+}
+
+// reads a number or a literal like true into parser->string
+static int json_literal(struct json_parser *parser) {
+  json_skip_whitespace(parser);
+  if (!json_clear_string(parser)) {
+    return 0;
+  }
+  while (parser->c != EOF && strchr(",}] \t\r\n", parser->c) == NULL) {
+    if (!json_append(parser, parser->c)) {
+      return 0;
+    }
+    json_next(parser);
+  }
+  return parser->string.len > 0 ? 1 : json_error(parser, "expected a value");
+}
+
+static int json_object(struct json_parser *parser,
+                       json_member_handler handler);
+static int json_array(struct json_parser *parser,
+                      json_element_handler handler);
+
+static int json_skip_member(struct json_parser *parser, const char *name);
+
+static int json_skip_value(struct json_parser *parser) {
+  json_skip_whitespace(parser);
+  switch (parser->c) {
+  case '"':
+    return json_string(parser);
+  case '{':
+    return json_object(parser, json_skip_member);
+  case '[':
+    return json_array(parser, json_skip_value);
+  default:
+    return json_literal(parser);
+  }
+}
+
+static int json_skip_member(struct json_parser *parser, const char *name) {
+  return json_skip_value(parser);
+}
+
+static int json_object(struct json_parser *parser,
+                       json_member_handler handler) {
+  if (!json_expect(parser, '{')) {
+    return 0;
+  }
+  json_skip_whitespace(parser);
+  if (parser->c == '}') {
+    json_next(parser);
+    return 1;
+  }
+
+  while (1) {
+    char name[64];
+    if (!json_string(parser)) {
+      return 0;
+    }
+    snprintf(name, sizeof(name), "%s", (char *)parser->string.data);
+    if (!json_expect(parser, ':') || !handler(parser, name)) {
+      return 0;
+    }
+    json_skip_whitespace(parser);
+    if (parser->c == '}') {
+      json_next(parser);
+      return 1;
+    }
+    if (!json_expect(parser, ',')) {
+      return 0;
+    }
+  }
+}
+
+static int json_array(struct json_parser *parser,
+                      json_element_handler handler) {
+  if (!json_expect(parser, '[')) {
+    return 0;
+  }
+  json_skip_whitespace(parser);
+  if (parser->c == ']') {
+    json_next(parser);
+    return 1;
+  }
+
+  while (1) {
+    if (!handler(parser)) {
+      return 0;
+    }
+    json_skip_whitespace(parser);
+    if (parser->c == ']') {
+      json_next(parser);
+      return 1;
+    }
+    if (!json_expect(parser, ',')) {
+      return 0;
+    }
+  }
+}
+
+static int json_hex_string(struct json_parser *parser, struct buffer *buffer) {
+  if (!json_string(parser)) {
+    return 0;
+  }
+  if (!buffer_set_hex(buffer, (char *)parser->string.data,
+                      parser->string.len)) {
+    return json_error(parser, "invalid hex value");
+  }
+  return 1;
+}
+
+static int json_emit_test(struct json_parser *parser) {
+  struct corpus_case test_case = {0};
+  size_t field_len =
+      parser->curve_info != NULL ? parser->curve_info->field_len : 0;
+
+  if (field_len > 0 && parser->p1363) {
+    test_case.signature_decoded = parser->signature.len == 2 * field_len;
+    if (test_case.signature_decoded) {
+      memcpy(parser->r, parser->signature.data, field_len);
+      memcpy(parser->s, parser->signature.data + field_len, field_len);
+    }
+  } else if (field_len > 0) {
+    test_case.signature_decoded = decode_der_signature(
+        parser->r, parser->s, &parser->signature, field_len);
+  }
+  if (!test_case.signature_decoded) {
+    memset(parser->r, 0, sizeof(parser->r));
+    memset(parser->s, 0, sizeof(parser->s));
+  }
+
+  test_case.id = parser->id;
+  test_case.curve = parser->curve;
+  test_case.curve_nid =
+      parser->curve_info != NULL ? parser->curve_info->nid : NID_undef;
+  test_case.md = parser->md;
+  test_case.message = parser->message.data;
+  test_case.message_len = parser->message.len;
+  test_case.public_key = parser->public_key.data;
+  test_case.public_key_len = parser->public_key.len;
+  test_case.signature_r = parser->r;
+  test_case.signature_s = parser->s;
+  test_case.signature_len = field_len;
+  test_case.result = parser->result;
+  test_case.comment = parser->comment;
+
+  parser->count++;
+  if (!parser->callback(&test_case, parser->context)) {
+    parser->stopped = 1;
+    return 0;
+  }
+  return 1;
+}
+
+static int json_test_member(struct json_parser *parser, const char *name) {
+  if (strcmp(name, "tcId") == 0) {
+    if (!json_literal(parser)) {
+      return 0;
+    }
+    parser->id = strtol((char *)parser->string.data, NULL, 10);
+    return 1;
+  }
+  if (strcmp(name, "comment") == 0) {
+    if (!json_string(parser)) {
+      return 0;
+    }
+    snprintf(parser->comment, sizeof(parser->comment), "%s",
+             (char *)parser->string.data);
+    return 1;
+  }
+  if (strcmp(name, "result") == 0) {
+    if (!json_string(parser)) {
+      return 0;
+    }
+    const char *result = (char *)parser->string.data;
+    if (strcmp(result, "valid") == 0) {
+      parser->result = CORPUS_VALID;
+    } else if (strcmp(result, "acceptable") == 0) {
+      parser->result = CORPUS_ACCEPTABLE;
+    } else {
+      parser->result = CORPUS_INVALID;
+    }
+    return 1;
+  }
+  if (strcmp(name, "msg") == 0) {
+    return json_hex_string(parser, &parser->message);
+  }
+  if (strcmp(name, "sig") == 0) {
+    return json_hex_string(parser, &parser->signature);
+  }
+  return json_skip_value(parser);
+}
+
+static int json_test(struct json_parser *parser) {
+  parser->id = 0;
+  parser->message.len = 0;
+  parser->signature.len = 0;
+  parser->result = CORPUS_INVALID;
+  parser->comment[0] = '\0';
+
+  return json_object(parser, json_test_member) && json_emit_test(parser);
+}
+
+static int json_key_member(struct json_parser *parser, const char *name) {
+  if (strcmp(name, "curve") == 0) {
+    if (!json_string(parser)) {
+      return 0;
+    }
+    snprintf(parser->curve, sizeof(parser->curve), "%s",
+             (char *)parser->string.data);
+    parser->curve_info = find_curve(parser->curve);
+    return 1;
+  }
+  if (strcmp(name, "wx") == 0) {
+    return json_hex_string(parser, &parser->wx);
+  }
+  if (strcmp(name, "wy") == 0) {
+    return json_hex_string(parser, &parser->wy);
+  }
+  return json_skip_value(parser);
+}
+
+// the public key is composed once the key object is complete, as the order of
+// its members is not defined
+static int json_key(struct json_parser *parser) {
+  parser->wx.len = 0;
+  parser->wy.len = 0;
+  if (!json_object(parser, json_key_member)) {
+    return 0;
+  }
+
+  size_t field_len =
+      parser->curve_info != NULL ? parser->curve_info->field_len : 0;
+  if (field_len > 0 && (!buffer_pad(&parser->wx, field_len) ||
+                        !buffer_pad(&parser->wy, field_len))) {
+    return json_error(parser, "public key is too large for its curve");
+  }
+  if (!buffer_reserve(&parser->public_key,
+                      parser->wx.len + parser->wy.len + 1)) {
+    return json_error(parser, "out of memory");
+  }
+  if (parser->wx.len > 0) {
+    memcpy(parser->public_key.data, parser->wx.data, parser->wx.len);
+  }
+  if (parser->wy.len > 0) {
+    memcpy(parser->public_key.data + parser->wx.len, parser->wy.data,
+           parser->wy.len);
+  }
+  parser->public_key.len = parser->wx.len + parser->wy.len;
+  return 1;
+}
+
+// the test cases are passed to the callback while they are read, so the key,
+// hash function and type of a group have to precede its tests, which is the
+// case for all Wycheproof files
+static int json_group_member(struct json_parser *parser, const char *name) {
+  if (strcmp(name, "key") == 0 || strcmp(name, "publicKey") == 0) {
+    return json_key(parser);
+  }
+  if (strcmp(name, "sha") == 0) {
+    if (!json_string(parser)) {
+      return 0;
+    }
+    EVP_MD_free(parser->md);
+    parser->md = fetch_md((char *)parser->string.data);
+    return 1;
+  }
+  if (strcmp(name, "type") == 0) {
+    if (!json_string(parser)) {
+      return 0;
+    }
+    parser->p1363 = strstr((char *)parser->string.data, "P1363") != NULL;
+    return 1;
+  }
+  if (strcmp(name, "tests") == 0) {
+    return json_array(parser, json_test);
+  }
+  return json_skip_value(parser);
+}
+
+static int json_group(struct json_parser *parser) {
+  parser->curve[0] = '\0';
+  parser->curve_info = NULL;
+  EVP_MD_free(parser->md);
+  parser->md = NULL;
+  parser->p1363 = 0;
+  parser->public_key.len = 0;
+
+  return json_object(parser, json_group_member);
+}
+
+static int json_file_member(struct json_parser *parser, const char *name) {
+  if (strcmp(name, "testGroups") == 0) {
+    return json_array(parser, json_group);
+  }
+  return json_skip_value(parser);
+}
+
+long corpus_load_wycheproof(const char *path, corpus_callback callback,
+                            void *context) {
+  long count = -1;
+  struct json_parser parser = {0};
+  parser.path = path;
+  parser.line = 1;
+  parser.callback = callback;
+  parser.context = context;
+
+  parser.file = fopen(path, "r");
+  if (parser.file == NULL) {
+    fprintf(stderr, "%s: could not open file\n", path);
+    goto end_corpus_load_wycheproof;
+  }
+  json_next(&parser);
+
+  if (json_object(&parser, json_file_member) || parser.stopped) {
+    count = parser.count;
+  }
+
+end_corpus_load_wycheproof:
+  if (parser.file != NULL) {
+    fclose(parser.file);
+  }
+  EVP_MD_free(parser.md);
+  buffer_free(&parser.string);
+  buffer_free(&parser.wx);
+  buffer_free(&parser.wy);
+  buffer_free(&parser.public_key);
+  buffer_free(&parser.message);
+  buffer_free(&parser.signature);
+  return count;
+}
+
+long corpus_load(const char *path, corpus_callback callback, void *context) {
+  const char *extension = strrchr(path, '.');
+  if (extension != NULL && strcmp(extension, ".json") == 0) {
+    return corpus_load_wycheproof(path, callback, context);
+  }
+  return corpus_load_rsp(path, callback, context);
+}
+
+int corpus_recovery_id(const struct corpus_case *test_case) {
+  int recovery_id = -1;
+  BIGNUM *k = NULL;
+  BIGNUM *y = NULL;
+  EC_POINT *point = NULL;
+
+  EC_GROUP *group = EC_GROUP_new_by_curve_name(test_case->curve_nid);
+  if (group == NULL || test_case->nonce_len == 0) {
+    goto end_corpus_recovery_id;
+  }
+  k = BN_bin2bn(test_case->nonce, (int)test_case->nonce_len, NULL);
+  y = BN_new();
+  point = EC_POINT_new(group);
+  if (k == NULL || y == NULL || point == NULL ||
+      EC_POINT_mul(group, point, k, NULL, NULL, NULL) != 1 ||
+      EC_POINT_get_affine_coordinates(group, point, NULL, y, NULL) != 1) {
+    goto end_corpus_recovery_id;
+  }
+  recovery_id = BN_is_odd(y);
+
+end_corpus_recovery_id:
+  ERR_clear_error();
+  EC_POINT_free(point);
+  BN_free(y);
+  BN_clear_free(k);
+  EC_GROUP_free(group);
+  return recovery_id;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stddef.h>
+
+#include "openssl/include/openssl/evp.h"
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming loaders for signature test vectors, so that large corpora don't
+ * need to be compiled into the tests. Supported are the .rsp/.txt files of the
+ * NIST CAVP ECDSA test vectors (SigVer.rsp, SigGen.txt) and the JSON files of
+ * the Wycheproof project (EcdsaVerify and EcdsaP1363Verify test groups). The
+ * files are read line by line or character by character and each test case is
+ * passed to a callback as soon as it is complete.
+ */
+
+enum corpus_result { CORPUS_VALID, CORPUS_INVALID, CORPUS_ACCEPTABLE };
+
+struct corpus_case {
+  // number of the test case in the file starting with 1, or the tcId of
+  // Wycheproof test cases
+  long id;
+  // as named in the file, e.g. "P-256" or "secp256r1"
+  const char *curve;
+  // NID_undef for curves that are not known to the loader
+  int curve_nid;
+  // hash function of the section or test group, NULL if it is not available
+  const EVP_MD *md;
+
+  const unsigned char *message;
+  size_t message_len;
+  // x || y, each padded to the length of a field element
+  const unsigned char *public_key;
+  size_t public_key_len;
+  // private key and nonce of SigGen vectors, otherwise their length is 0
+  const unsigned char *private_key;
+  size_t private_key_len;
+  const unsigned char *nonce;
+  size_t nonce_len;
+  // each padded to the length of a field element
+  const unsigned char *signature_r;
+  const unsigned char *signature_s;
+  size_t signature_len;
+  // 0 if the signature can't be split into r and s, e.g. because it is not
+  // DER encoded or r is too large. signature_r and signature_s are zero then.
+  int signature_decoded;
+
+  // SigGen vectors are always valid
+  enum corpus_result result;
+  // reason of a failed CAVP test case or comment of a Wycheproof test case
+  const char *comment;
+};
+
+// returning 0 stops the loader
+typedef int (*corpus_callback)(const struct corpus_case *test_case,
+                               void *context);
+
+// Loads a CAVP file and returns the number of test cases passed to the
+// callback or -1 if the file can't be read or parsed. The reason is written
+// to stderr.
+long corpus_load_rsp(const char *path, corpus_callback callback,
+                     void *context);
+
+// same as corpus_load_rsp for Wycheproof JSON files
+long corpus_load_wycheproof(const char *path, corpus_callback callback,
+                            void *context);
+
+// chooses the loader by the file extension, .json files are Wycheproof files
+long corpus_load(const char *path, corpus_callback callback, void *context);
+
+// Returns the recovery id (0 or 1) of a SigGen test case, which is the parity
+// of the y coordinate of k * G, or -1 if the case has no nonce.
+int corpus_recovery_id(const struct corpus_case *test_case);
+
+#ifdef __cplusplus
+extern
+}
+#endif
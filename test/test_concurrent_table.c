@@ -0,0 +1,276 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "concurrent_table.h"
+#include "epoch.h"
+
+#define THREAD_COUNT 4
+#define KEY_SPACE 1024
+#define ITERATIONS 20000
+
+struct test_key {
+  uint32_t id;
+  // not a multiple of the word size
+  unsigned char padding[9];
+};
+
+struct test_value {
+  uint64_t words[4];
+};
+
+static struct test_key key_of(uint32_t id) {
+  struct test_key key = {.id = id, .padding = {(unsigned char)id}};
+  return key;
+}
+
+// all words depend on the key, so that torn reads are detected
+static struct test_value value_of(uint32_t id) {
+  struct test_value value;
+  for (int i = 0; i < 4; i++) {
+    value.words[i] = (uint64_t)id * 0x9e3779b97f4a7c15ULL + i;
+  }
+  return value;
+}
+
+static atomic_int released = 0;
+
+static void release_object(void *object) {
+  atomic_fetch_add(&released, 1);
+  free(object);
+}
+
+static int acquire_object(void *object) { return 1; }
+
+static struct concurrent_table *new_table(size_t capacity) {
+  char error_message[256] = {0};
+  struct concurrent_table *table = concurrent_table_new(
+      error_message, capacity, sizeof(struct test_key),
+      sizeof(struct test_value), NULL);
+
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+  TEST_ASSERT_NOT_NULL(table);
+  return table;
+}
+
+void concurrent_table_should_return_inserted_values(void) {
+  char error_message[256] = {0};
+  struct concurrent_table *table = new_table(256);
+  struct test_value value;
+
+  for (uint32_t id = 0; id < 10; id++) {
+    struct test_key key = key_of(id);
+    struct test_value inserted = value_of(id);
+    TEST_ASSERT_EQUAL_INT(CONCURRENT_TABLE_INSERTED,
+                          concurrent_table_insert(table, error_message, &key,
+                                                  &inserted, &value, NULL));
+  }
+  for (uint32_t id = 0; id < 10; id++) {
+    struct test_key key = key_of(id);
+    struct test_value expected = value_of(id);
+    TEST_ASSERT_EQUAL_INT(
+        1, concurrent_table_get(table, error_message, &key, &value, NULL));
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &value, sizeof(value));
+  }
+  struct test_key missing = key_of(10);
+  TEST_ASSERT_EQUAL_INT(
+      0, concurrent_table_get(table, error_message, &missing, &value, NULL));
+
+  struct concurrent_table_shard_stats stats;
+  concurrent_table_stats(table, &stats);
+  TEST_ASSERT_EQUAL_UINT64(10, stats.hits);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.misses);
+  TEST_ASSERT_EQUAL_UINT64(10, stats.inserts);
+  TEST_ASSERT_EQUAL_UINT64(10, stats.entries);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.evictions);
+  TEST_ASSERT_EQUAL_UINT64(256, stats.capacity);
+
+  concurrent_table_free(table);
+}
+
+void concurrent_table_should_return_existing_value_of_key(void) {
+  char error_message[256] = {0};
+  struct concurrent_table *table = new_table(256);
+  struct test_key key = key_of(1);
+  struct test_value first = value_of(1);
+  struct test_value second = value_of(2);
+  struct test_value existing;
+
+  concurrent_table_insert(table, error_message, &key, &first, &existing,
+                          NULL);
+  TEST_ASSERT_EQUAL_INT(CONCURRENT_TABLE_EXISTS,
+                        concurrent_table_insert(table, error_message, &key,
+                                                &second, &existing, NULL));
+  TEST_ASSERT_EQUAL_MEMORY(&first, &existing, sizeof(existing));
+
+  concurrent_table_free(table);
+}
+
+void concurrent_table_should_keep_referenced_entries(void) {
+  char error_message[256] = {0};
+  // two slots per shard
+  struct concurrent_table *table =
+      new_table(2 * CONCURRENT_TABLE_SHARD_COUNT);
+  struct test_key kept = key_of(0);
+  struct test_value value = value_of(0);
+
+  concurrent_table_insert(table, error_message, &kept, &value, &value, NULL);
+  for (uint32_t id = 1; id < 200; id++) {
+    struct test_key key = key_of(id);
+    struct test_value inserted = value_of(id);
+    concurrent_table_insert(table, error_message, &key, &inserted, &value,
+                            NULL);
+    TEST_ASSERT_EQUAL_INT(
+        1, concurrent_table_get(table, error_message, &kept, &value, NULL));
+  }
+
+  struct concurrent_table_shard_stats stats;
+  concurrent_table_stats(table, &stats);
+  TEST_ASSERT_TRUE(stats.evictions > 0);
+  TEST_ASSERT_TRUE(stats.entries <= 2 * CONCURRENT_TABLE_SHARD_COUNT);
+
+  concurrent_table_free(table);
+}
+
+void concurrent_table_should_release_evicted_objects(void) {
+  char error_message[256] = {0};
+  // one slot per shard
+  struct concurrent_table *table =
+      concurrent_table_new(error_message, CONCURRENT_TABLE_SHARD_COUNT,
+                           sizeof(uint32_t), sizeof(void *), release_object);
+  TEST_ASSERT_NOT_NULL(table);
+
+  atomic_store(&released, 0);
+  for (uint32_t id = 0; id < 100; id++) {
+    uint32_t *object = malloc(sizeof(uint32_t));
+    void *existing = NULL;
+    *object = id;
+    TEST_ASSERT_EQUAL_INT(CONCURRENT_TABLE_INSERTED,
+                          concurrent_table_insert(table, error_message, &id,
+                                                  &object, &existing,
+                                                  acquire_object));
+  }
+
+  struct concurrent_table_shard_stats stats;
+  concurrent_table_stats(table, &stats);
+  TEST_ASSERT_EQUAL_UINT64(100, stats.entries + stats.evictions);
+  TEST_ASSERT_EQUAL_UINT64(0, epoch_reclaim());
+  TEST_ASSERT_EQUAL_INT(stats.evictions, atomic_load(&released));
+
+  // the objects are still valid
+  for (uint32_t id = 0; id < 100; id++) {
+    uint32_t *object = NULL;
+    if (concurrent_table_get(table, error_message, &id, &object,
+                             acquire_object)) {
+      TEST_ASSERT_EQUAL_UINT32(id, *object);
+    }
+  }
+
+  concurrent_table_free(table);
+  TEST_ASSERT_EQUAL_INT(100, atomic_load(&released));
+}
+
+void concurrent_table_should_reject_invalid_sizes(void) {
+  char error_message[256] = {0};
+
+  TEST_ASSERT_NULL(concurrent_table_new(error_message, 0, 8, 8, NULL));
+  TEST_ASSERT_EQUAL_STRING(
+      "Invalid capacity, key or value size of concurrent table\n",
+      error_message);
+  TEST_ASSERT_NULL(concurrent_table_new(
+      error_message, 16, CONCURRENT_TABLE_MAX_KEY_SIZE + 1, 8, NULL));
+  TEST_ASSERT_NULL(
+      concurrent_table_new(error_message, 16, 8, 16, release_object));
+}
+
+struct stress_context {
+  struct concurrent_table *table;
+  unsigned int seed;
+  atomic_int *torn_reads;
+};
+
+static void *stress(void *data) {
+  struct stress_context *context = data;
+  char error_message[256];
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    uint32_t id = (uint32_t)rand_r(&context->seed) % KEY_SPACE;
+    struct test_key key = key_of(id);
+    struct test_value expected = value_of(id);
+    struct test_value value;
+
+    if (concurrent_table_get(context->table, error_message, &key, &value,
+                             NULL) == 1) {
+      if (memcmp(&expected, &value, sizeof(value)) != 0) {
+        atomic_fetch_add(context->torn_reads, 1);
+      }
+    } else {
+      concurrent_table_insert(context->table, error_message, &key, &expected,
+                              &value, NULL);
+    }
+  }
+  return NULL;
+}
+
+void concurrent_table_should_not_return_torn_values(void) {
+  struct concurrent_table *table = new_table(KEY_SPACE / 4);
+  atomic_int torn_reads = 0;
+  pthread_t threads[THREAD_COUNT];
+  struct stress_context contexts[THREAD_COUNT];
+
+  for (int i = 0; i < THREAD_COUNT; i++) {
+    contexts[i] = (struct stress_context){
+        .table = table, .seed = (unsigned int)i + 1, .torn_reads = &torn_reads};
+    pthread_create(&threads[i], NULL, stress, &contexts[i]);
+  }
+  for (int i = 0; i < THREAD_COUNT; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  struct concurrent_table_shard_stats stats;
+  concurrent_table_stats(table, &stats);
+  TEST_ASSERT_EQUAL_INT(0, atomic_load(&torn_reads));
+  TEST_ASSERT_EQUAL_UINT64(THREAD_COUNT * ITERATIONS,
+                           stats.hits + stats.misses);
+  TEST_ASSERT_TRUE(stats.evictions > 0);
+
+  concurrent_table_free(table);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(concurrent_table_should_return_inserted_values);
+  RUN_TEST(concurrent_table_should_return_existing_value_of_key);
+  RUN_TEST(concurrent_table_should_keep_referenced_entries);
+  RUN_TEST(concurrent_table_should_release_evicted_objects);
+  RUN_TEST(concurrent_table_should_reject_invalid_sizes);
+  RUN_TEST(concurrent_table_should_not_return_torn_values);
+
+  return UNITY_END();
+}
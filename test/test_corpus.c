@@ -0,0 +1,173 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/obj_mac.h"
+#include "unity.h"
+
+#include "corpus.h"
+
+#define SIG_VER_PATH "test/vectors/SigVer.rsp"
+#define SIG_GEN_PATH "test/vectors/SigGen.rsp"
+#define WYCHEPROOF_PATH "test/vectors/ecdsa_p256_sha256_wycheproof_format.json"
+
+// the test cases are copied, so that they can be checked after loading
+struct loaded_case {
+  struct corpus_case test_case;
+  unsigned char message[128];
+  unsigned char public_key[64];
+  unsigned char nonce[32];
+  unsigned char signature_r[32];
+  unsigned char signature_s[32];
+  char hash_name[16];
+  char comment[64];
+};
+
+struct loaded_cases {
+  struct loaded_case cases[16];
+  int count;
+  // stops loading after this number of cases
+  int limit;
+};
+
+static int copy_case(const struct corpus_case *test_case, void *context) {
+  struct loaded_cases *loaded = context;
+  struct loaded_case *copy = &loaded->cases[loaded->count++];
+
+  TEST_ASSERT_TRUE(test_case->message_len <= sizeof(copy->message));
+  TEST_ASSERT_EQUAL_size_t(64, test_case->public_key_len);
+  TEST_ASSERT_EQUAL_size_t(32, test_case->signature_len);
+
+  copy->test_case = *test_case;
+  memcpy(copy->message, test_case->message, test_case->message_len);
+  memcpy(copy->public_key, test_case->public_key, 64);
+  if (test_case->nonce_len > 0) {
+    memcpy(copy->nonce, test_case->nonce, test_case->nonce_len);
+  }
+  memcpy(copy->signature_r, test_case->signature_r, 32);
+  memcpy(copy->signature_s, test_case->signature_s, 32);
+  snprintf(copy->hash_name, sizeof(copy->hash_name), "%s",
+           test_case->md != NULL ? EVP_MD_get0_name(test_case->md) : "");
+  snprintf(copy->comment, sizeof(copy->comment), "%s", test_case->comment);
+
+  return loaded->count < loaded->limit;
+}
+
+void corpus_load_rsp_should_pass_test_cases_to_callback(void) {
+  struct loaded_cases loaded = {.limit = 3};
+
+  TEST_ASSERT_EQUAL_INT(3, corpus_load(SIG_VER_PATH, copy_case, &loaded));
+  TEST_ASSERT_EQUAL_INT(3, loaded.count);
+
+  struct corpus_case *first = &loaded.cases[0].test_case;
+  TEST_ASSERT_EQUAL_INT(1, first->id);
+  TEST_ASSERT_EQUAL_INT(NID_X9_62_prime256v1, first->curve_nid);
+  TEST_ASSERT_EQUAL_STRING("SHA2-224", loaded.cases[0].hash_name);
+  TEST_ASSERT_EQUAL_size_t(128, first->message_len);
+  TEST_ASSERT_EQUAL_HEX8(0x3a, loaded.cases[0].message[0]);
+  TEST_ASSERT_EQUAL_HEX8(0xdf, loaded.cases[0].message[127]);
+  TEST_ASSERT_EQUAL_HEX8(0x84, loaded.cases[0].public_key[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x83, loaded.cases[0].public_key[32]);
+  TEST_ASSERT_EQUAL_HEX8(0xd0, loaded.cases[0].signature_r[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x8d, loaded.cases[0].signature_s[0]);
+  TEST_ASSERT_EQUAL_INT(1, first->signature_decoded);
+  TEST_ASSERT_EQUAL_size_t(0, first->private_key_len);
+  TEST_ASSERT_EQUAL_INT(CORPUS_VALID, first->result);
+
+  TEST_ASSERT_EQUAL_INT(CORPUS_INVALID, loaded.cases[1].test_case.result);
+  TEST_ASSERT_EQUAL_STRING("3 - S changed", loaded.cases[1].comment);
+  TEST_ASSERT_EQUAL_STRING("1 - Message changed", loaded.cases[2].comment);
+}
+
+void corpus_load_rsp_should_read_nonces_of_sig_gen_files(void) {
+  struct loaded_cases loaded = {.limit = 1};
+
+  TEST_ASSERT_EQUAL_INT(1, corpus_load(SIG_GEN_PATH, copy_case, &loaded));
+
+  struct corpus_case *test_case = &loaded.cases[0].test_case;
+  TEST_ASSERT_EQUAL_size_t(32, test_case->private_key_len);
+  TEST_ASSERT_EQUAL_size_t(32, test_case->nonce_len);
+  TEST_ASSERT_EQUAL_HEX8(0x58, loaded.cases[0].nonce[0]);
+
+  test_case->nonce = loaded.cases[0].nonce;
+  TEST_ASSERT_EQUAL_INT(0, corpus_recovery_id(test_case));
+}
+
+void corpus_load_wycheproof_should_decode_signatures(void) {
+  struct loaded_cases loaded = {.limit = 16};
+
+  TEST_ASSERT_EQUAL_INT(9, corpus_load(WYCHEPROOF_PATH, copy_case, &loaded));
+
+  for (int i = 0; i < loaded.count; i++) {
+    struct corpus_case *test_case = &loaded.cases[i].test_case;
+    TEST_ASSERT_EQUAL_INT(i + 1, test_case->id);
+    TEST_ASSERT_EQUAL_INT(NID_X9_62_prime256v1, test_case->curve_nid);
+    TEST_ASSERT_EQUAL_STRING("SHA2-256", loaded.cases[i].hash_name);
+  }
+
+  // the DER signature of the first group and the P1363 signature of the
+  // second group are the signatures of the first SigGen test cases
+  struct loaded_case *der = &loaded.cases[0];
+  TEST_ASSERT_EQUAL_INT(1, der->test_case.signature_decoded);
+  TEST_ASSERT_EQUAL_INT(CORPUS_VALID, der->test_case.result);
+  TEST_ASSERT_EQUAL_HEX8(0xf3, der->signature_r[0]);
+  TEST_ASSERT_EQUAL_HEX8(0xac, der->signature_r[31]);
+  TEST_ASSERT_EQUAL_HEX8(0x8b, der->signature_s[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x1c, der->public_key[0]);
+  TEST_ASSERT_EQUAL_HEX8(0xce, der->public_key[32]);
+
+  struct loaded_case *p1363 = &loaded.cases[6];
+  TEST_ASSERT_EQUAL_INT(1, p1363->test_case.signature_decoded);
+  TEST_ASSERT_EQUAL_STRING("signature from SigGen.rsp", p1363->comment);
+
+  // BER is not accepted
+  TEST_ASSERT_EQUAL_INT(0, loaded.cases[3].test_case.signature_decoded);
+  TEST_ASSERT_EQUAL_INT(CORPUS_INVALID, loaded.cases[3].test_case.result);
+  // a truncated P1363 signature can't be split
+  TEST_ASSERT_EQUAL_INT(0, loaded.cases[7].test_case.signature_decoded);
+
+  TEST_ASSERT_EQUAL_STRING("modified message \"last bit flipped\"",
+                           loaded.cases[5].comment);
+}
+
+void corpus_load_should_fail_for_missing_files(void) {
+  struct loaded_cases loaded = {.limit = 16};
+
+  TEST_ASSERT_EQUAL_INT(-1, corpus_load("test/vectors/missing.rsp", copy_case,
+                                        &loaded));
+  TEST_ASSERT_EQUAL_INT(-1, corpus_load("test/vectors/missing.json",
+                                        copy_case, &loaded));
+  TEST_ASSERT_EQUAL_INT(0, loaded.count);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(corpus_load_rsp_should_pass_test_cases_to_callback);
+  RUN_TEST(corpus_load_rsp_should_read_nonces_of_sig_gen_files);
+  RUN_TEST(corpus_load_wycheproof_should_decode_signatures);
+  RUN_TEST(corpus_load_should_fail_for_missing_files);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
@@ -0,0 +1,228 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstddef>
+#include <cstring>
+#include <execution>
+#include <string>
+#include <vector>
+
+#include "unity.h"
+
+#include "besu_native_ec.hpp"
+
+namespace ec = besu::native_ec;
+
+#define BATCH_SIZE 64
+
+// key of SigGen.txt from the CAVP test vectors
+static const char *private_key_hex =
+    "519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464";
+static const char *public_key_hex =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+template <std::size_t Size> static ec::bytes<Size> from_hex(const char *hex) {
+  ec::bytes<Size> result;
+  for (std::size_t i = 0; i < Size; i++) {
+    result[i] = static_cast<std::byte>(
+        std::stoi(std::string(hex + 2 * i, 2), nullptr, 16));
+  }
+  return result;
+}
+
+static ec::bytes<32> hash_of(int i) {
+  ec::bytes<32> hash{};
+  hash[0] = static_cast<std::byte>(i);
+  hash[31] = static_cast<std::byte>(i >> 8);
+  return hash;
+}
+
+static const ec::bytes<32> private_key = from_hex<32>(private_key_hex);
+static const ec::bytes<64> public_key = from_hex<64>(public_key_hex);
+
+void sign_should_create_signatures_that_verify_and_recover(void) {
+  ec::bytes<32> hash = hash_of(1);
+
+  ec::signature<ec::P256> signature =
+      ec::sign<ec::P256>(hash, private_key, public_key);
+
+  TEST_ASSERT_TRUE(ec::verify<ec::P256>(hash, signature, public_key));
+  TEST_ASSERT_TRUE(public_key == ec::recover<ec::P256>(hash, signature));
+  TEST_ASSERT_FALSE(ec::verify<ec::P256>(hash_of(2), signature, public_key));
+}
+
+void verify_should_throw_errors_of_c_library(void) {
+  ec::bytes<32> hash = hash_of(1);
+  ec::signature<ec::P256> signature =
+      ec::sign<ec::P256>(hash, private_key, public_key);
+  signature.s.fill(std::byte{0xff});
+
+  try {
+    ec::verify<ec::P256>(hash, signature, public_key);
+    TEST_FAIL_MESSAGE("verify with s greater than n / 2 should throw");
+  } catch (const ec::error &e) {
+    const char *expected = "Signature is not canonicalized. s of signature "
+                           "must not be greater than n / 2: ";
+    TEST_ASSERT_EQUAL_STRING_LEN(expected, e.what(), strlen(expected));
+  }
+}
+
+void derive_public_key_and_ecdh_should_match_c_library(void) {
+  TEST_ASSERT_TRUE(public_key == ec::derive_public_key<ec::P256>(private_key));
+
+  ecdh_result expected =
+      p256_ecdh(reinterpret_cast<const char *>(private_key.data()),
+                reinterpret_cast<const char *>(public_key.data()));
+  ec::bytes<32> shared_secret = ec::ecdh<ec::P256>(private_key, public_key);
+
+  TEST_ASSERT_EQUAL_MEMORY(expected.shared_secret, shared_secret.data(), 32);
+}
+
+template <typename ExecutionPolicy>
+static void run_batches(ExecutionPolicy &&policy) {
+  std::vector<ec::bytes<32>> hashes;
+  std::vector<ec::signature<ec::P256>> signatures;
+  for (int i = 0; i < BATCH_SIZE; i++) {
+    hashes.push_back(hash_of(i));
+    signatures.push_back(
+        ec::sign<ec::P256>(hashes[i], private_key, public_key));
+  }
+  // one invalid signature
+  hashes[BATCH_SIZE - 1] = hash_of(BATCH_SIZE);
+
+  std::vector<ec::verify_request<ec::P256>> verify_requests;
+  std::vector<ec::recover_request<ec::P256>> recover_requests;
+  for (int i = 0; i < BATCH_SIZE; i++) {
+    verify_requests.push_back(
+        {hashes[i], signatures[i].r, signatures[i].s, public_key});
+    recover_requests.push_back(
+        {hashes[i], signatures[i].r, signatures[i].s, signatures[i].v});
+  }
+
+  std::vector<verify_result> verify_results(BATCH_SIZE);
+  std::vector<key_recovery_result> recover_results(BATCH_SIZE);
+
+  TEST_ASSERT_EQUAL_size_t(BATCH_SIZE - 1,
+                           ec::verify_batch<ec::P256>(policy, verify_requests,
+                                                      verify_results));
+  TEST_ASSERT_EQUAL_size_t(BATCH_SIZE,
+                           ec::recover_batch<ec::P256>(
+                               policy, recover_requests, recover_results));
+
+  for (int i = 0; i < BATCH_SIZE - 1; i++) {
+    TEST_ASSERT_EQUAL_INT(1, verify_results[i].verified);
+    TEST_ASSERT_EQUAL_MEMORY(public_key.data(), recover_results[i].public_key,
+                             64);
+  }
+  TEST_ASSERT_EQUAL_INT(0, verify_results[BATCH_SIZE - 1].verified);
+}
+
+void batches_should_run_with_sequential_policy(void) {
+  run_batches(std::execution::seq);
+}
+
+void batches_should_run_with_parallel_policy(void) {
+  run_batches(std::execution::par);
+}
+
+void batches_should_reject_too_few_results(void) {
+  std::vector<ec::verify_request<ec::P256>> requests;
+  ec::bytes<32> hash = hash_of(1);
+  ec::signature<ec::P256> signature =
+      ec::sign<ec::P256>(hash, private_key, public_key);
+  requests.push_back({hash, signature.r, signature.s, public_key});
+  std::vector<verify_result> results;
+
+  try {
+    ec::verify_batch<ec::P256>(std::execution::seq, requests, results);
+    TEST_FAIL_MESSAGE("verify_batch without results should throw");
+  } catch (const std::length_error &) {
+  }
+}
+
+void validated_key_should_verify_and_agree_on_secret(void) {
+  ec::bytes<32> hash = hash_of(1);
+  ec::signature<ec::P256> signature =
+      ec::sign<ec::P256>(hash, private_key, public_key);
+
+  ec::validated_key<ec::P256> key(public_key);
+
+  TEST_ASSERT_TRUE(key.verify(hash, signature));
+  TEST_ASSERT_FALSE(key.verify(hash_of(2), signature));
+  TEST_ASSERT_TRUE(ec::ecdh<ec::P256>(private_key, public_key) ==
+                   key.ecdh(private_key));
+}
+
+void validated_key_should_throw_for_invalid_public_key(void) {
+  ec::bytes<64> invalid_key{};
+
+  try {
+    ec::validated_key<ec::P256> key(invalid_key);
+    TEST_FAIL_MESSAGE("validated_key of an invalid public key should throw");
+  } catch (const ec::error &e) {
+    TEST_ASSERT_EQUAL_STRING_LEN("Public key is not a point on the curve: ",
+                                 e.what(), 40);
+  }
+}
+
+void key_table_should_find_and_verify_keys(void) {
+  ec::bytes<32> hash = hash_of(1);
+  ec::signature<ec::P256> signature =
+      ec::sign<ec::P256>(hash, private_key, public_key);
+
+  ec::key_table<ec::P256> table(public_key);
+  int index = table.find(public_key);
+
+  TEST_ASSERT_EQUAL_INT(0, index);
+  TEST_ASSERT_TRUE(table.verify(index, hash, signature.r, signature.s));
+
+  ec::key_table<ec::P256> compact_table(public_key, KEY_TABLE_COMPACT);
+  TEST_ASSERT_EQUAL_INT(0, compact_table.find(public_key));
+  TEST_ASSERT_TRUE(compact_table.verify(0, hash, signature.r, signature.s));
+}
+
+void ecdh_key_pool_should_hand_out_valid_key_pairs(void) {
+  ec::ecdh_key_pool<ec::P256> pool(4);
+
+  ec::key_pair<ec::P256> key_pair = pool.take();
+
+  TEST_ASSERT_TRUE(key_pair.public_key ==
+                   ec::derive_public_key<ec::P256>(key_pair.private_key));
+  TEST_ASSERT_EQUAL_UINT64(1, pool.stats().taken);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(sign_should_create_signatures_that_verify_and_recover);
+  RUN_TEST(verify_should_throw_errors_of_c_library);
+  RUN_TEST(derive_public_key_and_ecdh_should_match_c_library);
+  RUN_TEST(batches_should_run_with_sequential_policy);
+  RUN_TEST(batches_should_run_with_parallel_policy);
+  RUN_TEST(batches_should_reject_too_few_results);
+  RUN_TEST(validated_key_should_verify_and_agree_on_secret);
+  RUN_TEST(validated_key_should_throw_for_invalid_public_key);
+  RUN_TEST(key_table_should_find_and_verify_keys);
+  RUN_TEST(ecdh_key_pool_should_hand_out_valid_key_pairs);
+
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// fork is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "unity.h"
+
+#include "constants.h"
+#include "csprng.h"
+#include "thread_context.h"
+
+#define OUTPUT_LEN 64
+
+static void *random_bytes_of_thread(void *output) {
+  char error_message[256] = {0};
+
+  if (thread_random_bytes(error_message, output, OUTPUT_LEN) != SUCCESS) {
+    memset(output, 0, OUTPUT_LEN);
+  }
+  return NULL;
+}
+
+void chacha20_block_should_match_rfc_8439_test_vector(void) {
+  // section 2.3.2 of RFC 8439
+  const uint32_t key[8] = {0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+                           0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c};
+  const uint32_t nonce[3] = {0x09000000, 0x4a000000, 0x00000000};
+  const unsigned char expected[CHACHA20_BLOCK_LEN] = {
+      0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd,
+      0x1f, 0xa3, 0x20, 0x71, 0xc4, 0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0,
+      0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e, 0xd2,
+      0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05,
+      0xd9, 0x8b, 0x02, 0xa2, 0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e,
+      0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e};
+  unsigned char block[CHACHA20_BLOCK_LEN];
+
+  chacha20_block(block, key, 1, nonce);
+
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, block, CHACHA20_BLOCK_LEN);
+}
+
+void csprng_bytes_should_not_repeat_output(void) {
+  char error_message[256] = {0};
+  struct csprng csprng = {.seeded = 0};
+  unsigned char first[OUTPUT_LEN], second[OUTPUT_LEN];
+  const unsigned char zero[OUTPUT_LEN] = {0};
+
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, csprng_bytes(&csprng, error_message, first, OUTPUT_LEN));
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, csprng_bytes(&csprng, error_message, second, OUTPUT_LEN));
+
+  TEST_ASSERT_NOT_EQUAL(0, memcmp(first, second, OUTPUT_LEN));
+  TEST_ASSERT_NOT_EQUAL(0, memcmp(first, zero, OUTPUT_LEN));
+  csprng_cleanse(&csprng);
+}
+
+void csprng_bytes_should_fill_requests_larger_than_the_reseed_interval(void) {
+  char error_message[256] = {0};
+  struct csprng csprng = {.seeded = 0};
+  const size_t len = CSPRNG_RESEED_INTERVAL + 3 * CSPRNG_BUFFER_LEN + 5;
+  unsigned char *output = calloc(len, 1);
+  unsigned char next[OUTPUT_LEN];
+  const unsigned char zero[OUTPUT_LEN] = {0};
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        csprng_bytes(&csprng, error_message, output, len));
+  TEST_ASSERT_NOT_EQUAL(0, memcmp(output + len - OUTPUT_LEN, zero, OUTPUT_LEN));
+  TEST_ASSERT_GREATER_OR_EQUAL(CSPRNG_RESEED_INTERVAL,
+                               csprng.output_since_seed);
+
+  // the next request reseeds the generator
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, csprng_bytes(&csprng, error_message, next, OUTPUT_LEN));
+  TEST_ASSERT_EQUAL_UINT64(OUTPUT_LEN, csprng.output_since_seed);
+
+  free(output);
+  csprng_cleanse(&csprng);
+}
+
+void thread_random_bytes_should_differ_between_threads(void) {
+  unsigned char outputs[2][OUTPUT_LEN];
+  pthread_t threads[2];
+  const unsigned char zero[OUTPUT_LEN] = {0};
+
+  for (int i = 0; i < 2; i++) {
+    pthread_create(&threads[i], NULL, random_bytes_of_thread, outputs[i]);
+  }
+  for (int i = 0; i < 2; i++) {
+    pthread_join(threads[i], NULL);
+    TEST_ASSERT_NOT_EQUAL(0, memcmp(outputs[i], zero, OUTPUT_LEN));
+  }
+
+  TEST_ASSERT_NOT_EQUAL(0, memcmp(outputs[0], outputs[1], OUTPUT_LEN));
+}
+
+void thread_random_bytes_should_differ_between_parent_and_child(void) {
+  char error_message[256] = {0};
+  unsigned char parent[OUTPUT_LEN], child[OUTPUT_LEN];
+  int pipe_fds[2];
+
+  // the generator of the thread is seeded before the fork
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, thread_random_bytes(error_message, parent, OUTPUT_LEN));
+  TEST_ASSERT_EQUAL_INT(0, pipe(pipe_fds));
+
+  pid_t pid = fork();
+  TEST_ASSERT_GREATER_OR_EQUAL(0, pid);
+  if (pid == 0) {
+    random_bytes_of_thread(child);
+    _exit(write(pipe_fds[1], child, OUTPUT_LEN) == OUTPUT_LEN ? 0 : 1);
+  }
+
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, thread_random_bytes(error_message, parent, OUTPUT_LEN));
+  TEST_ASSERT_EQUAL_INT(OUTPUT_LEN, read(pipe_fds[0], child, OUTPUT_LEN));
+  waitpid(pid, NULL, 0);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+
+  TEST_ASSERT_NOT_EQUAL(0, memcmp(parent, child, OUTPUT_LEN));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(chacha20_block_should_match_rfc_8439_test_vector);
+  RUN_TEST(csprng_bytes_should_not_repeat_output);
+  RUN_TEST(csprng_bytes_should_fill_requests_larger_than_the_reseed_interval);
+  RUN_TEST(thread_random_bytes_should_differ_between_threads);
+  RUN_TEST(thread_random_bytes_should_differ_between_parent_and_child);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
@@ -0,0 +1,197 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "utils.h"
+
+// COUNT = 0 of the P-256 section of KAS_ECC_CDH_PrimitiveTest.txt from the
+// CAVP test vectors
+static const char *private_key =
+    "7d7dc5f71eb29ddaf80d6214632eeae03d9058af1fb6d22ed80badb62bc1a534";
+static const char *peer_public_key =
+    "700c48f77f56584c5cc632ca65640db91b6bacce3a4df6b42ce7cc838833d287"
+    "db71e509e3fd9b060ddb20ba5c51dcc5948d46fbf640dfe0441782cab85fa4ac";
+static const char *shared_secret =
+    "46fc62106420ff012e54a434fbdd2d25ccc5852060561e68040dd7778997bd7b";
+
+// the public key of the private key
+// 38f65d6dce47676044d58ce5139582d568f64bb16098d179dbab07741dd5caf5 and the
+// secret it shares with the private key above
+static const char *other_public_key =
+    "119f2f047902782ab0c9e27a54aff5eb9b964829ca99c06b02ddba95b0a3f6d0"
+    "8f52b726664cac366fc98ac7a012b2682cbd962e5acb544671d41b9445704d1d";
+static const char *other_shared_secret =
+    "69854de86f85d63854b189cd4f7a556c668977ed93277edc449e9f7655b28175";
+
+static struct ecdh_result ecdh_hex(const char *private_key_hex,
+                                   const char *public_key_hex) {
+  unsigned char *private_key_data = hex_to_bin(private_key_hex);
+  unsigned char *public_key_data = hex_to_bin(public_key_hex);
+
+  struct ecdh_result result = p256_ecdh((const char *)private_key_data,
+                                        (const char *)public_key_data);
+
+  free(private_key_data);
+  free(public_key_data);
+  return result;
+}
+
+void p256_ecdh_should_compute_shared_secret(void) {
+  unsigned char *expected = hex_to_bin(shared_secret);
+
+  struct ecdh_result result = ecdh_hex(private_key, peer_public_key);
+
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, result.shared_secret, 32);
+  free(expected);
+}
+
+void p256_ecdh_should_reject_invalid_keys(void) {
+  char public_key[129];
+
+  // y + 1
+  strcpy(public_key, peer_public_key);
+  public_key[127] = 'd';
+  struct ecdh_result result = ecdh_hex(private_key, public_key);
+  TEST_ASSERT_EQUAL_STRING_LEN("Public key of peer is not a point on the "
+                               "curve: ",
+                               result.error_message, 40);
+
+  // the point at infinity can't be encoded as x || y either
+  result = ecdh_hex(private_key,
+                    "0000000000000000000000000000000000000000000000000000000000"
+                    "0000000000000000000000000000000000000000000000000000000000"
+                    "000000000000");
+  TEST_ASSERT_EQUAL_STRING_LEN("Public key of peer is not a point on the "
+                               "curve: ",
+                               result.error_message, 40);
+
+  result = ecdh_hex(
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      peer_public_key);
+  TEST_ASSERT_EQUAL_STRING("Private key must be between 1 and n - 1\n",
+                           result.error_message);
+
+  // n
+  result = ecdh_hex(
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551",
+      peer_public_key);
+  TEST_ASSERT_EQUAL_STRING("Private key must be between 1 and n - 1\n",
+                           result.error_message);
+}
+
+void p256_ecdh_batch_should_compute_all_shared_secrets(void) {
+  char private_keys[3 * 32];
+  char public_keys[3 * 64];
+  struct ecdh_result results[3];
+  const char *private_key_hex[] = {private_key, private_key, private_key};
+  const char *public_key_hex[] = {peer_public_key, other_public_key,
+                                  other_public_key};
+
+  for (int i = 0; i < 3; i++) {
+    unsigned char *data = hex_to_bin(private_key_hex[i]);
+    memcpy(private_keys + i * 32, data, 32);
+    free(data);
+    data = hex_to_bin(public_key_hex[i]);
+    memcpy(public_keys + i * 64, data, 64);
+    free(data);
+  }
+  // the last public key is not on the curve
+  public_keys[3 * 64 - 1] ^= 1;
+
+  TEST_ASSERT_EQUAL_INT(
+      2, p256_ecdh_batch(results, private_keys, public_keys, 3));
+
+  unsigned char *expected = hex_to_bin(shared_secret);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, results[0].shared_secret, 32);
+  free(expected);
+  expected = hex_to_bin(other_shared_secret);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, results[1].shared_secret, 32);
+  free(expected);
+  TEST_ASSERT_TRUE(strlen(results[2].error_message) > 0);
+}
+
+void p256_ecdh_key_pool_should_hand_out_distinct_key_pairs(void) {
+  char error_message[256] = {0};
+  struct p256_ecdh_key_pool *pool = NULL;
+  struct p256_ecdh_key_pair key_pairs[20];
+
+  TEST_ASSERT_EQUAL_INT(
+      1, p256_ecdh_key_pool_create(&pool, error_message, 8));
+
+  // takes more key pairs than the pool holds
+  for (int i = 0; i < 20; i++) {
+    TEST_ASSERT_EQUAL_INT(
+        1, p256_ecdh_key_pool_take(pool, error_message, &key_pairs[i]));
+    for (int j = 0; j < i; j++) {
+      TEST_ASSERT_TRUE(memcmp(key_pairs[i].private_key,
+                              key_pairs[j].private_key, 32) != 0);
+    }
+  }
+
+  // both sides derive the same secret from the key pairs
+  for (int i = 0; i + 1 < 20; i += 2) {
+    struct ecdh_result a =
+        p256_ecdh(key_pairs[i].private_key, key_pairs[i + 1].public_key);
+    struct ecdh_result b =
+        p256_ecdh(key_pairs[i + 1].private_key, key_pairs[i].public_key);
+    TEST_ASSERT_EQUAL_STRING("", a.error_message);
+    TEST_ASSERT_EQUAL_STRING("", b.error_message);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(a.shared_secret, b.shared_secret, 32);
+  }
+
+  struct ecdh_key_pool_stats stats = p256_ecdh_key_pool_stats(pool);
+  TEST_ASSERT_EQUAL_UINT64(8, stats.capacity);
+  TEST_ASSERT_EQUAL_UINT64(20, stats.taken);
+  TEST_ASSERT_TRUE(stats.available <= 8);
+  TEST_ASSERT_EQUAL_UINT64(20, stats.generated + stats.misses -
+                                   stats.available);
+
+  p256_ecdh_key_pool_free(pool);
+}
+
+void p256_ecdh_key_pool_should_reject_invalid_capacity(void) {
+  char error_message[256] = {0};
+  struct p256_ecdh_key_pool *pool = NULL;
+
+  TEST_ASSERT_EQUAL_INT(
+      0, p256_ecdh_key_pool_create(&pool, error_message, 0));
+  TEST_ASSERT_EQUAL_STRING("Capacity of key pool must be between 1 and 65536\n",
+                           error_message);
+  TEST_ASSERT_NULL(pool);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_ecdh_should_compute_shared_secret);
+  RUN_TEST(p256_ecdh_should_reject_invalid_keys);
+  RUN_TEST(p256_ecdh_batch_should_compute_all_shared_secrets);
+  RUN_TEST(p256_ecdh_key_pool_should_hand_out_distinct_key_pairs);
+  RUN_TEST(p256_ecdh_key_pool_should_reject_invalid_capacity);
+
+  return UNITY_END();
+}
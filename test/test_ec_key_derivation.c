@@ -0,0 +1,135 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "utils.h"
+
+#define KEY_PAIR_COUNT 100
+
+// key of SigGen.txt from the CAVP test vectors
+static const char *private_key =
+    "519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464";
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+static struct public_key_result derive_hex(const char *private_key_hex) {
+  unsigned char *private_key_data = hex_to_bin(private_key_hex);
+  struct public_key_result result =
+      p256_derive_public_key((const char *)private_key_data);
+  free(private_key_data);
+  return result;
+}
+
+void p256_derive_public_key_should_derive_public_key(void) {
+  unsigned char *expected = hex_to_bin(public_key);
+
+  struct public_key_result result = derive_hex(private_key);
+
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, result.public_key, 64);
+  free(expected);
+}
+
+void p256_derive_public_key_should_reject_invalid_private_keys(void) {
+  TEST_ASSERT_EQUAL_STRING(
+      "Private key must be between 1 and n - 1\n",
+      derive_hex(
+          "0000000000000000000000000000000000000000000000000000000000000000")
+          .error_message);
+  // n
+  TEST_ASSERT_EQUAL_STRING(
+      "Private key must be between 1 and n - 1\n",
+      derive_hex(
+          "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551")
+          .error_message);
+}
+
+void p256_derive_public_keys_should_derive_all_public_keys(void) {
+  char private_keys[3 * 32] = {0};
+  struct public_key_result results[3];
+  unsigned char *data = hex_to_bin(private_key);
+  unsigned char *expected = hex_to_bin(public_key);
+
+  memcpy(private_keys, data, 32);
+  // the second private key is 0
+  memcpy(private_keys + 2 * 32, data, 32);
+
+  TEST_ASSERT_EQUAL_INT(2, p256_derive_public_keys(results, private_keys, 3));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, results[0].public_key, 64);
+  TEST_ASSERT_EQUAL_STRING("Private key must be between 1 and n - 1\n",
+                           results[1].error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, results[2].public_key, 64);
+
+  free(data);
+  free(expected);
+}
+
+void p256_generate_keypairs_should_generate_matching_key_pairs(void) {
+  char error_message[256] = {0};
+  char *private_keys = malloc(KEY_PAIR_COUNT * 32);
+  char *public_keys = malloc(KEY_PAIR_COUNT * 64);
+
+  TEST_ASSERT_EQUAL_INT(1, p256_generate_keypairs(private_keys, public_keys,
+                                                  error_message,
+                                                  KEY_PAIR_COUNT));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  for (int i = 0; i < KEY_PAIR_COUNT; i++) {
+    struct public_key_result result =
+        p256_derive_public_key(private_keys + i * 32);
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(public_keys + i * 64, result.public_key, 64);
+    if (i > 0) {
+      TEST_ASSERT_TRUE(
+          memcmp(private_keys + i * 32, private_keys + (i - 1) * 32, 32) != 0);
+    }
+  }
+
+  free(private_keys);
+  free(public_keys);
+}
+
+void p256_generate_keypairs_should_reject_negative_count(void) {
+  char error_message[256] = {0};
+
+  TEST_ASSERT_EQUAL_INT(0,
+                        p256_generate_keypairs(NULL, NULL, error_message, -1));
+  TEST_ASSERT_EQUAL_STRING("Number of key pairs must not be negative\n",
+                           error_message);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_derive_public_key_should_derive_public_key);
+  RUN_TEST(p256_derive_public_key_should_reject_invalid_private_keys);
+  RUN_TEST(p256_derive_public_keys_should_derive_all_public_keys);
+  RUN_TEST(p256_generate_keypairs_should_generate_matching_key_pairs);
+  RUN_TEST(p256_generate_keypairs_should_reject_negative_count);
+
+  return UNITY_END();
+}
@@ -15,96 +15,104 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
-#include <stdlib.h>
 #include <string.h>
 
 #include "openssl/include/openssl/evp.h"
 #include "unity.h"
 
 #include "besu_native_ec.h"
-#include "ec_sign_test_vectors.h"
-#include "utils.h"
-
-void p256_key_recovery_should_recover_correct_public_keys(
-    const EVP_MD *md, struct sign_test_vector test_vectors[],
-    int test_vectors_len) {
+#include "corpus.h"
+#include "worker_pool.h"
+
+// the signatures of SigGen.txt from the CAVP test vectors, see test_ec_sign.c
+#define SIG_GEN_PATH "test/vectors/SigGen.rsp"
+#define SIG_GEN_CASE_COUNT 60
+#define SIG_GEN_SECTION_CASE_COUNT 15
+
+struct key_recovery_test {
+  const char *hash_name;
+  int case_count;
+};
+
+static int key_recovery_test_case(const struct corpus_case *test_case,
+                                  void *context) {
+  struct key_recovery_test *test = context;
   unsigned char md_value[EVP_MAX_MD_SIZE];
   unsigned int md_value_len = 0;
 
-  for (int i = 0; i < test_vectors_len; i++) {
-    unsigned char *data_bin = hex_to_bin(test_vectors[i].data);
-    char *signature_r_bin = (char *)hex_to_bin(test_vectors[i].signature_r);
-    char *signature_s_bin = (char *)hex_to_bin(test_vectors[i].signature_s);
-    char *public_key_bin = (char *)hex_to_bin(test_vectors[i].public_key);
+  if (!EVP_MD_is_a(test_case->md, test->hash_name)) {
+    return 1;
+  }
+  test->case_count++;
+
+  if (EVP_Digest(test_case->message, test_case->message_len, md_value,
+                 &md_value_len, test_case->md, NULL) != 1) {
+    TEST_FAIL_MESSAGE("Hashing not successful");
+  }
 
-    if (EVP_Digest(data_bin, strlen(test_vectors[i].data) / 2, md_value,
-                   &md_value_len, md, NULL) != 1) {
-      TEST_FAIL_MESSAGE("Hashing not successful");
-    }
+  int recovery_id = corpus_recovery_id(test_case);
+  TEST_ASSERT_TRUE(recovery_id == 0 || recovery_id == 1);
 
-    struct key_recovery_result result =
-        p256_key_recovery((const char *)md_value, md_value_len, signature_r_bin,
-                          signature_s_bin, test_vectors[i].signature_v);
+  // v can be passed as recovery id or in the Ethereum notation 27 / 28
+  const int signature_vs[] = {recovery_id, recovery_id + 27};
+  for (int i = 0; i < 2; i++) {
+    struct key_recovery_result result = p256_key_recovery(
+        (const char *)md_value, md_value_len,
+        (const char *)test_case->signature_r,
+        (const char *)test_case->signature_s, signature_vs[i]);
 
     TEST_ASSERT_EQUAL_STRING("", result.error_message);
-    TEST_ASSERT_EQUAL_CHAR_ARRAY(public_key_bin, result.public_key, 64);
-
-    free(data_bin);
-    free(signature_r_bin);
-    free(signature_s_bin);
-    free(public_key_bin);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(test_case->public_key, result.public_key,
+                                 64);
   }
+
+  return 1;
 }
 
-void p256_key_recovery_should_recover_correct_public_keys_from_sha224_hashes(
-    void) {
-  const EVP_MD *md = EVP_sha224();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha224) / sizeof(sign_test_vectors_sha224[0]);
+void p256_key_recovery_should_recover_correct_public_keys(
+    const char *hash_name) {
+  struct key_recovery_test test = {.hash_name = hash_name};
 
-  p256_key_recovery_should_recover_correct_public_keys(
-      md, sign_test_vectors_sha224, test_vectors_len);
+  TEST_ASSERT_EQUAL_INT(
+      SIG_GEN_CASE_COUNT,
+      corpus_load(SIG_GEN_PATH, key_recovery_test_case, &test));
+  TEST_ASSERT_EQUAL_INT(SIG_GEN_SECTION_CASE_COUNT, test.case_count);
+}
 
-  EVP_MD_free((EVP_MD *)md);
+void p256_key_recovery_should_recover_correct_public_keys_from_sha224_hashes(
+    void) {
+  p256_key_recovery_should_recover_correct_public_keys("SHA2-224");
 }
 
 void p256_key_recovery_should_recover_correct_public_keys_from_sha256_hashes(
     void) {
-  const EVP_MD *md = EVP_sha256();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha256) / sizeof(sign_test_vectors_sha256[0]);
-
-  p256_key_recovery_should_recover_correct_public_keys(
-      md, sign_test_vectors_sha256, test_vectors_len);
-
-  EVP_MD_free((EVP_MD *)md);
+  p256_key_recovery_should_recover_correct_public_keys("SHA2-256");
 }
 
 void p256_key_recovery_should_recover_correct_public_keys_from_sha384_hashes(
     void) {
-  const EVP_MD *md = EVP_sha384();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha384) / sizeof(sign_test_vectors_sha384[0]);
-
-  p256_key_recovery_should_recover_correct_public_keys(
-      md, sign_test_vectors_sha384, test_vectors_len);
-
-  EVP_MD_free((EVP_MD *)md);
+  p256_key_recovery_should_recover_correct_public_keys("SHA2-384");
 }
 
 void p256_key_recovery_should_recover_correct_public_keys_from_sha512_hashes(
     void) {
-  const EVP_MD *md = EVP_sha512();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha512) / sizeof(sign_test_vectors_sha512[0]);
-
-  p256_key_recovery_should_recover_correct_public_keys(
-      md, sign_test_vectors_sha512, test_vectors_len);
+  p256_key_recovery_should_recover_correct_public_keys("SHA2-512");
+}
 
-  EVP_MD_free((EVP_MD *)md);
+void p256_key_recovery_should_recover_correct_public_keys_in_low_latency_mode(
+    void) {
+  besu_native_ec_low_latency_set_enabled(1);
+  p256_key_recovery_should_recover_correct_public_keys("SHA2-256");
+  besu_native_ec_low_latency_set_enabled(0);
 }
 
 int main(void) {
+  char error_message[256] = {0};
+
+  // at least two workers, so that the low latency mode splits the
+  // multiplications on any machine
+  worker_pool_init(error_message, 2);
+
   UNITY_BEGIN();
 
   RUN_TEST(
@@ -115,6 +123,8 @@ int main(void) {
       p256_key_recovery_should_recover_correct_public_keys_from_sha384_hashes);
   RUN_TEST(
       p256_key_recovery_should_recover_correct_public_keys_from_sha512_hashes);
+  RUN_TEST(
+      p256_key_recovery_should_recover_correct_public_keys_in_low_latency_mode);
 
   return UNITY_END();
 }
@@ -0,0 +1,288 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "keccak.h"
+
+#define OWNER_COUNT 5
+#define SIGNATURE_LEN 65
+#define MAX_SIGNATURES 8
+
+// key pairs of the owners, sorted by ascending address
+static char private_keys[OWNER_COUNT][32];
+static char public_keys[OWNER_COUNT][64];
+static char addresses[OWNER_COUNT][20];
+// a key that is not an owner
+static char stranger_private_key[32];
+static char stranger_public_key[64];
+
+static const char data_hash[32] = "multisig transaction hash 012345";
+
+static void address_of(char address[20], const char public_key[64]) {
+  unsigned char hash[KECCAK_256_DIGEST_LEN];
+
+  keccak_256((const unsigned char *)public_key, 64, hash);
+  memcpy(address, hash + KECCAK_256_DIGEST_LEN - 20, 20);
+}
+
+static int create_owners(void) {
+  char keys[OWNER_COUNT + 1][32], key_data[OWNER_COUNT + 1][64];
+  char error_message[256] = {0};
+
+  if (p256_generate_keypairs((char *)keys, (char *)key_data, error_message,
+                             OWNER_COUNT + 1) != 1) {
+    return 0;
+  }
+  memcpy(stranger_private_key, keys[OWNER_COUNT], 32);
+  memcpy(stranger_public_key, key_data[OWNER_COUNT], 64);
+
+  for (int i = 0; i < OWNER_COUNT; i++) {
+    memcpy(private_keys[i], keys[i], 32);
+    memcpy(public_keys[i], key_data[i], 64);
+    address_of(addresses[i], public_keys[i]);
+  }
+
+  // insertion sort by address
+  for (int i = 1; i < OWNER_COUNT; i++) {
+    for (int j = i; j > 0 && memcmp(addresses[j - 1], addresses[j], 20) > 0;
+         j--) {
+      char private_key[32], public_key[64], address[20];
+      memcpy(private_key, private_keys[j], 32);
+      memcpy(public_key, public_keys[j], 64);
+      memcpy(address, addresses[j], 20);
+      memcpy(private_keys[j], private_keys[j - 1], 32);
+      memcpy(public_keys[j], public_keys[j - 1], 64);
+      memcpy(addresses[j], addresses[j - 1], 20);
+      memcpy(private_keys[j - 1], private_key, 32);
+      memcpy(public_keys[j - 1], public_key, 64);
+      memcpy(addresses[j - 1], address, 20);
+    }
+  }
+  return 1;
+}
+
+static void sign_into(char signature[SIGNATURE_LEN], const char private_key[],
+                      const char public_key[]) {
+  struct sign_result result =
+      p256_sign(data_hash, 32, private_key, public_key);
+
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  memcpy(signature, result.signature_r, 32);
+  memcpy(signature + 32, result.signature_s, 32);
+  signature[64] = result.signature_v;
+}
+
+// signs with the owners of the indices, -1 is the stranger
+static int create_signatures(char signatures[], const int signers[],
+                             const int signer_count) {
+  for (int i = 0; i < signer_count; i++) {
+    if (signers[i] < 0) {
+      sign_into(signatures + i * SIGNATURE_LEN, stranger_private_key,
+                stranger_public_key);
+    } else {
+      sign_into(signatures + i * SIGNATURE_LEN, private_keys[signers[i]],
+                public_keys[signers[i]]);
+    }
+  }
+  return signer_count * SIGNATURE_LEN;
+}
+
+void p256_verify_multisig_should_meet_threshold_of_ascending_signers(void) {
+  char signatures[MAX_SIGNATURES * SIGNATURE_LEN];
+  const int signers[] = {0, 2, 3, 4};
+  int signatures_len = create_signatures(signatures, signers, 4);
+  const int flags[] = {MULTISIG_ASCENDING_SIGNERS,
+                       MULTISIG_ASCENDING_SIGNERS | MULTISIG_PARALLEL};
+
+  for (int i = 0; i < 2; i++) {
+    struct multisig_result result = p256_verify_multisig(
+        data_hash, 32, signatures, signatures_len, (const char *)addresses,
+        20, OWNER_COUNT, 3, flags[i]);
+
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_INT(1, result.verified);
+    TEST_ASSERT_EQUAL_INT(3, result.signer_count);
+    // the last signature is not needed anymore
+    TEST_ASSERT_EQUAL_INT(3, result.recovered_count);
+  }
+}
+
+void p256_verify_multisig_should_enforce_order_and_uniqueness(void) {
+  char signatures[MAX_SIGNATURES * SIGNATURE_LEN];
+  const int descending[] = {3, 1, 4};
+  const int duplicates[] = {1, 1, 2};
+  int signatures_len = create_signatures(signatures, descending, 3);
+
+  struct multisig_result result = p256_verify_multisig(
+      data_hash, 32, signatures, signatures_len, (const char *)addresses, 20,
+      OWNER_COUNT, 2, MULTISIG_ASCENDING_SIGNERS);
+
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING("Signer of signature 1 is not in ascending order\n",
+                           result.error_message);
+
+  // without the rule the order doesn't matter
+  result =
+      p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                           (const char *)addresses, 20, OWNER_COUNT, 2, 0);
+  TEST_ASSERT_EQUAL_INT(1, result.verified);
+
+  signatures_len = create_signatures(signatures, duplicates, 3);
+  result = p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                                (const char *)addresses, 20, OWNER_COUNT, 2,
+                                MULTISIG_ASCENDING_SIGNERS);
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+
+  // a duplicate is only counted once
+  result = p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                                (const char *)addresses, 20, OWNER_COUNT, 3,
+                                MULTISIG_PARALLEL);
+  TEST_ASSERT_EQUAL_INT(0, result.verified);
+  TEST_ASSERT_EQUAL_INT(2, result.signer_count);
+}
+
+void p256_verify_multisig_should_stop_when_threshold_cannot_be_met(void) {
+  char signatures[MAX_SIGNATURES * SIGNATURE_LEN];
+  const int signers[] = {-1, 0, -1, 1, 2};
+  int signatures_len = create_signatures(signatures, signers, 5);
+  const int flags[] = {0, MULTISIG_PARALLEL};
+
+  // the modified signature recovers another key or none at all
+  signatures[SIGNATURE_LEN + 5] ^= 1;
+
+  for (int i = 0; i < 2; i++) {
+    struct multisig_result result = p256_verify_multisig(
+        data_hash, 32, signatures, signatures_len, (const char *)addresses,
+        20, OWNER_COUNT, 3, flags[i]);
+
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_INT(0, result.verified);
+    TEST_ASSERT_EQUAL_INT(0, result.signer_count);
+    // after 3 foreign signatures, 2 are left for a threshold of 3
+    TEST_ASSERT_EQUAL_INT(3, result.recovered_count);
+  }
+}
+
+void p256_verify_multisig_should_accept_public_keys_as_owners(void) {
+  char signatures[MAX_SIGNATURES * SIGNATURE_LEN];
+  const int signers[] = {4, 1};
+  int signatures_len = create_signatures(signatures, signers, 2);
+
+  struct multisig_result result = p256_verify_multisig(
+      data_hash, 32, signatures, signatures_len, (const char *)public_keys,
+      64, OWNER_COUNT, 2, MULTISIG_PARALLEL);
+
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_INT(1, result.verified);
+  TEST_ASSERT_EQUAL_INT(2, result.signer_count);
+}
+
+void p256_verify_multisig_should_not_count_signatures_out_of_range(void) {
+  char signatures[MAX_SIGNATURES * SIGNATURE_LEN];
+  const int signers[] = {0};
+  // n of P-256
+  const char order[32] = {
+      0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17,
+      0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+  const char zero[32] = {0};
+  const char *invalid_s[] = {zero, order};
+  int signatures_len = create_signatures(signatures, signers, 1);
+
+  for (int i = 0; i < 2; i++) {
+    memcpy(signatures + 32, invalid_s[i], 32);
+    // the only owner is the key that the invalid signature recovers to
+    struct key_recovery_result key = p256_key_recovery(
+        data_hash, 32, signatures, signatures + 32, signatures[64]);
+    if (strlen(key.error_message) != 0) {
+      continue;
+    }
+
+    struct multisig_result result =
+        p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                             key.public_key, 64, 1, 1, 0);
+
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_INT(0, result.verified);
+    TEST_ASSERT_EQUAL_INT(0, result.signer_count);
+    TEST_ASSERT_EQUAL_INT(1, result.recovered_count);
+  }
+}
+
+void p256_verify_multisig_should_reject_invalid_input(void) {
+  char signatures[MAX_SIGNATURES * SIGNATURE_LEN];
+  const int signers[] = {0, 1};
+  int signatures_len = create_signatures(signatures, signers, 2);
+
+  struct multisig_result result =
+      p256_verify_multisig(data_hash, 32, signatures, signatures_len - 1,
+                           (const char *)addresses, 20, OWNER_COUNT, 2, 0);
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING(
+      "Length of the signatures must be a multiple of 65\n",
+      result.error_message);
+
+  result = p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                                (const char *)addresses, 32, OWNER_COUNT, 2,
+                                0);
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING(
+      "Owners must be addresses of 20 bytes or public keys of 64 bytes\n",
+      result.error_message);
+
+  result = p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                                (const char *)addresses, 20, OWNER_COUNT,
+                                OWNER_COUNT + 1, 0);
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING(
+      "Threshold must be between 1 and the number of owners\n",
+      result.error_message);
+
+  // fewer signatures than the threshold can't meet it
+  result =
+      p256_verify_multisig(data_hash, 32, signatures, signatures_len,
+                           (const char *)addresses, 20, OWNER_COUNT, 3, 0);
+  TEST_ASSERT_EQUAL_INT(0, result.verified);
+  TEST_ASSERT_EQUAL_INT(0, result.recovered_count);
+}
+
+int main(void) {
+  if (!create_owners()) {
+    puts("FAIL: could not generate the keys of the owners");
+    return 1;
+  }
+
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_verify_multisig_should_meet_threshold_of_ascending_signers);
+  RUN_TEST(p256_verify_multisig_should_enforce_order_and_uniqueness);
+  RUN_TEST(p256_verify_multisig_should_stop_when_threshold_cannot_be_met);
+  RUN_TEST(p256_verify_multisig_should_accept_public_keys_as_owners);
+  RUN_TEST(p256_verify_multisig_should_not_count_signatures_out_of_range);
+  RUN_TEST(p256_verify_multisig_should_reject_invalid_input);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
@@ -0,0 +1,297 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "keccak.h"
+#include "utils.h"
+
+// key of SigGen.txt from the CAVP test vectors
+static const char *private_key =
+    "519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464";
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+// n of P-256
+static const unsigned char order[32] = {
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17,
+    0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+
+// p of P-256
+static const unsigned char field[32] = {
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+static unsigned char input[128];
+static unsigned char expected_output[32];
+// hash || r || s || x || y of the same signature
+static unsigned char verify_input[160];
+
+// hash || v || r || s of a signature of the key
+static int create_input(void) {
+  unsigned char *private_key_data = hex_to_bin(private_key);
+  unsigned char *public_key_data = hex_to_bin(public_key);
+  unsigned char public_key_hash[32];
+
+  memset(input, 0, sizeof(input));
+  for (int i = 0; i < 32; i++) {
+    input[i] = (unsigned char)(i + 1);
+  }
+  struct sign_result signature =
+      p256_sign((const char *)input, 32, (const char *)private_key_data,
+                (const char *)public_key_data);
+  if (strlen(signature.error_message) != 0) {
+    return 0;
+  }
+  input[63] = 27 + signature.signature_v;
+  memcpy(input + 64, signature.signature_r, 32);
+  memcpy(input + 96, signature.signature_s, 32);
+
+  memcpy(verify_input, input, 32);
+  memcpy(verify_input + 32, input + 64, 64);
+  memcpy(verify_input + 96, public_key_data, 64);
+
+  keccak_256(public_key_data, 64, public_key_hash);
+  memset(expected_output, 0, 12);
+  memcpy(expected_output + 12, public_key_hash + 12, 20);
+
+  free(private_key_data);
+  free(public_key_data);
+  return 1;
+}
+
+static int ecrecover(unsigned char output[32], const unsigned char data[],
+                     int data_len) {
+  memset(output, 0xee, 32);
+  return p256_ecrecover((char *)output, (const char *)data, data_len);
+}
+
+void p256_ecrecover_should_return_padded_address(void) {
+  unsigned char output[32];
+
+  TEST_ASSERT_EQUAL_INT(32, ecrecover(output, input, sizeof(input)));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_output, output, 32);
+}
+
+void p256_ecrecover_should_ignore_bytes_after_input(void) {
+  unsigned char longer_input[160];
+  unsigned char output[32];
+
+  memcpy(longer_input, input, sizeof(input));
+  memset(longer_input + sizeof(input), 0xff, 32);
+
+  TEST_ASSERT_EQUAL_INT(32,
+                        ecrecover(output, longer_input, sizeof(longer_input)));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_output, output, 32);
+}
+
+void p256_ecrecover_should_accept_high_s(void) {
+  unsigned char high_s_input[128];
+  unsigned char output[32];
+  int borrow = 0;
+
+  // n - s recovers the same key with the other v
+  memcpy(high_s_input, input, sizeof(input));
+  for (int i = 31; i >= 0; i--) {
+    int difference = order[i] - input[96 + i] - borrow;
+    borrow = difference < 0;
+    high_s_input[96 + i] = (unsigned char)(difference + (borrow ? 256 : 0));
+  }
+  high_s_input[63] = input[63] == 27 ? 28 : 27;
+
+  TEST_ASSERT_EQUAL_INT(32, ecrecover(output, high_s_input, 128));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_output, output, 32);
+}
+
+void p256_ecrecover_should_reject_invalid_v(void) {
+  unsigned char invalid_input[128];
+  unsigned char output[32];
+  const unsigned char invalid_v[] = {0, 1, 26, 29, 255};
+
+  memcpy(invalid_input, input, sizeof(input));
+  for (size_t i = 0; i < sizeof(invalid_v); i++) {
+    invalid_input[63] = invalid_v[i];
+    TEST_ASSERT_EQUAL_INT(0, ecrecover(output, invalid_input, 128));
+  }
+
+  // v is a 32 byte word
+  memcpy(invalid_input, input, sizeof(input));
+  invalid_input[32] = 1;
+  TEST_ASSERT_EQUAL_INT(0, ecrecover(output, invalid_input, 128));
+  invalid_input[32] = 0;
+  invalid_input[62] = 1;
+  TEST_ASSERT_EQUAL_INT(0, ecrecover(output, invalid_input, 128));
+}
+
+void p256_ecrecover_should_reject_r_and_s_out_of_range(void) {
+  unsigned char invalid_input[128];
+  unsigned char output[32];
+
+  for (int offset = 64; offset <= 96; offset += 32) {
+    memcpy(invalid_input, input, sizeof(input));
+    memset(invalid_input + offset, 0, 32);
+    TEST_ASSERT_EQUAL_INT(0, ecrecover(output, invalid_input, 128));
+
+    memcpy(invalid_input + offset, order, 32);
+    TEST_ASSERT_EQUAL_INT(0, ecrecover(output, invalid_input, 128));
+
+    memset(invalid_input + offset, 0xff, 32);
+    TEST_ASSERT_EQUAL_INT(0, ecrecover(output, invalid_input, 128));
+  }
+}
+
+void p256_ecrecover_should_pad_short_input_with_zeros(void) {
+  unsigned char output[32];
+
+  // r and s are missing and therefore 0
+  TEST_ASSERT_EQUAL_INT(0, ecrecover(output, input, 64));
+  TEST_ASSERT_EQUAL_INT(0, ecrecover(output, input, 0));
+  TEST_ASSERT_EQUAL_INT(0, ecrecover(output, NULL, 0));
+}
+
+static int verify_precompile(unsigned char output[32],
+                             const unsigned char data[], int data_len) {
+  memset(output, 0xee, 32);
+  return p256_verify_precompile((char *)output, (const char *)data, data_len);
+}
+
+static void assert_not_verified(const unsigned char data[], int data_len) {
+  unsigned char output[32];
+  unsigned char untouched[32];
+
+  memset(untouched, 0xee, sizeof(untouched));
+  TEST_ASSERT_EQUAL_INT(0, verify_precompile(output, data, data_len));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(untouched, output, 32);
+}
+
+void p256_verify_precompile_should_return_one_for_valid_signature(void) {
+  unsigned char output[32];
+  unsigned char expected[32] = {0};
+  expected[31] = 1;
+
+  TEST_ASSERT_EQUAL_INT(32, verify_precompile(output, verify_input, 160));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, output, 32);
+}
+
+void p256_verify_precompile_should_accept_high_s(void) {
+  unsigned char high_s_input[160];
+  unsigned char output[32];
+  int borrow = 0;
+
+  memcpy(high_s_input, verify_input, sizeof(verify_input));
+  for (int i = 31; i >= 0; i--) {
+    int difference = order[i] - verify_input[64 + i] - borrow;
+    borrow = difference < 0;
+    high_s_input[64 + i] = (unsigned char)(difference + (borrow ? 256 : 0));
+  }
+
+  TEST_ASSERT_EQUAL_INT(32, verify_precompile(output, high_s_input, 160));
+  TEST_ASSERT_EQUAL_UINT8(1, output[31]);
+}
+
+void p256_verify_precompile_should_require_exact_input_length(void) {
+  unsigned char longer_input[161];
+
+  memcpy(longer_input, verify_input, sizeof(verify_input));
+  longer_input[160] = 0;
+
+  assert_not_verified(longer_input, 161);
+  assert_not_verified(verify_input, 159);
+  assert_not_verified(verify_input, 0);
+  assert_not_verified(NULL, 0);
+}
+
+void p256_verify_precompile_should_reject_r_and_s_out_of_range(void) {
+  unsigned char invalid_input[160];
+
+  for (int offset = 32; offset <= 64; offset += 32) {
+    memcpy(invalid_input, verify_input, sizeof(verify_input));
+    memset(invalid_input + offset, 0, 32);
+    assert_not_verified(invalid_input, 160);
+
+    memcpy(invalid_input + offset, order, 32);
+    assert_not_verified(invalid_input, 160);
+
+    memset(invalid_input + offset, 0xff, 32);
+    assert_not_verified(invalid_input, 160);
+  }
+}
+
+void p256_verify_precompile_should_reject_invalid_public_key(void) {
+  unsigned char invalid_input[160];
+
+  // not on the curve
+  memcpy(invalid_input, verify_input, sizeof(verify_input));
+  invalid_input[159] ^= 1;
+  assert_not_verified(invalid_input, 160);
+
+  // the point at infinity
+  memset(invalid_input + 96, 0, 64);
+  assert_not_verified(invalid_input, 160);
+
+  // coordinates not less than p
+  for (int offset = 96; offset <= 128; offset += 32) {
+    memcpy(invalid_input, verify_input, sizeof(verify_input));
+    memcpy(invalid_input + offset, field, 32);
+    assert_not_verified(invalid_input, 160);
+  }
+}
+
+void p256_verify_precompile_should_reject_signature_of_other_hash(void) {
+  unsigned char invalid_input[160];
+
+  memcpy(invalid_input, verify_input, sizeof(verify_input));
+  invalid_input[0] ^= 1;
+  assert_not_verified(invalid_input, 160);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  if (!create_input()) {
+    // reported like a failed test, so that check_failing_test.sh finds it
+    puts("FAIL: could not sign the input");
+    return 1;
+  }
+
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_ecrecover_should_return_padded_address);
+  RUN_TEST(p256_ecrecover_should_ignore_bytes_after_input);
+  RUN_TEST(p256_ecrecover_should_accept_high_s);
+  RUN_TEST(p256_ecrecover_should_reject_invalid_v);
+  RUN_TEST(p256_ecrecover_should_reject_r_and_s_out_of_range);
+  RUN_TEST(p256_ecrecover_should_pad_short_input_with_zeros);
+  RUN_TEST(p256_verify_precompile_should_return_one_for_valid_signature);
+  RUN_TEST(p256_verify_precompile_should_accept_high_s);
+  RUN_TEST(p256_verify_precompile_should_require_exact_input_length);
+  RUN_TEST(p256_verify_precompile_should_reject_r_and_s_out_of_range);
+  RUN_TEST(p256_verify_precompile_should_reject_invalid_public_key);
+  RUN_TEST(p256_verify_precompile_should_reject_signature_of_other_hash);
+
+  return UNITY_END();
+}
@@ -21,95 +21,94 @@
 #include "unity.h"
 
 #include "besu_native_ec.h"
-#include "ec_sign_test_vectors.h"
-#include "utils.h"
-
-void p256_sign_should_create_valid_signatures(
-    const EVP_MD *md, struct sign_test_vector test_vectors[],
-    int test_vectors_len) {
+#include "corpus.h"
+
+//  This test vectors are copied from
+// https://csrc.nist.gov/groups/STM/cavp/documents/dss/186-3ecdsatestvectors.zip
+//
+// The following sets have been copied from SigGen.txt:
+// [P-256,SHA-224], [P-256,SHA-256], [P-256,SHA-384], [P-256,SHA-512]
+//
+// SigGen.txt contain also the values k, R and S. k is the random value that is
+// generated when a new signature is created, R and S are the expected signature
+// parts. P-256 is a non-deterministic algorithm, in order to use these parts of
+// the test vectors, k would need to be returned by the RNG (random number
+// generator). In the current implementation of this library it is not possible
+// to mock this behavior. Therefore the signatures in the tests are created
+// non-deterministically and are verified by calling p256_verify instead of
+// comparing them to R and S from the test vectors.
+#define SIG_GEN_PATH "test/vectors/SigGen.rsp"
+#define SIG_GEN_CASE_COUNT 60
+#define SIG_GEN_SECTION_CASE_COUNT 15
+
+struct sign_test {
+  const char *hash_name;
+  int case_count;
+};
+
+static int sign_test_case(const struct corpus_case *test_case, void *context) {
+  struct sign_test *test = context;
   unsigned char md_value[EVP_MAX_MD_SIZE];
   unsigned int md_value_len = 0;
 
-  for (int i = 0; i < test_vectors_len; i++) {
-    unsigned char *data_bin = hex_to_bin(test_vectors[i].data);
-    unsigned char *private_key_bin = hex_to_bin(test_vectors[i].private_key);
-    unsigned char *public_key_bin = hex_to_bin(test_vectors[i].public_key);
+  if (!EVP_MD_is_a(test_case->md, test->hash_name)) {
+    return 1;
+  }
+  test->case_count++;
 
-    if (EVP_Digest(data_bin, strlen(test_vectors[i].data) / 2, md_value,
-                   &md_value_len, md, NULL) != 1) {
-      TEST_FAIL_MESSAGE("Hashing not successful");
-    }
+  if (EVP_Digest(test_case->message, test_case->message_len, md_value,
+                 &md_value_len, test_case->md, NULL) != 1) {
+    TEST_FAIL_MESSAGE("Hashing not successful");
+  }
 
-    struct sign_result result_sign =
-        p256_sign((const char *)md_value, md_value_len,
-                  (const char *)private_key_bin, (const char *)public_key_bin);
+  struct sign_result result_sign =
+      p256_sign((const char *)md_value, md_value_len,
+                (const char *)test_case->private_key,
+                (const char *)test_case->public_key);
 
-    TEST_ASSERT_EQUAL_STRING("", result_sign.error_message);
+  TEST_ASSERT_EQUAL_STRING("", result_sign.error_message);
 
-    struct verify_result result_verify = p256_verify(
-        (const char *)md_value, md_value_len, result_sign.signature_r,
-        result_sign.signature_s, (const char *)public_key_bin);
+  struct verify_result result_verify = p256_verify(
+      (const char *)md_value, md_value_len, result_sign.signature_r,
+      result_sign.signature_s, (const char *)test_case->public_key);
 
-    TEST_ASSERT_EQUAL_STRING("", result_verify.error_message);
-    TEST_ASSERT_EQUAL_INT_MESSAGE(1, result_verify.verified,
-                                  "Signature verification not successful");
+  TEST_ASSERT_EQUAL_STRING("", result_verify.error_message);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(1, result_verify.verified,
+                                "Signature verification not successful");
 
-    struct key_recovery_result result_key_recovery = p256_key_recovery(
-        (const char *)md_value, md_value_len, result_sign.signature_r,
-        result_sign.signature_s, result_sign.signature_v);
+  struct key_recovery_result result_key_recovery = p256_key_recovery(
+      (const char *)md_value, md_value_len, result_sign.signature_r,
+      result_sign.signature_s, result_sign.signature_v);
 
-    TEST_ASSERT_EQUAL_STRING("", result_key_recovery.error_message);
-    TEST_ASSERT_EQUAL_CHAR_ARRAY(public_key_bin, result_key_recovery.public_key,
-                                 64);
+  TEST_ASSERT_EQUAL_STRING("", result_key_recovery.error_message);
+  TEST_ASSERT_EQUAL_CHAR_ARRAY(test_case->public_key,
+                               result_key_recovery.public_key, 64);
 
-    free(data_bin);
-    free(private_key_bin);
-    free(public_key_bin);
-  }
+  return 1;
 }
 
-void p256_sign_should_create_valid_signatures_from_sha224_hashes(void) {
-  const EVP_MD *md = EVP_sha224();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha224) / sizeof(sign_test_vectors_sha224[0]);
+void p256_sign_should_create_valid_signatures(const char *hash_name) {
+  struct sign_test test = {.hash_name = hash_name};
 
-  p256_sign_should_create_valid_signatures(md, sign_test_vectors_sha224,
-                                           test_vectors_len);
+  TEST_ASSERT_EQUAL_INT(SIG_GEN_CASE_COUNT,
+                        corpus_load(SIG_GEN_PATH, sign_test_case, &test));
+  TEST_ASSERT_EQUAL_INT(SIG_GEN_SECTION_CASE_COUNT, test.case_count);
+}
 
-  EVP_MD_free((EVP_MD *)md);
+void p256_sign_should_create_valid_signatures_from_sha224_hashes(void) {
+  p256_sign_should_create_valid_signatures("SHA2-224");
 }
 
 void p256_sign_should_create_valid_signatures_from_sha256_hashes(void) {
-  const EVP_MD *md = EVP_sha256();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha256) / sizeof(sign_test_vectors_sha256[0]);
-
-  p256_sign_should_create_valid_signatures(md, sign_test_vectors_sha256,
-                                           test_vectors_len);
-
-  EVP_MD_free((EVP_MD *)md);
+  p256_sign_should_create_valid_signatures("SHA2-256");
 }
 
 void p256_sign_should_create_valid_signatures_from_sha384_hashes(void) {
-  const EVP_MD *md = EVP_sha384();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha384) / sizeof(sign_test_vectors_sha384[0]);
-
-  p256_sign_should_create_valid_signatures(md, sign_test_vectors_sha384,
-                                           test_vectors_len);
-
-  EVP_MD_free((EVP_MD *)md);
+  p256_sign_should_create_valid_signatures("SHA2-384");
 }
 
 void p256_sign_should_create_valid_signatures_from_sha512_hashes(void) {
-  const EVP_MD *md = EVP_sha512();
-  int test_vectors_len =
-      sizeof(sign_test_vectors_sha512) / sizeof(sign_test_vectors_sha512[0]);
-
-  p256_sign_should_create_valid_signatures(md, sign_test_vectors_sha512,
-                                           test_vectors_len);
-
-  EVP_MD_free((EVP_MD *)md);
+  p256_sign_should_create_valid_signatures("SHA2-512");
 }
 
 int main(void) {
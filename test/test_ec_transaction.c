@@ -0,0 +1,356 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "keccak.h"
+#include "utils.h"
+
+#define TRANSACTION_COUNT 4
+
+// Transactions signed with the P-256 key
+// 519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464 of
+// SigGen.txt from the CAVP test vectors
+static const char *sender_address = "72c638b56de00804f9a14968bdab276959a98462";
+static const char *private_key =
+    "519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464";
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+#define CLAIM_COUNT 8
+
+static const char *transactions[TRANSACTION_COUNT] = {
+    // legacy transaction without chain id, v = 27
+    "f86c098504a817c800825208943535353535353535353535353535353535353535880de0"
+    "b6b3a7640000801ba0088bb9ff22ab291a74c86fc677ba897baadee370cc6129b82d170b"
+    "a3fc26415ca05adca5560862b7ff356cbbed30d479d19e1041d4f36fa8420549d797446d"
+    "c35e",
+    // legacy transaction with chain id 1337 (EIP-155)
+    "f8700a8504a817c800825208943535353535353535353535353535353535353535880de0"
+    "b6b3a7640000820102820a95a010a490523955cbc2c2d3452458fcdf97c4733469f18790"
+    "5f5cb67347f4244eb8a03c82700ee569e77803bb5e078dc1a2e9ad07cfd0fc8808779120"
+    "33a41a541408",
+    // EIP-2930 transaction with an access list
+    "01f8a38205390b8504a817c80082c3509435353535353535353535353535353535353535"
+    "358082deadf838f7943535353535353535353535353535353535353535e1a00000000000"
+    "00000000000000000000000000000000000000000000000000000701a0ecf269583287f9"
+    "c20ced5bb358f0005f2946e89ca7d0115cf4867eabec4e3185a073610aef79d5c166e9fd"
+    "392f15c953bd1d7f4bc8ab2d493c2b968ea33b3e9579",
+    // EIP-1559 transaction with 100 bytes of data
+    "02f8d38205390c84773594008506fc23ac00830186a09435353535353535353535353535"
+    "3535353535353505b864000102030405060708090a0b0c0d0e0f10111213141516171819"
+    "1a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d"
+    "3e3f404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f6061"
+    "6263c001a033d841dd01c2e0aae7faf8352498257e943e55dcd111a10e321d1392270f98"
+    "2aa03f3365baa3fa3f2847ad039f7f133c4121359c6d43cb55c8137814f54fc4d216",
+};
+
+static struct transaction_sender_result recover_hex(const char *hex) {
+  unsigned char *transaction = hex_to_bin(hex);
+  struct transaction_sender_result result = p256_recover_transaction_sender(
+      (const char *)transaction, strlen(hex) / 2);
+  free(transaction);
+  return result;
+}
+
+void p256_recover_transaction_sender_should_recover_sender_of_all_types(
+    void) {
+  unsigned char *address = hex_to_bin(sender_address);
+
+  for (int i = 0; i < TRANSACTION_COUNT; i++) {
+    struct transaction_sender_result result = recover_hex(transactions[i]);
+
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(address, result.address, 20);
+  }
+
+  free(address);
+}
+
+void p256_recover_transaction_sender_should_detect_modified_transactions(
+    void) {
+  unsigned char *address = hex_to_bin(sender_address);
+  char modified[512];
+  // the nonce of the EIP-1559 transaction is changed from 12 to 13
+  strcpy(modified, transactions[3]);
+  memcpy(modified + 12, "0d", 2);
+
+  struct transaction_sender_result result = recover_hex(modified);
+
+  if (strlen(result.error_message) == 0) {
+    TEST_ASSERT_TRUE(memcmp(address, result.address, 20) != 0);
+  }
+
+  free(address);
+}
+
+void p256_recover_transaction_sender_should_reject_invalid_transactions(void) {
+  char transaction[512];
+
+  TEST_ASSERT_EQUAL_STRING("Transaction is empty\n",
+                           recover_hex("").error_message);
+  TEST_ASSERT_EQUAL_STRING("Transaction type 3 is not supported\n",
+                           recover_hex("03c0").error_message);
+
+  // truncated and with trailing data
+  strcpy(transaction, transactions[0]);
+  transaction[strlen(transaction) - 2] = '\0';
+  TEST_ASSERT_EQUAL_STRING("Transaction is not a valid RLP list\n",
+                           recover_hex(transaction).error_message);
+  strcpy(transaction, transactions[0]);
+  strcat(transaction, "00");
+  TEST_ASSERT_EQUAL_STRING("Transaction is not a valid RLP list\n",
+                           recover_hex(transaction).error_message);
+
+  // an EIP-2930 envelope around a legacy transaction has too few fields
+  strcpy(transaction, "01");
+  strcat(transaction, transactions[0]);
+  TEST_ASSERT_EQUAL_STRING("Transaction has 9 fields, but 11 are expected\n",
+                           recover_hex(transaction).error_message);
+
+  // v = 29 of a legacy transaction
+  strcpy(transaction, transactions[0]);
+  memcpy(transaction + 86, "1d", 2);
+  TEST_ASSERT_EQUAL_STRING(
+      "v of legacy transaction must be 27, 28 or at least 35\n",
+      recover_hex(transaction).error_message);
+}
+
+void p256_recover_transaction_sender_should_reject_s_out_of_range(void) {
+  char transaction[512];
+
+  // s = 0 as an empty string, the list is 32 bytes shorter
+  strcpy(transaction, transactions[0]);
+  memcpy(transaction + 2, "4c", 2);
+  strcpy(transaction + 154, "80");
+  TEST_ASSERT_EQUAL_STRING("Signature r and s must be between 1 and n - 1\n",
+                           recover_hex(transaction).error_message);
+
+  // s = n
+  strcpy(transaction, transactions[0]);
+  strcpy(transaction + 156, "ffffffff00000000ffffffffffffffff"
+                            "bce6faada7179e84f3b9cac2fc632551");
+  TEST_ASSERT_EQUAL_STRING("Signature r and s must be between 1 and n - 1\n",
+                           recover_hex(transaction).error_message);
+
+  // r = n
+  strcpy(transaction, transactions[0]);
+  memcpy(transaction + 90,
+         "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551",
+         64);
+  TEST_ASSERT_EQUAL_STRING("Signature r and s must be between 1 and n - 1\n",
+                           recover_hex(transaction).error_message);
+}
+
+void p256_recover_transaction_sender_should_reject_high_s(void) {
+  char transaction[512];
+
+  // n - s with the other v recovers the same key, but is invalid since EIP-2
+  strcpy(transaction, transactions[0]);
+  memcpy(transaction + 86, "1c", 2);
+  strcpy(transaction + 156, "a5235aa8f79d4801ca934412cf2b862e"
+                            "1ed6b8d8b3a7f642ee6ff32bb7f561f3");
+  TEST_ASSERT_EQUAL_STRING("Signature s must not be greater than n / 2\n",
+                           recover_hex(transaction).error_message);
+}
+
+void p256_recover_transaction_senders_should_recover_all_senders(void) {
+  unsigned char *address = hex_to_bin(sender_address);
+  char transactions_data[1024];
+  int offsets[TRANSACTION_COUNT + 2] = {0};
+  struct transaction_sender_result results[TRANSACTION_COUNT + 1];
+
+  for (int i = 0; i < TRANSACTION_COUNT; i++) {
+    unsigned char *transaction = hex_to_bin(transactions[i]);
+    int len = strlen(transactions[i]) / 2;
+    memcpy(transactions_data + offsets[i], transaction, len);
+    offsets[i + 1] = offsets[i] + len;
+    free(transaction);
+  }
+  // the last transaction is empty
+  offsets[TRANSACTION_COUNT + 1] = offsets[TRANSACTION_COUNT];
+
+  TEST_ASSERT_EQUAL_INT(
+      TRANSACTION_COUNT,
+      p256_recover_transaction_senders(results, transactions_data, offsets,
+                                       TRANSACTION_COUNT + 1));
+
+  for (int i = 0; i < TRANSACTION_COUNT; i++) {
+    TEST_ASSERT_EQUAL_STRING("", results[i].error_message);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(address, results[i].address, 20);
+  }
+  TEST_ASSERT_EQUAL_STRING("Transaction is empty\n",
+                           results[TRANSACTION_COUNT].error_message);
+
+  free(address);
+}
+
+static struct sign_result sign_hash(const char data_hash[32]) {
+  unsigned char *private_key_data = hex_to_bin(private_key);
+  unsigned char *public_key_data = hex_to_bin(public_key);
+
+  struct sign_result signature =
+      p256_sign(data_hash, 32, (const char *)private_key_data,
+                (const char *)public_key_data);
+  TEST_ASSERT_EQUAL_STRING("", signature.error_message);
+
+  free(private_key_data);
+  free(public_key_data);
+  return signature;
+}
+
+void p256_verify_sender_address_should_match_address_of_signer(void) {
+  unsigned char *address = hex_to_bin(sender_address);
+  char data_hash[32] = {1, 2, 3};
+  struct sign_result signature = sign_hash(data_hash);
+
+  TEST_ASSERT_EQUAL_INT(
+      1, p256_verify_sender_address(data_hash, 32, signature.signature_r,
+                                    signature.signature_s,
+                                    signature.signature_v, (char *)address));
+  TEST_ASSERT_EQUAL_INT(1, p256_verify_sender_address(
+                               data_hash, 32, signature.signature_r,
+                               signature.signature_s,
+                               27 + signature.signature_v, (char *)address));
+
+  // another address, another hash and an invalid v
+  address[19] ^= 1;
+  TEST_ASSERT_EQUAL_INT(
+      0, p256_verify_sender_address(data_hash, 32, signature.signature_r,
+                                    signature.signature_s,
+                                    signature.signature_v, (char *)address));
+  address[19] ^= 1;
+  data_hash[0] ^= 1;
+  TEST_ASSERT_EQUAL_INT(
+      0, p256_verify_sender_address(data_hash, 32, signature.signature_r,
+                                    signature.signature_s,
+                                    signature.signature_v, (char *)address));
+  data_hash[0] ^= 1;
+  TEST_ASSERT_EQUAL_INT(
+      0, p256_verify_sender_address(data_hash, 32, signature.signature_r,
+                                    signature.signature_s, 2,
+                                    (char *)address));
+
+  free(address);
+}
+
+// the address that key_recovery returns for the signature, which may be out
+// of range
+static int recovered_address(unsigned char address[20],
+                             const char data_hash[32], const char r[32],
+                             const char s[32], const int v) {
+  unsigned char public_key_hash[32];
+  struct key_recovery_result key = p256_key_recovery(data_hash, 32, r, s, v);
+
+  if (strlen(key.error_message) != 0) {
+    return 0;
+  }
+  keccak_256((const unsigned char *)key.public_key, 64, public_key_hash);
+  memcpy(address, public_key_hash + 12, 20);
+  return 1;
+}
+
+void p256_verify_sender_address_should_reject_r_and_s_out_of_range(void) {
+  char data_hash[32] = {1, 2, 3};
+  char zero[32] = {0};
+  char order[32] = {
+      0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17,
+      0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+  unsigned char address[20];
+  struct sign_result signature = sign_hash(data_hash);
+  // n + 1 is 1 modulo n
+  char order_plus_one[32];
+  memcpy(order_plus_one, order, 32);
+  order_plus_one[31]++;
+
+  const char *out_of_range[][2] = {{signature.signature_r, zero},
+                                   {signature.signature_r, order},
+                                   {signature.signature_r, order_plus_one},
+                                   {order_plus_one, signature.signature_s}};
+  for (size_t i = 0; i < sizeof(out_of_range) / sizeof(out_of_range[0]);
+       i++) {
+    for (int v = 0; v < 2; v++) {
+      // claims the address that the invalid signature recovers to
+      if (!recovered_address(address, data_hash, out_of_range[i][0],
+                             out_of_range[i][1], v)) {
+        continue;
+      }
+      TEST_ASSERT_EQUAL_INT(0, p256_verify_sender_address(
+                                   data_hash, 32, out_of_range[i][0],
+                                   out_of_range[i][1], v, (char *)address));
+    }
+  }
+}
+
+void p256_verify_sender_addresses_should_check_all_claims(void) {
+  unsigned char *address = hex_to_bin(sender_address);
+  char data_hashes[CLAIM_COUNT * 32] = {0};
+  char signatures[CLAIM_COUNT * 65];
+  char addresses[CLAIM_COUNT * 20];
+  char results[CLAIM_COUNT];
+
+  for (int i = 0; i < CLAIM_COUNT; i++) {
+    data_hashes[i * 32] = (char)i;
+    struct sign_result signature = sign_hash(&data_hashes[i * 32]);
+    memcpy(&signatures[i * 65], signature.signature_r, 32);
+    memcpy(&signatures[i * 65 + 32], signature.signature_s, 32);
+    signatures[i * 65 + 64] = signature.signature_v;
+    memcpy(&addresses[i * 20], address, 20);
+  }
+  // claims of another sender
+  addresses[2 * 20] ^= 1;
+  addresses[5 * 20 + 19] ^= 1;
+  // s = 0
+  memset(&signatures[6 * 65 + 32], 0, 32);
+
+  TEST_ASSERT_EQUAL_INT(CLAIM_COUNT - 3,
+                        p256_verify_sender_addresses(results, data_hashes,
+                                                     signatures, addresses,
+                                                     CLAIM_COUNT));
+  for (int i = 0; i < CLAIM_COUNT; i++) {
+    TEST_ASSERT_EQUAL_INT(i == 2 || i == 5 || i == 6 ? 0 : 1, results[i]);
+  }
+
+  free(address);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_recover_transaction_sender_should_recover_sender_of_all_types);
+  RUN_TEST(
+      p256_recover_transaction_sender_should_detect_modified_transactions);
+  RUN_TEST(p256_recover_transaction_sender_should_reject_invalid_transactions);
+  RUN_TEST(p256_recover_transaction_sender_should_reject_s_out_of_range);
+  RUN_TEST(p256_recover_transaction_sender_should_reject_high_s);
+  RUN_TEST(p256_recover_transaction_senders_should_recover_all_senders);
+  RUN_TEST(p256_verify_sender_address_should_match_address_of_signer);
+  RUN_TEST(p256_verify_sender_address_should_reject_r_and_s_out_of_range);
+  RUN_TEST(p256_verify_sender_addresses_should_check_all_claims);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
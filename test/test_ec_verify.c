@@ -18,83 +18,86 @@
 #include <string.h>
 
 #include "openssl/include/openssl/evp.h"
+#include "openssl/include/openssl/obj_mac.h"
 #include "unity.h"
 
 #include "besu_native_ec.h"
-#include "ec_verify_test_vectors.h"
-#include "utils.h"
+#include "corpus.h"
+#include "worker_pool.h"
+
+//  This test runs test vectors from
+// https://csrc.nist.gov/groups/STM/cavp/documents/dss/186-3ecdsatestvectors.zip
+//
+// The following sets have been copied from SigVer.rsp:
+// [P-256,SHA-224], [P-256,SHA-256], [P-256,SHA-384], [P-256,SHA-512]
+#define SIG_VER_PATH "test/vectors/SigVer.rsp"
+#define SIG_VER_CASE_COUNT 60
+
+// n / 2 of P-256, signatures with a greater s are rejected, even if they are
+// valid according to the test vectors
+static const unsigned char half_order[32] = {
+    0x7f, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0x73, 0x7d, 0x56, 0xd3, 0x8b,
+    0xcf, 0x42, 0x79, 0xdc, 0xe5, 0x61, 0x7e, 0x31, 0x92, 0xa8};
+
+static int verify_test_case(const struct corpus_case *test_case,
+                            void *context) {
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  unsigned int md_value_len = 0;
 
-void p256_verify_should_verify_signatures_according_to_test_vectors(void) {
-  int test_vectors_len = sizeof(test_vectors) / sizeof(test_vectors[0]);
+  TEST_ASSERT_EQUAL_INT(NID_X9_62_prime256v1, test_case->curve_nid);
+  TEST_ASSERT_NOT_NULL(test_case->md);
 
-  const EVP_MD *md_sha224 = EVP_sha224();
-  const EVP_MD *md_sha256 = EVP_sha256();
-  const EVP_MD *md_sha384 = EVP_sha384();
-  const EVP_MD *md_sha512 = EVP_sha512();
+  if (EVP_Digest(test_case->message, test_case->message_len, md_value,
+                 &md_value_len, test_case->md, NULL) != 1) {
+    TEST_FAIL_MESSAGE("Hashing not successful");
+  }
 
-  unsigned char md_value[EVP_MAX_MD_SIZE];
-  unsigned int md_value_len = 0;
-  const EVP_MD *md = NULL;
-
-  for (int i = 0; i < test_vectors_len; i++) {
-    switch (test_vectors[i].hash_function_id) {
-    case SHA_224:
-      md = md_sha224;
-      break;
-    case SHA_256:
-      md = md_sha256;
-      break;
-    case SHA_384:
-      md = md_sha384;
-      break;
-    case SHA_512:
-      md = md_sha512;
-      break;
-    default:
-      TEST_FAIL_MESSAGE("Unknown hash id");
-    }
-
-    unsigned char *data_bin = hex_to_bin(test_vectors[i].data);
-    char *public_key_bin = (char *)hex_to_bin(test_vectors[i].public_key);
-    char *signature_r_bin = (char *)hex_to_bin(test_vectors[i].signature_r);
-    char *signature_s_bin = (char *)hex_to_bin(test_vectors[i].signature_s);
-
-    if (EVP_Digest(data_bin, strlen(test_vectors[i].data) / 2, md_value,
-                   &md_value_len, md, NULL) != 1) {
-      TEST_FAIL_MESSAGE("Hashing not successful");
-    }
-
-    struct verify_result result =
-        p256_verify((const char *)md_value, md_value_len, signature_r_bin,
-                    signature_s_bin, (const char *)public_key_bin);
-
-    TEST_ASSERT_EQUAL_INT(test_vectors[i].result, result.verified);
-
-    if (test_vectors[i].result == ERROR_NOT_CANONICALIZED) {
-      TEST_ASSERT_EQUAL_STRING(
-          "Signature is not canonicalized. s of signature must not be greater "
-          "than n / 2: : error:00000000:lib(0)::reason(0)\n",
-          result.error_message);
-    } else {
-      TEST_ASSERT_EQUAL_STRING("", result.error_message);
-    }
-
-    free(data_bin);
-    free(public_key_bin);
-    free(signature_r_bin);
-    free(signature_s_bin);
+  struct verify_result result =
+      p256_verify((const char *)md_value, md_value_len,
+                  (const char *)test_case->signature_r,
+                  (const char *)test_case->signature_s,
+                  (const char *)test_case->public_key);
+
+  if (memcmp(test_case->signature_s, half_order, 32) > 0) {
+    TEST_ASSERT_EQUAL_INT(-1, result.verified);
+    TEST_ASSERT_EQUAL_STRING(
+        "Signature is not canonicalized. s of signature must not be greater "
+        "than n / 2: : error:00000000:lib(0)::reason(0)\n",
+        result.error_message);
+  } else {
+    TEST_ASSERT_EQUAL_INT(test_case->result == CORPUS_VALID ? 1 : 0,
+                          result.verified);
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
   }
 
-  EVP_MD_free((EVP_MD *)md_sha224);
-  EVP_MD_free((EVP_MD *)md_sha256);
-  EVP_MD_free((EVP_MD *)md_sha384);
-  EVP_MD_free((EVP_MD *)md_sha512);
+  return 1;
+}
+
+void p256_verify_should_verify_signatures_according_to_test_vectors(void) {
+  TEST_ASSERT_EQUAL_INT(SIG_VER_CASE_COUNT,
+                        corpus_load(SIG_VER_PATH, verify_test_case, NULL));
+}
+
+void p256_verify_should_verify_signatures_in_low_latency_mode(void) {
+  besu_native_ec_low_latency_set_enabled(1);
+  int case_count = corpus_load(SIG_VER_PATH, verify_test_case, NULL);
+  besu_native_ec_low_latency_set_enabled(0);
+
+  TEST_ASSERT_EQUAL_INT(SIG_VER_CASE_COUNT, case_count);
 }
 
 int main(void) {
+  char error_message[256] = {0};
+
+  // at least two workers, so that the low latency mode splits the
+  // multiplications on any machine
+  worker_pool_init(error_message, 2);
+
   UNITY_BEGIN();
 
   RUN_TEST(p256_verify_should_verify_signatures_according_to_test_vectors);
+  RUN_TEST(p256_verify_should_verify_signatures_in_low_latency_mode);
 
   return UNITY_END();
 }
@@ -0,0 +1,284 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "utils.h"
+
+// Assertion signed with the P-256 key
+// 519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464 of
+// SigGen.txt from the CAVP test vectors. The authenticator data consists of
+// the SHA-256 hash of example.com, the flags UP and UV and a signCount of 1.
+static const char *authenticator_data =
+    "a379a6f6eeafb9a55e378c118034e2751e682fab9f2d30ab13d2125586ce1947"
+    "0500000001";
+static const char *client_data_json =
+    "{\"type\":\"webauthn.get\",\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\","
+    "\"origin\":\"https://example.com\",\"crossOrigin\":false}";
+static const char *challenge = "0102030405060708090a0b0c0d0e0f1011121314";
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+static const char *der_signature =
+    "30440220100446100276a3e1a6ff7f6a83e03a72c34274ade87a492c444703b2adeaa454"
+    "02202ca8ad06aac0115a29005500e9186bdc4874337a273ba1154a5a0a35053fbb71";
+static const char *raw_signature =
+    "100446100276a3e1a6ff7f6a83e03a72c34274ade87a492c444703b2adeaa454"
+    "2ca8ad06aac0115a29005500e9186bdc4874337a273ba1154a5a0a35053fbb71";
+// same signature with s replaced by n - s
+static const char *high_s_der_signature =
+    "30450220100446100276a3e1a6ff7f6a83e03a72c34274ade87a492c444703b2adeaa454"
+    "022100d35752f8553feea6d6ffaaff16e794237472c7337fdbfd6fa95fc08df72369e0";
+
+struct test_assertion {
+  struct p256_webauthn_assertion assertion;
+  unsigned char *authenticator_data;
+  unsigned char *challenge;
+  unsigned char *signature;
+  unsigned char *public_key;
+};
+
+static void create_assertion(struct test_assertion *test,
+                             const char *client_data, const char *signature) {
+  test->authenticator_data = hex_to_bin(authenticator_data);
+  test->challenge = hex_to_bin(challenge);
+  test->signature = hex_to_bin(signature);
+  test->public_key = hex_to_bin(public_key);
+
+  test->assertion = (struct p256_webauthn_assertion){
+      .authenticator_data = (const char *)test->authenticator_data,
+      .authenticator_data_len = strlen(authenticator_data) / 2,
+      .client_data_json = client_data,
+      .client_data_json_len = strlen(client_data),
+      .challenge = (const char *)test->challenge,
+      .challenge_len = strlen(challenge) / 2,
+      .signature = (const char *)test->signature,
+      .signature_len = strlen(signature) / 2,
+      .public_key = (const char *)test->public_key};
+}
+
+static void free_assertion(struct test_assertion *test) {
+  free(test->authenticator_data);
+  free(test->challenge);
+  free(test->signature);
+  free(test->public_key);
+}
+
+static struct verify_result verify_client_data(const char *client_data) {
+  struct test_assertion test;
+  create_assertion(&test, client_data, der_signature);
+  struct verify_result result = p256_verify_webauthn(&test.assertion, 0);
+  free_assertion(&test);
+  return result;
+}
+
+void p256_verify_webauthn_should_verify_der_and_raw_signatures(void) {
+  const char *signatures[] = {der_signature, raw_signature};
+
+  for (int i = 0; i < 2; i++) {
+    struct test_assertion test;
+    create_assertion(&test, client_data_json, signatures[i]);
+
+    struct verify_result result = p256_verify_webauthn(&test.assertion, 0);
+
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_INT(1, result.verified);
+    free_assertion(&test);
+  }
+}
+
+void p256_verify_webauthn_should_accept_high_s_only_if_allowed(void) {
+  struct test_assertion test;
+  create_assertion(&test, client_data_json, high_s_der_signature);
+
+  struct verify_result result = p256_verify_webauthn(&test.assertion, 0);
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING(
+      "Signature is not canonicalized. s of signature must not be greater "
+      "than n / 2: : error:00000000:lib(0)::reason(0)\n",
+      result.error_message);
+
+  result = p256_verify_webauthn(&test.assertion, 1);
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_INT(1, result.verified);
+
+  free_assertion(&test);
+}
+
+void p256_verify_webauthn_should_not_verify_modified_authenticator_data(
+    void) {
+  struct test_assertion test;
+  create_assertion(&test, client_data_json, der_signature);
+  // signCount 2 instead of 1
+  test.authenticator_data[36] = 2;
+
+  struct verify_result result = p256_verify_webauthn(&test.assertion, 0);
+
+  TEST_ASSERT_EQUAL_INT(0, result.verified);
+
+  test.assertion.authenticator_data_len = 36;
+  result = p256_verify_webauthn(&test.assertion, 0);
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING("Authenticator data is too short\n",
+                           result.error_message);
+
+  free_assertion(&test);
+}
+
+void p256_verify_webauthn_should_reject_other_client_data(void) {
+  struct verify_result result = verify_client_data(
+      "{\"type\":\"webauthn.get\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExM\","
+      "\"origin\":\"https://example.com\"}");
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING("Challenge of client data does not match\n",
+                           result.error_message);
+
+  result = verify_client_data(
+      "{\"type\":\"webauthn.create\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\"}");
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING("Type of client data must be webauthn.get\n",
+                           result.error_message);
+
+  const char *invalid_client_data[] = {
+      "",
+      "{}",
+      "[\"webauthn.get\"]",
+      // duplicate challenge
+      "{\"type\":\"webauthn.get\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\"}",
+      // unterminated and with trailing data
+      "{\"type\":\"webauthn.get\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\"",
+      "{\"type\":\"webauthn.get\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\"}"
+      "}",
+      // the challenge must be a string
+      "{\"type\":\"webauthn.get\",\"challenge\":[1,2,3]}",
+  };
+  for (size_t i = 0;
+       i < sizeof(invalid_client_data) / sizeof(invalid_client_data[0]); i++) {
+    result = verify_client_data(invalid_client_data[i]);
+    TEST_ASSERT_EQUAL_INT(-1, result.verified);
+    TEST_ASSERT_EQUAL_STRING(
+        "Client data is not a JSON object with type and challenge\n",
+        result.error_message);
+  }
+}
+
+void p256_verify_webauthn_should_skip_unknown_members(void) {
+  struct verify_result result = verify_client_data(
+      "{ \"type\" : \"webauthn.get\" , \"tokenBinding\": {\"status\": "
+      "\"present\", \"id\": [1, 2.5e3, true, null]}, \"other\": \"\\\"}\","
+      "\"challenge\":\"AQIDBAUGBwgJCgsMDQ4PEBESExQ\" }\n");
+
+  // the client data hash differs, so the signature is not valid
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_INT(0, result.verified);
+}
+
+void p256_verify_webauthn_should_reject_invalid_signature_encoding(void) {
+  struct test_assertion test;
+  create_assertion(&test, client_data_json, der_signature);
+  // trailing byte
+  test.assertion.signature_len = 63;
+
+  struct verify_result result = p256_verify_webauthn(&test.assertion, 0);
+
+  TEST_ASSERT_EQUAL_INT(-1, result.verified);
+  TEST_ASSERT_EQUAL_STRING("Signature must be DER encoded or r || s\n",
+                           result.error_message);
+  free_assertion(&test);
+}
+
+void p256_verify_webauthn_should_reject_r_and_s_out_of_range(void) {
+  // r of the signature with s = 0, s = n and s = n + 1
+  const char *signatures[] = {
+      "100446100276a3e1a6ff7f6a83e03a72c34274ade87a492c444703b2adeaa454"
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      "100446100276a3e1a6ff7f6a83e03a72c34274ade87a492c444703b2adeaa454"
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551",
+      "100446100276a3e1a6ff7f6a83e03a72c34274ade87a492c444703b2adeaa454"
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632552",
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551"
+      "2ca8ad06aac0115a29005500e9186bdc4874337a273ba1154a5a0a35053fbb71"};
+
+  for (size_t i = 0; i < sizeof(signatures) / sizeof(signatures[0]); i++) {
+    for (int allow_high_s = 0; allow_high_s < 2; allow_high_s++) {
+      struct test_assertion test;
+      create_assertion(&test, client_data_json, signatures[i]);
+
+      struct verify_result result =
+          p256_verify_webauthn(&test.assertion, allow_high_s);
+
+      TEST_ASSERT_EQUAL_INT(-1, result.verified);
+      TEST_ASSERT_EQUAL_STRING(
+          "Signature r and s must be between 1 and n - 1\n",
+          result.error_message);
+      free_assertion(&test);
+    }
+  }
+}
+
+void p256_verify_webauthn_batch_should_verify_all_assertions(void) {
+  struct test_assertion tests[3];
+  struct p256_webauthn_assertion assertions[3];
+  struct verify_result results[3];
+
+  create_assertion(&tests[0], client_data_json, der_signature);
+  create_assertion(&tests[1], client_data_json, raw_signature);
+  create_assertion(&tests[2], client_data_json, der_signature);
+  tests[2].authenticator_data[32] = 0x01;
+  for (int i = 0; i < 3; i++) {
+    assertions[i] = tests[i].assertion;
+  }
+
+  TEST_ASSERT_EQUAL_INT(2,
+                        p256_verify_webauthn_batch(results, assertions, 3, 0));
+  TEST_ASSERT_EQUAL_INT(1, results[0].verified);
+  TEST_ASSERT_EQUAL_INT(1, results[1].verified);
+  TEST_ASSERT_EQUAL_INT(0, results[2].verified);
+
+  for (int i = 0; i < 3; i++) {
+    free_assertion(&tests[i]);
+  }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_verify_webauthn_should_verify_der_and_raw_signatures);
+  RUN_TEST(p256_verify_webauthn_should_accept_high_s_only_if_allowed);
+  RUN_TEST(p256_verify_webauthn_should_not_verify_modified_authenticator_data);
+  RUN_TEST(p256_verify_webauthn_should_reject_other_client_data);
+  RUN_TEST(p256_verify_webauthn_should_skip_unknown_members);
+  RUN_TEST(p256_verify_webauthn_should_reject_invalid_signature_encoding);
+  RUN_TEST(p256_verify_webauthn_should_reject_r_and_s_out_of_range);
+  RUN_TEST(p256_verify_webauthn_batch_should_verify_all_assertions);
+
+  return UNITY_END();
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "unity.h"
+
+#include "epoch.h"
+
+static atomic_int released = 0;
+
+static void count_release(void *object) { atomic_fetch_add(&released, 1); }
+
+struct reader {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  int entered;
+  int leave;
+};
+
+static void *read_until_told(void *data) {
+  struct reader *reader = data;
+  char error_message[256];
+
+  epoch_enter(error_message);
+  pthread_mutex_lock(&reader->lock);
+  reader->entered = 1;
+  pthread_cond_broadcast(&reader->changed);
+  while (!reader->leave) {
+    pthread_cond_wait(&reader->changed, &reader->lock);
+  }
+  pthread_mutex_unlock(&reader->lock);
+  epoch_exit();
+  return NULL;
+}
+
+void epoch_retire_should_release_objects_without_readers(void) {
+  char error_message[256];
+  int object = 0;
+
+  epoch_reclaim();
+  atomic_store(&released, 0);
+  TEST_ASSERT_EQUAL_INT(1,
+                        epoch_retire(error_message, &object, count_release));
+
+  TEST_ASSERT_EQUAL_UINT64(0, epoch_reclaim());
+  TEST_ASSERT_EQUAL_INT(1, atomic_load(&released));
+}
+
+void epoch_retire_should_wait_for_readers(void) {
+  char error_message[256];
+  int object = 0;
+  struct reader reader = {.lock = PTHREAD_MUTEX_INITIALIZER,
+                          .changed = PTHREAD_COND_INITIALIZER};
+  pthread_t thread;
+
+  epoch_reclaim();
+  atomic_store(&released, 0);
+  pthread_create(&thread, NULL, read_until_told, &reader);
+  pthread_mutex_lock(&reader.lock);
+  while (!reader.entered) {
+    pthread_cond_wait(&reader.changed, &reader.lock);
+  }
+  pthread_mutex_unlock(&reader.lock);
+
+  TEST_ASSERT_EQUAL_INT(1,
+                        epoch_retire(error_message, &object, count_release));
+  TEST_ASSERT_EQUAL_UINT64(1, epoch_reclaim());
+  TEST_ASSERT_EQUAL_UINT64(1, epoch_reclaim());
+  TEST_ASSERT_EQUAL_INT(0, atomic_load(&released));
+
+  pthread_mutex_lock(&reader.lock);
+  reader.leave = 1;
+  pthread_cond_broadcast(&reader.changed);
+  pthread_mutex_unlock(&reader.lock);
+  pthread_join(thread, NULL);
+
+  TEST_ASSERT_EQUAL_UINT64(0, epoch_reclaim());
+  TEST_ASSERT_EQUAL_INT(1, atomic_load(&released));
+}
+
+void epoch_sections_should_be_nestable(void) {
+  char error_message[256];
+  int object = 0;
+
+  epoch_reclaim();
+  atomic_store(&released, 0);
+  TEST_ASSERT_EQUAL_INT(1, epoch_enter(error_message));
+  TEST_ASSERT_EQUAL_INT(1, epoch_enter(error_message));
+  TEST_ASSERT_EQUAL_INT(1,
+                        epoch_retire(error_message, &object, count_release));
+  epoch_exit();
+
+  TEST_ASSERT_EQUAL_UINT64(1, epoch_reclaim());
+  TEST_ASSERT_EQUAL_INT(0, atomic_load(&released));
+
+  epoch_exit();
+  TEST_ASSERT_EQUAL_UINT64(0, epoch_reclaim());
+  TEST_ASSERT_EQUAL_INT(1, atomic_load(&released));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(epoch_retire_should_release_objects_without_readers);
+  RUN_TEST(epoch_retire_should_wait_for_readers);
+  RUN_TEST(epoch_sections_should_be_nestable);
+
+  return UNITY_END();
+}
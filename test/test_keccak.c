@@ -0,0 +1,94 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "keccak.h"
+#include "utils.h"
+
+static void assert_keccak_256(const char *expected_hex,
+                              const unsigned char *data, size_t len) {
+  unsigned char digest[KECCAK_256_DIGEST_LEN];
+  unsigned char *expected = hex_to_bin(expected_hex);
+
+  keccak_256(data, len, digest);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, digest, KECCAK_256_DIGEST_LEN);
+
+  free(expected);
+}
+
+void keccak_256_should_hash_short_inputs(void) {
+  assert_keccak_256(
+      "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470",
+      (const unsigned char *)"", 0);
+  assert_keccak_256(
+      "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45",
+      (const unsigned char *)"abc", 3);
+}
+
+void keccak_256_should_hash_inputs_of_several_blocks(void) {
+  unsigned char data[300];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (unsigned char)(i % 251);
+  }
+
+  assert_keccak_256(
+      "4699841dafd5e26cca72b05a41d38c96b4b468e5a6cbf694cbebe77dacdf6528",
+      data, sizeof(data));
+}
+
+void keccak_256_update_should_accept_data_in_any_pieces(void) {
+  unsigned char data[300];
+  unsigned char expected[KECCAK_256_DIGEST_LEN];
+  unsigned char digest[KECCAK_256_DIGEST_LEN];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (unsigned char)(i % 251);
+  }
+  keccak_256(data, sizeof(data), expected);
+
+  // pieces that end before, at and behind the end of a block
+  const size_t piece_lens[] = {1, 7, 135, 136, 137};
+  for (size_t i = 0; i < sizeof(piece_lens) / sizeof(piece_lens[0]); i++) {
+    struct keccak_256_ctx ctx;
+    keccak_256_init(&ctx);
+    for (size_t offset = 0; offset < sizeof(data); offset += piece_lens[i]) {
+      size_t len = sizeof(data) - offset < piece_lens[i] ? sizeof(data) - offset
+                                                         : piece_lens[i];
+      keccak_256_update(&ctx, data + offset, len);
+    }
+    keccak_256_final(&ctx, digest);
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, digest, KECCAK_256_DIGEST_LEN);
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(keccak_256_should_hash_short_inputs);
+  RUN_TEST(keccak_256_should_hash_inputs_of_several_blocks);
+  RUN_TEST(keccak_256_update_should_accept_data_in_any_pieces);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
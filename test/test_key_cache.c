@@ -0,0 +1,241 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "corpus.h"
+
+#define KEY_COUNT 60
+
+struct signer {
+  char public_key[64];
+  char data_hash[64];
+  unsigned int data_hash_len;
+  char signature_r[32];
+  char signature_s[32];
+};
+
+static struct signer signers[KEY_COUNT];
+// a canonical signature that does not verify, but makes verify import the key
+static char signature_one[32] = {[31] = 1};
+
+static struct verify_result verify_dummy(const struct signer *signer) {
+  return p256_verify(signer->data_hash, signer->data_hash_len, signature_one,
+                     signature_one, signer->public_key);
+}
+
+void key_cache_should_return_cached_keys_for_repeat_signers(void) {
+  char error_message[256] = {0};
+  // large enough that no shard evicts any of the keys
+  TEST_ASSERT_EQUAL_INT(1, besu_native_ec_key_cache_set_capacity(
+                               error_message, 4 * KEY_COUNT));
+
+  struct key_cache_stats before = besu_native_ec_key_cache_stats();
+  for (int i = 0; i < 10; i++) {
+    verify_dummy(&signers[i]);
+    verify_dummy(&signers[i]);
+  }
+  struct key_cache_stats after = besu_native_ec_key_cache_stats();
+
+  TEST_ASSERT_EQUAL_UINT64(10, after.misses - before.misses);
+  TEST_ASSERT_EQUAL_UINT64(10, after.hits - before.hits);
+  TEST_ASSERT_EQUAL_UINT64(10, after.entries);
+
+  // the results are the same with a cached key
+  for (int i = 0; i < KEY_COUNT; i++) {
+    struct signer *signer = &signers[i];
+    struct verify_result first =
+        p256_verify(signer->data_hash, signer->data_hash_len,
+                    signer->signature_r, signer->signature_s,
+                    signer->public_key);
+    struct verify_result second =
+        p256_verify(signer->data_hash, signer->data_hash_len,
+                    signer->signature_r, signer->signature_s,
+                    signer->public_key);
+    TEST_ASSERT_EQUAL_INT(first.verified, second.verified);
+    TEST_ASSERT_EQUAL_STRING(first.error_message, second.error_message);
+  }
+}
+
+void key_cache_should_evict_least_recently_used_keys(void) {
+  char error_message[256] = {0};
+  TEST_ASSERT_EQUAL_INT(
+      1, besu_native_ec_key_cache_set_capacity(error_message, 16));
+
+  struct key_cache_stats before = besu_native_ec_key_cache_stats();
+  for (int i = 0; i < KEY_COUNT; i++) {
+    TEST_ASSERT_EQUAL_INT(0, verify_dummy(&signers[i]).verified);
+  }
+  struct key_cache_stats after = besu_native_ec_key_cache_stats();
+
+  TEST_ASSERT_EQUAL_UINT64(16, after.capacity);
+  TEST_ASSERT_TRUE(after.entries <= 16);
+  TEST_ASSERT_TRUE(after.evictions > before.evictions);
+
+  // the most recently used key is still cached
+  verify_dummy(&signers[KEY_COUNT - 1]);
+  TEST_ASSERT_EQUAL_UINT64(after.hits + 1,
+                           besu_native_ec_key_cache_stats().hits);
+}
+
+void key_cache_should_not_be_used_if_disabled(void) {
+  besu_native_ec_key_cache_set_enabled(0);
+
+  struct key_cache_stats before = besu_native_ec_key_cache_stats();
+  TEST_ASSERT_EQUAL_INT(0, before.enabled);
+  TEST_ASSERT_EQUAL_UINT64(0, before.entries);
+
+  TEST_ASSERT_EQUAL_INT(0, verify_dummy(&signers[0]).verified);
+  struct key_cache_stats after = besu_native_ec_key_cache_stats();
+  TEST_ASSERT_EQUAL_UINT64(before.hits, after.hits);
+  TEST_ASSERT_EQUAL_UINT64(before.misses, after.misses);
+  TEST_ASSERT_EQUAL_UINT64(0, after.entries);
+
+  besu_native_ec_key_cache_set_enabled(1);
+}
+
+void key_cache_should_not_cache_invalid_keys(void) {
+  struct signer signer = signers[0];
+  signer.public_key[63] ^= 1;
+
+  struct key_cache_stats before = besu_native_ec_key_cache_stats();
+  TEST_ASSERT_EQUAL_INT(-1, verify_dummy(&signer).verified);
+  TEST_ASSERT_EQUAL_INT(-1, verify_dummy(&signer).verified);
+  struct key_cache_stats after = besu_native_ec_key_cache_stats();
+
+  TEST_ASSERT_EQUAL_UINT64(before.misses + 2, after.misses);
+  TEST_ASSERT_EQUAL_UINT64(before.entries, after.entries);
+}
+
+void key_cache_should_reject_invalid_configuration(void) {
+  char error_message[256] = {0};
+
+  TEST_ASSERT_EQUAL_INT(
+      0, besu_native_ec_key_cache_set_capacity(error_message, -1));
+  TEST_ASSERT_EQUAL_STRING(
+      "Capacity of key cache must be between 0 and 16777216\n", error_message);
+
+  TEST_ASSERT_EQUAL_INT(
+      0, besu_native_ec_key_cache_set_admission_threshold(error_message, 0));
+  TEST_ASSERT_EQUAL_STRING(
+      "Admission threshold of key cache must be between 1 and 255\n",
+      error_message);
+}
+
+void key_cache_should_only_admit_keys_that_missed_as_often_as_threshold(void) {
+  char error_message[256] = {0};
+  TEST_ASSERT_EQUAL_INT(1, besu_native_ec_key_cache_set_capacity(
+                               error_message, 4 * KEY_COUNT));
+  TEST_ASSERT_EQUAL_INT(1, besu_native_ec_key_cache_set_admission_threshold(
+                               error_message, 2));
+
+  struct key_cache_stats before = besu_native_ec_key_cache_stats();
+  for (int i = 10; i < 20; i++) {
+    verify_dummy(&signers[i]);
+  }
+  struct key_cache_stats after = besu_native_ec_key_cache_stats();
+  TEST_ASSERT_EQUAL_INT(2, after.admission_threshold);
+  TEST_ASSERT_EQUAL_UINT64(10, after.rejections - before.rejections);
+  TEST_ASSERT_EQUAL_UINT64(0, after.entries);
+
+  // the second miss of a key caches it
+  for (int j = 0; j < 2; j++) {
+    for (int i = 10; i < 20; i++) {
+      verify_dummy(&signers[i]);
+    }
+  }
+  struct key_cache_stats cached = besu_native_ec_key_cache_stats();
+  TEST_ASSERT_EQUAL_UINT64(10, cached.rejections - before.rejections);
+  TEST_ASSERT_EQUAL_UINT64(20, cached.misses - before.misses);
+  TEST_ASSERT_EQUAL_UINT64(10, cached.hits - before.hits);
+  TEST_ASSERT_EQUAL_UINT64(10, cached.entries);
+
+  TEST_ASSERT_EQUAL_INT(1, besu_native_ec_key_cache_set_admission_threshold(
+                               error_message, 1));
+}
+
+void key_cache_should_keep_repeat_signers_during_flood_of_new_keys(void) {
+  char error_message[256] = {0};
+  TEST_ASSERT_EQUAL_INT(
+      1, besu_native_ec_key_cache_set_capacity(error_message, 16));
+  TEST_ASSERT_EQUAL_INT(1, besu_native_ec_key_cache_set_admission_threshold(
+                               error_message, 2));
+  struct key_cache_stats start = besu_native_ec_key_cache_stats();
+
+  verify_dummy(&signers[0]);
+  verify_dummy(&signers[0]);
+  // without the threshold, these keys evict the key of the repeat signer
+  for (int i = KEY_COUNT / 2; i < KEY_COUNT; i++) {
+    verify_dummy(&signers[i]);
+  }
+
+  struct key_cache_stats before = besu_native_ec_key_cache_stats();
+  TEST_ASSERT_EQUAL_UINT64(start.evictions, before.evictions);
+  verify_dummy(&signers[0]);
+  TEST_ASSERT_EQUAL_UINT64(before.hits + 1,
+                           besu_native_ec_key_cache_stats().hits);
+
+  TEST_ASSERT_EQUAL_INT(1, besu_native_ec_key_cache_set_admission_threshold(
+                               error_message, 1));
+}
+
+// copies the keys and signatures of all sections of SigGen.rsp
+static int copy_signers(const struct corpus_case *test_case, void *context) {
+  int *signer_count = context;
+  struct signer *signer = &signers[*signer_count];
+
+  memcpy(signer->public_key, test_case->public_key, 64);
+  memcpy(signer->signature_r, test_case->signature_r, 32);
+  memcpy(signer->signature_s, test_case->signature_s, 32);
+  EVP_Digest(test_case->message, test_case->message_len,
+             (unsigned char *)signer->data_hash, &signer->data_hash_len,
+             test_case->md, NULL);
+  return ++*signer_count < KEY_COUNT;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  int signer_count = 0;
+
+  if (corpus_load("test/vectors/SigGen.rsp", copy_signers, &signer_count) <
+          0 ||
+      signer_count != KEY_COUNT) {
+    // reported like a failed test, so that check_failing_test.sh finds it
+    puts("FAIL: could not load test/vectors/SigGen.rsp");
+    return 1;
+  }
+
+  UNITY_BEGIN();
+
+  RUN_TEST(key_cache_should_return_cached_keys_for_repeat_signers);
+  RUN_TEST(key_cache_should_evict_least_recently_used_keys);
+  RUN_TEST(key_cache_should_not_be_used_if_disabled);
+  RUN_TEST(key_cache_should_not_cache_invalid_keys);
+  RUN_TEST(key_cache_should_reject_invalid_configuration);
+  RUN_TEST(key_cache_should_only_admit_keys_that_missed_as_often_as_threshold);
+  RUN_TEST(key_cache_should_keep_repeat_signers_during_flood_of_new_keys);
+
+  return UNITY_END();
+}
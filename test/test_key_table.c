@@ -0,0 +1,381 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mkstemp is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "corpus.h"
+#include "key_table.h"
+
+#define KEY_COUNT 3
+
+static char public_keys[(KEY_COUNT + 1) * 64];
+static char private_keys[KEY_COUNT * 32];
+static char data_hash[32];
+static char table_path[] = "/tmp/besu_native_ec_key_table_XXXXXX";
+
+static void verify_signatures_with_table(struct p256_key_table *table) {
+  for (int i = 0; i < KEY_COUNT; i++) {
+    int index = p256_key_table_find(table, public_keys + i * 64);
+    TEST_ASSERT_TRUE(index >= 0);
+
+    struct sign_result signature =
+        p256_sign(data_hash, sizeof(data_hash), private_keys + i * 32,
+                  public_keys + i * 64);
+    TEST_ASSERT_EQUAL_STRING("", signature.error_message);
+
+    struct verify_result result = p256_key_table_verify(
+        table, index, data_hash, sizeof(data_hash), signature.signature_r,
+        signature.signature_s);
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_INT(1, result.verified);
+
+    // a signature of another signer must not be accepted
+    int other_index = p256_key_table_find(
+        table, public_keys + ((i + 1) % KEY_COUNT) * 64);
+    result = p256_key_table_verify(table, other_index, data_hash,
+                                   sizeof(data_hash), signature.signature_r,
+                                   signature.signature_s);
+    TEST_ASSERT_EQUAL_INT(0, result.verified);
+  }
+}
+
+void p256_key_table_create_should_sort_and_deduplicate_keys(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+
+  // the last key is a duplicate of the first one
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_create(&table, error_message,
+                                              public_keys, KEY_COUNT + 1));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  for (int i = 0; i < KEY_COUNT; i++) {
+    TEST_ASSERT_TRUE(p256_key_table_find(table, public_keys + i * 64) >= 0);
+  }
+
+  char unknown_key[64] = {0};
+  TEST_ASSERT_EQUAL_INT(-1, p256_key_table_find(table, unknown_key));
+
+  verify_signatures_with_table(table);
+
+  p256_key_table_free(table);
+}
+
+void p256_key_table_create_should_reject_invalid_keys(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+  char invalid_keys[2 * 64];
+
+  memcpy(invalid_keys, public_keys, 2 * 64);
+  // changing y moves the second key off the curve
+  invalid_keys[127] ^= 0x01;
+
+  TEST_ASSERT_EQUAL_INT(
+      FAILURE, p256_key_table_create(&table, error_message, invalid_keys, 2));
+  TEST_ASSERT_NULL(table);
+  TEST_ASSERT_NOT_EQUAL(0, strlen(error_message));
+}
+
+void p256_key_table_create_should_reject_key_counts_below_one(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(
+      FAILURE, p256_key_table_create(&table, error_message, public_keys, 0));
+  TEST_ASSERT_EQUAL_STRING(
+      "Number of keys of key table must be at least 1, but is 0\n",
+      error_message);
+  TEST_ASSERT_EQUAL_INT(FAILURE, p256_key_table_create_with_format(
+                                     &table, error_message, public_keys, -1,
+                                     KEY_TABLE_COMPACT));
+  TEST_ASSERT_EQUAL_STRING(
+      "Number of keys of key table must be at least 1, but is -1\n",
+      error_message);
+  TEST_ASSERT_NULL(table);
+}
+
+void p256_key_table_load_should_restore_saved_table(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+  struct p256_key_table *loaded_table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, p256_key_table_create(&table, error_message,
+                                                       public_keys, KEY_COUNT));
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_save(table, error_message, table_path));
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, p256_key_table_load(&loaded_table, error_message, table_path));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  for (int i = 0; i < KEY_COUNT; i++) {
+    TEST_ASSERT_EQUAL_INT(
+        p256_key_table_find(table, public_keys + i * 64),
+        p256_key_table_find(loaded_table, public_keys + i * 64));
+  }
+
+  verify_signatures_with_table(loaded_table);
+
+  p256_key_table_free(table);
+  p256_key_table_free(loaded_table);
+}
+
+void p256_key_table_load_should_reject_corrupted_files(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, p256_key_table_create(&table, error_message,
+                                                       public_keys, KEY_COUNT));
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_save(table, error_message, table_path));
+  p256_key_table_free(table);
+  table = NULL;
+
+  // flip one bit of the last entry
+  FILE *file = fopen(table_path, "r+b");
+  TEST_ASSERT_NOT_NULL(file);
+  fseek(file, -1, SEEK_END);
+  int last_byte = fgetc(file);
+  fseek(file, -1, SEEK_END);
+  fputc(last_byte ^ 0x01, file);
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_INT(
+      FAILURE, p256_key_table_load(&table, error_message, table_path));
+  TEST_ASSERT_NULL(table);
+  TEST_ASSERT_EQUAL_STRING("Checksum of key table file does not match\n",
+                           error_message);
+
+  // a truncated file must be rejected as well
+  TEST_ASSERT_EQUAL_INT(0, truncate(table_path, 100));
+  TEST_ASSERT_EQUAL_INT(
+      FAILURE, p256_key_table_load(&table, error_message, table_path));
+  TEST_ASSERT_EQUAL_STRING(
+      "Key table file is truncated or has trailing data\n", error_message);
+}
+
+void p256_key_table_save_should_use_unique_temporary_file(void) {
+  char error_message[256] = {0};
+  char fixed_temporary_path[sizeof(table_path) + 4];
+  struct p256_key_table *table = NULL;
+
+  // a fixed temporary path would collide with the directory
+  snprintf(fixed_temporary_path, sizeof(fixed_temporary_path), "%s.tmp",
+           table_path);
+  TEST_ASSERT_EQUAL_INT(0, mkdir(fixed_temporary_path, 0700));
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, p256_key_table_create(&table, error_message,
+                                                       public_keys, KEY_COUNT));
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_save(table, error_message, table_path));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  struct stat file_stat;
+  TEST_ASSERT_EQUAL_INT(0, stat(table_path, &file_stat));
+  TEST_ASSERT_EQUAL_INT(0644, file_stat.st_mode & 0777);
+
+  rmdir(fixed_temporary_path);
+  p256_key_table_free(table);
+}
+
+void p256_key_table_load_should_import_keys_of_full_tables(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, p256_key_table_create(&table, error_message,
+                                                       public_keys, KEY_COUNT));
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_save(table, error_message, table_path));
+  p256_key_table_free(table);
+  table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, p256_key_table_load(&table, error_message, table_path));
+  for (size_t i = 0; i < table->entry_count; i++) {
+    TEST_ASSERT_NOT_NULL(atomic_load(&table->keys[i]));
+  }
+  p256_key_table_free(table);
+  table = NULL;
+
+  // moves y of the last key off the curve and writes a matching checksum, so
+  // that only the import can reject the file
+  FILE *file = fopen(table_path, "r+b");
+  struct key_table_file_header header;
+  unsigned char entries[KEY_COUNT * 64];
+  TEST_ASSERT_NOT_NULL(file);
+  TEST_ASSERT_EQUAL_size_t(1, fread(&header, sizeof(header), 1, file));
+  TEST_ASSERT_EQUAL_size_t(1, fread(entries, sizeof(entries), 1, file));
+  entries[sizeof(entries) - 1] ^= 0x01;
+  memset(header.checksum, 0, sizeof(header.checksum));
+
+  EVP_MD_CTX *md_context = EVP_MD_CTX_new();
+  TEST_ASSERT_EQUAL_INT(1, EVP_DigestInit_ex(md_context, EVP_sha256(), NULL));
+  TEST_ASSERT_EQUAL_INT(
+      1, EVP_DigestUpdate(md_context, &header, sizeof(header)));
+  TEST_ASSERT_EQUAL_INT(
+      1, EVP_DigestUpdate(md_context, entries, sizeof(entries)));
+  TEST_ASSERT_EQUAL_INT(
+      1, EVP_DigestFinal_ex(md_context, header.checksum, NULL));
+  EVP_MD_CTX_free(md_context);
+
+  rewind(file);
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(entries, sizeof(entries), 1, file);
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_INT(
+      FAILURE, p256_key_table_load(&table, error_message, table_path));
+  TEST_ASSERT_NULL(table);
+  TEST_ASSERT_NOT_EQUAL(0, strlen(error_message));
+}
+
+static unsigned long long key_table_memory(void) {
+  return besu_native_ec_memory_budget_stats()
+      .subsystems[MEMORY_SUBSYSTEM_KEY_TABLES]
+      .used;
+}
+
+void p256_key_table_create_should_support_compact_format(void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+  unsigned long long before = key_table_memory();
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_create(&table, error_message,
+                                              public_keys, KEY_COUNT));
+  unsigned long long full_memory = key_table_memory() - before;
+  p256_key_table_free(table);
+  table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, p256_key_table_create_with_format(
+                                     &table, error_message, public_keys,
+                                     KEY_COUNT + 1, KEY_TABLE_COMPACT));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+  // the keys are not kept by the table, but imported through the key cache
+  TEST_ASSERT_TRUE(key_table_memory() - before < full_memory);
+
+  char unknown_key[64] = {0};
+  TEST_ASSERT_EQUAL_INT(-1, p256_key_table_find(table, unknown_key));
+  // the negated key shares x with the key, but not the parity of y
+  memcpy(unknown_key, public_keys, 64);
+  unknown_key[63] ^= 0x01;
+  TEST_ASSERT_EQUAL_INT(-1, p256_key_table_find(table, unknown_key));
+
+  verify_signatures_with_table(table);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_key_table_save(table, error_message, table_path));
+  p256_key_table_free(table);
+  table = NULL;
+
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, p256_key_table_load(&table, error_message, table_path));
+  verify_signatures_with_table(table);
+  p256_key_table_free(table);
+
+  FILE *file = fopen(table_path, "rb");
+  TEST_ASSERT_NOT_NULL(file);
+  fseek(file, 0, SEEK_END);
+  TEST_ASSERT_EQUAL_INT(sizeof(struct key_table_file_header) + KEY_COUNT * 33,
+                        ftell(file));
+  fclose(file);
+}
+
+void p256_key_table_create_should_reject_invalid_keys_of_compact_tables(
+    void) {
+  char error_message[256] = {0};
+  struct p256_key_table *table = NULL;
+  char invalid_keys[2 * 64];
+
+  // x stays on the curve, so the key can only be rejected before compressing
+  memcpy(invalid_keys, public_keys, 2 * 64);
+  invalid_keys[127] ^= 0x01;
+
+  TEST_ASSERT_EQUAL_INT(FAILURE, p256_key_table_create_with_format(
+                                     &table, error_message, invalid_keys, 2,
+                                     KEY_TABLE_COMPACT));
+  TEST_ASSERT_NULL(table);
+  TEST_ASSERT_NOT_EQUAL(0, strlen(error_message));
+
+  TEST_ASSERT_EQUAL_INT(FAILURE, p256_key_table_create_with_format(
+                                     &table, error_message, public_keys, 2,
+                                     2));
+  TEST_ASSERT_EQUAL_STRING("Unknown key table format 2\n", error_message);
+}
+
+// copies the keys of the first SHA-256 signatures of SigGen.rsp
+static int copy_keys(const struct corpus_case *test_case, void *context) {
+  int *key_count = context;
+
+  if (!EVP_MD_is_a(test_case->md, "SHA2-256")) {
+    return 1;
+  }
+  memcpy(private_keys + *key_count * 32, test_case->private_key, 32);
+  memcpy(public_keys + *key_count * 64, test_case->public_key, 64);
+  return ++*key_count < KEY_COUNT;
+}
+
+int main(void) {
+  const EVP_MD *md = EVP_sha256();
+  unsigned int md_value_len = 0;
+  int key_count = 0;
+
+  if (corpus_load("test/vectors/SigGen.rsp", copy_keys, &key_count) < 0 ||
+      key_count != KEY_COUNT) {
+    // reported like a failed test, so that check_failing_test.sh finds it
+    puts("FAIL: could not load test/vectors/SigGen.rsp");
+    return 1;
+  }
+  memcpy(public_keys + KEY_COUNT * 64, public_keys, 64);
+
+  EVP_Digest("key table", 9, (unsigned char *)data_hash, &md_value_len, md,
+             NULL);
+
+  int fd = mkstemp(table_path);
+  close(fd);
+
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_key_table_create_should_sort_and_deduplicate_keys);
+  RUN_TEST(p256_key_table_create_should_reject_invalid_keys);
+  RUN_TEST(p256_key_table_create_should_reject_key_counts_below_one);
+  RUN_TEST(p256_key_table_load_should_restore_saved_table);
+  RUN_TEST(p256_key_table_load_should_reject_corrupted_files);
+  RUN_TEST(p256_key_table_save_should_use_unique_temporary_file);
+  RUN_TEST(p256_key_table_load_should_import_keys_of_full_tables);
+  RUN_TEST(p256_key_table_create_should_support_compact_format);
+  RUN_TEST(p256_key_table_create_should_reject_invalid_keys_of_compact_tables);
+
+  unlink(table_path);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
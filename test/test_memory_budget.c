@@ -0,0 +1,179 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "key_cache.h"
+#include "table_memory.h"
+
+static struct memory_subsystem_stats
+subsystem_stats(enum memory_subsystem subsystem) {
+  return besu_native_ec_memory_budget_stats().subsystems[subsystem];
+}
+
+void memory_budget_should_evict_key_cache_under_pressure(void) {
+  char error_message[256] = {0};
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, besu_native_ec_key_cache_set_capacity(error_message, 256));
+
+  struct memory_budget_stats before = besu_native_ec_memory_budget_stats();
+  struct memory_subsystem_stats key_cache =
+      before.subsystems[MEMORY_SUBSYSTEM_KEY_CACHE];
+  TEST_ASSERT_TRUE(key_cache.used > 0);
+
+  // a budget below the used memory evicts the key cache
+  TEST_ASSERT_EQUAL_INT(SUCCESS, besu_native_ec_memory_set_budget(
+                                     error_message, before.used - 1));
+  TEST_ASSERT_EQUAL_UINT64(
+      0, subsystem_stats(MEMORY_SUBSYSTEM_KEY_CACHE).used);
+  TEST_ASSERT_EQUAL_UINT64(
+      key_cache.reclaimed + 1,
+      subsystem_stats(MEMORY_SUBSYSTEM_KEY_CACHE).reclaimed);
+
+  // a table that doesn't fit next to the key cache evicts it
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        besu_native_ec_memory_set_budget(error_message, 0));
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, besu_native_ec_key_cache_set_capacity(error_message, 256));
+  TEST_ASSERT_EQUAL_INT(SUCCESS, besu_native_ec_memory_set_budget(
+                                     error_message, before.used));
+  struct memory_budget_stats during = besu_native_ec_memory_budget_stats();
+  TEST_ASSERT_TRUE(during.subsystems[MEMORY_SUBSYSTEM_KEY_CACHE].used > 0);
+  struct table_memory table;
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, table_memory_alloc(&table, error_message,
+                                  MEMORY_SUBSYSTEM_KEY_TABLES,
+                                  during.budget - during.used + 1));
+  TEST_ASSERT_EQUAL_UINT64(
+      0, subsystem_stats(MEMORY_SUBSYSTEM_KEY_CACHE).used);
+  TEST_ASSERT_EQUAL_UINT64(
+      key_cache.reclaimed + 2,
+      subsystem_stats(MEMORY_SUBSYSTEM_KEY_CACHE).reclaimed);
+  TEST_ASSERT_EQUAL_UINT64(0, besu_native_ec_key_cache_stats().entries);
+  table_memory_free(&table);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        besu_native_ec_memory_set_budget(error_message, 0));
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, besu_native_ec_key_cache_set_capacity(
+                   error_message, KEY_CACHE_DEFAULT_CAPACITY));
+}
+
+void memory_budget_should_reject_tables_that_do_not_fit(void) {
+  char error_message[256] = {0};
+  struct table_memory table;
+  struct memory_subsystem_stats before =
+      subsystem_stats(MEMORY_SUBSYSTEM_KEY_TABLES);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, besu_native_ec_memory_set_budget(
+                                     error_message, 1024 * 1024));
+  TEST_ASSERT_EQUAL_INT(
+      FAILURE, table_memory_alloc(&table, error_message,
+                                  MEMORY_SUBSYSTEM_KEY_TABLES,
+                                  2 * 1024 * 1024));
+  TEST_ASSERT_EQUAL_STRING("Memory budget exceeded by key tables\n",
+                           error_message);
+
+  struct memory_subsystem_stats after =
+      subsystem_stats(MEMORY_SUBSYSTEM_KEY_TABLES);
+  TEST_ASSERT_EQUAL_UINT64(before.rejected + 1, after.rejected);
+  TEST_ASSERT_EQUAL_UINT64(before.used, after.used);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        besu_native_ec_memory_set_budget(error_message, 0));
+}
+
+void memory_budget_should_enforce_quotas(void) {
+  char error_message[256] = {0};
+  struct p256_ecdh_key_pool *pool = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, besu_native_ec_memory_set_quota(
+                                     error_message,
+                                     MEMORY_SUBSYSTEM_ECDH_KEY_POOLS, 1024));
+  TEST_ASSERT_EQUAL_INT(FAILURE,
+                        p256_ecdh_key_pool_create(&pool, error_message, 100));
+  TEST_ASSERT_EQUAL_STRING("Memory quota of ECDH key pools exceeded\n",
+                           error_message);
+  TEST_ASSERT_EQUAL_UINT64(
+      1024, subsystem_stats(MEMORY_SUBSYSTEM_ECDH_KEY_POOLS).quota);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, besu_native_ec_memory_set_quota(
+                                     error_message,
+                                     MEMORY_SUBSYSTEM_ECDH_KEY_POOLS, 0));
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_ecdh_key_pool_create(&pool, error_message, 100));
+  TEST_ASSERT_TRUE(subsystem_stats(MEMORY_SUBSYSTEM_ECDH_KEY_POOLS).used >=
+                   100 * sizeof(struct p256_ecdh_key_pair));
+  p256_ecdh_key_pool_free(pool);
+  TEST_ASSERT_EQUAL_UINT64(
+      0, subsystem_stats(MEMORY_SUBSYSTEM_ECDH_KEY_POOLS).used);
+}
+
+void memory_budget_stats_should_report_used_memory_by_subsystem(void) {
+  char error_message[256] = {0};
+  struct table_memory table;
+  struct memory_budget_stats before = besu_native_ec_memory_budget_stats();
+
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, table_memory_alloc(&table, error_message,
+                                  MEMORY_SUBSYSTEM_RECOVERY_INDEXES, 1000));
+  struct memory_budget_stats during = besu_native_ec_memory_budget_stats();
+  struct memory_subsystem_stats indexes =
+      during.subsystems[MEMORY_SUBSYSTEM_RECOVERY_INDEXES];
+  TEST_ASSERT_EQUAL_UINT64(before.used + table.mapped_len, during.used);
+  TEST_ASSERT_EQUAL_UINT64(table.mapped_len, indexes.used);
+  TEST_ASSERT_TRUE(indexes.peak >= table.mapped_len);
+
+  table_memory_free(&table);
+  struct memory_budget_stats after = besu_native_ec_memory_budget_stats();
+  TEST_ASSERT_EQUAL_UINT64(before.used, after.used);
+  TEST_ASSERT_EQUAL_UINT64(
+      0, after.subsystems[MEMORY_SUBSYSTEM_RECOVERY_INDEXES].used);
+}
+
+void memory_budget_should_reject_invalid_configuration(void) {
+  char error_message[256] = {0};
+
+  TEST_ASSERT_EQUAL_INT(FAILURE,
+                        besu_native_ec_memory_set_budget(error_message, -1));
+  TEST_ASSERT_EQUAL_STRING("Memory budget must not be negative\n",
+                           error_message);
+  TEST_ASSERT_EQUAL_INT(FAILURE, besu_native_ec_memory_set_quota(
+                                     error_message, MEMORY_SUBSYSTEM_COUNT,
+                                     0));
+  TEST_ASSERT_EQUAL_STRING("Unknown memory subsystem 4\n", error_message);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(memory_budget_should_evict_key_cache_under_pressure);
+  RUN_TEST(memory_budget_should_reject_tables_that_do_not_fit);
+  RUN_TEST(memory_budget_should_enforce_quotas);
+  RUN_TEST(memory_budget_stats_should_report_used_memory_by_subsystem);
+  RUN_TEST(memory_budget_should_reject_invalid_configuration);
+
+  return UNITY_END();
+}
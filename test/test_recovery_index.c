@@ -0,0 +1,326 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mkstemp is not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "openssl/include/openssl/evp.h"
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "corpus.h"
+#include "epoch.h"
+#include "recovery_index.h"
+
+#define VECTOR_COUNT 3
+
+struct recovery_input {
+  char data_hash[32];
+  char signature_r[32];
+  char signature_s[32];
+  int signature_v;
+  char public_key[64];
+};
+
+static struct recovery_input inputs[VECTOR_COUNT];
+static char index_path[] = "/tmp/besu_native_ec_recovery_index_XXXXXX";
+
+static struct p256_recovery_index *open_index(long long capacity) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, p256_recovery_index_open(
+                                     &index, error_message, index_path,
+                                     capacity));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  return index;
+}
+
+static void recover_all(struct p256_recovery_index *index, int count) {
+  for (int i = 0; i < count; i++) {
+    struct key_recovery_result result = p256_key_recovery_indexed(
+        index, inputs[i].data_hash, 32, inputs[i].signature_r,
+        inputs[i].signature_s, inputs[i].signature_v);
+
+    TEST_ASSERT_EQUAL_STRING("", result.error_message);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(inputs[i].public_key, result.public_key, 64);
+  }
+}
+
+void p256_key_recovery_indexed_should_only_recover_missing_keys(void) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = open_index(16);
+
+  recover_all(index, VECTOR_COUNT);
+
+  struct recovery_index_stats stats = p256_recovery_index_stats(index);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.hits);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT, stats.misses);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT, stats.pending);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.records);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_recovery_index_flush(index, error_message));
+  recover_all(index, VECTOR_COUNT);
+
+  stats = p256_recovery_index_stats(index);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT, stats.hits);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT, stats.records);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.pending);
+
+  // the same signature with v = 27 selects the same key
+  struct key_recovery_result result = p256_key_recovery_indexed(
+      index, inputs[0].data_hash, 32, inputs[0].signature_r,
+      inputs[0].signature_s, inputs[0].signature_v + 27);
+  TEST_ASSERT_EQUAL_CHAR_ARRAY(inputs[0].public_key, result.public_key, 64);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT + 1,
+                           p256_recovery_index_stats(index).hits);
+
+  p256_recovery_index_close(index);
+}
+
+void p256_recovery_index_open_should_restore_records_of_closed_index(void) {
+  struct p256_recovery_index *index = open_index(16);
+
+  recover_all(index, VECTOR_COUNT);
+  // closing the index writes the pending records
+  p256_recovery_index_close(index);
+
+  index = open_index(16);
+  recover_all(index, VECTOR_COUNT);
+
+  struct recovery_index_stats stats = p256_recovery_index_stats(index);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT, stats.hits);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.misses);
+
+  p256_recovery_index_close(index);
+}
+
+void p256_recovery_index_compact_should_grow_full_index(void) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = open_index(2);
+
+  recover_all(index, VECTOR_COUNT);
+  TEST_ASSERT_EQUAL_UINT64(1, p256_recovery_index_stats(index).dropped);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_recovery_index_compact(index, error_message, 8));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  struct recovery_index_stats stats = p256_recovery_index_stats(index);
+  TEST_ASSERT_EQUAL_UINT64(2, stats.records);
+  TEST_ASSERT_EQUAL_UINT64(8, stats.capacity);
+
+  recover_all(index, VECTOR_COUNT);
+  TEST_ASSERT_EQUAL_UINT64(2, p256_recovery_index_stats(index).hits);
+
+  // the index must not be compacted below the number of its records
+  TEST_ASSERT_EQUAL_INT(FAILURE,
+                        p256_recovery_index_compact(index, error_message, 2));
+
+  p256_recovery_index_close(index);
+}
+
+void p256_recovery_index_compact_should_not_unmap_file_under_lookups(void) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = open_index(16);
+
+  recover_all(index, VECTOR_COUNT);
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_recovery_index_flush(index, error_message));
+
+  // a lookup that still reads the file while it is compacted
+  TEST_ASSERT_EQUAL_INT(SUCCESS, epoch_enter(error_message));
+  struct recovery_index_file *file = atomic_load(&index->file);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_recovery_index_compact(index, error_message, 32));
+  TEST_ASSERT_TRUE(atomic_load(&index->file) != file);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT, file->header->record_count);
+  TEST_ASSERT_EQUAL_UINT64(1, epoch_reclaim());
+
+  epoch_exit();
+  TEST_ASSERT_EQUAL_UINT64(0, epoch_reclaim());
+
+  p256_recovery_index_close(index);
+}
+
+static void assert_space_reserved(void) {
+  struct stat file_stat;
+
+  TEST_ASSERT_EQUAL_INT(0, stat(index_path, &file_stat));
+  TEST_ASSERT_TRUE((long long)file_stat.st_blocks * 512 >=
+                   (long long)file_stat.st_size);
+}
+
+// records are written through the mapping, which can't report a full disk
+void p256_recovery_index_should_reserve_space_of_all_records(void) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = open_index(4096);
+
+  assert_space_reserved();
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, p256_recovery_index_compact(index, error_message, 8192));
+  assert_space_reserved();
+
+  p256_recovery_index_close(index);
+}
+
+void recovery_index_add_should_drop_keys_while_batch_cannot_be_written(void) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = open_index(1024);
+  unsigned char digest[RECOVERY_INDEX_DIGEST_LEN] = {0};
+  char public_key[64] = {0};
+
+  // writing to a read-only descriptor fails like a full disk
+  int fd = atomic_load(&index->file)->fd;
+  int index_fd = dup(fd);
+  int read_only_fd = open(index_path, O_RDONLY);
+  TEST_ASSERT_TRUE(index_fd >= 0 && read_only_fd >= 0);
+  TEST_ASSERT_TRUE(dup2(read_only_fd, fd) >= 0);
+
+  for (int i = 0; i < RECOVERY_INDEX_BATCH_SIZE + 8; i++) {
+    memcpy(digest, &i, sizeof(i));
+    recovery_index_add(index, digest, public_key);
+  }
+
+  struct recovery_index_stats stats = p256_recovery_index_stats(index);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.records);
+  TEST_ASSERT_EQUAL_UINT64(RECOVERY_INDEX_BATCH_SIZE, stats.pending);
+  TEST_ASSERT_EQUAL_UINT64(8, stats.dropped);
+  TEST_ASSERT_EQUAL_INT(FAILURE,
+                        p256_recovery_index_flush(index, error_message));
+
+  // the pending batch is written once the file can be written again
+  TEST_ASSERT_TRUE(dup2(index_fd, fd) >= 0);
+  close(index_fd);
+  close(read_only_fd);
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        p256_recovery_index_flush(index, error_message));
+
+  stats = p256_recovery_index_stats(index);
+  TEST_ASSERT_EQUAL_UINT64(RECOVERY_INDEX_BATCH_SIZE, stats.records);
+  TEST_ASSERT_EQUAL_UINT64(0, stats.pending);
+
+  p256_recovery_index_close(index);
+}
+
+void p256_recovery_index_open_should_drop_corrupted_records(void) {
+  struct p256_recovery_index *index = open_index(4);
+
+  recover_all(index, VECTOR_COUNT);
+  p256_recovery_index_close(index);
+
+  // the header takes 64 bytes and every record 104 bytes, flip one bit of the
+  // public key of the last record
+  FILE *file = fopen(index_path, "r+b");
+  TEST_ASSERT_NOT_NULL(file);
+  long offset = 64 + (VECTOR_COUNT - 1) * 104 + 40;
+  fseek(file, offset, SEEK_SET);
+  int byte = fgetc(file);
+  fseek(file, offset, SEEK_SET);
+  fputc(byte ^ 0x01, file);
+  fclose(file);
+
+  index = open_index(4);
+  TEST_ASSERT_EQUAL_UINT64(VECTOR_COUNT - 1,
+                           p256_recovery_index_stats(index).records);
+
+  // the corrupted record is recovered again instead of being returned
+  recover_all(index, VECTOR_COUNT);
+  TEST_ASSERT_EQUAL_UINT64(1, p256_recovery_index_stats(index).misses);
+
+  p256_recovery_index_close(index);
+}
+
+void p256_recovery_index_open_should_reject_other_files(void) {
+  char error_message[256] = {0};
+  struct p256_recovery_index *index = NULL;
+
+  FILE *file = fopen(index_path, "wb");
+  TEST_ASSERT_NOT_NULL(file);
+  fputs("not an index, but long enough to contain a header of an index file",
+        file);
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_INT(FAILURE, p256_recovery_index_open(
+                                     &index, error_message, index_path, 4));
+  TEST_ASSERT_EQUAL_STRING("File is not a recovery index\n", error_message);
+}
+
+// copies the first SHA-256 signatures of SigGen.rsp
+static int copy_inputs(const struct corpus_case *test_case, void *context) {
+  int *input_count = context;
+  struct recovery_input *input = &inputs[*input_count];
+
+  if (!EVP_MD_is_a(test_case->md, "SHA2-256")) {
+    return 1;
+  }
+  EVP_Digest(test_case->message, test_case->message_len,
+             (unsigned char *)input->data_hash, NULL, test_case->md, NULL);
+  memcpy(input->signature_r, test_case->signature_r, 32);
+  memcpy(input->signature_s, test_case->signature_s, 32);
+  memcpy(input->public_key, test_case->public_key, 64);
+  input->signature_v = corpus_recovery_id(test_case);
+  return ++*input_count < VECTOR_COUNT;
+}
+
+int main(void) {
+  int input_count = 0;
+
+  if (corpus_load("test/vectors/SigGen.rsp", copy_inputs, &input_count) < 0 ||
+      input_count != VECTOR_COUNT) {
+    // reported like a failed test, so that check_failing_test.sh finds it
+    puts("FAIL: could not load test/vectors/SigGen.rsp");
+    return 1;
+  }
+
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_key_recovery_indexed_should_only_recover_missing_keys);
+  RUN_TEST(p256_recovery_index_open_should_restore_records_of_closed_index);
+  RUN_TEST(p256_recovery_index_compact_should_grow_full_index);
+  RUN_TEST(p256_recovery_index_compact_should_not_unmap_file_under_lookups);
+  RUN_TEST(p256_recovery_index_should_reserve_space_of_all_records);
+  RUN_TEST(recovery_index_add_should_drop_keys_while_batch_cannot_be_written);
+  RUN_TEST(p256_recovery_index_open_should_drop_corrupted_records);
+  RUN_TEST(p256_recovery_index_open_should_reject_other_files);
+
+  return UNITY_END();
+}
+
+void setUp(void) {
+  // every test starts with a new index
+  int fd = mkstemp(index_path);
+  close(fd);
+  unlink(index_path);
+}
+
+void tearDown(void) {
+  unlink(index_path);
+  memcpy(index_path + strlen(index_path) - 6, "XXXXXX", 6);
+}
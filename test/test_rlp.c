@@ -0,0 +1,151 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "constants.h"
+#include "rlp.h"
+#include "utils.h"
+
+static int decode_hex(struct rlp_item *item, unsigned char **data,
+                      const char *hex) {
+  *data = hex_to_bin(hex);
+  return rlp_decode_item(item, *data, strlen(hex) / 2);
+}
+
+void rlp_decode_item_should_decode_strings_and_lists(void) {
+  struct rlp_item item;
+  unsigned char *data = NULL;
+
+  // a single byte
+  TEST_ASSERT_EQUAL_INT(SUCCESS, decode_hex(&item, &data, "7f"));
+  TEST_ASSERT_EQUAL_size_t(1, item.encoding_len);
+  TEST_ASSERT_EQUAL_size_t(1, item.payload_len);
+  TEST_ASSERT_EQUAL_HEX8(0x7f, item.payload[0]);
+  free(data);
+
+  // "dog"
+  TEST_ASSERT_EQUAL_INT(SUCCESS, decode_hex(&item, &data, "83646f67"));
+  TEST_ASSERT_FALSE(item.is_list);
+  TEST_ASSERT_EQUAL_size_t(3, item.payload_len);
+  TEST_ASSERT_EQUAL_MEMORY("dog", item.payload, 3);
+  free(data);
+
+  // ["cat", "dog"], followed by data that is not part of the item
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        decode_hex(&item, &data, "c88363617483646f67ff"));
+  TEST_ASSERT_TRUE(item.is_list);
+  TEST_ASSERT_EQUAL_size_t(9, item.encoding_len);
+
+  struct rlp_item element;
+  const unsigned char *cursor = item.payload;
+  const unsigned char *end = item.payload + item.payload_len;
+  TEST_ASSERT_EQUAL_INT(SUCCESS, rlp_next_item(&element, &cursor, end));
+  TEST_ASSERT_EQUAL_MEMORY("cat", element.payload, 3);
+  TEST_ASSERT_EQUAL_INT(SUCCESS, rlp_next_item(&element, &cursor, end));
+  TEST_ASSERT_EQUAL_MEMORY("dog", element.payload, 3);
+  TEST_ASSERT_EQUAL_INT(FAILURE, rlp_next_item(&element, &cursor, end));
+  free(data);
+}
+
+void rlp_decode_item_should_decode_long_strings(void) {
+  char hex[2 * 58 + 1] = "b838";
+  for (int i = 0; i < 56; i++) {
+    memcpy(hex + 4 + 2 * i, "61", 3);
+  }
+  struct rlp_item item;
+  unsigned char *data = NULL;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, decode_hex(&item, &data, hex));
+  TEST_ASSERT_EQUAL_size_t(56, item.payload_len);
+  TEST_ASSERT_EQUAL_size_t(58, item.encoding_len);
+  free(data);
+
+  // the same string with a truncated payload
+  hex[strlen(hex) - 2] = '\0';
+  TEST_ASSERT_EQUAL_INT(FAILURE, decode_hex(&item, &data, hex));
+  free(data);
+}
+
+void rlp_decode_item_should_reject_non_canonical_encodings(void) {
+  struct rlp_item item;
+  unsigned char *data = NULL;
+
+  // a single byte below 0x80 with a header
+  TEST_ASSERT_EQUAL_INT(FAILURE, decode_hex(&item, &data, "8105"));
+  free(data);
+
+  // a short string in the long form
+  TEST_ASSERT_EQUAL_INT(FAILURE, decode_hex(&item, &data, "b803646f67"));
+  free(data);
+
+  // a length with a leading zero
+  TEST_ASSERT_EQUAL_INT(FAILURE, decode_hex(&item, &data, "b90003646f67"));
+  free(data);
+}
+
+void rlp_item_to_uint64_should_reject_leading_zeros(void) {
+  struct rlp_item item;
+  unsigned char *data = NULL;
+  uint64_t value = 0;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, decode_hex(&item, &data, "820400"));
+  TEST_ASSERT_EQUAL_INT(SUCCESS, rlp_item_to_uint64(&value, &item));
+  TEST_ASSERT_EQUAL_UINT64(1024, value);
+  free(data);
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS, decode_hex(&item, &data, "820004"));
+  TEST_ASSERT_EQUAL_INT(FAILURE, rlp_item_to_uint64(&value, &item));
+  free(data);
+}
+
+void rlp_encode_should_create_canonical_encodings(void) {
+  unsigned char encoding[9];
+
+  TEST_ASSERT_EQUAL_size_t(1, rlp_encode_uint64(encoding, 0));
+  TEST_ASSERT_EQUAL_HEX8(0x80, encoding[0]);
+  TEST_ASSERT_EQUAL_size_t(1, rlp_encode_uint64(encoding, 0x7f));
+  TEST_ASSERT_EQUAL_HEX8(0x7f, encoding[0]);
+  TEST_ASSERT_EQUAL_size_t(3, rlp_encode_uint64(encoding, 1337));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(((unsigned char[]){0x82, 0x05, 0x39}),
+                               encoding, 3);
+
+  TEST_ASSERT_EQUAL_size_t(1, rlp_list_header(encoding, 55));
+  TEST_ASSERT_EQUAL_HEX8(0xf7, encoding[0]);
+  TEST_ASSERT_EQUAL_size_t(3, rlp_list_header(encoding, 1024));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(((unsigned char[]){0xf9, 0x04, 0x00}),
+                               encoding, 3);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(rlp_decode_item_should_decode_strings_and_lists);
+  RUN_TEST(rlp_decode_item_should_decode_long_strings);
+  RUN_TEST(rlp_decode_item_should_reject_non_canonical_encodings);
+  RUN_TEST(rlp_item_to_uint64_should_reject_leading_zeros);
+  RUN_TEST(rlp_encode_should_create_canonical_encodings);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
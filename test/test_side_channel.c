@@ -0,0 +1,239 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/obj_mac.h"
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "side_channel.h"
+#include "thread_context.h"
+#include "utils.h"
+
+// key and signature of SigGen.txt from the CAVP test vectors
+static const char *private_key =
+    "519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464";
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+static unsigned long long calls(enum ec_operation operation,
+                                enum side_channel_kernel kernel) {
+  return side_channel_kernel_calls(operation, kernel);
+}
+
+void side_channel_kernel_of_should_only_allow_variable_time_for_public_data(
+    void) {
+  TEST_ASSERT_EQUAL_INT(SIDE_CHANNEL_CONSTANT_TIME,
+                        side_channel_kernel_of(EC_OPERATION_ECDH));
+  TEST_ASSERT_EQUAL_INT(SIDE_CHANNEL_CONSTANT_TIME,
+                        side_channel_kernel_of(EC_OPERATION_KEY_GENERATION));
+  TEST_ASSERT_EQUAL_INT(SIDE_CHANNEL_VARIABLE_TIME,
+                        side_channel_kernel_of(EC_OPERATION_VERIFY));
+  TEST_ASSERT_EQUAL_INT(SIDE_CHANNEL_VARIABLE_TIME,
+                        side_channel_kernel_of(EC_OPERATION_KEY_RECOVERY));
+}
+
+// the constant time kernel computes sums with two single multiplications, the
+// variable time kernel with the double multiplication of OpenSSL
+void constant_and_variable_time_kernels_should_compute_same_multiples(void) {
+  char error_message[256] = {0};
+  const EC_GROUP *group = thread_group(error_message, NID_X9_62_prime256v1);
+  BN_CTX *bn_context = thread_bn_context(error_message);
+  const BIGNUM *n = EC_GROUP_get0_order(group);
+  BIGNUM *k = BN_new(), *g_scalar = BN_new(), *p_scalar = BN_new(),
+         *secret_g_scalar = BN_new(), *secret_p_scalar = BN_new(),
+         *sum = BN_new();
+  EC_POINT *point = EC_POINT_new(group), *expected = EC_POINT_new(group),
+           *variable_time = EC_POINT_new(group),
+           *constant_time = EC_POINT_new(group);
+
+  for (int i = 0; i < 16; i++) {
+    // point = k * G, so that g_scalar * G + p_scalar * point is
+    // (g_scalar + p_scalar * k) * G
+    TEST_ASSERT_EQUAL_INT(1, BN_rand_range(k, n));
+    TEST_ASSERT_EQUAL_INT(1, BN_rand_range(g_scalar, n));
+    TEST_ASSERT_EQUAL_INT(1, BN_rand_range(p_scalar, n));
+    TEST_ASSERT_EQUAL_INT(1, EC_POINT_mul(group, point, k, NULL, NULL,
+                                          bn_context));
+    TEST_ASSERT_EQUAL_INT(1, BN_mod_mul(sum, p_scalar, k, n, bn_context));
+    TEST_ASSERT_EQUAL_INT(1, BN_mod_add(sum, sum, g_scalar, n, bn_context));
+    TEST_ASSERT_EQUAL_INT(1, EC_POINT_mul(group, expected, sum, NULL, NULL,
+                                          bn_context));
+    BN_copy(secret_g_scalar, g_scalar);
+    BN_copy(secret_p_scalar, p_scalar);
+    side_channel_mark_secret(secret_g_scalar);
+    side_channel_mark_secret(secret_p_scalar);
+
+    TEST_ASSERT_EQUAL_INT(
+        1, side_channel_point_mul(variable_time, error_message,
+                                  EC_OPERATION_VERIFY, group, g_scalar, point,
+                                  p_scalar, bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        1, side_channel_point_mul(constant_time, error_message,
+                                  EC_OPERATION_ECDH, group, secret_g_scalar,
+                                  point, secret_p_scalar, bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        0, EC_POINT_cmp(group, variable_time, expected, bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        0, EC_POINT_cmp(group, constant_time, expected, bn_context));
+
+    // a multiple of the point only
+    TEST_ASSERT_EQUAL_INT(1, BN_mod_mul(sum, p_scalar, k, n, bn_context));
+    TEST_ASSERT_EQUAL_INT(1, EC_POINT_mul(group, expected, sum, NULL, NULL,
+                                          bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        1, side_channel_point_mul(variable_time, error_message,
+                                  EC_OPERATION_KEY_RECOVERY, group, NULL,
+                                  point, p_scalar, bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        1, side_channel_point_mul(constant_time, error_message,
+                                  EC_OPERATION_ECDH, group, NULL, point,
+                                  secret_p_scalar, bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        0, EC_POINT_cmp(group, variable_time, expected, bn_context));
+    TEST_ASSERT_EQUAL_INT(
+        0, EC_POINT_cmp(group, constant_time, expected, bn_context));
+  }
+
+  BN_free(k);
+  BN_free(g_scalar);
+  BN_free(p_scalar);
+  BN_clear_free(secret_g_scalar);
+  BN_clear_free(secret_p_scalar);
+  BN_free(sum);
+  EC_POINT_free(point);
+  EC_POINT_free(expected);
+  EC_POINT_free(variable_time);
+  EC_POINT_free(constant_time);
+}
+
+void operations_with_private_keys_should_use_constant_time_kernel(void) {
+  unsigned char *private_key_data = hex_to_bin(private_key);
+  unsigned char *public_key_data = hex_to_bin(public_key);
+
+  unsigned long long key_generation =
+      calls(EC_OPERATION_KEY_GENERATION, SIDE_CHANNEL_CONSTANT_TIME);
+  unsigned long long ecdh =
+      calls(EC_OPERATION_ECDH, SIDE_CHANNEL_CONSTANT_TIME);
+
+  // the constant time kernel rejects scalars that are not marked as secret,
+  // the operations only succeed if they mark the private key
+  struct public_key_result derived =
+      p256_derive_public_key((const char *)private_key_data);
+  TEST_ASSERT_EQUAL_STRING("", derived.error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(public_key_data, derived.public_key, 64);
+  TEST_ASSERT_EQUAL_UINT64(
+      key_generation + 1,
+      calls(EC_OPERATION_KEY_GENERATION, SIDE_CHANNEL_CONSTANT_TIME));
+
+  struct ecdh_result shared_secret = p256_ecdh(
+      (const char *)private_key_data, (const char *)public_key_data);
+  TEST_ASSERT_EQUAL_STRING("", shared_secret.error_message);
+  TEST_ASSERT_EQUAL_UINT64(
+      ecdh + 1, calls(EC_OPERATION_ECDH, SIDE_CHANNEL_CONSTANT_TIME));
+
+  TEST_ASSERT_EQUAL_UINT64(
+      0, calls(EC_OPERATION_KEY_GENERATION, SIDE_CHANNEL_VARIABLE_TIME));
+  TEST_ASSERT_EQUAL_UINT64(
+      0, calls(EC_OPERATION_ECDH, SIDE_CHANNEL_VARIABLE_TIME));
+
+  free(private_key_data);
+  free(public_key_data);
+}
+
+void key_recovery_should_compute_q_with_one_variable_time_multiplication(
+    void) {
+  unsigned char *private_key_data = hex_to_bin(private_key);
+  unsigned char *public_key_data = hex_to_bin(public_key);
+  char data_hash[32] = {1, 2, 3};
+
+  struct sign_result signature =
+      p256_sign(data_hash, sizeof(data_hash), (const char *)private_key_data,
+                (const char *)public_key_data);
+  TEST_ASSERT_EQUAL_STRING("", signature.error_message);
+
+  unsigned long long variable_time =
+      calls(EC_OPERATION_KEY_RECOVERY, SIDE_CHANNEL_VARIABLE_TIME);
+  struct key_recovery_result recovered =
+      p256_key_recovery(data_hash, sizeof(data_hash), signature.signature_r,
+                        signature.signature_s, signature.signature_v);
+  TEST_ASSERT_EQUAL_STRING("", recovered.error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(public_key_data, recovered.public_key, 64);
+
+  // P-256 has cofactor 1, so that there is no nR check, only u1 * G + u2 * R
+  TEST_ASSERT_EQUAL_UINT64(
+      variable_time + 1,
+      calls(EC_OPERATION_KEY_RECOVERY, SIDE_CHANNEL_VARIABLE_TIME));
+  TEST_ASSERT_EQUAL_UINT64(
+      0, calls(EC_OPERATION_KEY_RECOVERY, SIDE_CHANNEL_CONSTANT_TIME));
+
+  free(private_key_data);
+  free(public_key_data);
+}
+
+void side_channel_point_mul_should_enforce_marking_of_secrets(void) {
+  char error_message[256] = {0};
+  const EC_GROUP *group = thread_group(error_message, NID_X9_62_prime256v1);
+  BN_CTX *bn_context = thread_bn_context(error_message);
+  EC_POINT *point = EC_POINT_new(group);
+  BIGNUM *scalar = BN_new();
+  BN_set_word(scalar, 7);
+
+  TEST_ASSERT_EQUAL_INT(
+      0, side_channel_point_mul(point, error_message, EC_OPERATION_ECDH, group,
+                                scalar, NULL, NULL, bn_context));
+  TEST_ASSERT_EQUAL_STRING("Scalars of constant time multiplications must be "
+                           "marked as secret\n",
+                           error_message);
+  TEST_ASSERT_EQUAL_INT(1, side_channel_point_mul(
+                               point, error_message, EC_OPERATION_KEY_RECOVERY,
+                               group, scalar, NULL, NULL, bn_context));
+
+  side_channel_mark_secret(scalar);
+  TEST_ASSERT_EQUAL_INT(0, side_channel_point_mul(
+                               point, error_message, EC_OPERATION_KEY_RECOVERY,
+                               group, scalar, NULL, NULL, bn_context));
+  TEST_ASSERT_EQUAL_STRING("Secret scalars must not be used in variable time "
+                           "multiplications\n",
+                           error_message);
+  TEST_ASSERT_EQUAL_INT(
+      1, side_channel_point_mul(point, error_message, EC_OPERATION_ECDH, group,
+                                scalar, NULL, NULL, bn_context));
+
+  BN_free(scalar);
+  EC_POINT_free(point);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(
+      side_channel_kernel_of_should_only_allow_variable_time_for_public_data);
+  RUN_TEST(constant_and_variable_time_kernels_should_compute_same_multiples);
+  RUN_TEST(operations_with_private_keys_should_use_constant_time_kernel);
+  RUN_TEST(key_recovery_should_compute_q_with_one_variable_time_multiplication);
+  RUN_TEST(side_channel_point_mul_should_enforce_marking_of_secrets);
+
+  return UNITY_END();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "table_memory.h"
+
+static unsigned long long backing_bytes(struct table_memory_stats stats,
+                                        enum table_memory_backing backing) {
+  switch (backing) {
+  case TABLE_MEMORY_HUGETLB:
+    return stats.huge_page_bytes;
+  case TABLE_MEMORY_TRANSPARENT_HUGE_PAGES:
+    return stats.transparent_huge_page_bytes;
+  default:
+    return stats.regular_page_bytes;
+  }
+}
+
+void table_memory_alloc_should_use_regular_pages_for_small_tables(void) {
+  char error_message[256] = {0};
+  struct table_memory table;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        table_memory_alloc(&table, error_message,
+                                           MEMORY_SUBSYSTEM_KEY_TABLES, 1000));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+  TEST_ASSERT_NOT_NULL(table.data);
+  TEST_ASSERT_EQUAL_INT(TABLE_MEMORY_REGULAR_PAGES, table.backing);
+  TEST_ASSERT_TRUE(table.mapped_len >= 1000);
+
+  table_memory_free(&table);
+}
+
+void table_memory_alloc_should_align_large_tables_to_huge_pages(void) {
+  char error_message[256] = {0};
+  struct table_memory table;
+  size_t size = 3 * TABLE_MEMORY_HUGE_PAGE_SIZE + 1;
+
+  TEST_ASSERT_EQUAL_INT(SUCCESS,
+                        table_memory_alloc(&table, error_message,
+                                           MEMORY_SUBSYSTEM_KEY_TABLES, size));
+  TEST_ASSERT_NOT_NULL(table.data);
+  TEST_ASSERT_EQUAL_UINT64(4 * TABLE_MEMORY_HUGE_PAGE_SIZE, table.mapped_len);
+
+  if (table.backing != TABLE_MEMORY_REGULAR_PAGES) {
+    TEST_ASSERT_EQUAL_UINT64(
+        0, (uintptr_t)table.data % TABLE_MEMORY_HUGE_PAGE_SIZE);
+  }
+
+  // the memory must be zeroed and writable over its full length
+  unsigned char *data = table.data;
+  TEST_ASSERT_EQUAL_UINT8(0, data[0]);
+  TEST_ASSERT_EQUAL_UINT8(0, data[size - 1]);
+  memset(data, 0xab, size);
+
+  table_memory_free(&table);
+  TEST_ASSERT_NULL(table.data);
+}
+
+void table_memory_stats_should_report_allocated_tables(void) {
+  char error_message[256] = {0};
+  struct table_memory table;
+  struct table_memory_stats before = besu_native_ec_table_memory_stats();
+
+  TEST_ASSERT_EQUAL_INT(
+      SUCCESS, table_memory_alloc(&table, error_message,
+                                  MEMORY_SUBSYSTEM_KEY_TABLES,
+                                  2 * TABLE_MEMORY_HUGE_PAGE_SIZE));
+
+  struct table_memory_stats during = besu_native_ec_table_memory_stats();
+  TEST_ASSERT_EQUAL_UINT64(before.tables + 1, during.tables);
+  TEST_ASSERT_EQUAL_UINT64(backing_bytes(before, table.backing) +
+                               table.mapped_len,
+                           backing_bytes(during, table.backing));
+
+  table_memory_free(&table);
+
+  struct table_memory_stats after = besu_native_ec_table_memory_stats();
+  TEST_ASSERT_EQUAL_UINT64(before.tables, after.tables);
+  TEST_ASSERT_EQUAL_UINT64(before.huge_page_bytes, after.huge_page_bytes);
+  TEST_ASSERT_EQUAL_UINT64(before.transparent_huge_page_bytes,
+                           after.transparent_huge_page_bytes);
+  TEST_ASSERT_EQUAL_UINT64(before.regular_page_bytes,
+                           after.regular_page_bytes);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(table_memory_alloc_should_use_regular_pages_for_small_tables);
+  RUN_TEST(table_memory_alloc_should_align_large_tables_to_huge_pages);
+  RUN_TEST(table_memory_stats_should_report_allocated_tables);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
@@ -0,0 +1,153 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openssl/include/openssl/obj_mac.h"
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "ec_key.h"
+#include "thread_context.h"
+#include "utils.h"
+
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+static EVP_PKEY *import_public_key(void) {
+  char error_message[256] = {0};
+  EVP_PKEY *key = NULL;
+  unsigned char *public_key_data = hex_to_bin(public_key);
+
+  create_public_key(&key, error_message, public_key_data, 64, "prime256v1");
+  free(public_key_data);
+  return key;
+}
+
+void thread_context_should_reuse_objects_of_thread(void) {
+  char error_message[256] = {0};
+
+  BN_CTX *bn_context = thread_bn_context(error_message);
+  const EC_GROUP *group = thread_group(error_message, NID_X9_62_prime256v1);
+  TEST_ASSERT_NOT_NULL(bn_context);
+  TEST_ASSERT_NOT_NULL(group);
+
+  TEST_ASSERT_EQUAL_PTR(bn_context, thread_bn_context(error_message));
+  TEST_ASSERT_EQUAL_PTR(group,
+                        thread_group(error_message, NID_X9_62_prime256v1));
+
+  const EC_GROUP *other_group = thread_group(error_message, NID_secp384r1);
+  TEST_ASSERT_NOT_NULL(other_group);
+  TEST_ASSERT_TRUE(group != other_group);
+  TEST_ASSERT_EQUAL_INT(NID_secp384r1, EC_GROUP_get_curve_name(other_group));
+}
+
+void thread_verify_context_should_be_reused_for_same_key(void) {
+  char error_message[256] = {0};
+  EVP_PKEY *key = import_public_key();
+  EVP_PKEY *other_key = import_public_key();
+
+  EVP_PKEY_CTX *verify_context = thread_verify_context(error_message, key);
+  TEST_ASSERT_NOT_NULL(verify_context);
+  TEST_ASSERT_EQUAL_PTR(verify_context,
+                        thread_verify_context(error_message, key));
+  TEST_ASSERT_TRUE(verify_context !=
+                   thread_verify_context(error_message, other_key));
+
+  // the context keeps the key alive
+  EVP_PKEY_free(key);
+  EVP_PKEY_free(other_key);
+
+  besu_native_ec_release_thread_context();
+}
+
+void thread_verify_point_should_be_decoded_once_per_key(void) {
+  char error_message[256] = {0};
+  EVP_PKEY *key = import_public_key();
+  const EC_GROUP *group = NULL;
+  unsigned char expected[65] = {POINT_CONVERSION_UNCOMPRESSED};
+  unsigned char octet[65];
+
+  const EC_POINT *point = thread_verify_point(error_message, key, &group);
+  TEST_ASSERT_NOT_NULL(point);
+  TEST_ASSERT_EQUAL_PTR(thread_group(error_message, NID_X9_62_prime256v1),
+                        group);
+  TEST_ASSERT_EQUAL_PTR(point, thread_verify_point(error_message, key, &group));
+
+  unsigned char *public_key_data = hex_to_bin(public_key);
+  memcpy(expected + 1, public_key_data, 64);
+  TEST_ASSERT_EQUAL_size_t(
+      sizeof(octet),
+      EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED, octet,
+                         sizeof(octet), thread_bn_context(error_message)));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, octet, sizeof(octet));
+
+  // the point shares the slot of the verify context and is freed with it
+  TEST_ASSERT_NOT_NULL(thread_verify_context(error_message, key));
+  thread_verify_context_discard(key);
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  free(public_key_data);
+  EVP_PKEY_free(key);
+}
+
+static void *use_thread_context(void *result) {
+  char error_message[256] = {0};
+  EVP_PKEY *key = import_public_key();
+
+  *(int *)result = thread_bn_context(error_message) != NULL &&
+                   thread_group(error_message, NID_X9_62_prime256v1) != NULL &&
+                   thread_verify_context(error_message, key) != NULL;
+
+  EVP_PKEY_free(key);
+  return NULL;
+}
+
+// the leak check of the sanitizer builds fails if the contexts are not freed
+// when the thread exits
+void thread_context_should_be_separate_for_each_thread(void) {
+  char error_message[256] = {0};
+  int result = 0;
+  pthread_t thread;
+  BN_CTX *bn_context = thread_bn_context(error_message);
+
+  TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, use_thread_context,
+                                          &result));
+  pthread_join(thread, NULL);
+
+  TEST_ASSERT_EQUAL_INT(1, result);
+  TEST_ASSERT_EQUAL_PTR(bn_context, thread_bn_context(error_message));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(thread_context_should_reuse_objects_of_thread);
+  RUN_TEST(thread_verify_context_should_be_reused_for_same_key);
+  RUN_TEST(thread_verify_point_should_be_decoded_once_per_key);
+  RUN_TEST(thread_context_should_be_separate_for_each_thread);
+
+  return UNITY_END();
+}
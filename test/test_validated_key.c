@@ -0,0 +1,225 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "besu_native_ec.h"
+#include "utils.h"
+
+// key of SigGen.txt from the CAVP test vectors
+static const char *private_key =
+    "519b423d715f8b581f4fa8ee59f4771a5b44c8130b4e3eacca54a56dda72b464";
+static const char *public_key =
+    "1ccbe91c075fc7f4f033bfa248db8fccd3565de94bbfb12f3c59ff46c271bf83"
+    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5ca89a4ca9";
+
+// COUNT = 0 of the P-256 section of KAS_ECC_CDH_PrimitiveTest.txt from the
+// CAVP test vectors
+static const char *ecdh_private_key =
+    "7d7dc5f71eb29ddaf80d6214632eeae03d9058af1fb6d22ed80badb62bc1a534";
+static const char *ecdh_peer_public_key =
+    "700c48f77f56584c5cc632ca65640db91b6bacce3a4df6b42ce7cc838833d287"
+    "db71e509e3fd9b060ddb20ba5c51dcc5948d46fbf640dfe0441782cab85fa4ac";
+static const char *ecdh_shared_secret =
+    "46fc62106420ff012e54a434fbdd2d25ccc5852060561e68040dd7778997bd7b";
+
+static char data_hash[32];
+
+static int create_hex(struct p256_validated_key **key, char *error_message,
+                      const char *public_key_hex) {
+  unsigned char *public_key_data = hex_to_bin(public_key_hex);
+  int ret = p256_validated_key_create(key, error_message,
+                                      (const char *)public_key_data);
+  free(public_key_data);
+  return ret;
+}
+
+static struct sign_result sign_data_hash(void) {
+  unsigned char *private_key_data = hex_to_bin(private_key);
+  unsigned char *public_key_data = hex_to_bin(public_key);
+
+  struct sign_result signature =
+      p256_sign(data_hash, sizeof(data_hash), (const char *)private_key_data,
+                (const char *)public_key_data);
+
+  free(private_key_data);
+  free(public_key_data);
+  return signature;
+}
+
+void p256_validated_key_verify_should_verify_signatures(void) {
+  char error_message[256] = {0};
+  struct p256_validated_key *key = NULL;
+  struct sign_result signature = sign_data_hash();
+  char other_data_hash[32] = {0};
+
+  TEST_ASSERT_EQUAL_INT(1, create_hex(&key, error_message, public_key));
+  TEST_ASSERT_EQUAL_STRING("", error_message);
+
+  struct verify_result result =
+      p256_validated_key_verify(key, data_hash, sizeof(data_hash),
+                                signature.signature_r, signature.signature_s);
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_INT(1, result.verified);
+
+  result = p256_validated_key_verify(key, other_data_hash,
+                                     sizeof(other_data_hash),
+                                     signature.signature_r,
+                                     signature.signature_s);
+  TEST_ASSERT_EQUAL_INT(0, result.verified);
+
+  p256_validated_key_free(key);
+}
+
+void p256_validated_key_matches_recovery_should_compare_recovered_key(void) {
+  char error_message[256] = {0};
+  struct p256_validated_key *key = NULL;
+  struct sign_result signature = sign_data_hash();
+
+  TEST_ASSERT_EQUAL_INT(1, create_hex(&key, error_message, public_key));
+
+  struct verify_result result = p256_validated_key_matches_recovery(
+      key, data_hash, sizeof(data_hash), signature.signature_r,
+      signature.signature_s, signature.signature_v);
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_INT(1, result.verified);
+
+  // the other recovery id recovers another key
+  result = p256_validated_key_matches_recovery(
+      key, data_hash, sizeof(data_hash), signature.signature_r,
+      signature.signature_s, 1 - signature.signature_v);
+  TEST_ASSERT_EQUAL_INT(0, result.verified);
+
+  p256_validated_key_free(key);
+}
+
+void p256_validated_key_ecdh_should_compute_shared_secret(void) {
+  char error_message[256] = {0};
+  struct p256_validated_key *key = NULL;
+  unsigned char *private_key_data = hex_to_bin(ecdh_private_key);
+  unsigned char *expected = hex_to_bin(ecdh_shared_secret);
+
+  TEST_ASSERT_EQUAL_INT(1,
+                        create_hex(&key, error_message, ecdh_peer_public_key));
+
+  struct ecdh_result result =
+      p256_validated_key_ecdh(key, (const char *)private_key_data);
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, result.shared_secret, 32);
+
+  p256_validated_key_free(key);
+  free(private_key_data);
+  free(expected);
+}
+
+static void *create_ecdh_peer_key(void *key) {
+  char error_message[256] = {0};
+
+  create_hex(key, error_message, ecdh_peer_public_key);
+  return NULL;
+}
+
+// the group of the creating thread is freed when it exits, the key must not
+// depend on it
+void p256_validated_key_ecdh_should_use_key_of_exited_thread(void) {
+  struct p256_validated_key *key = NULL;
+  pthread_t thread;
+  unsigned char *private_key_data = hex_to_bin(ecdh_private_key);
+  unsigned char *expected = hex_to_bin(ecdh_shared_secret);
+
+  TEST_ASSERT_EQUAL_INT(
+      0, pthread_create(&thread, NULL, create_ecdh_peer_key, &key));
+  pthread_join(thread, NULL);
+  TEST_ASSERT_NOT_NULL(key);
+
+  struct ecdh_result result =
+      p256_validated_key_ecdh(key, (const char *)private_key_data);
+  TEST_ASSERT_EQUAL_STRING("", result.error_message);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, result.shared_secret, 32);
+
+  p256_validated_key_free(key);
+  free(private_key_data);
+  free(expected);
+}
+
+void p256_validated_key_create_should_reject_invalid_keys(void) {
+  char error_message[256] = {0};
+  char invalid_public_key[129];
+  struct p256_validated_key *key = NULL;
+
+  strcpy(invalid_public_key, public_key);
+  invalid_public_key[127] = 'a';
+  TEST_ASSERT_EQUAL_INT(0, create_hex(&key, error_message, invalid_public_key));
+  TEST_ASSERT_EQUAL_STRING_LEN("Public key is not a point on the curve: ",
+                               error_message, 40);
+  TEST_ASSERT_NULL(key);
+
+  // x = p
+  TEST_ASSERT_EQUAL_INT(
+      0, create_hex(&key, error_message,
+                    "ffffffff00000001000000000000000000000000ffffffffffffffff"
+                    "ffffffff"
+                    "ce4014c68811f9a21a1fdb2c0e6113e06db7ca93b7404e78dc7ccd5c"
+                    "a89a4ca9"));
+  TEST_ASSERT_NULL(key);
+}
+
+void p256_validated_keys_create_should_validate_all_keys(void) {
+  char public_keys[3 * 64];
+  struct p256_validated_key *keys[3];
+  unsigned char *data = hex_to_bin(public_key);
+
+  for (int i = 0; i < 3; i++) {
+    memcpy(public_keys + i * 64, data, 64);
+  }
+  public_keys[64 + 63] ^= 1;
+
+  TEST_ASSERT_EQUAL_INT(2, p256_validated_keys_create(keys, public_keys, 3));
+  TEST_ASSERT_NOT_NULL(keys[0]);
+  TEST_ASSERT_NULL(keys[1]);
+  TEST_ASSERT_NOT_NULL(keys[2]);
+
+  for (int i = 0; i < 3; i++) {
+    p256_validated_key_free(keys[i]);
+  }
+  free(data);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(void) {
+  for (size_t i = 0; i < sizeof(data_hash); i++) {
+    data_hash[i] = (char)i;
+  }
+
+  UNITY_BEGIN();
+
+  RUN_TEST(p256_validated_key_verify_should_verify_signatures);
+  RUN_TEST(p256_validated_key_matches_recovery_should_compare_recovered_key);
+  RUN_TEST(p256_validated_key_ecdh_should_compute_shared_secret);
+  RUN_TEST(p256_validated_key_ecdh_should_use_key_of_exited_thread);
+  RUN_TEST(p256_validated_key_create_should_reject_invalid_keys);
+  RUN_TEST(p256_validated_keys_create_should_validate_all_keys);
+
+  return UNITY_END();
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "constants.h"
+#include "worker_pool.h"
+
+#define ITEM_COUNT 100000
+#define PAIR_RUNS 1000
+
+struct visit_context {
+  atomic_uchar visits[ITEM_COUNT];
+};
+
+static void visit_items(void *context, size_t begin, size_t end) {
+  struct visit_context *visit_context = context;
+
+  for (size_t i = begin; i < end; i++) {
+    atomic_fetch_add(&visit_context->visits[i], 1);
+  }
+}
+
+static void assert_visited_once(struct visit_context *context) {
+  for (size_t i = 0; i < ITEM_COUNT; i++) {
+    TEST_ASSERT_EQUAL_UINT8(1, atomic_load(&context->visits[i]));
+  }
+}
+
+static void *run_visits(void *context) {
+  worker_pool_run(ITEM_COUNT, visit_items, context);
+
+  return NULL;
+}
+
+void worker_pool_run_should_process_every_item_once(void) {
+  static struct visit_context context;
+  memset(&context, 0, sizeof(context));
+
+  worker_pool_run(ITEM_COUNT, visit_items, &context);
+
+  assert_visited_once(&context);
+}
+
+void worker_pool_run_should_process_items_of_concurrent_callers(void) {
+  static struct visit_context contexts[4];
+  pthread_t threads[4];
+  memset(contexts, 0, sizeof(contexts));
+
+  for (int i = 0; i < 4; i++) {
+    pthread_create(&threads[i], NULL, run_visits, &contexts[i]);
+  }
+  for (int i = 0; i < 4; i++) {
+    pthread_join(threads[i], NULL);
+    assert_visited_once(&contexts[i]);
+  }
+}
+
+void worker_pool_run_should_not_call_work_without_items(void) {
+  static struct visit_context context;
+  memset(&context, 0, sizeof(context));
+
+  worker_pool_run(0, visit_items, &context);
+
+  TEST_ASSERT_EQUAL_UINT8(0, atomic_load(&context.visits[0]));
+}
+
+void worker_pool_run_should_process_items_with_spinning_workers(void) {
+  static struct visit_context contexts[4];
+  pthread_t threads[4];
+  memset(contexts, 0, sizeof(contexts));
+
+  worker_pool_set_spinning(1);
+  for (int i = 0; i < 4; i++) {
+    pthread_create(&threads[i], NULL, run_visits, &contexts[i]);
+  }
+  for (int i = 0; i < 4; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  worker_pool_set_spinning(0);
+
+  for (int i = 0; i < 4; i++) {
+    assert_visited_once(&contexts[i]);
+  }
+}
+
+struct pair_context {
+  pthread_t threads[2];
+  int visits[2];
+};
+
+static void record_pair_threads(void *context, size_t begin, size_t end) {
+  struct pair_context *pair_context = context;
+
+  for (size_t i = begin; i < end; i++) {
+    pair_context->threads[i] = pthread_self();
+    pair_context->visits[i]++;
+  }
+}
+
+static void assert_pair_split(void) {
+  for (int i = 0; i < PAIR_RUNS; i++) {
+    struct pair_context context = {.visits = {0, 0}};
+
+    worker_pool_run_pair(record_pair_threads, &context);
+
+    TEST_ASSERT_EQUAL_INT(1, context.visits[0]);
+    TEST_ASSERT_EQUAL_INT(1, context.visits[1]);
+    TEST_ASSERT_TRUE(pthread_equal(context.threads[0], pthread_self()));
+    TEST_ASSERT_FALSE(pthread_equal(context.threads[1], pthread_self()));
+  }
+}
+
+void worker_pool_run_pair_should_process_second_item_on_worker(void) {
+  assert_pair_split();
+}
+
+void worker_pool_run_pair_should_process_second_item_on_spinning_worker(
+    void) {
+  worker_pool_set_spinning(1);
+  assert_pair_split();
+  worker_pool_set_spinning(0);
+}
+
+int main(void) {
+  char error_message[256] = {0};
+
+  // at least two workers, so that the items are split on any machine
+  worker_pool_init(error_message, 2);
+
+  UNITY_BEGIN();
+
+  RUN_TEST(worker_pool_run_should_process_every_item_once);
+  RUN_TEST(worker_pool_run_should_process_items_of_concurrent_callers);
+  RUN_TEST(worker_pool_run_should_not_call_work_without_items);
+  RUN_TEST(worker_pool_run_should_process_items_with_spinning_workers);
+  RUN_TEST(worker_pool_run_pair_should_process_second_item_on_worker);
+  RUN_TEST(worker_pool_run_pair_should_process_second_item_on_spinning_worker);
+
+  return UNITY_END();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
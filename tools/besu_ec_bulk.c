@@ -0,0 +1,315 @@
+/*
+ * Copyright ConsenSys AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// mmap, ftruncate and clock_gettime are not part of strict C11
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "besu_native_ec.h"
+#include "constants.h"
+#include "worker_pool.h"
+
+// Runs verify, recover or sign over a file of fixed-size binary records and
+// writes one fixed-size result per record. All values are big-endian byte
+// strings as they are passed to the p256_* functions.
+//
+//   verify:  hash (32) | r (32) | s (32) | public key (64)
+//            -> 1 byte: 1 = verified, 0 = not verified, 255 = error
+//   recover: hash (32) | r (32) | s (32) | v (1)
+//            -> public key (64), all zero on error
+//   sign:    hash (32) | private key (32) | public key (64)
+//            -> r (32) | s (32) | v (1), v = 255 on error
+
+#define HASH_LEN 32
+#define SCALAR_LEN 32
+#define PUBLIC_KEY_LEN 64
+
+#define RESULT_ERROR 0xff
+
+struct operation {
+  const char *name;
+  size_t record_len;
+  size_t result_len;
+  // returns SUCCESS if the record could be processed without errors
+  int (*process)(const unsigned char *record, unsigned char *result);
+};
+
+static int process_verify(const unsigned char *record, unsigned char *result) {
+  const char *p = (const char *)record;
+  struct verify_result verify_result =
+      p256_verify(p, HASH_LEN, p + HASH_LEN, p + HASH_LEN + SCALAR_LEN,
+                  p + HASH_LEN + 2 * SCALAR_LEN);
+
+  result[0] = verify_result.verified < 0 ? RESULT_ERROR
+                                         : (unsigned char)verify_result.verified;
+
+  return verify_result.verified == 1 ? SUCCESS : FAILURE;
+}
+
+static int process_recover(const unsigned char *record,
+                           unsigned char *result) {
+  const char *p = (const char *)record;
+  struct key_recovery_result recovery_result =
+      p256_key_recovery(p, HASH_LEN, p + HASH_LEN, p + HASH_LEN + SCALAR_LEN,
+                        record[HASH_LEN + 2 * SCALAR_LEN]);
+
+  if (strlen(recovery_result.error_message) != 0) {
+    memset(result, 0, PUBLIC_KEY_LEN);
+    return FAILURE;
+  }
+
+  memcpy(result, recovery_result.public_key, PUBLIC_KEY_LEN);
+
+  return SUCCESS;
+}
+
+static int process_sign(const unsigned char *record, unsigned char *result) {
+  const char *p = (const char *)record;
+  struct sign_result sign_result =
+      p256_sign(p, HASH_LEN, p + HASH_LEN, p + HASH_LEN + SCALAR_LEN);
+
+  if (strlen(sign_result.error_message) != 0) {
+    memset(result, 0, 2 * SCALAR_LEN);
+    result[2 * SCALAR_LEN] = RESULT_ERROR;
+    return FAILURE;
+  }
+
+  memcpy(result, sign_result.signature_r, SCALAR_LEN);
+  memcpy(result + SCALAR_LEN, sign_result.signature_s, SCALAR_LEN);
+  result[2 * SCALAR_LEN] = (unsigned char)sign_result.signature_v;
+
+  return SUCCESS;
+}
+
+static const struct operation operations[] = {
+    {"verify", HASH_LEN + 2 * SCALAR_LEN + PUBLIC_KEY_LEN, 1, process_verify},
+    {"recover", HASH_LEN + 2 * SCALAR_LEN + 1, PUBLIC_KEY_LEN,
+     process_recover},
+    {"sign", HASH_LEN + SCALAR_LEN + PUBLIC_KEY_LEN, 2 * SCALAR_LEN + 1,
+     process_sign},
+};
+
+struct bulk_job {
+  const struct operation *operation;
+  const unsigned char *records;
+  unsigned char *results;
+  size_t record_count;
+  atomic_size_t processed;
+  atomic_size_t failed;
+  atomic_int done;
+};
+
+static void process_records(void *context, size_t begin, size_t end) {
+  struct bulk_job *job = context;
+  size_t failed = 0;
+
+  for (size_t i = begin; i < end; i++) {
+    if (job->operation->process(
+            job->records + i * job->operation->record_len,
+            job->results + i * job->operation->result_len) != SUCCESS) {
+      failed++;
+    }
+  }
+
+  atomic_fetch_add(&job->failed, failed);
+  atomic_fetch_add(&job->processed, end - begin);
+}
+
+static double seconds_since(const struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void *report_progress(void *context) {
+  struct bulk_job *job = context;
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  int printed = 0;
+
+  for (int tick = 1; !atomic_load(&job->done); tick++) {
+    struct timespec interval = {.tv_sec = 0, .tv_nsec = 100000000};
+    nanosleep(&interval, NULL);
+
+    // the progress is printed once per second
+    if (tick % 10 != 0) {
+      continue;
+    }
+
+    size_t processed = atomic_load(&job->processed);
+    double seconds = seconds_since(&start);
+    fprintf(stderr, "\r%zu / %zu records (%.1f%%), %.0f records/s", processed,
+            job->record_count, 100.0 * processed / job->record_count,
+            processed / seconds);
+    printed = 1;
+  }
+
+  if (printed) {
+    fprintf(stderr, "\n");
+  }
+
+  return NULL;
+}
+
+static void print_usage(const char *program) {
+  fprintf(stderr,
+          "Usage: %s verify|recover|sign <input file> <output file> "
+          "[--threads <count>]\n"
+          "\n"
+          "Record formats, all values big-endian:\n"
+          "  verify:  hash (32) | r (32) | s (32) | public key (64)\n"
+          "           -> 1 byte: 1 = verified, 0 = not verified, "
+          "255 = error\n"
+          "  recover: hash (32) | r (32) | s (32) | v (1)\n"
+          "           -> public key (64), all zero on error\n"
+          "  sign:    hash (32) | private key (32) | public key (64)\n"
+          "           -> r (32) | s (32) | v (1), v = 255 on error\n",
+          program);
+}
+
+int main(int argc, char *argv[]) {
+  int ret = EXIT_FAILURE;
+  int thread_count = -1;
+  char error_message[256] = {0};
+
+  int input_fd = -1;
+  int output_fd = -1;
+  void *input = MAP_FAILED;
+  void *output = MAP_FAILED;
+  size_t input_len = 0;
+  size_t output_len = 0;
+
+  if (argc != 4 && !(argc == 6 && strcmp(argv[4], "--threads") == 0)) {
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (argc == 6) {
+    // the calling thread processes records as well
+    if ((thread_count = atoi(argv[5]) - 1) < 0) {
+      print_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  const struct operation *operation = NULL;
+  for (size_t i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+    if (strcmp(argv[1], operations[i].name) == 0) {
+      operation = &operations[i];
+    }
+  }
+  if (operation == NULL) {
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  struct stat input_stat;
+  if ((input_fd = open(argv[2], O_RDONLY)) < 0 ||
+      fstat(input_fd, &input_stat) != 0) {
+    fprintf(stderr, "Could not open input file %s\n", argv[2]);
+    goto end;
+  }
+
+  input_len = input_stat.st_size;
+  if (input_len == 0 || input_len % operation->record_len != 0) {
+    fprintf(stderr, "Length of %s is not a multiple of %zu byte records\n",
+            argv[2], operation->record_len);
+    goto end;
+  }
+
+  struct bulk_job job = {.operation = operation,
+                         .record_count = input_len / operation->record_len,
+                         .processed = 0,
+                         .failed = 0,
+                         .done = 0};
+  output_len = job.record_count * operation->result_len;
+
+  if ((output_fd = open(argv[3], O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0 ||
+      ftruncate(output_fd, output_len) != 0) {
+    fprintf(stderr, "Could not create output file %s\n", argv[3]);
+    goto end;
+  }
+
+  if ((input = mmap(NULL, input_len, PROT_READ, MAP_PRIVATE, input_fd, 0)) ==
+          MAP_FAILED ||
+      (output = mmap(NULL, output_len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     output_fd, 0)) == MAP_FAILED) {
+    fprintf(stderr, "Could not map input and output files\n");
+    goto end;
+  }
+  // the records are read front to back by every worker
+  madvise(input, input_len, MADV_SEQUENTIAL);
+
+  job.records = input;
+  job.results = output;
+
+  if (worker_pool_init(error_message, thread_count) != SUCCESS) {
+    fprintf(stderr, "%s", error_message);
+  }
+
+  pthread_t progress_thread;
+  pthread_create(&progress_thread, NULL, report_progress, &job);
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  worker_pool_run(job.record_count, process_records, &job);
+
+  double seconds = seconds_since(&start);
+  atomic_store(&job.done, 1);
+  pthread_join(progress_thread, NULL);
+
+  fprintf(stderr,
+          "%s: %zu records in %.3f s with %d threads, %.0f records/s, "
+          "%zu failed\n",
+          operation->name, job.record_count, seconds,
+          worker_pool_thread_count() + 1, job.record_count / seconds,
+          atomic_load(&job.failed));
+
+  if (msync(output, output_len, MS_SYNC) != 0) {
+    fprintf(stderr, "Could not write output file %s\n", argv[3]);
+    goto end;
+  }
+
+  ret = EXIT_SUCCESS;
+
+end:
+  if (input != MAP_FAILED) {
+    munmap(input, input_len);
+  }
+  if (output != MAP_FAILED) {
+    munmap(output, output_len);
+  }
+  if (input_fd >= 0) {
+    close(input_fd);
+  }
+  if (output_fd >= 0) {
+    close(output_fd);
+  }
+
+  return ret;
+}